@@ -0,0 +1,901 @@
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <gtk/gtk.h>
+#include <bbextensions.h>
+#include <bblibrary.h>
+#include "bbgedacache.h"
+#include "bbgedarecord.h"
+
+
+/**
+ * Identifies cache files, and prevents reading other files as cache files
+ */
+#define CACHE_MAGIC "BBSC"
+
+
+/**
+ * Incremented whenever the layout of the cache file changes
+ */
+#define CACHE_VERSION (1)
+
+
+/**
+ * Written in host byte order, so entries from hosts with a different byte order are rejected
+ */
+#define CACHE_BYTE_ORDER (0x01020304)
+
+
+/**
+ * The extension of cache files
+ */
+#define CACHE_EXTENSION ".bbc"
+
+
+/**
+ * The checksum of the source file contents
+ */
+#define CHECKSUM_TYPE G_CHECKSUM_SHA256
+
+
+/**
+ * The length of the checksum in hexadecimal, excluding the null terminator
+ */
+#define CHECKSUM_LENGTH (64)
+
+
+/**
+ * The maximum number of parameters on the first line of an item
+ *
+ * Prevents a corrupt cache entry from causing large allocations.
+ */
+#define MAX_PARAMS (256)
+
+
+/**
+ * The number of bits in each word of the integer mask
+ */
+#define MASK_BITS (32)
+
+
+enum
+{
+    PROP_0,
+    PROP_DIRECTORY,
+    N_PROPERTIES
+};
+
+
+struct _BbGedaCache
+{
+    GObject parent;
+
+    /**
+     * The directory containing the cached files
+     */
+    gchar *directory;
+};
+
+
+struct _BbGedaCacheKey
+{
+    /**
+     * The URI of the source file
+     */
+    gchar *uri;
+
+    /**
+     * The size of the source file in bytes
+     */
+    guint64 size;
+
+    /**
+     * The modification time of the source file in microseconds
+     */
+    gint64 modified;
+
+    /**
+     * The checksum of the source file contents in hexadecimal
+     */
+    gchar *checksum;
+};
+
+
+/**
+ * The beginning of each cache file
+ *
+ * The header is followed by:
+ *
+ * - The offset of each string within the string data, as guint32[string_count]
+ * - The records, as guint32[word_count]
+ * - The string data, containing each null terminated string
+ *
+ * String 0 contains the URI of the source file. Each record contains:
+ *
+ * - A flags word, containing 1 for an attribute and 0 otherwise
+ * - The number of parameters, including the token
+ * - The number of additional lines
+ * - A mask, with one bit per parameter set for integers, as guint32[(param_count + 31) / 32]
+ * - For each parameter, the integer value or the index of the string, as guint32[param_count]
+ * - For each additional line, the index of the string, as guint32[line_count]
+ */
+typedef struct _BbCacheHeader BbCacheHeader;
+
+struct _BbCacheHeader
+{
+    gchar magic[4];
+    guint32 version;
+    guint32 byte_order;
+    guint32 string_count;
+    guint32 record_count;
+    guint32 word_count;
+    guint64 size;
+    gint64 modified;
+    gchar checksum[CHECKSUM_LENGTH];
+};
+
+
+/**
+ * The contents of a cache file under construction
+ */
+typedef struct _BbCacheBuilder BbCacheBuilder;
+
+struct _BbCacheBuilder
+{
+    /**
+     * Maps each interned string to its index plus one
+     */
+    GHashTable *indices;
+
+    /**
+     * The offset of each string within the string data
+     */
+    GArray *offsets;
+
+    /**
+     * The records
+     */
+    GArray *words;
+
+    /**
+     * The string data
+     */
+    GString *strings;
+};
+
+
+G_DEFINE_TYPE_EXTENDED(
+    BbGedaCache,
+    bb_geda_cache,
+    G_TYPE_OBJECT,
+    0,
+    )
+
+
+// region Function prototypes
+
+static void
+bb_geda_cache_builder_add_record(BbCacheBuilder *builder, BbGedaRecord *record);
+
+static void
+bb_geda_cache_builder_clear(BbCacheBuilder *builder);
+
+static void
+bb_geda_cache_builder_init(BbCacheBuilder *builder);
+
+static guint32
+bb_geda_cache_builder_intern(BbCacheBuilder *builder, const gchar *string);
+
+static GArray*
+bb_geda_cache_decode(const gchar *contents, gsize length, const BbGedaCacheKey *key, GError **error);
+
+static void
+bb_geda_cache_dispose(GObject *object);
+
+static void
+bb_geda_cache_finalize(GObject *object);
+
+static gchar*
+bb_geda_cache_get_path(BbGedaCache *cache, const BbGedaCacheKey *key);
+
+static void
+bb_geda_cache_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
+
+static gboolean
+bb_geda_cache_parse_value(const gchar *token, int *value);
+
+static void
+bb_geda_cache_set_directory(BbGedaCache *cache, const gchar *directory);
+
+static void
+bb_geda_cache_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
+
+// endregion
+
+
+static GParamSpec *properties[N_PROPERTIES];
+
+
+/**
+ * Append a record, interning its strings
+ *
+ * @param builder The cache file under construction
+ * @param record A record from pre-scanning the text of the source file
+ */
+static void
+bb_geda_cache_builder_add_record(BbCacheBuilder *builder, BbGedaRecord *record)
+{
+    int count = bb_params_get_count(record->params);
+    guint32 line_count = record->lines != NULL ? g_strv_length(record->lines) : 0;
+    guint32 mask_count = (count + MASK_BITS - 1) / MASK_BITS;
+    guint first = builder->words->len;
+
+    g_array_set_size(builder->words, first + 3 + mask_count + count + line_count);
+
+    guint32 *words = &g_array_index(builder->words, guint32, first);
+    guint32 *mask = words + 3;
+    guint32 *values = mask + mask_count;
+    guint32 *lines = values + count;
+
+    words[0] = record->attribute ? 1 : 0;
+    words[1] = count;
+    words[2] = line_count;
+
+    memset(mask, 0, mask_count * sizeof(guint32));
+
+    for (int index = 0; index < count; index++)
+    {
+        const gchar *token = bb_params_get_string(record->params, index, NULL);
+        int value;
+
+        /* The token identifying the item type always remains a string */
+
+        if (index > 0 && bb_geda_cache_parse_value(token, &value))
+        {
+            mask[index / MASK_BITS] |= 1u << (index % MASK_BITS);
+            values[index] = (guint32) value;
+        }
+        else
+        {
+            values[index] = bb_geda_cache_builder_intern(builder, token);
+        }
+    }
+
+    for (guint32 index = 0; index < line_count; index++)
+    {
+        lines[index] = bb_geda_cache_builder_intern(builder, record->lines[index]);
+    }
+}
+
+
+static void
+bb_geda_cache_builder_clear(BbCacheBuilder *builder)
+{
+    g_clear_pointer(&builder->indices, g_hash_table_unref);
+    g_clear_pointer(&builder->offsets, g_array_unref);
+    g_clear_pointer(&builder->words, g_array_unref);
+
+    if (builder->strings != NULL)
+    {
+        g_string_free(builder->strings, TRUE);
+        builder->strings = NULL;
+    }
+}
+
+
+static void
+bb_geda_cache_builder_init(BbCacheBuilder *builder)
+{
+    builder->indices = g_hash_table_new(g_str_hash, g_str_equal);
+    builder->offsets = g_array_new(FALSE, FALSE, sizeof(guint32));
+    builder->words = g_array_new(FALSE, FALSE, sizeof(guint32));
+    builder->strings = g_string_new(NULL);
+}
+
+
+/**
+ * Get the index of a string, adding it to the string table if not already present
+ *
+ * @param builder The cache file under construction
+ * @param string The string, which must remain valid until the builder is cleared
+ * @return The index of the string
+ */
+static guint32
+bb_geda_cache_builder_intern(BbCacheBuilder *builder, const gchar *string)
+{
+    guint32 index = GPOINTER_TO_UINT(g_hash_table_lookup(builder->indices, string));
+
+    if (index == 0)
+    {
+        guint32 offset = builder->strings->len;
+
+        g_array_append_val(builder->offsets, offset);
+        g_string_append_len(builder->strings, string, strlen(string) + 1);
+
+        index = builder->offsets->len;
+
+        g_hash_table_insert(builder->indices, (gpointer) string, GUINT_TO_POINTER(index));
+    }
+
+    return index - 1;
+}
+
+
+static void
+bb_geda_cache_class_init(BbGedaCacheClass *klasse)
+{
+    GObjectClass *object_class = G_OBJECT_CLASS(klasse);
+    g_return_if_fail(object_class != NULL);
+
+    object_class->dispose = bb_geda_cache_dispose;
+    object_class->finalize = bb_geda_cache_finalize;
+    object_class->get_property = bb_geda_cache_get_property;
+    object_class->set_property = bb_geda_cache_set_property;
+
+    properties[PROP_DIRECTORY] = bb_object_class_install_property(
+        object_class,
+        PROP_DIRECTORY,
+        g_param_spec_string(
+            "directory",
+            "",
+            "",
+            NULL,
+            G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS
+            )
+        );
+}
+
+
+/**
+ * Build the records from the contents of a cache file
+ *
+ * @param contents The contents of the cache file
+ * @param length The length of the contents in bytes
+ * @param key The key for the source file
+ * @param error The error, if the contents are incompatible or corrupt
+ * @return An array of BbGedaRecord, or NULL if the entry is stale or an error occurred
+ */
+static GArray*
+bb_geda_cache_decode(const gchar *contents, gsize length, const BbGedaCacheKey *key, GError **error)
+{
+    BbCacheHeader header;
+
+    if (length < sizeof(BbCacheHeader))
+    {
+        g_set_error(error, BB_ERROR_DOMAIN, 0, "Truncated cache entry");
+        return NULL;
+    }
+
+    memcpy(&header, contents, sizeof(BbCacheHeader));
+
+    if (memcmp(header.magic, CACHE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != CACHE_VERSION ||
+        header.byte_order != CACHE_BYTE_ORDER)
+    {
+        g_set_error(error, BB_ERROR_DOMAIN, 0, "Incompatible cache entry");
+        return NULL;
+    }
+
+    if (header.size != key->size ||
+        header.modified != key->modified ||
+        memcmp(header.checksum, key->checksum, CHECKSUM_LENGTH) != 0)
+    {
+        return NULL;
+    }
+
+    guint64 table_length = sizeof(BbCacheHeader) + sizeof(guint32) * ((guint64) header.string_count + header.word_count);
+
+    if (header.string_count == 0 || table_length >= length || contents[length - 1] != '\0')
+    {
+        g_set_error(error, BB_ERROR_DOMAIN, 0, "Corrupt cache entry");
+        return NULL;
+    }
+
+    /* Mapped files begin on a page boundary, and the header is a multiple of the word size */
+
+    const guint32 *offsets = (const guint32*) (contents + sizeof(BbCacheHeader));
+    const guint32 *words = offsets + header.string_count;
+    const gchar *data = (const gchar*) (words + header.word_count);
+    gsize data_length = length - table_length;
+
+    const gchar **strings = g_new(const gchar*, header.string_count);
+    GError *local_error = NULL;
+
+    for (guint32 index = 0; local_error == NULL && index < header.string_count; index++)
+    {
+        if (offsets[index] >= data_length)
+        {
+            local_error = g_error_new(BB_ERROR_DOMAIN, 0, "Corrupt cache entry");
+        }
+        else
+        {
+            strings[index] = data + offsets[index];
+        }
+    }
+
+    /* A different source file with a colliding cache file name */
+
+    if (local_error == NULL && g_strcmp0(strings[0], key->uri) != 0)
+    {
+        g_free(strings);
+        return NULL;
+    }
+
+    GArray *records = g_array_sized_new(FALSE, TRUE, sizeof(BbGedaRecord), header.record_count);
+    g_array_set_clear_func(records, (GDestroyNotify) bb_geda_record_clear);
+
+    const guint32 *current = words;
+    const guint32 *end = words + header.word_count;
+    const gchar *tokens[MAX_PARAMS];
+
+    for (guint32 index = 0; local_error == NULL && index < header.record_count; index++)
+    {
+        if (end - current < 3)
+        {
+            local_error = g_error_new(BB_ERROR_DOMAIN, 0, "Corrupt cache entry");
+            break;
+        }
+
+        guint32 count = current[1];
+        guint32 line_count = current[2];
+        guint32 mask_count = (count + MASK_BITS - 1) / MASK_BITS;
+
+        if (count == 0 || count > MAX_PARAMS || (guint64) (end - current) < 3ull + mask_count + count + line_count)
+        {
+            local_error = g_error_new(BB_ERROR_DOMAIN, 0, "Corrupt cache entry");
+            break;
+        }
+
+        BbGedaRecord record = { 0 };
+        const guint32 *mask = current + 3;
+        const guint32 *values = mask + mask_count;
+        const guint32 *lines = values + count;
+
+        record.attribute = (current[0] & 1) != 0;
+
+        for (guint32 param = 0; local_error == NULL && param < count; param++)
+        {
+            if (mask[param / MASK_BITS] & (1u << (param % MASK_BITS)))
+            {
+                tokens[param] = NULL;
+            }
+            else if (values[param] < header.string_count)
+            {
+                tokens[param] = strings[values[param]];
+            }
+            else
+            {
+                local_error = g_error_new(BB_ERROR_DOMAIN, 0, "Corrupt cache entry");
+            }
+        }
+
+        if (local_error == NULL && tokens[0] == NULL)
+        {
+            local_error = g_error_new(BB_ERROR_DOMAIN, 0, "Corrupt cache entry");
+        }
+
+        if (local_error == NULL)
+        {
+            record.params = bb_params_new_with_values(count, tokens, (const int*) values);
+        }
+
+        if (local_error == NULL && line_count > 0)
+        {
+            record.lines = g_new0(gchar*, line_count + 1);
+
+            for (guint32 line = 0; local_error == NULL && line < line_count; line++)
+            {
+                if (lines[line] < header.string_count)
+                {
+                    /* The lines are only read, so may point into the read-only mapping */
+                    record.lines[line] = (gchar*) strings[lines[line]];
+                }
+                else
+                {
+                    local_error = g_error_new(BB_ERROR_DOMAIN, 0, "Corrupt cache entry");
+                }
+            }
+        }
+
+        /* Appended even on error, so the array releases it */
+        g_array_append_val(records, record);
+
+        current = lines + line_count;
+    }
+
+    if (local_error == NULL && current != end)
+    {
+        local_error = g_error_new(BB_ERROR_DOMAIN, 0, "Corrupt cache entry");
+    }
+
+    g_free(strings);
+
+    if (local_error != NULL)
+    {
+        g_propagate_error(error, local_error);
+        g_array_unref(records);
+        records = NULL;
+    }
+
+    return records;
+}
+
+
+static void
+bb_geda_cache_dispose(GObject *object)
+{
+}
+
+
+static void
+bb_geda_cache_finalize(GObject *object)
+{
+    BbGedaCache *cache = BB_GEDA_CACHE(object);
+
+    g_free(cache->directory);
+
+    G_OBJECT_CLASS(bb_geda_cache_parent_class)->finalize(object);
+}
+
+
+const gchar*
+bb_geda_cache_get_directory(BbGedaCache *cache)
+{
+    g_return_val_if_fail(BB_IS_GEDA_CACHE(cache), NULL);
+
+    return cache->directory;
+}
+
+
+/**
+ * Get the location of the cache file for a source file
+ *
+ * @param cache A BbGedaCache
+ * @param key The key for the source file
+ * @return The path of the cache file
+ */
+static gchar*
+bb_geda_cache_get_path(BbGedaCache *cache, const BbGedaCacheKey *key)
+{
+    gchar *name = g_compute_checksum_for_string(G_CHECKSUM_SHA1, key->uri, -1);
+    gchar *basename = g_strconcat(name, CACHE_EXTENSION, NULL);
+    gchar *path = g_build_filename(cache->directory, basename, NULL);
+
+    g_free(basename);
+    g_free(name);
+
+    return path;
+}
+
+
+static void
+bb_geda_cache_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec)
+{
+    switch (property_id)
+    {
+        case PROP_DIRECTORY:
+            g_value_set_string(value, bb_geda_cache_get_directory(BB_GEDA_CACHE(object)));
+            break;
+
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+    }
+}
+
+
+static void
+bb_geda_cache_init(BbGedaCache *cache)
+{
+}
+
+
+void
+bb_geda_cache_key_free(BbGedaCacheKey *key)
+{
+    if (key != NULL)
+    {
+        g_free(key->checksum);
+        g_free(key->uri);
+        g_slice_free(BbGedaCacheKey, key);
+    }
+}
+
+
+BbGedaCacheKey*
+bb_geda_cache_key_new(GFile *file, GFileInfo *info, const gchar *contents, gsize length)
+{
+    g_return_val_if_fail(G_IS_FILE(file), NULL);
+    g_return_val_if_fail(G_IS_FILE_INFO(info), NULL);
+    g_return_val_if_fail(contents != NULL, NULL);
+
+    BbGedaCacheKey *key = g_slice_new(BbGedaCacheKey);
+
+    key->uri = g_file_get_uri(file);
+    key->size = g_file_info_get_attribute_uint64(info, G_FILE_ATTRIBUTE_STANDARD_SIZE);
+    key->modified = G_USEC_PER_SEC * g_file_info_get_attribute_uint64(info, G_FILE_ATTRIBUTE_TIME_MODIFIED)
+        + g_file_info_get_attribute_uint32(info, G_FILE_ATTRIBUTE_TIME_MODIFIED_USEC);
+    key->checksum = g_compute_checksum_for_data(CHECKSUM_TYPE, (const guchar*) contents, length);
+
+    return key;
+}
+
+
+GArray*
+bb_geda_cache_load(BbGedaCache *cache, const BbGedaCacheKey *key, GMappedFile **mapping, GError **error)
+{
+    g_return_val_if_fail(BB_IS_GEDA_CACHE(cache), NULL);
+    g_return_val_if_fail(key != NULL, NULL);
+    g_return_val_if_fail(mapping != NULL, NULL);
+
+    GError *local_error = NULL;
+    GArray *records = NULL;
+    gchar *path = bb_geda_cache_get_path(cache, key);
+
+    GMappedFile *mapped = g_mapped_file_new(path, FALSE, &local_error);
+
+    if (g_error_matches(local_error, G_FILE_ERROR, G_FILE_ERROR_NOENT))
+    {
+        /* Not previously cached */
+        g_clear_error(&local_error);
+    }
+    else if (local_error == NULL)
+    {
+        records = bb_geda_cache_decode(
+            g_mapped_file_get_contents(mapped),
+            g_mapped_file_get_length(mapped),
+            key,
+            &local_error
+            );
+    }
+
+    if (records != NULL)
+    {
+        *mapping = g_steal_pointer(&mapped);
+    }
+
+    g_clear_pointer(&mapped, g_mapped_file_unref);
+    g_free(path);
+
+    if (local_error != NULL)
+    {
+        g_propagate_error(error, local_error);
+    }
+
+    return records;
+}
+
+
+BbGedaCache*
+bb_geda_cache_new(const gchar *directory)
+{
+    return BB_GEDA_CACHE(g_object_new(
+        BB_TYPE_GEDA_CACHE,
+        "directory", directory,
+        NULL
+        ));
+}
+
+
+/**
+ * Check for the canonical text of a 32 bit integer
+ *
+ * Only text that formats identically from the integer is converted, so the conversion is lossless. Other text,
+ * such as leading zeros or an explicit plus sign, remains a string and is parsed when creating the item.
+ *
+ * @param token The text of the parameter
+ * @param value Receives the integer value
+ * @return TRUE if the token is the canonical text of an integer
+ */
+static gboolean
+bb_geda_cache_parse_value(const gchar *token, int *value)
+{
+    const gchar *current = token;
+    gboolean negative = (*current == '-');
+    gint64 magnitude = 0;
+
+    if (negative)
+    {
+        current++;
+    }
+
+    const gchar *digits = current;
+
+    while (g_ascii_isdigit(*current) && current - digits < 10)
+    {
+        magnitude = 10 * magnitude + (*current++ - '0');
+    }
+
+    if (*current != '\0' || current == digits || (*digits == '0' && (current - digits > 1 || negative)))
+    {
+        return FALSE;
+    }
+
+    gint64 result = negative ? -magnitude : magnitude;
+
+    if (result < G_MININT || result > G_MAXINT)
+    {
+        return FALSE;
+    }
+
+    *value = (int) result;
+
+    return TRUE;
+}
+
+
+/**
+ * Set the directory containing the cached files
+ *
+ * @param cache A BbGedaCache
+ * @param directory The directory, or NULL for the user's cache directory
+ */
+static void
+bb_geda_cache_set_directory(BbGedaCache *cache, const gchar *directory)
+{
+    g_return_if_fail(BB_IS_GEDA_CACHE(cache));
+
+    g_free(cache->directory);
+
+    if (directory != NULL)
+    {
+        cache->directory = g_strdup(directory);
+    }
+    else
+    {
+        cache->directory = g_build_filename(g_get_user_cache_dir(), "bbsch", NULL);
+    }
+
+    g_object_notify_by_pspec(G_OBJECT(cache), properties[PROP_DIRECTORY]);
+}
+
+
+static void
+bb_geda_cache_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec)
+{
+    switch (property_id)
+    {
+        case PROP_DIRECTORY:
+            bb_geda_cache_set_directory(BB_GEDA_CACHE(object), g_value_get_string(value));
+            break;
+
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+    }
+}
+
+
+gboolean
+bb_geda_cache_store(
+    BbGedaCache *cache,
+    const BbGedaCacheKey *key,
+    GArray *records,
+    GCancellable *cancellable,
+    GError **error
+    )
+{
+    g_return_val_if_fail(BB_IS_GEDA_CACHE(cache), FALSE);
+    g_return_val_if_fail(key != NULL, FALSE);
+    g_return_val_if_fail(records != NULL, FALSE);
+
+    BbCacheBuilder builder;
+    GError *local_error = NULL;
+
+    bb_geda_cache_builder_init(&builder);
+    bb_geda_cache_builder_intern(&builder, key->uri);
+
+    for (guint index = 0; index < records->len; index++)
+    {
+        bb_geda_cache_builder_add_record(&builder, &g_array_index(records, BbGedaRecord, index));
+    }
+
+    BbCacheHeader header = { 0 };
+
+    memcpy(header.magic, CACHE_MAGIC, sizeof(header.magic));
+    header.version = CACHE_VERSION;
+    header.byte_order = CACHE_BYTE_ORDER;
+    header.string_count = builder.offsets->len;
+    header.record_count = records->len;
+    header.word_count = builder.words->len;
+    header.size = key->size;
+    header.modified = key->modified;
+    memcpy(header.checksum, key->checksum, CHECKSUM_LENGTH);
+
+    if (g_mkdir_with_parents(cache->directory, 0700) != 0)
+    {
+        int code = errno;
+
+        local_error = g_error_new(
+            G_FILE_ERROR,
+            g_file_error_from_errno(code),
+            "Unable to create cache directory %s: %s",
+            cache->directory,
+            g_strerror(code)
+            );
+    }
+
+    gchar *path = bb_geda_cache_get_path(cache, key);
+    GFile *file = g_file_new_for_path(path);
+    GFileOutputStream *stream = NULL;
+
+    if (local_error == NULL)
+    {
+        stream = g_file_replace(
+            file,
+            NULL,
+            FALSE,
+            G_FILE_CREATE_PRIVATE | G_FILE_CREATE_REPLACE_DESTINATION,
+            cancellable,
+            &local_error
+            );
+    }
+
+    struct
+    {
+        const void *data;
+        gsize length;
+    }
+    sections[] =
+    {
+        { &header, sizeof(BbCacheHeader) },
+        { builder.offsets->data, builder.offsets->len * sizeof(guint32) },
+        { builder.words->data, builder.words->len * sizeof(guint32) },
+        { builder.strings->str, builder.strings->len }
+    };
+
+    for (int index = 0; local_error == NULL && index < G_N_ELEMENTS(sections); index++)
+    {
+        g_output_stream_write_all(
+            G_OUTPUT_STREAM(stream),
+            sections[index].data,
+            sections[index].length,
+            NULL,
+            cancellable,
+            &local_error
+            );
+    }
+
+    if (local_error == NULL)
+    {
+        g_output_stream_close(G_OUTPUT_STREAM(stream), cancellable, &local_error);
+    }
+    else if (stream != NULL)
+    {
+        /* Closing with a cancelled cancellable discards the temporary file and leaves any existing entry */
+
+        GCancellable *abort = g_cancellable_new();
+
+        g_cancellable_cancel(abort);
+        g_output_stream_close(G_OUTPUT_STREAM(stream), abort, NULL);
+        g_object_unref(abort);
+    }
+
+    g_clear_object(&stream);
+    g_object_unref(file);
+    g_free(path);
+    bb_geda_cache_builder_clear(&builder);
+
+    if (local_error != NULL)
+    {
+        g_propagate_error(error, local_error);
+        return FALSE;
+    }
+
+    return TRUE;
+}
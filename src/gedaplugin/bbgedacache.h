@@ -0,0 +1,139 @@
+#ifndef __BBGEDACACHE__
+#define __BBGEDACACHE__
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file bbgedacache.h
+ *
+ * A cache of pre-scanned gEDA files, in a compact binary form, for reopening large files quickly
+ *
+ * The cache holds the records found by the reader's pre-scan, with integer parameters already parsed and all
+ * strings, including attributes and the lines of text, interned in a single string table. Loading the cache
+ * maps the file into memory and builds the records without tokenizing or parsing any text. The items are then
+ * created by the same factories used for the text format.
+ *
+ * Each cached file is stored in the cache directory under a name derived from the URI of the source file. An
+ * entry is only used when the URI, size, modification time and checksum of the contents all match the source.
+ * The cache is an optimization only. Any missing, stale, incompatible or corrupt entry results in a miss, and
+ * the caller reads the text instead.
+ *
+ * The entries use the byte order of the host, and entries written on a host with a different byte order are
+ * treated as incompatible.
+ *
+ * These functions are reentrant.
+ */
+
+#include <gtk/gtk.h>
+
+
+#define BB_TYPE_GEDA_CACHE bb_geda_cache_get_type()
+G_DECLARE_FINAL_TYPE(BbGedaCache, bb_geda_cache, BB, GEDA_CACHE, GObject)
+
+
+/**
+ * Identifies the exact contents of a source file
+ */
+typedef struct _BbGedaCacheKey BbGedaCacheKey;
+
+
+/**
+ * Get the directory containing the cached files
+ *
+ * @param cache A BbGedaCache
+ * @return The directory, owned by the cache
+ */
+const gchar*
+bb_geda_cache_get_directory(BbGedaCache *cache);
+
+
+/**
+ * Free resources associated with a key
+ *
+ * @param key A BbGedaCacheKey, or NULL
+ */
+void
+bb_geda_cache_key_free(BbGedaCacheKey *key);
+
+
+/**
+ * Create a key identifying the contents of a source file
+ *
+ * Computes the checksum of the contents, so the contents must be unmodified.
+ *
+ * Use bb_geda_cache_key_free() to release all associated resources
+ *
+ * @param file The source file
+ * @param info Information for the source file, including the size and modification time
+ * @param contents The contents of the source file
+ * @param length The length of the contents in bytes
+ * @return A new BbGedaCacheKey
+ */
+BbGedaCacheKey*
+bb_geda_cache_key_new(GFile *file, GFileInfo *info, const gchar *contents, gsize length);
+
+
+/**
+ * Load the records of a source file from the cache
+ *
+ * The records point into the mapped cache file, so the mapping must be released after the records.
+ *
+ * @param cache A BbGedaCache
+ * @param key The key for the source file
+ * @param mapping Receives the mapped cache file on success
+ * @param error The error, if the cache entry exists but is unusable
+ * @return An array of BbGedaRecord in file order, or NULL on a miss or error
+ */
+GArray*
+bb_geda_cache_load(BbGedaCache *cache, const BbGedaCacheKey *key, GMappedFile **mapping, GError **error);
+
+
+/**
+ * Create a cache, with entries stored in the given directory
+ *
+ * @param directory The directory containing the cached files, or NULL for the user's cache directory
+ * @return A new BbGedaCache
+ */
+BbGedaCache*
+bb_geda_cache_new(const gchar *directory);
+
+
+/**
+ * Store the records of a source file in the cache, replacing any existing entry
+ *
+ * The entry is written to a temporary file and renamed, so concurrent readers see either the old entry or the
+ * new entry.
+ *
+ * @param cache A BbGedaCache
+ * @param key The key for the source file
+ * @param records An array of BbGedaRecord from pre-scanning the text of the source file
+ * @param cancellable A token to cancel the operation
+ * @param error The error, if any
+ * @return TRUE on success, FALSE on failure
+ */
+gboolean
+bb_geda_cache_store(
+    BbGedaCache *cache,
+    const BbGedaCacheKey *key,
+    GArray *records,
+    GCancellable *cancellable,
+    GError **error
+    );
+
+
+#endif
@@ -36,6 +36,8 @@
 #include "bbarctool.h"
 #include "bbtoolchanger.h"
 #include "bbgraphics.h"
+#include "bbdisplaylist.h"
+#include "bbtilecache.h"
 #include "actions/bbzoomreceiver.h"
 #include "actions/bbrevealreceiver.h"
 #include "actions/bbgridsubject.h"
@@ -94,6 +96,37 @@
 #define BB_ZOOM_QUANTIZE (200.0)
 
 
+/**
+ * Additional device units around an invalidated item
+ *
+ * Covers antialiasing and the minimum line width applied when rendering.
+ */
+#define BB_INVALIDATE_MARGIN (2.0)
+
+
+/**
+ * The fraction of the view a repaint must cover to replay the display list
+ *
+ * Smaller repaints, like those for an edited item, render only the items in the damaged region through the
+ * spatial index. Replaying the whole list would cost more than walking the few items in the region.
+ */
+#define BB_DISPLAY_LIST_COVERAGE (0.5)
+
+
+/**
+ * The number of layouts retained for measuring text
+ *
+ * Items cache their bounds, so text is only measured again after it changes.
+ */
+#define BB_METRICS_CACHE_CAPACITY (256)
+
+
+/**
+ * The key for the number of journaled edits when a snapshot started, attached to its temporary file
+ */
+#define BB_SNAPSHOT_EDIT_COUNT_KEY "bb-snapshot-edit-count"
+
+
 enum
 {
     PROP_0,
@@ -119,8 +152,12 @@ enum
     PROP_SCHEMATIC,
     PROP_TOOL_CHANGER,
 
+    PROP_DETAIL_POLICY,
     PROP_FILE,
+    PROP_MOTION_EVENTS,
+    PROP_MOTION_UPDATES,
     PROP_TAB,
+    PROP_TEXT_CACHE,
 
     N_PROPERTIES
 };
@@ -137,6 +174,16 @@ struct _BbGedaEditor
 {
     BbDocumentWindow parent;
 
+    /**
+     * Thresholds for simplifying features too small to be legible at the current zoom
+     */
+    BbDetailPolicy *detail_policy;
+
+    /**
+     * A recording of the schematic, replayed for repaints covering most of the view
+     */
+    BbDisplayList *display_list;
+
     /**
      * Stores the current drawing tool for this window.
      */
@@ -176,26 +223,82 @@ struct _BbGedaEditor
      */
     double last_y;
 
+    /**
+     * The number of motion events received from the view
+     */
+    guint64 motion_events;
+
+    /**
+     * A tick callback delivering the latest motion to the drawing tool, or zero if no motion is pending
+     */
+    guint motion_tick;
+
+    /**
+     * The number of motion updates delivered to the drawing tool, at most one per frame
+     */
+    guint64 motion_updates;
+
     /**
      * The matrix for converting user (i.e. schematic) coordinates to widget coordinates.
      */
     cairo_matrix_t matrix;
 
+    /**
+     * A context with the identity transform, for measuring text independently of the zoom
+     */
+    cairo_t *metrics_cairo;
+
+    /**
+     * Text layouts for measuring text, separate from text_cache so rendering and measuring do not reshape each
+     * other's layouts
+     */
+    BbTextCache *metrics_cache;
+
+    /**
+     * Paths of items, retained across frames and keyed by the item geometry revision
+     */
+    BbPathCache *path_cache;
+
     /**
      * @brief
      */
     GSList *redo_stack;
 
+    /**
+     * An idle source continuing an incomplete frame, or zero if none is pending
+     */
+    guint refine_source;
+
     /**
      * Indicates that hidden objects on the schematic should be revealed.
      */
     gboolean reveal;
 
+    /**
+     * Rendered tiles of the schematic with hidden attributes revealed
+     *
+     * Each setting of reveal keeps its own layer of tiles, so toggling reveal only composites the other layer. Both
+     * layers are released when the view is unmapped, such as in a background tab.
+     */
+    BbTileCache *reveal_tiles;
+
+    /**
+     * Rendered tiles of the schematic with hidden attributes concealed
+     *
+     * The tiles are reused when panning and scaled in place after zooming.
+     */
+    BbTileCache *scene_tiles;
+
     /**
      * @brief
      */
     BbSchematic *schematic;
 
+    /**
+     * Records edits for crash recovery, or NULL if the document has not been saved
+     */
+    BbGedaJournal *journal;
+
     /**
      * @brief
      */
@@ -206,6 +309,11 @@ struct _BbGedaEditor
      */
     BbToolChanger *tool_changer;
 
+    /**
+     * Shaped text layouts, retained across frames
+     */
+    BbTextCache *text_cache;
+
     /**
      * @brief
      */
@@ -221,6 +329,30 @@ struct _BbGedaEditor
 };
 
 
+/**
+ * The state of a background save, or of a snapshot write
+ */
+typedef struct _BbSaveState BbSaveState;
+
+struct _BbSaveState
+{
+    /**
+     * The editor, with a reference held for the duration of the save
+     */
+    BbGedaEditor *editor;
+
+    /**
+     * The document, or the temporary file for a snapshot, being written
+     */
+    GFile *file;
+
+    /**
+     * The number of journaled edits when the save started
+     */
+    gulong edit_count;
+};
+
+
 // region Function Prototypes
 
 static void
@@ -265,6 +397,9 @@ bb_geda_editor_drawing_tool_support_init(BbDrawingToolSupportInterface *iface);
 static void
 bb_geda_editor_finalize(GObject *object);
 
+static void
+bb_geda_editor_flush_motion(BbGedaEditor *editor);
+
 static gboolean
 bb_geda_editor_get_can_scale_down(BbGridSubject *grid_subject);
 
@@ -289,12 +424,18 @@ bb_geda_editor_grid_subject_init(BbGridSubjectInterface *iface);
 static void
 bb_geda_editor_invalidate_all(BbToolSubject *tool_subject);
 
+static void
+bb_geda_editor_invalidate_bounds(BbGedaEditor *window, const BbBounds *bounds);
+
 static void
 bb_geda_editor_invalidate_item_cb(gpointer unused, BbGedaItem *item, BbGedaEditor *window);
 
 static void
 bb_geda_editor_invalidate_rect_dev(BbToolSubject *tool_subject, double x0, double y0, double x1, double y1);
 
+static void
+bb_geda_editor_items_changed_cb(BbSchematic *schematic, GPtrArray *items, BbBounds *damage, BbGedaEditor *window);
+
 static gboolean
 bb_geda_editor_key_pressed_cb(GtkWidget *widget, GdkEvent *event, gpointer user_data);
 
@@ -304,18 +445,45 @@ bb_geda_editor_key_released_cb(GtkWidget *widget, GdkEvent *event, gpointer user
 static gboolean
 bb_geda_editor_motion_notify_cb(GtkWidget *widget, GdkEvent  *event, gpointer user_data);
 
+static gboolean
+bb_geda_editor_motion_tick_cb(GtkWidget *widget, GdkFrameClock *clock, gpointer user_data);
+
+static void
+bb_geda_editor_notify_detail_policy_cb(BbDetailPolicy *policy, GParamSpec *pspec, BbGedaEditor *window);
+
 static void
 bb_geda_editor_notify_grid_control_cb(BbGrid *grid, GParamSpec *pspec, BbGedaEditor *window);
 
 static void
 bb_geda_editor_property_subject_init(BbPropertySubjectInterface *iface);
 
+static gboolean
+bb_geda_editor_refine_cb(BbGedaEditor *editor);
+
+static void
+bb_geda_editor_render_region(BbGedaEditor *editor, BbGraphics *graphics);
+
+static void
+bb_geda_editor_render_tile_cb(cairo_t *cairo, BbGedaEditor *editor);
+
 static void
 bb_geda_editor_reveal_receiver_init(BbRevealReceiverInterface *iface);
 
+static void
+bb_geda_editor_save_ready_cb(BbSchematic *schematic, GAsyncResult *result, BbSaveState *state);
+
+static void
+bb_geda_editor_save_state_free(BbSaveState *state);
+
+static void
+bb_geda_editor_schematic_changed_cb(BbSchematic *schematic, BbGedaItem *item, BbGedaEditor *window);
+
 static void
 bb_geda_editor_save_receiver_init(BbSaveReceiverInterface *iface);
 
+static void
+bb_geda_editor_write_ready_cb(BbSchematic *schematic, GAsyncResult *result, GTask *task);
+
 static void
 bb_geda_editor_redo_receiver_init(BbRedoReceiverInterface *iface);
 
@@ -349,6 +517,12 @@ bb_geda_editor_tool_changed_cb(BbToolChanger *changer, BbGedaEditor *window);
 static void
 bb_geda_editor_tool_subject_init(BbToolSubjectInterface *iface);
 
+static void
+bb_geda_editor_unmap_cb(BbGedaView *view, BbGedaEditor *editor);
+
+static void
+bb_geda_editor_update_motion(BbGedaEditor *editor);
+
 //static void
 //bb_geda_editor_undo(BbClipboardSubject *clipboard_subject);
 
@@ -638,18 +812,51 @@ bb_geda_editor_calculate_from_corners(BbBoundsCalculator *calculator, int x0, in
 {
     BbBounds *temp = bb_bounds_new_with_points(x0, y0, x1, y1);
 
-    // TODO expand with the width
+    int expand = (width + 1) / 2;
+
+    temp->min_x -= expand;
+    temp->min_y -= expand;
+    temp->max_x += expand;
+    temp->max_y += expand;
 
     return temp;
 }
 
 
+static BbBounds*
+bb_geda_editor_calculate_from_text(
+    BbBoundsCalculator *calculator,
+    int insert_x,
+    int insert_y,
+    BbTextAlignment alignment,
+    int angle,
+    int size,
+    const char *text
+    )
+{
+    BbGedaEditor *editor = BB_GEDA_EDITOR(calculator);
+    g_return_val_if_fail(editor != NULL, NULL);
+
+    return bb_graphics_measure_text(
+        editor->metrics_cache,
+        editor->metrics_cairo,
+        insert_x,
+        insert_y,
+        alignment,
+        bb_angle_to_radians(angle),
+        size,
+        text
+        );
+}
+
+
 static void
 bb_geda_editor_bounds_calculator_init(BbBoundsCalculatorInterface *iface)
 {
     g_return_if_fail(iface != NULL);
 
     iface->calculate_from_corners = bb_geda_editor_calculate_from_corners;
+    iface->calculate_from_text = bb_geda_editor_calculate_from_text;
 }
 
 // endregion
@@ -1082,16 +1289,68 @@ bb_geda_editor_reveal_receiver_init(BbRevealReceiverInterface *iface)
 
 // region From BbSaveReceiver interface
 
+/**
+ * Replace the document with a snapshot written by bb_geda_editor_write_async()
+ *
+ * After a successful commit, the journal restarts from the saved document.
+ *
+ * @param subject A BbGedaEditor
+ * @param temporary The temporary file from bb_geda_editor_write_finish()
+ * @param error An optional location to store an error
+ * @return TRUE on success, FALSE on failure
+ */
 static gboolean
-bb_geda_editor_get_can_save(BbSaveReceiver *subject)
+bb_geda_editor_commit(BbSaveReceiver *subject, GFile *temporary, GError **error)
 {
     BbGedaEditor *window = BB_GEDA_EDITOR(subject);
     g_return_val_if_fail(window != NULL, FALSE);
+    g_return_val_if_fail(window->file != NULL, FALSE);
+
+    GError *local_error = NULL;
+    gulong edit_count = GPOINTER_TO_SIZE(g_object_get_data(G_OBJECT(temporary), BB_SNAPSHOT_EDIT_COUNT_KEY));
+
+    gboolean success = bb_save_receiver_replace_file(temporary, window->file, &local_error);
+
+    if (!success)
+    {
+        g_file_delete(temporary, NULL, NULL);
+        g_propagate_error(error, local_error);
+        return FALSE;
+    }
+
+    if (window->journal != NULL)
+    {
+        bb_geda_journal_saved(window->journal, window->file, edit_count, &local_error);
+    }
+    else
+    {
+        /* The first save of a new document. Edits during the write are unknown, so start with a snapshot. */
+
+        window->journal = bb_geda_journal_new(window->schematic, window->file, TRUE, &local_error);
+    }
+
+    if (local_error != NULL)
+    {
+        /* The document is saved, so the failure only affects crash recovery */
+
+        g_warning("Unable to restart journal: %s", local_error->message);
+        g_clear_error(&local_error);
+    }
 
     return TRUE;
 }
 
 
+static gboolean
+bb_geda_editor_get_can_save(BbSaveReceiver *subject)
+{
+    BbGedaEditor *window = BB_GEDA_EDITOR(subject);
+    g_return_val_if_fail(window != NULL, FALSE);
+
+    return window->file != NULL;
+}
+
+
 static gboolean
 bb_geda_editor_get_can_save_as(BbSaveReceiver *subject)
 {
@@ -1102,6 +1361,15 @@ bb_geda_editor_get_can_save_as(BbSaveReceiver *subject)
 }
 
 
+/**
+ * Begin saving the schematic in the background
+ *
+ * The save completes in bb_geda_editor_save_ready_cb(), which reports failures to the user. This function never sets
+ * the error.
+ *
+ * @param subject A BbGedaEditor
+ * @param error Unused
+ */
 static void
 bb_geda_editor_save(BbSaveReceiver *subject, GError **error)
 {
@@ -1110,33 +1378,92 @@ bb_geda_editor_save(BbSaveReceiver *subject, GError **error)
     g_return_if_fail(window->file != NULL);
     g_return_if_fail(window->schematic != NULL);
 
-    GError *local_error = NULL;
+    BbSaveState *state = g_slice_new(BbSaveState);
 
-    GFileOutputStream *stream = g_file_replace(
+    state->editor = g_object_ref(window);
+    state->file = g_object_ref(window->file);
+    state->edit_count = (window->journal != NULL) ? bb_geda_journal_get_edit_count(window->journal) : 0;
+
+    bb_schematic_save_async(
+        window->schematic,
         window->file,
+        G_PRIORITY_DEFAULT,
         NULL,
-        TRUE,
-        G_FILE_CREATE_NONE,
-        NULL,
-        &local_error
+        (GAsyncReadyCallback) bb_geda_editor_save_ready_cb,
+        state
     );
+}
 
-    if (local_error == NULL)
+
+/**
+ * Completes a background save
+ *
+ * After a successful save, the journal restarts from the saved document. After a failed save, a dialog reports the
+ * error.
+ *
+ * @param schematic The schematic that was saved
+ * @param result The result of the save
+ * @param state The editor, file and edit count at the start of the save
+ */
+static void
+bb_geda_editor_save_ready_cb(BbSchematic *schematic, GAsyncResult *result, BbSaveState *state)
+{
+    BbGedaEditor *window = state->editor;
+    GError *local_error = NULL;
+
+    bb_schematic_save_finish(schematic, result, &local_error);
+
+    if (local_error != NULL)
     {
-        bb_schematic_write(
-            window->schematic,
-            G_OUTPUT_STREAM(stream),
-            NULL,
-            &local_error
-        );
+        GtkWidget *toplevel = gtk_widget_get_toplevel(GTK_WIDGET(window));
+
+        GtkWidget *dialog = gtk_message_dialog_new(
+            gtk_widget_is_toplevel(toplevel) ? GTK_WINDOW(toplevel) : NULL,
+            GTK_DIALOG_MODAL,
+            GTK_MESSAGE_ERROR,
+            GTK_BUTTONS_OK,
+            "%s",
+            local_error->message
+            );
+
+        gtk_dialog_run(GTK_DIALOG(dialog));
+
+        gtk_widget_destroy(dialog);
+
+        g_clear_error(&local_error);
+    }
+    else if (window->journal != NULL)
+    {
+        bb_geda_journal_saved(window->journal, state->file, state->edit_count, &local_error);
     }
+    else if (schematic == window->schematic)
+    {
+        /* The first save of a new document. Edits during the save are unknown, so start with a snapshot. */
 
-    g_clear_object(&stream);
+        window->journal = bb_geda_journal_new(schematic, state->file, TRUE, &local_error);
+    }
 
     if (local_error != NULL)
     {
-        g_propagate_error(error, local_error);
+        g_warning("Unable to restart journal: %s", local_error->message);
+        g_clear_error(&local_error);
     }
+
+    bb_geda_editor_save_state_free(state);
+}
+
+
+/**
+ * Release the state of a background save or write
+ *
+ * @param state The state to free
+ */
+static void
+bb_geda_editor_save_state_free(BbSaveState *state)
+{
+    g_object_unref(state->file);
+    g_object_unref(state->editor);
+    g_slice_free(BbSaveState, state);
 }
 
 
@@ -1181,7 +1508,9 @@ bb_geda_editor_save_as(BbSaveReceiver *subject, GError **error)
     {
         if (gtk_dialog_run(GTK_DIALOG(dialog)) == GTK_RESPONSE_ACCEPT)
         {
+            g_clear_object(&window->file);
             window->file = gtk_file_chooser_get_file(GTK_FILE_CHOOSER(dialog));
+            g_object_notify_by_pspec(G_OBJECT(window), properties[PROP_CAN_SAVE]);
 
             bb_geda_editor_save(subject, &local_error);
         }
@@ -1195,15 +1524,121 @@ bb_geda_editor_save_as(BbSaveReceiver *subject, GError **error)
     }
 }
 
+/**
+ * Write a snapshot of the schematic to a temporary file, on a worker thread
+ *
+ * @param subject A BbGedaEditor
+ * @param cancellable An optional cancellable object
+ * @param callback A callback function when the write completes
+ * @param user_data User data to pass to the callback function
+ */
+static void
+bb_geda_editor_write_async(
+    BbSaveReceiver *subject,
+    GCancellable *cancellable,
+    GAsyncReadyCallback callback,
+    gpointer user_data
+    )
+{
+    BbGedaEditor *window = BB_GEDA_EDITOR(subject);
+    g_return_if_fail(window != NULL);
+    g_return_if_fail(window->schematic != NULL);
+
+    GTask *task = g_task_new(window, cancellable, callback, user_data);
+
+    if (window->file == NULL)
+    {
+        g_task_return_new_error(
+            task,
+            BB_ERROR_DOMAIN,
+            ERROR_NOT_SUPPORTED,
+            "%s has not been saved",
+            bb_document_window_get_tab(BB_DOCUMENT_WINDOW(window))
+            );
+
+        g_object_unref(task);
+        return;
+    }
+
+    BbSaveState *state = g_slice_new(BbSaveState);
+
+    state->editor = g_object_ref(window);
+    state->file = bb_save_receiver_get_temporary_file(window->file);
+    state->edit_count = (window->journal != NULL) ? bb_geda_journal_get_edit_count(window->journal) : 0;
+
+    g_task_set_task_data(task, state, (GDestroyNotify) bb_geda_editor_save_state_free);
+
+    bb_schematic_save_async(
+        window->schematic,
+        state->file,
+        G_PRIORITY_DEFAULT,
+        cancellable,
+        (GAsyncReadyCallback) bb_geda_editor_write_ready_cb,
+        task
+        );
+}
+
+
+/**
+ * Complete writing a snapshot of the schematic
+ *
+ * @param subject A BbGedaEditor
+ * @param result The result passed to the callback
+ * @param error An optional location to store an error
+ * @return The temporary file containing the snapshot, carrying its edit count for commit, or NULL on failure
+ */
+static GFile*
+bb_geda_editor_write_finish(BbSaveReceiver *subject, GAsyncResult *result, GError **error)
+{
+    g_return_val_if_fail(g_task_is_valid(result, subject), NULL);
+
+    return g_task_propagate_pointer(G_TASK(result), error);
+}
+
+
+/**
+ * Completes writing a snapshot of the schematic
+ *
+ * On success, the edit count at the start of the write is attached to the temporary file, so each snapshot commits
+ * with its own count. On failure, the partially written temporary file is deleted.
+ *
+ * @param schematic The schematic that was written
+ * @param result The result of the write
+ * @param task The task for bb_geda_editor_write_async()
+ */
+static void
+bb_geda_editor_write_ready_cb(BbSchematic *schematic, GAsyncResult *result, GTask *task)
+{
+    BbSaveState *state = g_task_get_task_data(task);
+    GError *local_error = NULL;
+
+    if (bb_schematic_save_finish(schematic, result, &local_error))
+    {
+        g_object_set_data(G_OBJECT(state->file), BB_SNAPSHOT_EDIT_COUNT_KEY, GSIZE_TO_POINTER(state->edit_count));
+        g_task_return_pointer(task, g_object_ref(state->file), g_object_unref);
+    }
+    else
+    {
+        g_file_delete(state->file, NULL, NULL);
+        g_task_return_error(task, local_error);
+    }
+
+    g_object_unref(task);
+}
+
+
 static void
 bb_geda_editor_save_receiver_init(BbSaveReceiverInterface *iface)
 {
     g_return_if_fail(iface != NULL);
 
+    iface->commit = bb_geda_editor_commit;
     iface->get_can_save = bb_geda_editor_get_can_save;
     iface->get_can_save_as = bb_geda_editor_get_can_save_as;
     iface->save = bb_geda_editor_save;
     iface->save_as = bb_geda_editor_save_as;
+    iface->write_async = bb_geda_editor_write_async;
+    iface->write_finish = bb_geda_editor_write_finish;
 }
 
 // endregion
@@ -1471,9 +1906,7 @@ bb_geda_editor_add_item(BbToolSubject *subject, BbGedaItem *item)
     g_return_if_fail(window != NULL);
     g_return_if_fail(window->schematic != NULL);
 
-    GSList *items = g_slist_append(NULL, item);
-
-    bb_schematic_add_items(window->schematic, items);
+    bb_schematic_add_item(window->schematic, item);
 }
 
 
@@ -1483,6 +1916,8 @@ bb_geda_editor_button_pressed_cb(GtkWidget *widget, GdkEvent *event, gpointer us
     BbGedaEditor *window = BB_GEDA_EDITOR(user_data);
     g_return_val_if_fail(window != NULL, FALSE);
 
+    bb_geda_editor_flush_motion(window);
+
     window->last_x = event->button.x;
     window->last_y = event->button.y;
 
@@ -1501,6 +1936,8 @@ bb_geda_editor_button_released_cb(GtkWidget *widget, GdkEvent *event, gpointer u
     BbGedaEditor *window = BB_GEDA_EDITOR(user_data);
     g_return_val_if_fail(window != NULL, FALSE);
 
+    bb_geda_editor_flush_motion(window);
+
     window->last_x = event->button.x;
     window->last_y = event->button.y;
 
@@ -1715,13 +2152,65 @@ bb_geda_editor_class_init(BbGedaEditorClass *klasse)
             )
         );
 
-    /* From BbDocumentWindow */
-
-    properties[PROP_TAB] = g_object_class_find_property(
+    properties[PROP_DETAIL_POLICY] = bb_object_class_install_property(
         object_class,
-        "tab"
+        PROP_DETAIL_POLICY,
+        g_param_spec_object(
+            "detail-policy",
+            "",
+            "",
+            BB_TYPE_DETAIL_POLICY,
+            G_PARAM_READABLE | G_PARAM_STATIC_STRINGS
+            )
         );
-}
+
+    properties[PROP_MOTION_EVENTS] = bb_object_class_install_property(
+        object_class,
+        PROP_MOTION_EVENTS,
+        g_param_spec_uint64(
+            "motion-events",
+            "",
+            "",
+            0,
+            G_MAXUINT64,
+            0,
+            G_PARAM_READABLE | G_PARAM_STATIC_STRINGS
+            )
+        );
+
+    properties[PROP_MOTION_UPDATES] = bb_object_class_install_property(
+        object_class,
+        PROP_MOTION_UPDATES,
+        g_param_spec_uint64(
+            "motion-updates",
+            "",
+            "",
+            0,
+            G_MAXUINT64,
+            0,
+            G_PARAM_READABLE | G_PARAM_STATIC_STRINGS
+            )
+        );
+
+    properties[PROP_TEXT_CACHE] = bb_object_class_install_property(
+        object_class,
+        PROP_TEXT_CACHE,
+        g_param_spec_object(
+            "text-cache",
+            "",
+            "",
+            BB_TYPE_TEXT_CACHE,
+            G_PARAM_READABLE | G_PARAM_STATIC_STRINGS
+            )
+        );
+
+    /* From BbDocumentWindow */
+
+    properties[PROP_TAB] = g_object_class_find_property(
+        object_class,
+        "tab"
+        );
+}
 
 
 static void
@@ -1733,6 +2222,31 @@ bb_geda_editor_class_finalize(BbGedaEditorClass *klasse)
 static void
 bb_geda_editor_dispose(GObject *object)
 {
+    BbGedaEditor *editor = BB_GEDA_EDITOR(object);
+    g_return_if_fail(editor != NULL);
+
+    if (editor->motion_tick != 0 && editor->view != NULL)
+    {
+        gtk_widget_remove_tick_callback(GTK_WIDGET(editor->view), editor->motion_tick);
+    }
+
+    editor->motion_tick = 0;
+
+    if (editor->refine_source != 0)
+    {
+        g_source_remove(editor->refine_source);
+        editor->refine_source = 0;
+    }
+
+    g_clear_object(&editor->detail_policy);
+    g_clear_object(&editor->display_list);
+    g_clear_pointer(&editor->metrics_cairo, cairo_destroy);
+    g_clear_object(&editor->metrics_cache);
+    g_clear_object(&editor->path_cache);
+    g_clear_object(&editor->text_cache);
+    g_clear_object(&editor->reveal_tiles);
+    g_clear_object(&editor->scene_tiles);
+    g_clear_pointer(&editor->journal, bb_geda_journal_free);
 }
 
 
@@ -1752,8 +2266,39 @@ bb_geda_editor_draw_cb(BbGedaView *view, cairo_t *cairo, BbGedaEditor *editor)
     cairo_matrix_t widget_matrix;
     cairo_get_matrix(cairo, &widget_matrix);
 
+    /* Before the transform, the clip extents are the damaged area in widget coordinates */
+
+    double clip_x0;
+    double clip_y0;
+    double clip_x1;
+    double clip_y1;
+
+    cairo_clip_extents(cairo, &clip_x0, &clip_y0, &clip_x1, &clip_y1);
+
+    double view_area = (double) gtk_widget_get_allocated_width(GTK_WIDGET(view))
+        * (double) gtk_widget_get_allocated_height(GTK_WIDGET(view));
+
+    gboolean full = (clip_x1 - clip_x0) * (clip_y1 - clip_y0) >= BB_DISPLAY_LIST_COVERAGE * view_area;
+
+    bb_text_cache_set_font_options(
+        editor->text_cache,
+        gdk_screen_get_font_options(gtk_widget_get_screen(GTK_WIDGET(view)))
+        );
+
+    guint64 collapsed = bb_detail_policy_get_collapsed(editor->detail_policy);
+    guint64 greeked = bb_detail_policy_get_greeked(editor->detail_policy);
+    guint64 skipped = bb_detail_policy_get_skipped(editor->detail_policy);
+
     GtkStyleContext *style = gtk_widget_get_style_context(GTK_WIDGET(editor));
-    BbGraphics *graphics = bb_graphics_new(cairo, &widget_matrix, editor->reveal, style);
+    BbGraphics *graphics = bb_graphics_new(
+        cairo,
+        &widget_matrix,
+        editor->reveal,
+        style,
+        editor->text_cache,
+        editor->path_cache,
+        editor->detail_policy
+        );
 
     cairo_save(cairo);
     cairo_transform(cairo, &editor->matrix);
@@ -1763,9 +2308,38 @@ bb_geda_editor_draw_cb(BbGedaView *view, cairo_t *cairo, BbGedaEditor *editor)
         bb_grid_draw(editor->grid, graphics);
     }
 
-    if (editor->schematic != NULL)
+    BbTileCache *tiles = editor->reveal ? editor->reveal_tiles : editor->scene_tiles;
+
+    if (editor->schematic != NULL && bb_tile_cache_get_fits(tiles, (int) (clip_x1 - clip_x0), (int) (clip_y1 - clip_y0)))
+    {
+        cairo_save(cairo);
+        cairo_set_matrix(cairo, &widget_matrix);
+
+        gboolean complete = bb_tile_cache_draw(
+            tiles,
+            cairo,
+            &editor->matrix,
+            (BbTileRenderFunc) bb_geda_editor_render_tile_cb,
+            editor
+            );
+
+        cairo_restore(cairo);
+
+        /* Stale tiles filled in part of the frame, so continue rendering once pending events are handled */
+
+        if (!complete && editor->refine_source == 0)
+        {
+            editor->refine_source = g_idle_add((GSourceFunc) bb_geda_editor_refine_cb, editor);
+        }
+    }
+    else if (editor->schematic != NULL && full)
+    {
+        bb_display_list_update(editor->display_list, editor->schematic, editor->reveal);
+        bb_display_list_replay(editor->display_list, graphics);
+    }
+    else if (editor->schematic != NULL)
     {
-        bb_schematic_render(editor->schematic, BB_ITEM_RENDERER(graphics));
+        bb_geda_editor_render_region(editor, graphics);
     }
 
     // TODO remove
@@ -1780,6 +2354,17 @@ bb_geda_editor_draw_cb(BbGedaView *view, cairo_t *cairo, BbGedaEditor *editor)
     cairo_stroke(cairo);
 
     cairo_restore(cairo);
+
+    g_object_unref(graphics);
+
+    g_debug(
+        "Level of detail at %.3g pixels per unit: %" G_GUINT64_FORMAT " texts greeked, %" G_GUINT64_FORMAT
+            " details skipped, %" G_GUINT64_FORMAT " items collapsed",
+        hypot(editor->matrix.xx, editor->matrix.yx),
+        bb_detail_policy_get_greeked(editor->detail_policy) - greeked,
+        bb_detail_policy_get_skipped(editor->detail_policy) - skipped,
+        bb_detail_policy_get_collapsed(editor->detail_policy) - collapsed
+        );
 }
 
 
@@ -1789,6 +2374,26 @@ bb_geda_editor_finalize(GObject *object)
 }
 
 
+/**
+ * Deliver any pending motion to the drawing tool immediately
+ *
+ * Called before other input, so the drawing tool sees the pointer where the user last moved it.
+ *
+ * @param editor This editor
+ */
+static void
+bb_geda_editor_flush_motion(BbGedaEditor *editor)
+{
+    if (editor->motion_tick != 0)
+    {
+        gtk_widget_remove_tick_callback(GTK_WIDGET(editor->view), editor->motion_tick);
+        editor->motion_tick = 0;
+
+        bb_geda_editor_update_motion(editor);
+    }
+}
+
+
 gboolean
 bb_geda_editor_get_can_reload(BbGedaEditor *window)
 {
@@ -1816,6 +2421,33 @@ bb_geda_editor_get_grid_control(BbGedaEditor *window)
 }
 
 
+BbDetailPolicy*
+bb_geda_editor_get_detail_policy(BbGedaEditor *editor)
+{
+    g_return_val_if_fail(BB_IS_GEDA_EDITOR(editor), NULL);
+
+    return editor->detail_policy;
+}
+
+
+guint64
+bb_geda_editor_get_motion_events(BbGedaEditor *editor)
+{
+    g_return_val_if_fail(BB_IS_GEDA_EDITOR(editor), 0);
+
+    return editor->motion_events;
+}
+
+
+guint64
+bb_geda_editor_get_motion_updates(BbGedaEditor *editor)
+{
+    g_return_val_if_fail(BB_IS_GEDA_EDITOR(editor), 0);
+
+    return editor->motion_updates;
+}
+
+
 static void
 bb_geda_editor_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec)
 {
@@ -1898,12 +2530,37 @@ bb_geda_editor_get_property(GObject *object, guint property_id, GValue *value, G
             g_value_set_object(value, bb_geda_editor_get_drawing_tool(window));
             break;
 
+        case PROP_DETAIL_POLICY:
+            g_value_set_object(value, bb_geda_editor_get_detail_policy(window));
+            break;
+
+        case PROP_MOTION_EVENTS:
+            g_value_set_uint64(value, bb_geda_editor_get_motion_events(window));
+            break;
+
+        case PROP_MOTION_UPDATES:
+            g_value_set_uint64(value, bb_geda_editor_get_motion_updates(window));
+            break;
+
+        case PROP_TEXT_CACHE:
+            g_value_set_object(value, bb_geda_editor_get_text_cache(window));
+            break;
+
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
     }
 }
 
 
+BbTextCache*
+bb_geda_editor_get_text_cache(BbGedaEditor *editor)
+{
+    g_return_val_if_fail(BB_IS_GEDA_EDITOR(editor), NULL);
+
+    return editor->text_cache;
+}
+
+
 static void
 bb_geda_editor_init(BbGedaEditor *window)
 {
@@ -1911,12 +2568,33 @@ bb_geda_editor_init(BbGedaEditor *window)
 
     window->schematic = bb_schematic_new();
     bb_geda_editor_set_grid(window, bb_grid_new(BB_TOOL_SUBJECT(window)));
+    window->detail_policy = bb_detail_policy_new();
+    window->display_list = bb_display_list_new();
+    window->metrics_cache = bb_text_cache_new(BB_METRICS_CACHE_CAPACITY);
+    window->path_cache = bb_path_cache_new(BB_PATH_CACHE_DEFAULT_CAPACITY);
     window->redo_stack = NULL;
+    window->reveal_tiles = bb_tile_cache_new(BB_TILE_CACHE_DEFAULT_CAPACITY);
+    window->scene_tiles = bb_tile_cache_new(BB_TILE_CACHE_DEFAULT_CAPACITY);
     window->selection = g_hash_table_new(g_direct_hash, g_direct_equal);
+    window->text_cache = bb_text_cache_new(BB_TEXT_CACHE_DEFAULT_CAPACITY);
     window->undo_stack = NULL;
 
     cairo_matrix_init_identity(&window->matrix);
 
+    /* Unhinted metrics scale linearly, so measurements hold at every zoom */
+
+    cairo_surface_t *metrics_surface = cairo_image_surface_create(CAIRO_FORMAT_A8, 1, 1);
+    cairo_font_options_t *metrics_options = cairo_font_options_create();
+
+    cairo_font_options_set_hint_metrics(metrics_options, CAIRO_HINT_METRICS_OFF);
+    cairo_font_options_set_hint_style(metrics_options, CAIRO_HINT_STYLE_NONE);
+    bb_text_cache_set_font_options(window->metrics_cache, metrics_options);
+
+    window->metrics_cairo = cairo_create(metrics_surface);
+
+    cairo_font_options_destroy(metrics_options);
+    cairo_surface_destroy(metrics_surface);
+
     gtk_widget_add_events(
         GTK_WIDGET(window->view),
         GDK_BUTTON_PRESS_MASK |
@@ -1967,6 +2645,20 @@ bb_geda_editor_init(BbGedaEditor *window)
         G_CALLBACK(bb_geda_editor_draw_cb),
         window
         );
+
+    g_signal_connect(
+        window->view,
+        "unmap",
+        G_CALLBACK(bb_geda_editor_unmap_cb),
+        window
+        );
+
+    g_signal_connect(
+        window->detail_policy,
+        "notify",
+        G_CALLBACK(bb_geda_editor_notify_detail_policy_cb),
+        window
+        );
 }
 
 
@@ -1982,9 +2674,65 @@ bb_geda_editor_invalidate_all(BbToolSubject *tool_subject)
 }
 
 
+/**
+ * Repaint the portion of the view covering a region of the schematic
+ *
+ * @param window This schematic window
+ * @param bounds The region in schematic coordinates, or NULL to repaint everything
+ */
+static void
+bb_geda_editor_invalidate_bounds(BbGedaEditor *window, const BbBounds *bounds)
+{
+    g_return_if_fail(window != NULL);
+    g_return_if_fail(window->view != NULL);
+
+    /* Bounds without area, such as text, cannot be trusted to cover the rendered item */
+
+    if (bb_bounds_is_empty(bounds) || bounds->min_x == bounds->max_x || bounds->min_y == bounds->max_y)
+    {
+        bb_geda_editor_invalidate_all(BB_TOOL_SUBJECT(window));
+    }
+    else
+    {
+        double x[4] = { bounds->min_x, bounds->max_x, bounds->min_x, bounds->max_x };
+        double y[4] = { bounds->min_y, bounds->min_y, bounds->max_y, bounds->max_y };
+
+        for (int corner = 0; corner < 4; corner++)
+        {
+            cairo_matrix_transform_point(&window->matrix, &x[corner], &y[corner]);
+        }
+
+        double min_x = MIN(MIN(x[0], x[1]), MIN(x[2], x[3])) - BB_INVALIDATE_MARGIN;
+        double min_y = MIN(MIN(y[0], y[1]), MIN(y[2], y[3])) - BB_INVALIDATE_MARGIN;
+        double max_x = MAX(MAX(x[0], x[1]), MAX(x[2], x[3])) + BB_INVALIDATE_MARGIN;
+        double max_y = MAX(MAX(y[0], y[1]), MAX(y[2], y[3])) + BB_INVALIDATE_MARGIN;
+
+        GtkAllocation allocation;
+
+        gtk_widget_get_allocation(GTK_WIDGET(window->view), &allocation);
+
+        /* Skip items entirely outside the view, and keep the remainder within integer range */
+
+        if (max_x >= 0.0 && max_y >= 0.0 && min_x <= allocation.width && min_y <= allocation.height)
+        {
+            bb_geda_editor_invalidate_rect_dev(
+                BB_TOOL_SUBJECT(window),
+                MAX(min_x, 0.0),
+                MAX(min_y, 0.0),
+                MIN(max_x, allocation.width),
+                MIN(max_y, allocation.height)
+                );
+        }
+    }
+}
+
+
 /**
  * Invalidate a single item
  *
+ * Items emit the signal both before and after a change, so invalidating the current bounds on each emission
+ * covers the union of the old and new locations.
+ *
  * @param unused Represents the source, which could be emitted from unrelated classes
  * @param item The item that changed and needs to be invalidated
  * @param window This schematic window
@@ -1993,10 +2741,20 @@ static void
 bb_geda_editor_invalidate_item_cb(gpointer unused, BbGedaItem *item, BbGedaEditor *window)
 {
     g_return_if_fail(window != NULL);
-    g_return_if_fail(window->view != NULL);
 
-    // TODO Just invalidate everything until the bounds calculations are working
-    gtk_widget_queue_draw(GTK_WIDGET(window->view));
+    BbBounds *bounds = NULL;
+
+    if (item != NULL)
+    {
+        bounds = bb_geda_item_calculate_bounds(item, BB_BOUNDS_CALCULATOR(window));
+    }
+
+    bb_geda_editor_invalidate_bounds(window, bounds);
+
+    if (bounds != NULL)
+    {
+        bb_bounds_free(bounds);
+    }
 }
 
 
@@ -2018,12 +2776,70 @@ bb_geda_editor_invalidate_rect_dev(BbToolSubject *tool_subject, double x0, doubl
 }
 
 
+/**
+ * Discard the tiles covering a batch of changed items, then repaint them with a single invalidation
+ *
+ * @param schematic The schematic containing the items
+ * @param items The items changed by the batch
+ * @param damage The bounds the items occupied before the batch
+ * @param window This schematic window
+ */
+static void
+bb_geda_editor_items_changed_cb(BbSchematic *schematic, GPtrArray *items, BbBounds *damage, BbGedaEditor *window)
+{
+    g_return_if_fail(BB_IS_GEDA_EDITOR(window));
+    g_return_if_fail(items != NULL);
+    g_return_if_fail(damage != NULL);
+
+    BbBounds *bounds = bb_bounds_copy(damage);
+    gboolean trusted = TRUE;
+
+    for (guint index = 0; trusted && index < items->len; index++)
+    {
+        BbBounds *temp = bb_geda_item_calculate_bounds(g_ptr_array_index(items, index), BB_BOUNDS_CALCULATOR(window));
+
+        /* As with single items, bounds without area cannot be trusted to cover the rendered item */
+
+        if (bb_bounds_is_empty(temp) || temp->min_x == temp->max_x || temp->min_y == temp->max_y)
+        {
+            trusted = FALSE;
+        }
+        else
+        {
+            bb_bounds_union(bounds, bounds, temp);
+        }
+
+        if (temp != NULL)
+        {
+            bb_bounds_free(temp);
+        }
+    }
+
+    if (trusted)
+    {
+        bb_tile_cache_invalidate_bounds(window->reveal_tiles, bounds, BB_INVALIDATE_MARGIN);
+        bb_tile_cache_invalidate_bounds(window->scene_tiles, bounds, BB_INVALIDATE_MARGIN);
+        bb_geda_editor_invalidate_bounds(window, bounds);
+    }
+    else
+    {
+        bb_tile_cache_invalidate(window->reveal_tiles);
+        bb_tile_cache_invalidate(window->scene_tiles);
+        bb_geda_editor_invalidate_all(BB_TOOL_SUBJECT(window));
+    }
+
+    bb_bounds_free(bounds);
+}
+
+
 static gboolean
 bb_geda_editor_key_pressed_cb(GtkWidget *widget, GdkEvent *event, gpointer user_data)
 {
     BbGedaEditor *window = BB_GEDA_EDITOR(user_data);
     g_return_val_if_fail(window != NULL, FALSE);
 
+    bb_geda_editor_flush_motion(window);
+
     if (window->drawing_tool != NULL)
     {
         bb_drawing_tool_key_pressed(window->drawing_tool);
@@ -2039,6 +2855,8 @@ bb_geda_editor_key_released_cb(GtkWidget *widget, GdkEvent *event, gpointer user
     BbGedaEditor *window = BB_GEDA_EDITOR(user_data);
     g_return_val_if_fail(window != NULL, FALSE);
 
+    bb_geda_editor_flush_motion(window);
+
     if (window->drawing_tool != NULL)
     {
         bb_drawing_tool_key_released(window->drawing_tool);
@@ -2048,6 +2866,12 @@ bb_geda_editor_key_released_cb(GtkWidget *widget, GdkEvent *event, gpointer user
 }
 
 
+/**
+ * Record the pointer position, and schedule an update of the drawing tool for the next frame
+ *
+ * Pointers can report motion many times per frame. Only the latest position reaches the drawing tool, so the tool
+ * snaps the coordinates and invalidates its preview at most once per frame.
+ */
 static gboolean
 bb_geda_editor_motion_notify_cb(GtkWidget *widget, GdkEvent *event, gpointer user_data)
 {
@@ -2056,13 +2880,38 @@ bb_geda_editor_motion_notify_cb(GtkWidget *widget, GdkEvent *event, gpointer use
 
     window->last_x = event->motion.x;
     window->last_y = event->motion.y;
+    window->motion_events++;
 
-    if (window->drawing_tool != NULL)
+    if (window->drawing_tool == NULL)
     {
-        return bb_drawing_tool_motion_notify(window->drawing_tool, event->motion.x, event->motion.y);
+        return FALSE;
     }
 
-    return FALSE;
+    if (window->motion_tick == 0)
+    {
+        window->motion_tick = gtk_widget_add_tick_callback(
+            GTK_WIDGET(window->view),
+            bb_geda_editor_motion_tick_cb,
+            window,
+            NULL
+            );
+    }
+
+    return TRUE;
+}
+
+
+static gboolean
+bb_geda_editor_motion_tick_cb(GtkWidget *widget, GdkFrameClock *clock, gpointer user_data)
+{
+    BbGedaEditor *window = BB_GEDA_EDITOR(user_data);
+    g_return_val_if_fail(window != NULL, G_SOURCE_REMOVE);
+
+    window->motion_tick = 0;
+
+    bb_geda_editor_update_motion(window);
+
+    return G_SOURCE_REMOVE;
 }
 
 
@@ -2079,6 +2928,20 @@ bb_geda_editor_new(GFile *file, BbSchematic *schematic, BbToolChanger *tool_chan
 }
 
 
+static void
+bb_geda_editor_notify_detail_policy_cb(BbDetailPolicy *policy, GParamSpec *pspec, BbGedaEditor *window)
+{
+    g_return_if_fail(BB_IS_GEDA_EDITOR(window));
+
+    /* Tiles were rendered using the previous thresholds */
+
+    bb_tile_cache_invalidate(window->reveal_tiles);
+    bb_tile_cache_invalidate(window->scene_tiles);
+
+    gtk_widget_queue_draw(GTK_WIDGET(window->view));
+}
+
+
 static void
 bb_geda_editor_notify_grid_cb(BbGrid *grid, GParamSpec *pspec, BbGedaEditor *window)
 {
@@ -2093,6 +2956,25 @@ bb_geda_editor_notify_grid_control_cb(BbGrid *grid, GParamSpec *pspec, BbGedaEdi
 }
 
 
+/**
+ * Continue an incomplete frame, replacing stale tiles with newly rendered tiles
+ *
+ * @param editor This editor
+ * @return G_SOURCE_REMOVE, since the next incomplete frame schedules another call
+ */
+static gboolean
+bb_geda_editor_refine_cb(BbGedaEditor *editor)
+{
+    g_return_val_if_fail(BB_IS_GEDA_EDITOR(editor), G_SOURCE_REMOVE);
+
+    editor->refine_source = 0;
+
+    gtk_widget_queue_draw(GTK_WIDGET(editor->view));
+
+    return G_SOURCE_REMOVE;
+}
+
+
 void
 bb_geda_editor_reload(BbGedaEditor *window, GError **error)
 {
@@ -2102,6 +2984,113 @@ bb_geda_editor_reload(BbGedaEditor *window, GError **error)
 }
 
 
+/**
+ * Render the items within the clip region of the graphics
+ *
+ * @param editor This editor
+ * @param graphics The graphics, with the transform in schematic coordinates
+ */
+static void
+bb_geda_editor_render_region(BbGedaEditor *editor, BbGraphics *graphics)
+{
+    double x0;
+    double y0;
+    double x1;
+    double y1;
+    BbBounds region;
+
+    /* The clip extents, after the transform, are the damaged area in schematic coordinates */
+
+    cairo_clip_extents(bb_graphics_get_cairo(graphics), &x0, &y0, &x1, &y1);
+
+    region.min_x = (int) CLAMP(floor(x0), G_MININT, G_MAXINT);
+    region.min_y = (int) CLAMP(floor(y0), G_MININT, G_MAXINT);
+    region.max_x = (int) CLAMP(ceil(x1), G_MININT, G_MAXINT);
+    region.max_y = (int) CLAMP(ceil(y1), G_MININT, G_MAXINT);
+
+    bb_schematic_render_region(
+        editor->schematic,
+        BB_ITEM_RENDERER(graphics),
+        BB_BOUNDS_CALCULATOR(editor),
+        &region
+        );
+}
+
+
+/**
+ * Render the items within a tile
+ *
+ * @param cairo The cairo context for the tile, with the transform in schematic coordinates
+ * @param editor This editor
+ */
+static void
+bb_geda_editor_render_tile_cb(cairo_t *cairo, BbGedaEditor *editor)
+{
+    g_return_if_fail(cairo != NULL);
+    g_return_if_fail(BB_IS_GEDA_EDITOR(editor));
+
+    /* The tile surface takes the place of the widget, so widget coordinates are pixels in the tile */
+
+    cairo_matrix_t tile_matrix;
+    cairo_matrix_init_identity(&tile_matrix);
+
+    BbGraphics *graphics = bb_graphics_new(
+        cairo,
+        &tile_matrix,
+        editor->reveal,
+        gtk_widget_get_style_context(GTK_WIDGET(editor)),
+        editor->text_cache,
+        editor->path_cache,
+        editor->detail_policy
+        );
+
+    bb_geda_editor_render_region(editor, graphics);
+
+    g_object_unref(graphics);
+}
+
+
+/**
+ * Discard the tiles covering an item in the schematic, then repaint the item
+ *
+ * @param schematic The schematic containing the item
+ * @param item The item added to, changed in, or removed from the schematic
+ * @param window This schematic window
+ */
+static void
+bb_geda_editor_schematic_changed_cb(BbSchematic *schematic, BbGedaItem *item, BbGedaEditor *window)
+{
+    g_return_if_fail(BB_IS_GEDA_EDITOR(window));
+
+    BbBounds *bounds = NULL;
+
+    if (item != NULL)
+    {
+        bounds = bb_geda_item_calculate_bounds(item, BB_BOUNDS_CALCULATOR(window));
+    }
+
+    /* As with repainting, bounds without area cannot be trusted to cover the rendered item */
+
+    if (bb_bounds_is_empty(bounds) || bounds->min_x == bounds->max_x || bounds->min_y == bounds->max_y)
+    {
+        bb_tile_cache_invalidate(window->reveal_tiles);
+        bb_tile_cache_invalidate(window->scene_tiles);
+    }
+    else
+    {
+        bb_tile_cache_invalidate_bounds(window->reveal_tiles, bounds, BB_INVALIDATE_MARGIN);
+        bb_tile_cache_invalidate_bounds(window->scene_tiles, bounds, BB_INVALIDATE_MARGIN);
+    }
+
+    if (bounds != NULL)
+    {
+        bb_bounds_free(bounds);
+    }
+
+    bb_geda_editor_invalidate_item_cb(schematic, item, window);
+}
+
+
 //void
 //bb_geda_editor_register(GTypeModule *module)
 //{
@@ -2268,7 +3257,13 @@ bb_geda_editor_set_schematic(BbGedaEditor *window, BbSchematic *schematic)
         {
             g_signal_handlers_disconnect_by_func(
                 window->schematic,
-                bb_geda_editor_invalidate_item_cb,
+                bb_geda_editor_schematic_changed_cb,
+                window
+                );
+
+            g_signal_handlers_disconnect_by_func(
+                window->schematic,
+                bb_geda_editor_items_changed_cb,
                 window
                 );
 
@@ -2277,6 +3272,21 @@ bb_geda_editor_set_schematic(BbGedaEditor *window, BbSchematic *schematic)
 
         window->schematic = schematic;
 
+        if (window->display_list != NULL)
+        {
+            bb_display_list_invalidate(window->display_list);
+        }
+
+        if (window->reveal_tiles != NULL)
+        {
+            bb_tile_cache_invalidate(window->reveal_tiles);
+        }
+
+        if (window->scene_tiles != NULL)
+        {
+            bb_tile_cache_invalidate(window->scene_tiles);
+        }
+
         if (window->schematic != NULL)
         {
             g_object_ref(window->schematic);
@@ -2284,7 +3294,21 @@ bb_geda_editor_set_schematic(BbGedaEditor *window, BbSchematic *schematic)
             g_signal_connect(
                 window->schematic,
                 "invalidate-item",
-                G_CALLBACK(bb_geda_editor_invalidate_item_cb),
+                G_CALLBACK(bb_geda_editor_schematic_changed_cb),
+                window
+                );
+
+            g_signal_connect(
+                window->schematic,
+                "item-added",
+                G_CALLBACK(bb_geda_editor_schematic_changed_cb),
+                window
+                );
+
+            g_signal_connect(
+                window->schematic,
+                "items-changed",
+                G_CALLBACK(bb_geda_editor_items_changed_cb),
                 window
                 );
         }
@@ -2294,6 +3318,20 @@ bb_geda_editor_set_schematic(BbGedaEditor *window, BbSchematic *schematic)
 }
 
 
+void
+bb_geda_editor_set_journal(BbGedaEditor *editor, BbGedaJournal *journal)
+{
+    g_return_if_fail(BB_IS_GEDA_EDITOR(editor));
+
+    if (editor->journal != journal)
+    {
+        bb_geda_journal_free(editor->journal);
+
+        editor->journal = journal;
+    }
+}
+
+
 void
 bb_geda_editor_set_tool_changer(BbGedaEditor *window, BbToolChanger *tool_changer)
 {
@@ -2400,6 +3438,51 @@ bb_geda_editor_tool_subject_init(BbToolSubjectInterface *iface)
 }
 
 
+/**
+ * Release the rendered tiles while the view is not shown
+ *
+ * Documents in background tabs are unmapped, so only the visible documents hold tiles. The tiles are rendered again
+ * when the view is next drawn.
+ *
+ * @param view The view of this editor
+ * @param editor This editor
+ */
+static void
+bb_geda_editor_unmap_cb(BbGedaView *view, BbGedaEditor *editor)
+{
+    g_return_if_fail(BB_IS_GEDA_EDITOR(editor));
+
+    /* The view can be unmapped while the editor is disposed */
+
+    if (editor->reveal_tiles != NULL)
+    {
+        bb_tile_cache_invalidate(editor->reveal_tiles);
+    }
+
+    if (editor->scene_tiles != NULL)
+    {
+        bb_tile_cache_invalidate(editor->scene_tiles);
+    }
+}
+
+
+/**
+ * Deliver the latest pointer position to the drawing tool
+ *
+ * @param editor This editor
+ */
+static void
+bb_geda_editor_update_motion(BbGedaEditor *editor)
+{
+    if (editor->drawing_tool != NULL)
+    {
+        editor->motion_updates++;
+
+        bb_drawing_tool_motion_notify(editor->drawing_tool, editor->last_x, editor->last_y);
+    }
+}
+
+
 static void
 bb_geda_editor_user_to_widget_distance(BbToolSubject *subject, double ux, double uy, double *wx, double *wy)
 {
@@ -21,10 +21,13 @@
 #include <gtk/gtk.h>
 #include <bbapplyfunc.h>
 #include <bbqueryfunc.h>
+#include "bbdetailpolicy.h"
 #include "bbdocumentwindow.h"
 #include "bbdrawingtool.h"
 #include "bbtoolchanger.h"
 #include "bbschematic.h"
+#include "bbtextcache.h"
+#include "bbgedajournal.h"
 
 
 #define BB_TYPE_GEDA_EDITOR bb_geda_editor_get_type()
@@ -41,6 +44,51 @@ gboolean
 bb_geda_editor_get_can_reload(BbGedaEditor *editor);
 
 
+/**
+ * Get the policy deciding the level of detail when rendering this editor
+ *
+ * The thresholds can be adjusted through the policy properties, and the policy counts the items it
+ * collapsed, greeked, or skipped.
+ *
+ * @param editor This editor
+ * @return The detail policy, owned by this editor
+ */
+BbDetailPolicy*
+bb_geda_editor_get_detail_policy(BbGedaEditor *editor);
+
+
+/**
+ * Get the number of pointer motion events received, for profiling
+ *
+ * @param editor This editor
+ * @return The number of motion events since creation
+ */
+guint64
+bb_geda_editor_get_motion_events(BbGedaEditor *editor);
+
+
+/**
+ * Get the number of motion updates delivered to the drawing tools, for profiling
+ *
+ * Motion events are coalesced, so the drawing tool sees at most one update per frame.
+ *
+ * @param editor This editor
+ * @return The number of motion updates since creation
+ */
+guint64
+bb_geda_editor_get_motion_updates(BbGedaEditor *editor);
+
+
+/**
+ * Get the cache of shaped text layouts used when rendering this editor, for profiling
+ *
+ * @param editor This editor
+ * @return The text cache, owned by this editor
+ */
+BbTextCache*
+bb_geda_editor_get_text_cache(BbGedaEditor *editor);
+
+
 BbGedaEditor*
 bb_geda_editor_new(GFile *file, BbSchematic *schematic, BbToolChanger *tool_changer);
 
@@ -54,6 +102,16 @@ void
 bb_geda_editor_reload(BbGedaEditor *editor, GError **error);
 
 
+/**
+ * Set the journal recording edits to the document
+ *
+ * @param editor This editor
+ * @param journal The journal, or NULL. The editor takes ownership of the journal.
+ */
+void
+bb_geda_editor_set_journal(BbGedaEditor *editor, BbGedaJournal *journal);
+
+
 void
 bb_geda_editor_set_tool_changer(BbGedaEditor *editor, BbToolChanger *tool_changer);
 
@@ -62,6 +62,15 @@ struct _BbGedaFactory
 static void
 bb_geda_factory_create_ready(BbGedaFactory *factory, GAsyncResult *result, GTask *task);
 
+static BbGedaItem*
+bb_geda_factory_create_with_lines(
+    BbGedaItemFactory *factory,
+    BbGedaVersion *version,
+    BbParams *params,
+    gchar **lines,
+    GError **error
+    );
+
 static void
 bb_geda_factory_dispose(GObject *object);
 
@@ -167,6 +176,56 @@ bb_geda_factory_create(
 }
 
 
+static BbGedaItem*
+bb_geda_factory_create_with_lines(
+    BbGedaItemFactory *factory,
+    BbGedaVersion *version,
+    BbParams *params,
+    gchar **lines,
+    GError **error
+    )
+{
+    BbGedaFactory *geda_factory = BB_GEDA_FACTORY(factory);
+    g_return_val_if_fail(geda_factory != NULL, NULL);
+
+    BbGedaItem *item = NULL;
+    GError *local_error = NULL;
+
+    BbGedaItemFactory *specific_factory = g_hash_table_lookup(
+        geda_factory->table,
+        bb_params_get_token(params)
+        );
+
+    if (specific_factory == NULL)
+    {
+        local_error = g_error_new(
+            BB_ERROR_DOMAIN,
+            ERROR_UNKNOWN_ITEM_TOKEN,
+            "Unknown gEDA item type: '%s'",
+            bb_params_get_token(params)
+            );
+    }
+    else
+    {
+        item = bb_geda_item_factory_create_with_lines(
+            specific_factory,
+            version,
+            params,
+            lines,
+            &local_error
+            );
+    }
+
+    if (local_error != NULL)
+    {
+        g_propagate_error(error, local_error);
+        g_clear_object(&item);
+    }
+
+    return item;
+}
+
+
 void
 bb_geda_factory_create_async(
     BbGedaItemFactory *factory,
@@ -375,6 +434,7 @@ bb_geda_factory_geda_item_factory(BbGedaItemFactoryInterface *iface)
 
     iface->create = bb_geda_factory_create;
     iface->create_async = bb_geda_factory_create_async;
+    iface->create_with_lines = bb_geda_factory_create_with_lines;
 }
 
 
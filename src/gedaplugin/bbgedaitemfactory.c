@@ -48,6 +48,15 @@ bb_geda_item_factory_create_finish_default(
     GError **error
     );
 
+static BbGedaItem*
+bb_geda_item_factory_create_with_lines_default(
+    BbGedaItemFactory *factory,
+    BbGedaVersion *version,
+    BbParams *params,
+    gchar **lines,
+    GError **error
+    );
+
 static void
 bb_geda_item_factory_register_type(GTypeModule *module);
 
@@ -63,6 +72,7 @@ bb_geda_item_factory_default_init(BbGedaItemFactoryInterface *iface)
     iface->create = bb_geda_item_factory_create_missing;
     iface->create_async = bb_geda_item_factory_create_async_missing;
     iface->create_finish = bb_geda_item_factory_create_finish_default;
+    iface->create_with_lines = bb_geda_item_factory_create_with_lines_default;
 }
 
 
@@ -168,6 +178,45 @@ bb_geda_item_factory_create_finish_default(
 }
 
 
+BbGedaItem*
+bb_geda_item_factory_create_with_lines(
+    BbGedaItemFactory *factory,
+    BbGedaVersion *version,
+    BbParams *params,
+    gchar **lines,
+    GError **error
+    )
+{
+    g_return_val_if_fail(BB_IS_GEDA_ITEM_FACTORY(factory), NULL);
+
+    BbGedaItemFactoryInterface *iface = BB_GEDA_ITEM_FACTORY_GET_IFACE(factory);
+
+    g_return_val_if_fail(iface != NULL, NULL);
+    g_return_val_if_fail(iface->create_with_lines != NULL, NULL);
+
+    return iface->create_with_lines(factory, version, params, lines, error);
+}
+
+
+/*
+ * Single line items do not read from the stream, so the synchronous create works without one
+ */
+static BbGedaItem*
+bb_geda_item_factory_create_with_lines_default(
+    BbGedaItemFactory *factory,
+    BbGedaVersion *version,
+    BbParams *params,
+    gchar **lines,
+    GError **error
+    )
+{
+    g_return_val_if_fail(BB_IS_GEDA_ITEM_FACTORY(factory), NULL);
+    g_return_val_if_fail(lines == NULL, NULL);
+
+    return bb_geda_item_factory_create(factory, version, params, NULL, error);
+}
+
+
 //GType
 //bb_geda_item_factory_get_type()
 //{
@@ -52,6 +52,14 @@ struct _BbGedaItemFactoryInterface
         GAsyncResult *result,
         GError **error
         );
+
+    BbGedaItem* (*create_with_lines)(
+        BbGedaItemFactory *factory,
+        BbGedaVersion *version,
+        BbParams *params,
+        gchar **lines,
+        GError **error
+        );
 };
 
 
@@ -113,4 +121,28 @@ bb_geda_item_factory_create_finish(
     );
 
 
+/**
+ * Synchronously create a gEDA schematic item from lines already in memory
+ *
+ * The default implementation is suitable for items occupying a single line. Factories for items with additional
+ * lines (e.g. text and paths) must override it. This function is reentrant, and may be called from multiple
+ * threads simultaneously.
+ *
+ * @param factory A BbGedaItemFactory
+ * @param version The gEDA version from the beginning of the input
+ * @param params The first line of the item converted to BbParams
+ * @param lines A NULL terminated array of the remaining lines of the item, or NULL for single line items
+ * @param error An optional location to store any error encountered
+ * @return The BbGedaItem created from the operation, or NULL if encountering an error
+ */
+BbGedaItem*
+bb_geda_item_factory_create_with_lines(
+    BbGedaItemFactory *factory,
+    BbGedaVersion *version,
+    BbParams *params,
+    gchar **lines,
+    GError **error
+    );
+
+
 #endif
@@ -0,0 +1,1260 @@
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include <gtk/gtk.h>
+#include <bblibrary.h>
+#include <bbwritebuffer.h>
+#include <bbelectrical.h>
+#include "bbgedafactory.h"
+#include "bbgedajournal.h"
+
+
+/**
+ * The file attributes identifying the saved document
+ */
+#define DOCUMENT_ATTRIBUTES \
+    G_FILE_ATTRIBUTE_STANDARD_SIZE "," \
+    G_FILE_ATTRIBUTE_TIME_MODIFIED "," \
+    G_FILE_ATTRIBUTE_TIME_MODIFIED_USEC
+
+
+/**
+ * The token of the header line
+ */
+#define HEADER_TOKEN "J"
+
+
+/**
+ * The version of the journal format, incremented on any incompatible change
+ */
+#define JOURNAL_VERSION (1)
+
+
+/**
+ * The delay, in milliseconds, used to batch edits into a single append
+ */
+#define FLUSH_DELAY (500)
+
+
+/**
+ * The smallest journal, in bytes, compacted into a snapshot
+ *
+ * Compaction rewrites every item, so it only occurs after the journal reaches twice the size of the previous
+ * snapshot, keeping the amortized cost of each edit proportional to the size of the edit.
+ */
+#define MIN_COMPACT_LENGTH (256 * 1024)
+
+
+/**
+ * The largest gap allowed between the identifier of an added item and the number of items known
+ *
+ * Guards against allocating an unreasonable number of slots for a corrupt identifier.
+ */
+#define MAX_ID_GAP (1024 * 1024)
+
+
+#define ADD_TOKEN "+"
+#define CHANGE_TOKEN "="
+#define REMOVE_TOKEN "-"
+#define SNAPSHOT_TOKEN "S"
+
+#define OPEN_ATTRIBUTES_TOKEN "{"
+#define CLOSE_ATTRIBUTES_TOKEN "}"
+
+
+struct _BbGedaJournal
+{
+    /**
+     * The document containing the saved schematic
+     */
+    GFile *file;
+
+    /**
+     * The file containing the journal
+     */
+    GFile *journal_file;
+
+    /**
+     * The schematic receiving the edits
+     */
+    BbSchematic *schematic;
+
+    /**
+     * The stream appending to the journal, or NULL after journaling stops
+     */
+    GOutputStream *stream;
+
+    /**
+     * Formats entries for the stream
+     */
+    BbWriteBuffer *buffer;
+
+    /**
+     * The identifier, plus one, of each item in the schematic
+     */
+    GHashTable *ids;
+
+    /**
+     * The identifier assigned to the next item added
+     */
+    guint next_id;
+
+    /**
+     * Items added since the last flush
+     */
+    GHashTable *added;
+
+    /**
+     * The identifiers of items removed since the last flush
+     */
+    GArray *removed;
+
+    /**
+     * Items changed since the last flush, excluding items added
+     */
+    GHashTable *changed;
+
+    /**
+     * The number of edits recorded
+     */
+    gulong edit_count;
+
+    /**
+     * The source flushing pending edits, or 0 if none are scheduled
+     */
+    guint flush_source;
+
+    /**
+     * The number of bytes in the journal file
+     */
+    guint64 length;
+
+    /**
+     * The length at which the journal is compacted
+     */
+    guint64 compact_length;
+};
+
+
+// region Function prototypes
+
+static gboolean
+bb_geda_journal_append_item(BbGedaJournal *journal, const gchar *token, guint id, BbGedaItem *item, GError **error);
+
+static void
+bb_geda_journal_assign_ids_lambda(BbGedaItem *item, BbGedaJournal *journal);
+
+static gboolean
+bb_geda_journal_check_item(BbGedaItem *item, GError **error);
+
+static void
+bb_geda_journal_clear_pending(BbGedaJournal *journal);
+
+static void
+bb_geda_journal_close(BbGedaJournal *journal);
+
+static int
+bb_geda_journal_compare_added_lambda(gconstpointer a, gconstpointer b, BbGedaJournal *journal);
+
+static gboolean
+bb_geda_journal_flush_timeout(BbGedaJournal *journal);
+
+static void
+bb_geda_journal_format_item(BbGedaItem *item, BbWriteBuffer *buffer);
+
+static GFile*
+bb_geda_journal_get_journal_file(GFile *file);
+
+static void
+bb_geda_journal_invalidate_item_cb(BbSchematic *schematic, BbGedaItem *item, BbGedaJournal *journal);
+
+static void
+bb_geda_journal_item_added_cb(BbSchematic *schematic, BbGedaItem *item, BbGedaJournal *journal);
+
+static void
+bb_geda_journal_item_removed_cb(BbSchematic *schematic, BbGedaItem *item, BbGedaJournal *journal);
+
+static void
+bb_geda_journal_items_changed_cb(BbSchematic *schematic, GPtrArray *items, BbBounds *damage, BbGedaJournal *journal);
+
+static gchar*
+bb_geda_journal_next_line(gchar **cursor, gchar *end);
+
+static gboolean
+bb_geda_journal_peek_token(gchar *cursor, gchar *end, const gchar *token);
+
+static gchar*
+bb_geda_journal_query_header(GFile *file, GError **error);
+
+static gboolean
+bb_geda_journal_read_attributes(BbGedaFactory *factory, BbGedaItem *item, gchar **cursor, gchar *end, GError **error);
+
+static BbGedaItem*
+bb_geda_journal_read_item(BbGedaFactory *factory, gchar **cursor, gchar *end, GError **error);
+
+static BbGedaItem*
+bb_geda_journal_read_record(BbGedaFactory *factory, gchar **cursor, gchar *end, GError **error);
+
+static gboolean
+bb_geda_journal_read_id(BbParams *params, guint limit, guint *id);
+
+static gboolean
+bb_geda_journal_rewrite(BbGedaJournal *journal, gboolean snapshot, GError **error);
+
+static void
+bb_geda_journal_schedule(BbGedaJournal *journal);
+
+static void
+bb_geda_journal_snapshot_lambda(BbGedaItem *item, GPtrArray *items);
+
+static void
+bb_geda_journal_stop(BbGedaJournal *journal);
+
+// endregion
+
+
+/**
+ * Append an entry containing the record of an item, along with its attributes
+ *
+ * @param journal A BbGedaJournal
+ * @param token The token identifying the entry
+ * @param id The identifier of the item
+ * @param item The item
+ * @param error An optional location to store an error
+ * @return TRUE on success, FALSE if the item has no file representation
+ */
+static gboolean
+bb_geda_journal_append_item(BbGedaJournal *journal, const gchar *token, guint id, BbGedaItem *item, GError **error)
+{
+    if (!bb_geda_journal_check_item(item, error))
+    {
+        return FALSE;
+    }
+
+    int value = (int) id;
+
+    bb_write_buffer_append_params(journal->buffer, token, 1, &value);
+    bb_geda_journal_format_item(item, journal->buffer);
+
+    return TRUE;
+}
+
+
+static void
+bb_geda_journal_assign_ids_lambda(BbGedaItem *item, BbGedaJournal *journal)
+{
+    g_hash_table_insert(journal->ids, item, GUINT_TO_POINTER(++journal->next_id));
+}
+
+
+/**
+ * Check that an item, and each of its attributes, has a file representation
+ *
+ * @param item The item
+ * @param error An optional location to store an error
+ * @return TRUE if the item can be journaled
+ */
+static gboolean
+bb_geda_journal_check_item(BbGedaItem *item, GError **error)
+{
+    GPtrArray *items = g_ptr_array_new_with_free_func((GDestroyNotify) g_object_unref);
+    gboolean success = TRUE;
+
+    g_ptr_array_add(items, g_object_ref(item));
+
+    if (BB_IS_ELECTRICAL(item))
+    {
+        bb_electrical_foreach(BB_ELECTRICAL(item), (GFunc) bb_geda_journal_snapshot_lambda, items);
+    }
+
+    for (guint index = 0; success && index < items->len; index++)
+    {
+        BbGedaItem *current = g_ptr_array_index(items, index);
+
+        success = bb_geda_item_can_format(current);
+
+        if (!success)
+        {
+            g_set_error(
+                error,
+                BB_ERROR_DOMAIN,
+                ERROR_NOT_SUPPORTED,
+                "Unable to journal item of type %s",
+                G_OBJECT_TYPE_NAME(current)
+                );
+        }
+    }
+
+    g_ptr_array_free(items, TRUE);
+
+    return success;
+}
+
+
+static void
+bb_geda_journal_clear_pending(BbGedaJournal *journal)
+{
+    g_hash_table_remove_all(journal->added);
+    g_array_set_size(journal->removed, 0);
+    g_hash_table_remove_all(journal->changed);
+
+    if (journal->flush_source != 0)
+    {
+        g_source_remove(journal->flush_source);
+        journal->flush_source = 0;
+    }
+}
+
+
+/**
+ * Order added items by identifier, so replay assigns the same slots
+ */
+static int
+bb_geda_journal_compare_added_lambda(gconstpointer a, gconstpointer b, BbGedaJournal *journal)
+{
+    guint id_a = GPOINTER_TO_UINT(g_hash_table_lookup(journal->ids, *(BbGedaItem**) a));
+    guint id_b = GPOINTER_TO_UINT(g_hash_table_lookup(journal->ids, *(BbGedaItem**) b));
+
+    return (id_a > id_b) - (id_a < id_b);
+}
+
+
+/**
+ * Stop writing to the journal file, leaving the file in place
+ *
+ * @param journal A BbGedaJournal
+ */
+static void
+bb_geda_journal_close(BbGedaJournal *journal)
+{
+    g_clear_pointer(&journal->buffer, bb_write_buffer_free);
+
+    if (journal->stream != NULL)
+    {
+        g_output_stream_close(journal->stream, NULL, NULL);
+        g_clear_object(&journal->stream);
+    }
+
+    journal->length = 0;
+}
+
+
+gboolean
+bb_geda_journal_flush(BbGedaJournal *journal, GError **error)
+{
+    g_return_val_if_fail(journal != NULL, FALSE);
+
+    GHashTableIter iter;
+    gpointer key;
+    GError *local_error = NULL;
+
+    if (journal->stream == NULL)
+    {
+        bb_geda_journal_clear_pending(journal);
+        return TRUE;
+    }
+
+    for (guint index = 0; index < journal->removed->len; index++)
+    {
+        int id = g_array_index(journal->removed, int, index);
+
+        bb_write_buffer_append_params(journal->buffer, REMOVE_TOKEN, 1, &id);
+    }
+
+    GPtrArray *added = g_ptr_array_new();
+
+    g_hash_table_iter_init(&iter, journal->added);
+
+    while (g_hash_table_iter_next(&iter, &key, NULL))
+    {
+        g_ptr_array_add(added, key);
+    }
+
+    g_ptr_array_sort_with_data(added, (GCompareDataFunc) bb_geda_journal_compare_added_lambda, journal);
+
+    for (guint index = 0; local_error == NULL && index < added->len; index++)
+    {
+        BbGedaItem *item = g_ptr_array_index(added, index);
+        guint id = GPOINTER_TO_UINT(g_hash_table_lookup(journal->ids, item)) - 1;
+
+        bb_geda_journal_append_item(journal, ADD_TOKEN, id, item, &local_error);
+    }
+
+    g_ptr_array_free(added, TRUE);
+
+    g_hash_table_iter_init(&iter, journal->changed);
+
+    while (local_error == NULL && g_hash_table_iter_next(&iter, &key, NULL))
+    {
+        guint id = GPOINTER_TO_UINT(g_hash_table_lookup(journal->ids, key)) - 1;
+
+        bb_geda_journal_append_item(journal, CHANGE_TOKEN, id, key, &local_error);
+    }
+
+    bb_geda_journal_clear_pending(journal);
+
+    if (local_error == NULL)
+    {
+        journal->length += bb_write_buffer_get_length(journal->buffer);
+
+        bb_write_buffer_flush(journal->buffer, NULL, &local_error);
+    }
+
+    if (local_error == NULL)
+    {
+        g_output_stream_flush(journal->stream, NULL, &local_error);
+    }
+
+    if (local_error == NULL && journal->length > journal->compact_length)
+    {
+        bb_geda_journal_rewrite(journal, TRUE, &local_error);
+    }
+
+    if (local_error != NULL)
+    {
+        bb_geda_journal_stop(journal);
+        g_propagate_error(error, local_error);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+
+static gboolean
+bb_geda_journal_flush_timeout(BbGedaJournal *journal)
+{
+    GError *local_error = NULL;
+
+    journal->flush_source = 0;
+
+    if (!bb_geda_journal_flush(journal, &local_error))
+    {
+        g_warning("Unable to update journal: %s", local_error->message);
+        g_clear_error(&local_error);
+    }
+
+    return G_SOURCE_REMOVE;
+}
+
+
+/**
+ * Format the record of an item, followed by its attributes, as in a schematic file
+ *
+ * @param item An item checked with bb_geda_journal_check_item()
+ * @param buffer The buffer receiving the records
+ */
+static void
+bb_geda_journal_format_item(BbGedaItem *item, BbWriteBuffer *buffer)
+{
+    bb_geda_item_format(item, buffer);
+
+    if (BB_IS_ELECTRICAL(item))
+    {
+        GPtrArray *attributes = g_ptr_array_new_with_free_func((GDestroyNotify) g_object_unref);
+
+        bb_electrical_foreach(BB_ELECTRICAL(item), (GFunc) bb_geda_journal_snapshot_lambda, attributes);
+
+        if (attributes->len > 0)
+        {
+            bb_write_buffer_append_params(buffer, OPEN_ATTRIBUTES_TOKEN, 0, NULL);
+
+            for (guint index = 0; index < attributes->len; index++)
+            {
+                bb_geda_item_format(g_ptr_array_index(attributes, index), buffer);
+            }
+
+            bb_write_buffer_append_params(buffer, CLOSE_ATTRIBUTES_TOKEN, 0, NULL);
+        }
+
+        g_ptr_array_free(attributes, TRUE);
+    }
+}
+
+
+void
+bb_geda_journal_free(BbGedaJournal *journal)
+{
+    if (journal != NULL)
+    {
+        bb_geda_journal_clear_pending(journal);
+        bb_geda_journal_stop(journal);
+
+        g_signal_handlers_disconnect_by_data(journal->schematic, journal);
+
+        g_hash_table_destroy(journal->added);
+        g_hash_table_destroy(journal->changed);
+        g_hash_table_destroy(journal->ids);
+        g_array_free(journal->removed, TRUE);
+        g_object_unref(journal->file);
+        g_object_unref(journal->journal_file);
+        g_object_unref(journal->schematic);
+        g_slice_free(BbGedaJournal, journal);
+    }
+}
+
+
+gulong
+bb_geda_journal_get_edit_count(BbGedaJournal *journal)
+{
+    g_return_val_if_fail(journal != NULL, 0);
+
+    return journal->edit_count;
+}
+
+
+/**
+ * Get the journal file of a document
+ *
+ * @param file The document
+ * @return The hidden journal file in the same folder as the document
+ */
+static GFile*
+bb_geda_journal_get_journal_file(GFile *file)
+{
+    GFile *parent = g_file_get_parent(file);
+    gchar *basename = g_file_get_basename(file);
+    gchar *name = g_strdup_printf(".%s.bbjournal", basename);
+
+    GFile *journal_file = (parent != NULL) ? g_file_get_child(parent, name) : g_file_new_for_path(name);
+
+    g_clear_object(&parent);
+    g_free(basename);
+    g_free(name);
+
+    return journal_file;
+}
+
+
+static void
+bb_geda_journal_invalidate_item_cb(BbSchematic *schematic, BbGedaItem *item, BbGedaJournal *journal)
+{
+    /* The record of an added item is formatted when flushed, so it already includes the change */
+
+    if (g_hash_table_contains(journal->ids, item) && !g_hash_table_contains(journal->added, item))
+    {
+        g_hash_table_add(journal->changed, item);
+    }
+
+    bb_geda_journal_schedule(journal);
+}
+
+
+static void
+bb_geda_journal_item_added_cb(BbSchematic *schematic, BbGedaItem *item, BbGedaJournal *journal)
+{
+    gpointer id = GUINT_TO_POINTER(++journal->next_id);
+
+    g_hash_table_insert(journal->ids, item, id);
+    g_hash_table_insert(journal->added, item, id);
+
+    bb_geda_journal_schedule(journal);
+}
+
+
+static void
+bb_geda_journal_item_removed_cb(BbSchematic *schematic, BbGedaItem *item, BbGedaJournal *journal)
+{
+    guint id = GPOINTER_TO_UINT(g_hash_table_lookup(journal->ids, item));
+
+    if (id > 0)
+    {
+        g_hash_table_remove(journal->ids, item);
+        g_hash_table_remove(journal->changed, item);
+
+        /* An item added and removed between flushes never reaches the journal */
+
+        if (!g_hash_table_remove(journal->added, item))
+        {
+            int removed_id = id - 1;
+
+            g_array_append_val(journal->removed, removed_id);
+        }
+    }
+
+    bb_geda_journal_schedule(journal);
+}
+
+
+static void
+bb_geda_journal_items_changed_cb(BbSchematic *schematic, GPtrArray *items, BbBounds *damage, BbGedaJournal *journal)
+{
+    for (guint index = 0; index < items->len; index++)
+    {
+        bb_geda_journal_invalidate_item_cb(schematic, g_ptr_array_index(items, index), journal);
+    }
+}
+
+
+BbGedaJournal*
+bb_geda_journal_new(BbSchematic *schematic, GFile *file, gboolean snapshot, GError **error)
+{
+    g_return_val_if_fail(BB_IS_SCHEMATIC(schematic), NULL);
+    g_return_val_if_fail(G_IS_FILE(file), NULL);
+
+    BbGedaJournal *journal = g_slice_new0(BbGedaJournal);
+
+    journal->file = g_object_ref(file);
+    journal->journal_file = bb_geda_journal_get_journal_file(file);
+    journal->schematic = g_object_ref(schematic);
+    journal->ids = g_hash_table_new(g_direct_hash, g_direct_equal);
+    journal->added = g_hash_table_new(g_direct_hash, g_direct_equal);
+    journal->removed = g_array_new(FALSE, FALSE, sizeof(int));
+    journal->changed = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+    if (!bb_geda_journal_rewrite(journal, snapshot, error))
+    {
+        bb_geda_journal_free(journal);
+        return NULL;
+    }
+
+    g_signal_connect(schematic, "invalidate-item", G_CALLBACK(bb_geda_journal_invalidate_item_cb), journal);
+    g_signal_connect(schematic, "item-added", G_CALLBACK(bb_geda_journal_item_added_cb), journal);
+    g_signal_connect(schematic, "item-removed", G_CALLBACK(bb_geda_journal_item_removed_cb), journal);
+    g_signal_connect(schematic, "items-changed", G_CALLBACK(bb_geda_journal_items_changed_cb), journal);
+
+    return journal;
+}
+
+
+/**
+ * Get the next line from the contents of the journal
+ *
+ * @param cursor The position of the next line, advanced past the line
+ * @param end The end of the contents
+ * @return The null terminated line, or NULL if no complete line remains
+ */
+static gchar*
+bb_geda_journal_next_line(gchar **cursor, gchar *end)
+{
+    gchar *line = *cursor;
+
+    if (line >= end)
+    {
+        return NULL;
+    }
+
+    gchar *terminator = memchr(line, '\n', end - line);
+
+    /* The last line is incomplete when the process exits during a write */
+
+    if (terminator == NULL)
+    {
+        *cursor = end;
+        return NULL;
+    }
+
+    *terminator = '\0';
+    *cursor = terminator + 1;
+
+    return line;
+}
+
+
+/**
+ * Test whether the next line of the contents consists of a token
+ *
+ * @param cursor The position of the next line
+ * @param end The end of the contents
+ * @param token The token
+ * @return TRUE if the next line is complete and contains only the token
+ */
+static gboolean
+bb_geda_journal_peek_token(gchar *cursor, gchar *end, const gchar *token)
+{
+    gsize length = strlen(token);
+
+    return (end - cursor > length) && (strncmp(cursor, token, length) == 0) && (cursor[length] == '\n');
+}
+
+
+/**
+ * Format the header identifying the saved contents of the document
+ *
+ * @param file The document
+ * @param error An optional location to store an error
+ * @return The header line, without a newline, or NULL on failure
+ */
+static gchar*
+bb_geda_journal_query_header(GFile *file, GError **error)
+{
+    GFileInfo *info = g_file_query_info(file, DOCUMENT_ATTRIBUTES, G_FILE_QUERY_INFO_NONE, NULL, error);
+
+    if (info == NULL)
+    {
+        return NULL;
+    }
+
+    gchar *header = g_strdup_printf(
+        HEADER_TOKEN " %d %" G_GUINT64_FORMAT " %" G_GUINT64_FORMAT " %u",
+        JOURNAL_VERSION,
+        g_file_info_get_attribute_uint64(info, G_FILE_ATTRIBUTE_STANDARD_SIZE),
+        g_file_info_get_attribute_uint64(info, G_FILE_ATTRIBUTE_TIME_MODIFIED),
+        g_file_info_get_attribute_uint32(info, G_FILE_ATTRIBUTE_TIME_MODIFIED_USEC)
+        );
+
+    g_object_unref(info);
+
+    return header;
+}
+
+
+/**
+ * Read the identifier from an entry
+ *
+ * @param params The parameters of the entry
+ * @param limit The largest identifier accepted
+ * @param id The identifier
+ * @return TRUE if the entry contains a valid identifier
+ */
+static gboolean
+bb_geda_journal_read_id(BbParams *params, guint limit, guint *id)
+{
+    GError *local_error = NULL;
+
+    int value = bb_params_get_int(params, 1, &local_error);
+
+    if (local_error != NULL)
+    {
+        g_clear_error(&local_error);
+        return FALSE;
+    }
+
+    if (value < 0 || (guint) value > limit)
+    {
+        return FALSE;
+    }
+
+    *id = value;
+
+    return TRUE;
+}
+
+
+/**
+ * Read the attributes following the record of an item, if any, and attach them to the item
+ *
+ * @param factory Creates items from gEDA records
+ * @param item The item owning the attributes
+ * @param cursor The position after the record of the item, advanced past the attributes
+ * @param end The end of the contents
+ * @param error An optional location to store an error
+ * @return TRUE on success, FALSE on failure
+ */
+static gboolean
+bb_geda_journal_read_attributes(BbGedaFactory *factory, BbGedaItem *item, gchar **cursor, gchar *end, GError **error)
+{
+    GError *local_error = NULL;
+
+    if (!bb_geda_journal_peek_token(*cursor, end, OPEN_ATTRIBUTES_TOKEN))
+    {
+        return TRUE;
+    }
+
+    bb_geda_journal_next_line(cursor, end);
+
+    while (local_error == NULL && !bb_geda_journal_peek_token(*cursor, end, CLOSE_ATTRIBUTES_TOKEN))
+    {
+        BbGedaItem *attribute = bb_geda_journal_read_record(factory, cursor, end, &local_error);
+
+        if (local_error != NULL)
+        {
+            /* Corrupt or incomplete attribute */
+        }
+        else if (!BB_IS_ATTRIBUTE(attribute))
+        {
+            local_error = g_error_new(
+                BB_ERROR_DOMAIN,
+                0,
+                "Item type %s is not an attribute",
+                G_OBJECT_TYPE_NAME(attribute)
+                );
+        }
+        else if (!BB_IS_ELECTRICAL(item))
+        {
+            local_error = g_error_new(
+                BB_ERROR_DOMAIN,
+                0,
+                "Item type %s does not support attributes",
+                G_OBJECT_TYPE_NAME(item)
+                );
+        }
+        else
+        {
+            bb_electrical_add_attribute(BB_ELECTRICAL(item), BB_ATTRIBUTE(attribute));
+        }
+
+        g_clear_object(&attribute);
+    }
+
+    if (local_error == NULL)
+    {
+        bb_geda_journal_next_line(cursor, end);
+    }
+
+    if (local_error != NULL)
+    {
+        g_propagate_error(error, local_error);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+
+/**
+ * Create an item, along with its attributes, from its entry in the journal
+ *
+ * @param factory Creates items from gEDA records
+ * @param cursor The position of the record, advanced past the record and its attributes
+ * @param end The end of the contents
+ * @param error An optional location to store an error
+ * @return The new item, or NULL on failure
+ */
+static BbGedaItem*
+bb_geda_journal_read_item(BbGedaFactory *factory, gchar **cursor, gchar *end, GError **error)
+{
+    GError *local_error = NULL;
+
+    BbGedaItem *item = bb_geda_journal_read_record(factory, cursor, end, &local_error);
+
+    if (local_error == NULL)
+    {
+        bb_geda_journal_read_attributes(factory, item, cursor, end, &local_error);
+    }
+
+    if (local_error != NULL)
+    {
+        g_propagate_error(error, local_error);
+        g_clear_object(&item);
+    }
+
+    return item;
+}
+
+
+/**
+ * Create an item from a single record in the journal
+ *
+ * @param factory Creates items from gEDA records
+ * @param cursor The position of the record, advanced past the record
+ * @param end The end of the contents
+ * @param error An optional location to store an error
+ * @return The new item, or NULL on failure
+ */
+static BbGedaItem*
+bb_geda_journal_read_record(BbGedaFactory *factory, gchar **cursor, gchar *end, GError **error)
+{
+    GError *local_error = NULL;
+    BbGedaItem *item = NULL;
+    gchar **lines = NULL;
+    BbParams *params = NULL;
+    int line_count = 0;
+
+    gchar *line = bb_geda_journal_next_line(cursor, end);
+
+    if (line == NULL)
+    {
+        local_error = g_error_new(BB_ERROR_DOMAIN, ERROR_UNEXPECTED_EOF, "Unexpected EOF");
+    }
+    else
+    {
+        params = bb_params_new_in_place(line, strlen(line), &local_error);
+    }
+
+    if (local_error == NULL)
+    {
+        if (bb_params_token_matches(params, BB_GEDA_TEXT_TOKEN))
+        {
+            line_count = bb_geda_text_get_line_count(params, &local_error);
+        }
+        else if (bb_params_token_matches(params, BB_GEDA_PATH_TOKEN))
+        {
+            line_count = bb_geda_path_get_line_count(params, &local_error);
+        }
+    }
+
+    if (local_error == NULL && line_count > 0)
+    {
+        lines = g_new0(gchar*, line_count + 1);
+
+        for (int index = 0; local_error == NULL && index < line_count; index++)
+        {
+            lines[index] = bb_geda_journal_next_line(cursor, end);
+
+            if (lines[index] == NULL)
+            {
+                local_error = g_error_new(BB_ERROR_DOMAIN, ERROR_UNEXPECTED_EOF, "Unexpected EOF");
+            }
+        }
+    }
+
+    if (local_error == NULL)
+    {
+        item = bb_geda_item_factory_create_with_lines(
+            BB_GEDA_ITEM_FACTORY(factory),
+            NULL,
+            params,
+            lines,
+            &local_error
+            );
+    }
+
+    /* The lines point into the contents */
+
+    g_free(lines);
+    g_clear_pointer(&params, bb_params_free);
+
+    if (local_error != NULL)
+    {
+        g_propagate_error(error, local_error);
+        g_clear_object(&item);
+    }
+
+    return item;
+}
+
+
+BbSchematic*
+bb_geda_journal_recover(GFile *file, BbSchematic *schematic, GError **error)
+{
+    g_return_val_if_fail(G_IS_FILE(file), NULL);
+    g_return_val_if_fail(BB_IS_SCHEMATIC(schematic), NULL);
+
+    gchar *contents = NULL;
+    gchar *header = NULL;
+    gsize length = 0;
+    GError *local_error = NULL;
+    BbSchematic *recovered = NULL;
+
+    GFile *journal_file = bb_geda_journal_get_journal_file(file);
+
+    g_file_load_contents(journal_file, NULL, &contents, &length, NULL, &local_error);
+
+    if (g_error_matches(local_error, G_IO_ERROR, G_IO_ERROR_NOT_FOUND))
+    {
+        g_clear_error(&local_error);
+    }
+    else if (local_error == NULL)
+    {
+        header = bb_geda_journal_query_header(file, &local_error);
+    }
+
+    gchar *cursor = contents;
+    gchar *end = contents + length;
+    gchar *line = (header != NULL) ? bb_geda_journal_next_line(&cursor, end) : NULL;
+
+    /* A journal of a different revision of the document cannot be replayed onto it */
+
+    if (line != NULL && g_strcmp0(line, header) != 0)
+    {
+        g_debug("Ignoring stale journal");
+        line = NULL;
+    }
+
+    if (line != NULL)
+    {
+        BbGedaFactory *factory = bb_geda_factory_new();
+        GPtrArray *slots = g_ptr_array_new_with_free_func((GDestroyNotify) g_object_unref);
+        gboolean replaying = TRUE;
+        guint replayed = 0;
+
+        bb_schematic_foreach(schematic, (GFunc) bb_geda_journal_snapshot_lambda, slots);
+
+        while (replaying && (line = bb_geda_journal_next_line(&cursor, end)) != NULL)
+        {
+            BbParams *params = bb_params_new_in_place(line, strlen(line), NULL);
+            guint id = 0;
+
+            replaying = (params != NULL);
+
+            if (!replaying)
+            {
+                /* Corrupt or incomplete entry */
+            }
+            else if (bb_params_token_matches(params, SNAPSHOT_TOKEN))
+            {
+                GPtrArray *snapshot = g_ptr_array_new_with_free_func((GDestroyNotify) g_object_unref);
+
+                replaying = bb_geda_journal_read_id(params, G_MAXINT, &id);
+
+                for (guint index = 0; replaying && index < id; index++)
+                {
+                    BbGedaItem *item = bb_geda_journal_read_item(factory, &cursor, end, NULL);
+
+                    replaying = (item != NULL);
+
+                    if (replaying)
+                    {
+                        g_ptr_array_add(snapshot, item);
+                    }
+                }
+
+                if (replaying)
+                {
+                    g_ptr_array_unref(slots);
+                    slots = g_steal_pointer(&snapshot);
+                }
+
+                g_clear_pointer(&snapshot, g_ptr_array_unref);
+            }
+            else if (bb_params_token_matches(params, ADD_TOKEN) || bb_params_token_matches(params, CHANGE_TOKEN))
+            {
+                replaying = bb_geda_journal_read_id(params, slots->len + MAX_ID_GAP, &id);
+
+                BbGedaItem *item = replaying ? bb_geda_journal_read_item(factory, &cursor, end, NULL) : NULL;
+
+                replaying = (item != NULL);
+
+                if (replaying)
+                {
+                    if (id >= slots->len)
+                    {
+                        g_ptr_array_set_size(slots, id + 1);
+                    }
+
+                    g_clear_object(&g_ptr_array_index(slots, id));
+                    g_ptr_array_index(slots, id) = item;
+                }
+            }
+            else if (bb_params_token_matches(params, REMOVE_TOKEN))
+            {
+                replaying = bb_geda_journal_read_id(params, G_MAXINT, &id);
+
+                if (replaying && id < slots->len)
+                {
+                    g_clear_object(&g_ptr_array_index(slots, id));
+                }
+            }
+            else
+            {
+                replaying = FALSE;
+            }
+
+            if (replaying)
+            {
+                replayed++;
+            }
+
+            g_clear_pointer(&params, bb_params_free);
+        }
+
+        /* A journal containing only the header holds no edits, so the saved document is already current */
+
+        recovered = (replayed > 0) ? bb_schematic_new() : NULL;
+
+        for (guint index = 0; recovered != NULL && index < slots->len; index++)
+        {
+            BbGedaItem *item = g_ptr_array_index(slots, index);
+
+            if (item != NULL)
+            {
+                bb_schematic_add_item(recovered, item);
+            }
+        }
+
+        g_ptr_array_unref(slots);
+        g_object_unref(factory);
+    }
+
+    g_free(contents);
+    g_free(header);
+    g_object_unref(journal_file);
+
+    if (local_error != NULL)
+    {
+        g_propagate_error(error, local_error);
+    }
+
+    return recovered;
+}
+
+
+/**
+ * Start a new journal file, containing only the header and an optional snapshot
+ *
+ * Items are renumbered in schematic order, which is the order replay assigns to the saved document or to the
+ * snapshot.
+ *
+ * @param journal A BbGedaJournal
+ * @param snapshot TRUE to include a snapshot of every item
+ * @param error An optional location to store an error
+ * @return TRUE on success, FALSE on failure
+ */
+static gboolean
+bb_geda_journal_rewrite(BbGedaJournal *journal, gboolean snapshot, GError **error)
+{
+    GError *local_error = NULL;
+    GPtrArray *items = g_ptr_array_new_with_free_func((GDestroyNotify) g_object_unref);
+
+    /* The previous journal remains until replaced, in case of a crash while rewriting */
+
+    bb_geda_journal_clear_pending(journal);
+    bb_geda_journal_close(journal);
+
+    g_hash_table_remove_all(journal->ids);
+    journal->next_id = 0;
+
+    bb_schematic_foreach(journal->schematic, (GFunc) bb_geda_journal_assign_ids_lambda, journal);
+
+    gchar *header = bb_geda_journal_query_header(journal->file, &local_error);
+
+    GFileOutputStream *stream = (local_error == NULL) ? g_file_replace(
+        journal->journal_file,
+        NULL,
+        FALSE,
+        G_FILE_CREATE_PRIVATE,
+        NULL,
+        &local_error
+        ) : NULL;
+
+    if (stream != NULL)
+    {
+        BbWriteBuffer *buffer = bb_write_buffer_new(G_OUTPUT_STREAM(stream), BB_WRITE_BUFFER_DEFAULT_BLOCK_SIZE);
+
+        bb_write_buffer_append_string(buffer, header);
+        bb_write_buffer_append_char(buffer, '\n');
+
+        if (snapshot)
+        {
+            bb_schematic_foreach(journal->schematic, (GFunc) bb_geda_journal_snapshot_lambda, items);
+
+            int count = items->len;
+
+            bb_write_buffer_append_params(buffer, SNAPSHOT_TOKEN, 1, &count);
+
+            for (guint index = 0; local_error == NULL && index < items->len; index++)
+            {
+                BbGedaItem *item = g_ptr_array_index(items, index);
+
+                if (bb_geda_journal_check_item(item, &local_error))
+                {
+                    bb_geda_journal_format_item(item, buffer);
+                    bb_write_buffer_flush_if_full(buffer, NULL, &local_error);
+                }
+            }
+        }
+
+        if (local_error == NULL)
+        {
+            bb_write_buffer_flush(buffer, NULL, &local_error);
+        }
+
+        if (local_error == NULL)
+        {
+            journal->length = g_seekable_tell(G_SEEKABLE(stream));
+
+            g_output_stream_close(G_OUTPUT_STREAM(stream), NULL, &local_error);
+        }
+        else
+        {
+            /* Closing with a cancelled cancellable discards the incomplete replacement */
+
+            GCancellable *cancellable = g_cancellable_new();
+
+            g_cancellable_cancel(cancellable);
+            g_output_stream_close(G_OUTPUT_STREAM(stream), cancellable, NULL);
+            g_object_unref(cancellable);
+        }
+
+        bb_write_buffer_free(buffer);
+        g_object_unref(stream);
+    }
+
+    g_ptr_array_free(items, TRUE);
+    g_free(header);
+
+    if (local_error == NULL)
+    {
+        journal->compact_length = MAX(MIN_COMPACT_LENGTH, 2 * journal->length);
+        journal->stream = G_OUTPUT_STREAM(g_file_append_to(
+            journal->journal_file,
+            G_FILE_CREATE_PRIVATE,
+            NULL,
+            &local_error
+            ));
+    }
+
+    if (local_error != NULL)
+    {
+        bb_geda_journal_stop(journal);
+        g_propagate_error(error, local_error);
+        return FALSE;
+    }
+
+    journal->buffer = bb_write_buffer_new(journal->stream, BB_WRITE_BUFFER_DEFAULT_BLOCK_SIZE);
+
+    return TRUE;
+}
+
+
+gboolean
+bb_geda_journal_saved(BbGedaJournal *journal, GFile *file, gulong edit_count, GError **error)
+{
+    g_return_val_if_fail(journal != NULL, FALSE);
+    g_return_val_if_fail(G_IS_FILE(file), FALSE);
+
+    if (!g_file_equal(file, journal->file))
+    {
+        bb_geda_journal_stop(journal);
+
+        g_object_unref(journal->file);
+        journal->file = g_object_ref(file);
+
+        g_object_unref(journal->journal_file);
+        journal->journal_file = bb_geda_journal_get_journal_file(file);
+    }
+
+    /* Edits made after the save started are not in the document, so they must be kept in a snapshot */
+
+    return bb_geda_journal_rewrite(journal, journal->edit_count != edit_count, error);
+}
+
+
+static void
+bb_geda_journal_schedule(BbGedaJournal *journal)
+{
+    journal->edit_count++;
+
+    if (journal->stream != NULL && journal->flush_source == 0)
+    {
+        journal->flush_source = g_timeout_add(FLUSH_DELAY, (GSourceFunc) bb_geda_journal_flush_timeout, journal);
+    }
+}
+
+
+static void
+bb_geda_journal_snapshot_lambda(BbGedaItem *item, GPtrArray *items)
+{
+    g_ptr_array_add(items, g_object_ref(item));
+}
+
+
+/**
+ * Stop writing to the journal file and delete it
+ *
+ * @param journal A BbGedaJournal
+ */
+static void
+bb_geda_journal_stop(BbGedaJournal *journal)
+{
+    bb_geda_journal_close(journal);
+
+    g_file_delete(journal->journal_file, NULL, NULL);
+}
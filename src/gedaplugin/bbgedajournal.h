@@ -0,0 +1,129 @@
+#ifndef __BBGEDAJOURNAL__
+#define __BBGEDAJOURNAL__
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file bbgedajournal.h
+ *
+ * An append-only journal of the edits made to a schematic since it was last saved
+ *
+ * The journal is stored next to the document, as a hidden file with the extension ".bbjournal". It starts
+ * with a header identifying the size and modification time of the saved document. Each entry refers to an
+ * item by an identifier assigned when the journal started or when the item was added:
+ *
+ *     + id    followed by the record of an added item
+ *     - id    an item was removed
+ *     = id    followed by the new record of a changed item
+ *     S count followed by the records of every item, replacing all previous entries
+ *
+ * Edits are batched and appended shortly after they occur. The cost of each append depends only on the items
+ * changed, not on the size of the schematic. When the journal grows too large, it is compacted by rewriting it
+ * as a single snapshot. Saving the document restarts the journal.
+ *
+ * Closing the journal deletes the file, so a journal only remains after a crash. When the document is opened
+ * again, bb_geda_journal_recover() replays the entries onto the saved document.
+ */
+
+#include <gtk/gtk.h>
+#include <bblibrary.h>
+
+
+typedef struct _BbGedaJournal BbGedaJournal;
+
+
+/**
+ * Write the pending edits to the journal
+ *
+ * On failure, journaling stops and the journal file is deleted.
+ *
+ * @param journal A BbGedaJournal
+ * @param error An optional location to store an error
+ * @return TRUE on success, FALSE on failure
+ */
+gboolean
+bb_geda_journal_flush(BbGedaJournal *journal, GError **error);
+
+
+/**
+ * Stop journaling and delete the journal file
+ *
+ * Pending edits are discarded. Call after the document is saved, or when the user discards the changes.
+ *
+ * @param journal A BbGedaJournal, or NULL
+ */
+void
+bb_geda_journal_free(BbGedaJournal *journal);
+
+
+/**
+ * Get the number of edits recorded since the journal started
+ *
+ * @param journal A BbGedaJournal
+ * @return The number of edits
+ */
+gulong
+bb_geda_journal_get_edit_count(BbGedaJournal *journal);
+
+
+/**
+ * Start journaling the edits made to a schematic
+ *
+ * Use bb_geda_journal_free() to release all associated resources
+ *
+ * @param schematic The schematic to journal
+ * @param file The document containing the saved schematic
+ * @param snapshot TRUE if the schematic differs from the saved document, as after recovery
+ * @param error An optional location to store an error
+ * @return A new BbGedaJournal, or NULL on failure
+ */
+BbGedaJournal*
+bb_geda_journal_new(BbSchematic *schematic, GFile *file, gboolean snapshot, GError **error);
+
+
+/**
+ * Replay the journal left by a crash onto the saved document
+ *
+ * Replay stops at the first incomplete entry, which is usually the last entry written before the crash. If no entry
+ * is replayed, the saved document is already current and there is nothing to recover.
+ *
+ * @param file The document containing the saved schematic
+ * @param schematic The schematic loaded from the document
+ * @param error An optional location to store an error
+ * @return A new BbSchematic with the recovered edits, or NULL if there is nothing to recover
+ */
+BbSchematic*
+bb_geda_journal_recover(GFile *file, BbSchematic *schematic, GError **error);
+
+
+/**
+ * Restart the journal after the document is saved
+ *
+ * Edits made while the save was in progress are kept in the journal as a snapshot.
+ *
+ * @param journal A BbGedaJournal
+ * @param file The document, which may differ from the original after "save as"
+ * @param edit_count The edit count when the save started
+ * @param error An optional location to store an error
+ * @return TRUE on success, FALSE on failure
+ */
+gboolean
+bb_geda_journal_saved(BbGedaJournal *journal, GFile *file, gulong edit_count, GError **error);
+
+
+#endif
@@ -23,6 +23,7 @@
 #include "bbgedareader.h"
 #include "bbspecificopener.h"
 #include "bbgedaeditor.h"
+#include "bbgedajournal.h"
 
 
 enum
@@ -67,10 +68,7 @@ bb_geda_opener_get_property(
     );
 
 static void
-bb_geda_opener_open_ready_1(GFile *file, GAsyncResult *result, GTask *task);
-
-static void
-bb_geda_opener_open_ready_2(BbGedaReader *reader, GAsyncResult *result, GTask *task);
+bb_geda_opener_open_ready(BbGedaReader *reader, GAsyncResult *result, GTask *task);
 
 static void
 bb_geda_opener_set_property(
@@ -122,40 +120,69 @@ bb_geda_opener_open_async(
         user_data
         );
 
-    g_file_read_async(
+    g_task_set_task_data(task, g_object_ref(file), g_object_unref);
+
+    bb_geda_reader_load_file_async(
+        bb_geda_opener_get_reader(BB_GEDA_OPENER(specific_opener)),
         file,
-        G_PRIORITY_DEFAULT,
-        NULL,
-        (GAsyncReadyCallback) bb_geda_opener_open_ready_1,
+        cancellable,
+        (GAsyncReadyCallback) bb_geda_opener_open_ready,
         task
         );
 }
 
 
 static void
-bb_geda_opener_open_ready_1(GFile *file, GAsyncResult *result, GTask *task)
+bb_geda_opener_open_ready(BbGedaReader *reader, GAsyncResult *result, GTask *task)
 {
     GError *local_error = NULL;
 
-    GFileInputStream *file_stream = g_file_read_finish(file, result, &local_error);
+    BbSchematic *schematic = bb_geda_reader_load_finish(reader, result, &local_error);
 
     if (g_task_return_error_if_cancelled(task))
     {
+        g_clear_object(&schematic);
         g_object_unref(task);
     }
     else if (local_error != NULL)
     {
+        g_task_return_error(task, local_error);
         g_object_unref(task);
     }
-    else if (file_stream == NULL)
+    else if (schematic == NULL)
     {
+        g_task_return_new_error(task, BB_ERROR_DOMAIN, 0, "Internal error");
         g_object_unref(task);
     }
     else
     {
-        GDataInputStream *data_stream = g_data_input_stream_new(G_INPUT_STREAM(file_stream));
         BbGedaOpener *opener = BB_GEDA_OPENER(g_task_get_source_object(task));
-        BbSchematic *schematic = bb_schematic_new();
+        GFile *file = G_FILE(g_task_get_task_data(task));
+
+        /* A journal remaining from a crash holds edits made after the last save */
+
+        BbSchematic *recovered = bb_geda_journal_recover(file, schematic, &local_error);
+
+        if (local_error != NULL)
+        {
+            g_warning("Unable to recover unsaved changes: %s", local_error->message);
+            g_clear_error(&local_error);
+        }
+
+        if (recovered != NULL)
+        {
+            g_debug("Recovered unsaved changes");
+            g_object_unref(schematic);
+            schematic = recovered;
+        }
+
+        BbGedaJournal *journal = bb_geda_journal_new(schematic, file, recovered != NULL, &local_error);
+
+        if (local_error != NULL)
+        {
+            g_warning("Unable to start journal: %s", local_error->message);
+            g_clear_error(&local_error);
+        }
 
         BbGedaEditor *editor = bb_geda_editor_new(
             file,
@@ -163,47 +190,16 @@ bb_geda_opener_open_ready_1(GFile *file, GAsyncResult *result, GTask *task)
             bb_main_window_get_tool_changer(opener->main_window)
             );
 
+        bb_geda_editor_set_journal(editor, journal);
+
         bb_main_window_add_page(
             opener->main_window,
             BB_DOCUMENT_WINDOW(editor)
             );
 
-        bb_geda_reader_read_async(
-            bb_geda_opener_get_reader(BB_GEDA_OPENER(opener)),
-            data_stream,
-            schematic,
-            NULL,
-            (GAsyncReadyCallback) bb_geda_opener_open_ready_2,
-            task
-            );
-    }
-}
-
-
-static void
-bb_geda_opener_open_ready_2(BbGedaReader *reader, GAsyncResult *result, GTask *task)
-{
-    GError *local_error = NULL;
-
-    gboolean success = TRUE; bb_geda_reader_read_finish(reader, result, &local_error);    // TODO
+        g_object_unref(schematic);
 
-    if (g_task_return_error_if_cancelled(task))
-    {
-        g_object_unref(task);
-    }
-    else if (local_error != NULL)
-    {
-        g_task_return_error(task, local_error);
-        g_object_unref(task);
-    }
-    else if (!success)
-    {
-        g_task_return_boolean(task, success);
-        g_object_unref(task);
-    }
-    else
-    {
-        g_task_return_boolean(task, success);
+        g_task_return_boolean(task, TRUE);
         g_object_unref(task);
     }
 }
@@ -320,11 +316,16 @@ bb_geda_opener_init(BbGedaOpener *opener)
 BbGedaOpener*
 bb_geda_opener_new(BbMainWindow *main_window)
 {
+    BbGedaCache *cache = bb_geda_cache_new(NULL);
+
     BbGedaReader *reader = BB_GEDA_READER(g_object_new(
         BB_TYPE_GEDA_READER,
+        "cache", cache,
         NULL
         ));
 
+    g_object_unref(cache);
+
     return BB_GEDA_OPENER(g_object_new(
         BB_TYPE_GEDA_OPENER,
         "main-window", main_window,
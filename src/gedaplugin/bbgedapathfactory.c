@@ -74,6 +74,15 @@ bb_geda_path_factory_create_async(
 static void
 bb_geda_path_factory_create_ready_line(GDataInputStream *stream, GAsyncResult *result, GTask *task);
 
+static BbGedaItem*
+bb_geda_path_factory_create_with_lines(
+    BbGedaItemFactory *factory,
+    BbGedaVersion *version,
+    BbParams *params,
+    gchar **lines,
+    GError **error
+    );
+
 static void
 bb_geda_path_factory_dispose(GObject *object);
 
@@ -117,7 +126,66 @@ bb_geda_path_factory_create(
     GError **error
     )
 {
-    return BB_GEDA_ITEM(bb_geda_path_new_with_params(params, NULL, error));
+    GError *local_error = NULL;
+    BbGedaItem *item = NULL;
+
+    g_assert(BB_IS_GEDA_ITEM_FACTORY(factory));
+    g_assert(params != NULL);
+    g_assert(G_IS_DATA_INPUT_STREAM(stream));
+
+    TaskData *task_data = bb_geda_path_factory_task_data_new(params, &local_error);
+
+    if (local_error == NULL && task_data == NULL)
+    {
+        local_error = g_error_new(BB_ERROR_DOMAIN, 0, "Internal error");
+    }
+
+    while (local_error == NULL && task_data->index < task_data->line_count)
+    {
+        gchar *line = g_data_input_stream_read_line_utf8(stream, NULL, NULL, &local_error);
+
+        if (local_error == NULL && line == NULL)
+        {
+            local_error = g_error_new(BB_ERROR_DOMAIN, ERROR_UNEXPECTED_EOF, "Unexpected EOF");
+        }
+
+        if (local_error == NULL)
+        {
+            *(task_data->lines + task_data->index) = line;
+
+            task_data->index++;
+        }
+    }
+
+    if (local_error == NULL)
+    {
+        item = bb_geda_path_factory_create_with_lines(
+            factory,
+            version,
+            task_data->params,
+            task_data->lines,
+            &local_error
+            );
+    }
+
+    if (local_error == NULL && item == NULL)
+    {
+        local_error = g_error_new(
+            BB_ERROR_DOMAIN,
+            0,
+            "Internal error: " __FILE__ " line %d", __LINE__
+            );
+    }
+
+    bb_geda_path_factory_task_data_free(task_data);
+
+    if (local_error != NULL)
+    {
+        g_propagate_error(error, local_error);
+        g_clear_object(&item);
+    }
+
+    return item;
 }
 
 
@@ -208,26 +276,23 @@ bb_geda_path_factory_create_ready_line(GDataInputStream *stream, GAsyncResult *r
         }
         else
         {
-            BbGedaPath *path = NULL;
-            gchar *merged = g_strjoinv(" ", task_data->lines);
-            GSList *commands = bb_path_parser_parse(merged, &local_error);
-            g_free(merged);
+            BbGedaItem *path = bb_geda_path_factory_create_with_lines(
+                BB_GEDA_ITEM_FACTORY(g_task_get_source_object(task)),
+                NULL,
+                task_data->params,
+                task_data->lines,
+                &local_error
+                );
 
-            if (local_error == NULL)
+            if (local_error == NULL && path == NULL)
             {
-                path = bb_geda_path_new_with_params(task_data->params, commands, &local_error);
-
-                if (local_error == NULL && path == NULL)
-                {
-                    local_error = g_error_new(
-                        BB_ERROR_DOMAIN,
-                        0,
-                        "Internal error: " __FILE__ " line %d", __LINE__
-                        );
-                }
+                local_error = g_error_new(
+                    BB_ERROR_DOMAIN,
+                    0,
+                    "Internal error: " __FILE__ " line %d", __LINE__
+                    );
             }
 
-
             if (local_error == NULL)
             {
                 g_task_return_pointer(task, path, NULL);
@@ -244,6 +309,42 @@ bb_geda_path_factory_create_ready_line(GDataInputStream *stream, GAsyncResult *r
 }
 
 
+static BbGedaItem*
+bb_geda_path_factory_create_with_lines(
+    BbGedaItemFactory *factory,
+    BbGedaVersion *version,
+    BbParams *params,
+    gchar **lines,
+    GError **error
+    )
+{
+    g_return_val_if_fail(params != NULL, NULL);
+    g_return_val_if_fail(lines != NULL, NULL);
+
+    GError *local_error = NULL;
+    BbGedaPath *path = NULL;
+
+    gchar *merged = g_strjoinv(" ", lines);
+    BbPathData *data = bb_path_parser_parse(merged, &local_error);
+    g_free(merged);
+
+    if (local_error == NULL)
+    {
+        path = bb_geda_path_new_with_params(params, data, &local_error);
+    }
+
+    bb_path_data_free(data);
+
+    if (local_error != NULL)
+    {
+        g_propagate_error(error, local_error);
+        g_clear_object(&path);
+    }
+
+    return BB_GEDA_ITEM(path);
+}
+
+
 
 static void
 bb_geda_path_factory_class_init(BbGedaPathFactoryClass *klasse)
@@ -304,6 +405,7 @@ bb_geda_path_factory_item_factory_init(BbGedaItemFactoryInterface *iface)
 {
     iface->create = bb_geda_path_factory_create;
     iface->create_async = bb_geda_path_factory_create_async;
+    iface->create_with_lines = bb_geda_path_factory_create_with_lines;
 }
 
 BbGedaItemFactory*
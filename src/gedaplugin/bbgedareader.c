@@ -16,11 +16,15 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
 #include <gtk/gtk.h>
 #include <bblibrary.h>
+#include <bbextensions.h>
 #include <gedaplugin/bbgedaitemfactory.h>
 #include <bbelectrical.h>
+#include "bbgedacache.h"
 #include "bbgedareader.h"
+#include "bbgedarecord.h"
 
 
 #define VERSION_TOKEN "v"
@@ -28,9 +32,36 @@
 #define CLOSE_ATTRIBUTES_TOKEN "}"
 
 
+/**
+ * The size of each read from the stream by the synchronous reader
+ *
+ * Large enough to hold most schematics and symbols completely, so the underlying file is read in only a few
+ * system calls.
+ */
+#define BULK_BUFFER_SIZE (1024 * 1024)
+
+
+/**
+ * The number of records processed by a single work item on the thread pool
+ *
+ * Files with fewer records are processed on the calling thread.
+ */
+#define RECORDS_PER_CHUNK 1024
+
+
+/**
+ * The file attributes needed for the cache key
+ */
+#define CACHE_KEY_ATTRIBUTES \
+    G_FILE_ATTRIBUTE_STANDARD_SIZE "," \
+    G_FILE_ATTRIBUTE_TIME_MODIFIED "," \
+    G_FILE_ATTRIBUTE_TIME_MODIFIED_USEC
+
+
 enum
 {
     PROP_0,
+    PROP_CACHE,
     N_PROPERTIES
 };
 
@@ -39,6 +70,11 @@ struct _BbGedaReader
 {
     GObject parent;
 
+    /**
+     * An optional cache of pre-scanned files, or NULL to always read the text
+     */
+    BbGedaCache *cache;
+
     BbGedaFactory *factory;
 };
 
@@ -57,6 +93,21 @@ struct _BbTaskData
 };
 
 
+/**
+ * A contiguous range of records for a single work item on the thread pool
+ */
+typedef struct _BbChunk BbChunk;
+
+struct _BbChunk
+{
+    BbGedaRecord *records;
+
+    guint count;
+
+    GCancellable *cancellable;
+};
+
+
 G_DEFINE_TYPE_EXTENDED(
     BbGedaReader,
     bb_geda_reader,
@@ -67,6 +118,15 @@ G_DEFINE_TYPE_EXTENDED(
 
 // region Function prototypes
 
+static void
+bb_geda_reader_create_chunk_lambda(BbChunk *chunk, BbGedaReader *reader);
+
+static void
+bb_geda_reader_create_items(BbGedaReader *reader, GArray *records, GCancellable *cancellable, GError **error);
+
+static BbSchematic*
+bb_geda_reader_create_schematic(BbGedaReader *reader, GArray *records, GCancellable *cancellable, GError **error);
+
 static void
 bb_geda_reader_dispose(GObject *object);
 
@@ -76,15 +136,37 @@ bb_geda_reader_finalize(GObject *object);
 static void
 bb_geda_reader_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
 
+static int
+bb_geda_reader_get_line_count(BbParams *params, GError **error);
+
+static void
+bb_geda_reader_load_file_thread(GTask *task, BbGedaReader *reader, GFile *file, GCancellable *cancellable);
+
+static void
+bb_geda_reader_load_thread(GTask *task, BbGedaReader *reader, GInputStream *stream, GCancellable *cancellable);
+
+static GSList*
+bb_geda_reader_merge_records(GArray *records, GError **error);
+
+static gchar*
+bb_geda_reader_next_line(gchar **cursor, gchar *end, gsize *length);
+
+static gchar*
+bb_geda_reader_read_contents(GInputStream *stream, GCancellable *cancellable, gsize *length, GError **error);
+
 static void
 bb_geda_reader_read_attribute_ready(BbGedaItemFactory *factory, GAsyncResult *result, GTask *task);
 
+
 static void
 bb_geda_reader_read_item_line_ready(GDataInputStream *stream, GAsyncResult *result, GTask *task);
 
 static void
 bb_geda_reader_read_version_ready(GDataInputStream *stream, GAsyncResult *result, GTask *task);
 
+static GArray*
+bb_geda_reader_scan_records(gchar *contents, gsize length, GError **error);
+
 static void
 bb_geda_reader_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
 
@@ -101,6 +183,18 @@ bb_geda_reader_class_init(BbGedaReaderClass *klasse)
     G_OBJECT_CLASS(klasse)->finalize = bb_geda_reader_finalize;
     G_OBJECT_CLASS(klasse)->get_property = bb_geda_reader_get_property;
     G_OBJECT_CLASS(klasse)->set_property = bb_geda_reader_set_property;
+
+    properties[PROP_CACHE] = bb_object_class_install_property(
+        G_OBJECT_CLASS(klasse),
+        PROP_CACHE,
+        g_param_spec_object(
+            "cache",
+            "",
+            "",
+            BB_TYPE_GEDA_CACHE,
+            G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS
+            )
+        );
 }
 
 
@@ -110,9 +204,142 @@ bb_geda_reader_class_finalize(BbGedaReaderClass *klasse)
 }
 
 
+/**
+ * Create the items for a range of records on a worker thread
+ *
+ * @param chunk The range of records
+ * @param reader The BbGedaReader performing the read
+ */
+static void
+bb_geda_reader_create_chunk_lambda(BbChunk *chunk, BbGedaReader *reader)
+{
+    for (guint index = 0; index < chunk->count; index++)
+    {
+        BbGedaRecord *record = &chunk->records[index];
+
+        if (g_cancellable_set_error_if_cancelled(chunk->cancellable, &record->error))
+        {
+            break;
+        }
+
+        record->item = bb_geda_item_factory_create_with_lines(
+            BB_GEDA_ITEM_FACTORY(reader->factory),
+            NULL,
+            record->params,
+            record->lines,
+            &record->error
+            );
+    }
+}
+
+
+/**
+ * Create the items for all records, in parallel when the file is large enough
+ *
+ * Each record receives either an item or an error. Errors are reported, in file order, when merging.
+ *
+ * @param reader The BbGedaReader performing the read
+ * @param records The records located by the pre-scan
+ * @param cancellable A token to cancel the operation
+ * @param error An error preventing the items from being created
+ */
+static void
+bb_geda_reader_create_items(BbGedaReader *reader, GArray *records, GCancellable *cancellable, GError **error)
+{
+    GError *local_error = NULL;
+    guint chunk_count = (records->len + RECORDS_PER_CHUNK - 1) / RECORDS_PER_CHUNK;
+    BbChunk *chunks = g_new0(BbChunk, chunk_count);
+
+    for (guint index = 0; index < chunk_count; index++)
+    {
+        guint first = index * RECORDS_PER_CHUNK;
+
+        chunks[index].records = &g_array_index(records, BbGedaRecord, first);
+        chunks[index].count = MIN(RECORDS_PER_CHUNK, records->len - first);
+        chunks[index].cancellable = cancellable;
+    }
+
+    if (chunk_count == 1)
+    {
+        bb_geda_reader_create_chunk_lambda(&chunks[0], reader);
+    }
+    else if (chunk_count > 1)
+    {
+        GThreadPool *pool = g_thread_pool_new(
+            (GFunc) bb_geda_reader_create_chunk_lambda,
+            reader,
+            MIN(g_get_num_processors(), chunk_count),
+            TRUE,
+            &local_error
+            );
+
+        for (guint index = 0; local_error == NULL && index < chunk_count; index++)
+        {
+            g_thread_pool_push(pool, &chunks[index], &local_error);
+        }
+
+        if (pool != NULL)
+        {
+            /* Waits for all pushed chunks to complete */
+            g_thread_pool_free(pool, FALSE, TRUE);
+        }
+    }
+
+    g_free(chunks);
+
+    if (local_error != NULL)
+    {
+        g_propagate_error(error, local_error);
+    }
+}
+
+
+/**
+ * Create the items for all records and add them to a new schematic
+ *
+ * @param reader The BbGedaReader performing the read
+ * @param records The records, from the pre-scan or from the cache
+ * @param cancellable A token to cancel the operation
+ * @param error The error, if any
+ * @return A new BbSchematic containing the items, or NULL if an error occurred
+ */
+static BbSchematic*
+bb_geda_reader_create_schematic(BbGedaReader *reader, GArray *records, GCancellable *cancellable, GError **error)
+{
+    GError *local_error = NULL;
+    GSList *items = NULL;
+    BbSchematic *schematic = NULL;
+
+    bb_geda_reader_create_items(reader, records, cancellable, &local_error);
+
+    if (local_error == NULL)
+    {
+        items = bb_geda_reader_merge_records(records, &local_error);
+    }
+
+    if (local_error == NULL)
+    {
+        schematic = bb_schematic_new();
+
+        bb_schematic_add_items(schematic, items);
+    }
+
+    /* The schematic holds its own references to the items */
+    g_slist_free_full(items, g_object_unref);
+
+    if (local_error != NULL)
+    {
+        g_propagate_error(error, local_error);
+    }
+
+    return schematic;
+}
+
+
 static void
 bb_geda_reader_dispose(GObject *object)
 {
+    bb_geda_reader_set_cache(BB_GEDA_READER(object), NULL);
 }
 
 
@@ -127,12 +354,50 @@ bb_geda_reader_get_property(GObject *object, guint property_id, GValue *value, G
 {
     switch (property_id)
     {
+        case PROP_CACHE:
+            g_value_set_object(value, bb_geda_reader_get_cache(BB_GEDA_READER(object)));
+            break;
+
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
     }
 }
 
 
+BbGedaCache*
+bb_geda_reader_get_cache(BbGedaReader *reader)
+{
+    g_return_val_if_fail(BB_IS_GEDA_READER(reader), NULL);
+
+    return reader->cache;
+}
+
+
+/**
+ * Get the number of lines following the first line of an item
+ *
+ * @param params The first line of the item
+ * @param error The error, if the line count is invalid
+ * @return The number of additional lines, or zero for single line items
+ */
+static int
+bb_geda_reader_get_line_count(BbParams *params, GError **error)
+{
+    if (bb_params_token_matches(params, BB_GEDA_TEXT_TOKEN))
+    {
+        return bb_geda_text_get_line_count(params, error);
+    }
+    else if (bb_params_token_matches(params, BB_GEDA_PATH_TOKEN))
+    {
+        return bb_geda_path_get_line_count(params, error);
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+
 static void
 bb_geda_reader_init(BbGedaReader *reader)
 {
@@ -140,6 +405,423 @@ bb_geda_reader_init(BbGedaReader *reader)
 }
 
 
+void
+bb_geda_reader_load_file_async(
+    BbGedaReader *reader,
+    GFile *file,
+    GCancellable *cancellable,
+    GAsyncReadyCallback callback,
+    gpointer user_data
+    )
+{
+    g_return_if_fail(BB_IS_GEDA_READER(reader));
+    g_return_if_fail(G_IS_FILE(file));
+
+    GTask *task = g_task_new(
+        reader,
+        cancellable,
+        callback,
+        user_data
+        );
+
+    g_task_set_task_data(
+        task,
+        g_object_ref(file),
+        g_object_unref
+        );
+
+    g_task_run_in_thread(
+        task,
+        (GTaskThreadFunc) bb_geda_reader_load_file_thread
+        );
+
+    g_object_unref(task);
+}
+
+
+/**
+ * Read the schematic from a file on a worker thread
+ *
+ * @param task The task for the load operation
+ * @param reader The BbGedaReader performing the load
+ * @param file The task data containing the GFile
+ * @param cancellable A token to cancel the operation
+ */
+static void
+bb_geda_reader_load_file_thread(GTask *task, BbGedaReader *reader, GFile *file, GCancellable *cancellable)
+{
+    GError *local_error = NULL;
+
+    BbSchematic *schematic = bb_geda_reader_read_file(reader, file, cancellable, &local_error);
+
+    if (local_error != NULL)
+    {
+        g_task_return_error(task, local_error);
+    }
+    else
+    {
+        g_task_return_pointer(task, schematic, g_object_unref);
+    }
+}
+
+
+void
+bb_geda_reader_load_async(
+    BbGedaReader *reader,
+    GInputStream *stream,
+    GCancellable *cancellable,
+    GAsyncReadyCallback callback,
+    gpointer user_data
+    )
+{
+    g_return_if_fail(BB_IS_GEDA_READER(reader));
+    g_return_if_fail(G_IS_INPUT_STREAM(stream));
+
+    GTask *task = g_task_new(
+        reader,
+        cancellable,
+        callback,
+        user_data
+        );
+
+    g_task_set_task_data(
+        task,
+        g_object_ref(stream),
+        g_object_unref
+        );
+
+    g_task_run_in_thread(
+        task,
+        (GTaskThreadFunc) bb_geda_reader_load_thread
+        );
+
+    g_object_unref(task);
+}
+
+
+BbSchematic*
+bb_geda_reader_load_finish(BbGedaReader *reader, GAsyncResult *result, GError **error)
+{
+    g_return_val_if_fail(BB_IS_GEDA_READER(reader), NULL);
+    g_return_val_if_fail(g_task_is_valid(result, reader), NULL);
+
+    return g_task_propagate_pointer(G_TASK(result), error);
+}
+
+
+/**
+ * Read the schematic on a worker thread
+ *
+ * @param task The task for the load operation
+ * @param reader The BbGedaReader performing the load
+ * @param stream The task data containing the GInputStream
+ * @param cancellable A token to cancel the operation
+ */
+static void
+bb_geda_reader_load_thread(GTask *task, BbGedaReader *reader, GInputStream *stream, GCancellable *cancellable)
+{
+    GError *local_error = NULL;
+
+    BbSchematic *schematic = bb_geda_reader_read(reader, stream, cancellable, &local_error);
+
+    if (local_error != NULL)
+    {
+        g_task_return_error(task, local_error);
+    }
+    else
+    {
+        g_task_return_pointer(task, schematic, g_object_unref);
+    }
+}
+
+
+/**
+ * Combine the created items, in file order, attaching attributes to their owners
+ *
+ * @param records The records, after the items have been created
+ * @param error The first error, in file order, if any
+ * @return A list of the items, in file order, owned by the caller
+ */
+static GSList*
+bb_geda_reader_merge_records(GArray *records, GError **error)
+{
+    GSList *items = NULL;
+    BbGedaItem *last_item = NULL;
+    GError *local_error = NULL;
+
+    for (guint index = 0; local_error == NULL && index < records->len; index++)
+    {
+        BbGedaRecord *record = &g_array_index(records, BbGedaRecord, index);
+
+        if (record->error != NULL)
+        {
+            local_error = g_steal_pointer(&record->error);
+        }
+        else if (record->item == NULL)
+        {
+            local_error = g_error_new(BB_ERROR_DOMAIN, 0, "Internal error");
+        }
+        else if (!record->attribute)
+        {
+            last_item = g_steal_pointer(&record->item);
+            items = g_slist_prepend(items, last_item);
+        }
+        else if (!BB_IS_ATTRIBUTE(record->item))
+        {
+            local_error = g_error_new(
+                BB_ERROR_DOMAIN,
+                0,
+                "Item type %s is not an attribute",
+                G_OBJECT_TYPE_NAME(record->item)  // TODO user friendly name
+                );
+        }
+        else if (!BB_IS_ELECTRICAL(last_item))
+        {
+            local_error = g_error_new(
+                BB_ERROR_DOMAIN,
+                0,
+                "Item type %s does not support attributes",
+                last_item != NULL ? G_OBJECT_TYPE_NAME(last_item) : "(none)"    // TODO user friendly name
+                );
+        }
+        else
+        {
+            bb_electrical_add_attribute(
+                BB_ELECTRICAL(last_item),
+                BB_ATTRIBUTE(record->item)
+                );
+        }
+    }
+
+    if (local_error != NULL)
+    {
+        g_propagate_error(error, local_error);
+        g_slist_free_full(items, g_object_unref);
+        items = NULL;
+    }
+
+    return g_slist_reverse(items);
+}
+
+
+/**
+ * Get the next line from the file contents, replacing the line terminator with a null terminator
+ *
+ * @param cursor The location of the next line, updated to the location of the line after
+ * @param end The end of the file contents
+ * @param length The length of the line, excluding the terminator
+ * @return The line, or NULL at the end of the file contents
+ */
+static gchar*
+bb_geda_reader_next_line(gchar **cursor, gchar *end, gsize *length)
+{
+    gchar *line = *cursor;
+
+    if (line >= end)
+    {
+        return NULL;
+    }
+
+    gchar *terminator = memchr(line, '\n', end - line);
+
+    if (terminator == NULL)
+    {
+        terminator = end;
+        *cursor = end;
+    }
+    else
+    {
+        *terminator = '\0';
+        *cursor = terminator + 1;
+    }
+
+    *length = terminator - line;
+
+    return line;
+}
+
+
+/**
+ * Read the entire contents of a stream into memory
+ *
+ * @param stream The stream to read
+ * @param cancellable A token to cancel the operation
+ * @param length The length of the contents, excluding the null terminator
+ * @param error The error, if any
+ * @return The null terminated contents of the stream, or NULL on error
+ */
+static gchar*
+bb_geda_reader_read_contents(GInputStream *stream, GCancellable *cancellable, gsize *length, GError **error)
+{
+    GError *local_error = NULL;
+    GByteArray *contents = g_byte_array_sized_new(BULK_BUFFER_SIZE);
+    gssize count;
+
+    do
+    {
+        guint used = contents->len;
+
+        g_byte_array_set_size(contents, used + BULK_BUFFER_SIZE);
+
+        count = g_input_stream_read(
+            stream,
+            contents->data + used,
+            BULK_BUFFER_SIZE,
+            cancellable,
+            &local_error
+            );
+
+        g_byte_array_set_size(contents, used + MAX(count, 0));
+    }
+    while (local_error == NULL && count > 0);
+
+    if (local_error != NULL)
+    {
+        g_propagate_error(error, local_error);
+        g_byte_array_free(contents, TRUE);
+        return NULL;
+    }
+
+    *length = contents->len;
+    g_byte_array_append(contents, (const guint8*) "", 1);
+
+    return (gchar*) g_byte_array_free(contents, FALSE);
+}
+
+
+BbSchematic*
+bb_geda_reader_read(BbGedaReader *reader, GInputStream *stream, GCancellable *cancellable, GError **error)
+{
+    g_return_val_if_fail(BB_IS_GEDA_READER(reader), NULL);
+    g_return_val_if_fail(G_IS_INPUT_STREAM(stream), NULL);
+
+    GError *local_error = NULL;
+    gsize length = 0;
+    GArray *records = NULL;
+    BbSchematic *schematic = NULL;
+
+    gchar *contents = bb_geda_reader_read_contents(stream, cancellable, &length, &local_error);
+
+    if (local_error == NULL)
+    {
+        records = bb_geda_reader_scan_records(contents, length, &local_error);
+    }
+
+    if (local_error == NULL)
+    {
+        schematic = bb_geda_reader_create_schematic(reader, records, cancellable, &local_error);
+    }
+
+    /* The records point into the contents, so must be released first */
+    if (records != NULL)
+    {
+        g_array_unref(records);
+    }
+
+    g_free(contents);
+
+    if (local_error != NULL)
+    {
+        g_propagate_error(error, local_error);
+    }
+
+    return schematic;
+}
+
+
+BbSchematic*
+bb_geda_reader_read_file(BbGedaReader *reader, GFile *file, GCancellable *cancellable, GError **error)
+{
+    g_return_val_if_fail(BB_IS_GEDA_READER(reader), NULL);
+    g_return_val_if_fail(G_IS_FILE(file), NULL);
+
+    GError *local_error = NULL;
+    BbGedaCacheKey *key = NULL;
+    gchar *contents = NULL;
+    gsize length = 0;
+    GMappedFile *mapping = NULL;
+    GArray *records = NULL;
+    BbSchematic *schematic = NULL;
+
+    /* Hold a reference for the duration of the read, in case the cache is replaced */
+    BbGedaCache *cache = reader->cache != NULL ? g_object_ref(reader->cache) : NULL;
+
+    GFileInputStream *stream = g_file_read(file, cancellable, &local_error);
+
+    if (local_error == NULL)
+    {
+        contents = bb_geda_reader_read_contents(G_INPUT_STREAM(stream), cancellable, &length, &local_error);
+    }
+
+    if (local_error == NULL && cache != NULL)
+    {
+        GError *cache_error = NULL;
+
+        /* Query the open stream, so the key describes the contents actually read */
+
+        GFileInfo *info = g_file_input_stream_query_info(stream, CACHE_KEY_ATTRIBUTES, cancellable, &cache_error);
+
+        if (cache_error == NULL)
+        {
+            key = bb_geda_cache_key_new(file, info, contents, length);
+            records = bb_geda_cache_load(cache, key, &mapping, &cache_error);
+        }
+
+        if (cache_error != NULL)
+        {
+            g_debug("Not using cache: %s", cache_error->message);
+            g_clear_error(&cache_error);
+        }
+
+        g_clear_object(&info);
+    }
+
+    gboolean cached = (records != NULL);
+
+    if (local_error == NULL && !cached)
+    {
+        records = bb_geda_reader_scan_records(contents, length, &local_error);
+    }
+
+    if (local_error == NULL)
+    {
+        schematic = bb_geda_reader_create_schematic(reader, records, cancellable, &local_error);
+    }
+
+    if (local_error == NULL && key != NULL && !cached)
+    {
+        GError *cache_error = NULL;
+
+        bb_geda_cache_store(cache, key, records, cancellable, &cache_error);
+
+        if (cache_error != NULL)
+        {
+            g_debug("Unable to cache: %s", cache_error->message);
+            g_clear_error(&cache_error);
+        }
+    }
+
+    /* The records point into the contents or the mapping, so must be released first */
+    if (records != NULL)
+    {
+        g_array_unref(records);
+    }
+
+    g_clear_pointer(&mapping, g_mapped_file_unref);
+    g_free(contents);
+    bb_geda_cache_key_free(key);
+    g_clear_object(&stream);
+    g_clear_object(&cache);
+
+    if (local_error != NULL)
+    {
+        g_propagate_error(error, local_error);
+    }
+
+    return schematic;
+}
+
+
 void
 bb_geda_reader_read_async(
     BbGedaReader *reader,
@@ -569,11 +1251,162 @@ bb_geda_reader_register(GTypeModule *module)
 #endif
 
 
+/**
+ * Locate the boundaries of each item in the file contents
+ *
+ * Lines are tokenized in place, so the records reference the contents and must be freed before the contents.
+ * Attribute lists are flattened, with each attribute record marked as belonging to the preceding item.
+ *
+ * @param contents The null terminated file contents, modified in place
+ * @param length The length of the file contents
+ * @param error The error, if any
+ * @return An array of BbGedaRecord in file order, or NULL on error
+ */
+static GArray*
+bb_geda_reader_scan_records(gchar *contents, gsize length, GError **error)
+{
+    gboolean attributes = FALSE;
+    gchar *cursor = contents;
+    gchar *end = contents + length;
+    gsize line_length;
+    GError *local_error = NULL;
+    BbParams *params = NULL;
+
+    GArray *records = g_array_new(FALSE, TRUE, sizeof(BbGedaRecord));
+    g_array_set_clear_func(records, (GDestroyNotify) bb_geda_record_clear);
+
+    gchar *line = bb_geda_reader_next_line(&cursor, end, &line_length);
+
+    if (line == NULL)
+    {
+        local_error = g_error_new(BB_ERROR_DOMAIN, ERROR_UNEXPECTED_EOF, "Unexpected EOF");
+    }
+    else if (line_length == 0)
+    {
+        local_error = g_error_new(BB_ERROR_DOMAIN, ERROR_UNEXPECTED_EMPTY_LINE, "Unexpected empty line");
+    }
+    else
+    {
+        params = bb_params_new_in_place(line, line_length, &local_error);
+    }
+
+    if (local_error == NULL && !bb_params_token_matches(params, VERSION_TOKEN))
+    {
+        local_error = g_error_new(
+            BB_ERROR_DOMAIN,
+            ERROR_EXPECTED_VERSION,
+            "Expected gEDA file version on first line"
+            );
+    }
+
+    g_clear_pointer(&params, bb_params_free);
+
+    while (local_error == NULL && (line = bb_geda_reader_next_line(&cursor, end, &line_length)) != NULL)
+    {
+        if (line_length == 0)
+        {
+            local_error = g_error_new(BB_ERROR_DOMAIN, ERROR_UNEXPECTED_EMPTY_LINE, "Unexpected empty line");
+        }
+        else
+        {
+            params = bb_params_new_in_place(line, line_length, &local_error);
+        }
+
+        if (local_error == NULL)
+        {
+            if (attributes && bb_params_token_matches(params, CLOSE_ATTRIBUTES_TOKEN))
+            {
+                attributes = FALSE;
+            }
+            else if (!attributes && bb_params_token_matches(params, OPEN_ATTRIBUTES_TOKEN))
+            {
+                attributes = TRUE;
+            }
+            else
+            {
+                BbGedaRecord record = { 0 };
+
+                record.attribute = attributes;
+                record.params = g_steal_pointer(&params);
+
+                int line_count = bb_geda_reader_get_line_count(record.params, &local_error);
+
+                if (local_error == NULL && line_count > 0)
+                {
+                    record.lines = g_new0(gchar*, line_count + 1);
+
+                    for (int index = 0; local_error == NULL && index < line_count; index++)
+                    {
+                        record.lines[index] = bb_geda_reader_next_line(&cursor, end, &line_length);
+
+                        if (record.lines[index] == NULL)
+                        {
+                            local_error = g_error_new(BB_ERROR_DOMAIN, ERROR_UNEXPECTED_EOF, "Unexpected EOF");
+                        }
+                    }
+                }
+
+                /* Appended even on error, so the array releases it */
+                g_array_append_val(records, record);
+            }
+        }
+
+        g_clear_pointer(&params, bb_params_free);
+    }
+
+    if (local_error == NULL && attributes)
+    {
+        local_error = g_error_new(
+            BB_ERROR_DOMAIN,
+            ERROR_UNTERMINATED_ATTRIBUTES,
+            "Unterminated attribute list"
+            );
+    }
+
+    if (local_error != NULL)
+    {
+        g_propagate_error(error, local_error);
+        g_array_unref(records);
+        records = NULL;
+    }
+
+    return records;
+}
+
+
+void
+bb_geda_reader_set_cache(BbGedaReader *reader, BbGedaCache *cache)
+{
+    g_return_if_fail(BB_IS_GEDA_READER(reader));
+
+    if (reader->cache != cache)
+    {
+        if (reader->cache != NULL)
+        {
+            g_object_unref(reader->cache);
+        }
+
+        reader->cache = cache;
+
+        if (reader->cache != NULL)
+        {
+            g_object_ref(reader->cache);
+        }
+
+        g_object_notify_by_pspec(G_OBJECT(reader), properties[PROP_CACHE]);
+    }
+}
+
+
 static void
 bb_geda_reader_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec)
 {
     switch (property_id)
     {
+        case PROP_CACHE:
+            bb_geda_reader_set_cache(BB_GEDA_READER(object), g_value_get_object(value));
+            break;
+
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
     }
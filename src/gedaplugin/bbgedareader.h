@@ -29,12 +29,135 @@
 
 #include <gtk/gtk.h>
 #include <bblibrary.h>
+#include "bbgedacache.h"
 
 
 #define BB_TYPE_GEDA_READER bb_geda_reader_get_type()
 G_DECLARE_FINAL_TYPE(BbGedaReader, bb_geda_reader, BB, GEDA_READER, GObject)
 
 
+/**
+ * Get the cache of pre-scanned files used by bb_geda_reader_read_file()
+ *
+ * @param reader A BbGedaReader
+ * @return The cache, or NULL when files are always read as text
+ */
+BbGedaCache*
+bb_geda_reader_get_cache(BbGedaReader *reader);
+
+
+/**
+ * @brief Read an entire gEDA schematic or symbol file synchronously
+ *
+ * The entire stream is read into memory and pre-scanned for record boundaries (the item line, any attribute
+ * list, and the additional lines of text and paths). Items are then created on a pool of worker threads and
+ * added to the schematic, in file order, in one operation. No signals are emitted on any object visible to
+ * other threads, so this function is safe to call from a worker thread.
+ *
+ * This function is reentrant.
+ *
+ * @param reader A BbGedaReader to perform the read operation
+ * @param stream A GInputStream to read the schematic from
+ * @param cancellable A token to cancel the operation
+ * @param error The error, if any, from reading the file
+ * @return A new BbSchematic containing the items, or NULL if an error occurred
+ */
+BbSchematic*
+bb_geda_reader_read(
+    BbGedaReader *reader,
+    GInputStream *stream,
+    GCancellable *cancellable,
+    GError **error
+    );
+
+
+/**
+ * @brief Read an entire gEDA schematic or symbol file synchronously, using the cache when possible
+ *
+ * Behaves as bb_geda_reader_read(), except the records come from the cache when the cache holds an entry
+ * matching the contents of the file. After reading the text, the records are stored in the cache for next time.
+ * Problems with the cache are never reported as errors, and only cause the text to be read.
+ *
+ * This function is reentrant.
+ *
+ * @param reader A BbGedaReader to perform the read operation
+ * @param file The file to read the schematic from
+ * @param cancellable A token to cancel the operation
+ * @param error The error, if any, from reading the file
+ * @return A new BbSchematic containing the items, or NULL if an error occurred
+ */
+BbSchematic*
+bb_geda_reader_read_file(
+    BbGedaReader *reader,
+    GFile *file,
+    GCancellable *cancellable,
+    GError **error
+    );
+
+
+/**
+ * @brief Begin loading a gEDA schematic or symbol file on a worker thread, using the cache when possible
+ *
+ * Runs bb_geda_reader_read_file() in a thread and completes once with the finished schematic. Use
+ * bb_geda_reader_load_finish() to obtain the schematic.
+ *
+ * This function is reentrant.
+ *
+ * @param reader A BbGedaReader to perform the read operation
+ * @param file The file to read the schematic from
+ * @param cancellable A token to cancel the asynchronous operation
+ * @param callback A callback function when the asynchronous operation is complete (i.e. ready)
+ * @param user_data Generic data to pass to the GAsyncReadyCallback callback
+ */
+void
+bb_geda_reader_load_file_async(
+    BbGedaReader *reader,
+    GFile *file,
+    GCancellable *cancellable,
+    GAsyncReadyCallback callback,
+    gpointer user_data
+    );
+
+
+/**
+ * @brief Begin loading a gEDA schematic or symbol file on a worker thread
+ *
+ * Runs bb_geda_reader_read() in a thread and completes once with the finished schematic.
+ *
+ * This function is reentrant.
+ *
+ * @param reader A BbGedaReader to perform the read operation
+ * @param stream A GInputStream to read the schematic from
+ * @param cancellable A token to cancel the asynchronous operation
+ * @param callback A callback function when the asynchronous operation is complete (i.e. ready)
+ * @param user_data Generic data to pass to the GAsyncReadyCallback callback
+ */
+void
+bb_geda_reader_load_async(
+    BbGedaReader *reader,
+    GInputStream *stream,
+    GCancellable *cancellable,
+    GAsyncReadyCallback callback,
+    gpointer user_data
+    );
+
+
+/**
+ * Obtain the schematic from loading a gEDA schematic or symbol file on a worker thread
+ *
+ * @param reader The BbGedaReader passed to bb_geda_reader_load_async() or bb_geda_reader_load_file_async()
+ * @param result
+ * @param error
+ * @return A new BbSchematic, or NULL if an error occurred
+ */
+BbSchematic*
+bb_geda_reader_load_finish(
+    BbGedaReader *reader,
+    GAsyncResult *result,
+    GError **error
+    );
+
+
 /**
  * @brief Begin reading a gEDA schematic or symbol file asynchronously
  *
@@ -57,6 +180,16 @@ bb_geda_reader_read_async(
     );
 
 
+/**
+ * Set the cache of pre-scanned files used by bb_geda_reader_read_file()
+ *
+ * @param reader A BbGedaReader
+ * @param cache The cache, or NULL to always read files as text
+ */
+void
+bb_geda_reader_set_cache(BbGedaReader *reader, BbGedaCache *cache);
+
+
 /**
  * Obtain results from reading a gEDA schematic or symbol file asynchronously
  *
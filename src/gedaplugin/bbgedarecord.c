@@ -1,5 +1,3 @@
-#ifndef __BBCLOSEPATH__
-#define __BBCLOSEPATH__
 /*
  * bbschem
  * Copyright (C) 2020 Edward C. Hennessy
@@ -19,19 +17,16 @@
  */
 
 #include <gtk/gtk.h>
-#include "bbpathcommand.h"
+#include "bbgedarecord.h"
 
-#define BB_TYPE_CLOSE_PATH bb_close_path_get_type()
-G_DECLARE_FINAL_TYPE(BbClosePath, bb_close_path, BB, CLOSE_PATH, BbPathCommand)
 
-struct _BbClosePathClass
+void
+bb_geda_record_clear(BbGedaRecord *record)
 {
-    BbPathCommandClass parent;
-};
+    g_return_if_fail(record != NULL);
 
-
-BbClosePath*
-bb_close_path_new();
-
-
-#endif
+    g_clear_error(&record->error);
+    g_clear_object(&record->item);
+    g_clear_pointer(&record->lines, g_free);
+    g_clear_pointer(&record->params, bb_params_free);
+}
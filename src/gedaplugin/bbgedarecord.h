@@ -0,0 +1,76 @@
+#ifndef __BBGEDARECORD__
+#define __BBGEDARECORD__
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ *
+ * A single item located within a gEDA file, before and after creating the item
+ *
+ * Records come from either pre-scanning the text of a file, or from a cached copy of an earlier pre-scan. In
+ * both cases the params and lines point into a buffer owned by the caller, which must outlive the records.
+ */
+
+#include <gtk/gtk.h>
+#include <bblibrary.h>
+
+
+typedef struct _BbGedaRecord BbGedaRecord;
+
+struct _BbGedaRecord
+{
+    /**
+     * The item is an attribute of the preceding non-attribute item
+     */
+    gboolean attribute;
+
+    /**
+     * The first line of the item
+     */
+    BbParams *params;
+
+    /**
+     * A NULL terminated array of the remaining lines, or NULL for single lines
+     *
+     * Only the array belongs to the record. The lines point into the caller's buffer.
+     */
+    gchar **lines;
+
+    /**
+     * The item created from the record, or NULL if not created or an error occurred
+     */
+    BbGedaItem *item;
+
+    /**
+     * The error from creating the item, if any
+     */
+    GError *error;
+};
+
+
+/**
+ * Release the resources held by a record, for use as the clear function of a GArray
+ *
+ * @param record A BbGedaRecord
+ */
+void
+bb_geda_record_clear(BbGedaRecord *record);
+
+
+#endif
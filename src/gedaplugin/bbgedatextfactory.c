@@ -73,6 +73,15 @@ bb_geda_text_factory_create_async(
 static void
 bb_geda_text_factory_create_ready_line(GDataInputStream *stream, GAsyncResult *result, GTask *task);
 
+static BbGedaItem*
+bb_geda_text_factory_create_with_lines(
+    BbGedaItemFactory *factory,
+    BbGedaVersion *version,
+    BbParams *params,
+    gchar **lines,
+    GError **error
+    );
+
 static void
 bb_geda_text_factory_dispose(GObject *object);
 
@@ -116,7 +125,66 @@ bb_geda_text_factory_create(
     GError **error
     )
 {
-    return BB_GEDA_ITEM(bb_geda_text_new_with_params(params, NULL, error));
+    GError *local_error = NULL;
+    BbGedaItem *item = NULL;
+
+    g_assert(BB_IS_GEDA_ITEM_FACTORY(factory));
+    g_assert(params != NULL);
+    g_assert(G_IS_DATA_INPUT_STREAM(stream));
+
+    TaskData *task_data = bb_geda_text_factory_task_data_new(params, &local_error);
+
+    if (local_error == NULL && task_data == NULL)
+    {
+        local_error = g_error_new(BB_ERROR_DOMAIN, 0, "Internal error");
+    }
+
+    while (local_error == NULL && task_data->index < task_data->line_count)
+    {
+        gchar *line = g_data_input_stream_read_line_utf8(stream, NULL, NULL, &local_error);
+
+        if (local_error == NULL && line == NULL)
+        {
+            local_error = g_error_new(BB_ERROR_DOMAIN, ERROR_UNEXPECTED_EOF, "Unexpected EOF");
+        }
+
+        if (local_error == NULL)
+        {
+            *(task_data->lines + task_data->index) = line;
+
+            task_data->index++;
+        }
+    }
+
+    if (local_error == NULL)
+    {
+        item = bb_geda_text_factory_create_with_lines(
+            factory,
+            version,
+            task_data->params,
+            task_data->lines,
+            &local_error
+            );
+    }
+
+    if (local_error == NULL && item == NULL)
+    {
+        local_error = g_error_new(
+            BB_ERROR_DOMAIN,
+            0,
+            "Internal error: " __FILE__ " line %d", __LINE__
+            );
+    }
+
+    bb_geda_text_factory_task_data_free(task_data);
+
+    if (local_error != NULL)
+    {
+        g_propagate_error(error, local_error);
+        g_clear_object(&item);
+    }
+
+    return item;
 }
 
 
@@ -207,7 +275,13 @@ bb_geda_text_factory_create_ready_line(GDataInputStream *stream, GAsyncResult *r
         }
         else
         {
-            BbGedaText *text = bb_geda_text_new_with_params(task_data->params, task_data->lines, &local_error);
+            BbGedaItem *text = bb_geda_text_factory_create_with_lines(
+                BB_GEDA_ITEM_FACTORY(g_task_get_source_object(task)),
+                NULL,
+                task_data->params,
+                task_data->lines,
+                &local_error
+                );
 
             if (local_error == NULL && text == NULL)
             {
@@ -234,6 +308,22 @@ bb_geda_text_factory_create_ready_line(GDataInputStream *stream, GAsyncResult *r
 }
 
 
+static BbGedaItem*
+bb_geda_text_factory_create_with_lines(
+    BbGedaItemFactory *factory,
+    BbGedaVersion *version,
+    BbParams *params,
+    gchar **lines,
+    GError **error
+    )
+{
+    g_return_val_if_fail(params != NULL, NULL);
+    g_return_val_if_fail(lines != NULL, NULL);
+
+    return BB_GEDA_ITEM(bb_geda_text_new_with_params(params, lines, error));
+}
+
+
 
 static void
 bb_geda_text_factory_class_init(BbGedaTextFactoryClass *klasse)
@@ -294,6 +384,7 @@ bb_geda_text_factory_item_factory_init(BbGedaItemFactoryInterface *iface)
 {
     iface->create = bb_geda_text_factory_create;
     iface->create_async = bb_geda_text_factory_create_async;
+    iface->create_with_lines = bb_geda_text_factory_create_with_lines;
 }
 
 BbGedaItemFactory*
@@ -39,6 +39,8 @@ enum
     /* From BbOpenAction */
 
     PROP_RECEIVER,
+    PROP_BUSY,
+    PROP_FRACTION,
     
     N_PROPERTIES
 };
@@ -49,17 +51,40 @@ struct _BbOpenAction
     GObject parent;
 
     BbMainWindow *window;
-};
 
+    /**
+     * The batches of files being opened, as BbOpenActionBatch
+     */
+    GSList *batches;
+};
 
-typedef struct _TaskData TaskData;
 
-struct _TaskData
+/**
+ * A batch of files being opened
+ */
+typedef struct
 {
-    GFile *file;
-    BbGeneralOpener *opener;
-    BbMainWindow *window;
-};
+    /**
+     * The action that started the batch, with a reference held for the duration of the batch
+     */
+    BbOpenAction *open_action;
+
+    /**
+     * Cancels this batch only
+     */
+    GCancellable *cancellable;
+
+    /**
+     * The number of files in the batch opened, or failed to open
+     */
+    guint completed;
+
+    /**
+     * The number of files in the batch
+     */
+    guint total;
+}
+BbOpenActionBatch;
 
 
 static void
@@ -105,10 +130,10 @@ static void
 bb_open_action_open_uris(BbOpenAction *open_action, GSList *uris);
 
 static void
-bb_open_action_open_uris_lambda(const char *uri, BbOpenAction *open_action);
+bb_open_action_open_uris_progress(guint completed, guint total, BbOpenActionBatch *batch);
 
 static void
-bb_open_action_open_uris_lambda_ready(BbGeneralOpener *opener, GAsyncResult *result, TaskData *task_data);
+bb_open_action_open_uris_ready(BbGeneralOpener *opener, GAsyncResult *result, BbOpenActionBatch *batch);
 
 static void
 bb_open_action_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
@@ -168,6 +193,20 @@ bb_open_action_activate(GAction *action, GVariant *parameter)
 }
 
 
+void
+bb_open_action_cancel(BbOpenAction *open_action)
+{
+    g_return_if_fail(BB_IS_OPEN_ACTION(open_action));
+
+    for (GSList *iter = open_action->batches; iter != NULL; iter = g_slist_next(iter))
+    {
+        BbOpenActionBatch *batch = iter->data;
+
+        g_cancellable_cancel(batch->cancellable);
+    }
+}
+
+
 static void
 bb_open_action_change_state(GAction *action, GVariant *value)
 {
@@ -231,6 +270,32 @@ bb_open_action_class_init(BbOpenActionClass *klasse)
             G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS
             )
         );
+
+    properties[PROP_BUSY] = bb_object_class_install_property(
+        object_class,
+        PROP_BUSY,
+        g_param_spec_boolean(
+            "busy",
+            "",
+            "",
+            FALSE,
+            G_PARAM_READABLE | G_PARAM_STATIC_STRINGS
+            )
+        );
+
+    properties[PROP_FRACTION] = bb_object_class_install_property(
+        object_class,
+        PROP_FRACTION,
+        g_param_spec_double(
+            "fraction",
+            "",
+            "",
+            0.0,
+            1.0,
+            0.0,
+            G_PARAM_READABLE | G_PARAM_STATIC_STRINGS
+            )
+        );
 }
 
 
@@ -262,6 +327,7 @@ bb_open_action_dispose(GObject *object)
     BbOpenAction *open_action = BB_OPEN_ACTION(object);
     g_return_if_fail(BB_IS_OPEN_ACTION(open_action));
 
+    bb_open_action_cancel(open_action);
     g_clear_object(&open_action->window);
 }
 
@@ -274,6 +340,15 @@ bb_open_action_finalize(GObject *object)
 }
 
 
+gboolean
+bb_open_action_get_busy(BbOpenAction *open_action)
+{
+    g_return_val_if_fail(BB_IS_OPEN_ACTION(open_action), FALSE);
+
+    return open_action->batches != NULL;
+}
+
+
 static gboolean
 bb_open_action_get_enabled(GAction *action)
 {
@@ -283,6 +358,26 @@ bb_open_action_get_enabled(GAction *action)
 }
 
 
+double
+bb_open_action_get_fraction(BbOpenAction *open_action)
+{
+    g_return_val_if_fail(BB_IS_OPEN_ACTION(open_action), 0.0);
+
+    guint completed = 0;
+    guint total = 0;
+
+    for (GSList *iter = open_action->batches; iter != NULL; iter = g_slist_next(iter))
+    {
+        BbOpenActionBatch *batch = iter->data;
+
+        completed += batch->completed;
+        total += batch->total;
+    }
+
+    return (total > 0) ? (double) completed / (double) total : 0.0;
+}
+
+
 static const gchar*
 bb_open_action_get_name(GAction *action)
 {
@@ -334,6 +429,14 @@ bb_open_action_get_property(GObject *object, guint property_id, GValue *value, G
             g_value_set_object(value, bb_open_action_get_window(BB_OPEN_ACTION(object)));
             break;
 
+        case PROP_BUSY:
+            g_value_set_boolean(value, bb_open_action_get_busy(BB_OPEN_ACTION(object)));
+            break;
+
+        case PROP_FRACTION:
+            g_value_set_double(value, bb_open_action_get_fraction(BB_OPEN_ACTION(object)));
+            break;
+
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
     }
@@ -394,102 +497,125 @@ bb_open_action_new(BbMainWindow *window)
 }
 
 
-static void
-bb_open_action_open_uris(BbOpenAction *open_action, GSList *uris)
-{
-    g_slist_foreach(uris, (GFunc) bb_open_action_open_uris_lambda, open_action);
-}
-
-
 /**
- * @brief Initiate identification of the content type
+ * Open a batch of files, parsing several at once on worker threads
+ *
+ * A batch already in progress continues. Each batch has its own cancellable and progress, and the properties of the
+ * action combine the batches in progress.
  *
- * @param uri
- * @param open_action
+ * @param open_action A BbOpenAction
+ * @param uris The filenames to open
  */
 static void
-bb_open_action_open_uris_lambda(const char *uri, BbOpenAction *open_action)
+bb_open_action_open_uris(BbOpenAction *open_action, GSList *uris)
 {
-    g_return_if_fail(uri != NULL);
     g_return_if_fail(BB_IS_OPEN_ACTION(open_action));
 
-    TaskData *task_data = g_new0(TaskData, 1);
+    GSList *files = NULL;
+
+    for (GSList *iter = uris; iter != NULL; iter = g_slist_next(iter))
+    {
+        // g_file_new_for_uri() gets an 'Operation not supported' error
+        files = g_slist_prepend(files, g_file_new_for_path(iter->data));
+    }
 
-    // g_file_new_for_uri() gets an 'Operation not supported' error
-    task_data->file = g_file_new_for_path(uri);
-    task_data->opener = g_object_ref(bb_main_window_get_opener(open_action->window));
-    task_data->window = g_object_ref(open_action->window);
+    files = g_slist_reverse(files);
 
-    bb_general_opener_read_content_type_async(
-        task_data->opener,
-        task_data->file,
-        NULL,
-        (GAsyncReadyCallback) bb_open_action_open_uris_lambda_ready,
-        task_data
+    BbOpenActionBatch *batch = g_slice_new0(BbOpenActionBatch);
+
+    batch->open_action = g_object_ref(open_action);
+    batch->cancellable = g_cancellable_new();
+    batch->total = g_slist_length(files);
+
+    gboolean was_busy = bb_open_action_get_busy(open_action);
+
+    open_action->batches = g_slist_prepend(open_action->batches, batch);
+
+    if (!was_busy)
+    {
+        g_object_notify_by_pspec(G_OBJECT(open_action), properties[PROP_BUSY]);
+    }
+
+    g_object_notify_by_pspec(G_OBJECT(open_action), properties[PROP_FRACTION]);
+
+    bb_general_opener_open_files_async(
+        bb_main_window_get_opener(open_action->window),
+        files,
+        0,
+        batch->cancellable,
+        (BbOpenProgressFunc) bb_open_action_open_uris_progress,
+        batch,
+        (GAsyncReadyCallback) bb_open_action_open_uris_ready,
+        batch
         );
+
+    g_slist_free_full(files, g_object_unref);
 }
 
 
 static void
-bb_open_action_open_uris_lambda_ready(BbGeneralOpener *opener, GAsyncResult *result, TaskData *task_data)
+bb_open_action_open_uris_progress(guint completed, guint total, BbOpenActionBatch *batch)
+{
+    g_return_if_fail(batch != NULL);
+    g_return_if_fail(BB_IS_OPEN_ACTION(batch->open_action));
+
+    batch->completed = completed;
+    batch->total = total;
+
+    g_object_notify_by_pspec(G_OBJECT(batch->open_action), properties[PROP_FRACTION]);
+}
+
+
+/**
+ * Report the files that could not be opened, once for the entire batch
+ *
+ * @param opener The opener of the batch
+ * @param result The result of the batch
+ * @param batch The batch, freed here
+ */
+static void
+bb_open_action_open_uris_ready(BbGeneralOpener *opener, GAsyncResult *result, BbOpenActionBatch *batch)
 {
     g_warn_if_fail(BB_IS_GENERAL_OPENER(opener));
     g_warn_if_fail(G_IS_ASYNC_RESULT(result));
-    g_warn_if_fail(task_data != NULL);
+    g_warn_if_fail(batch != NULL);
 
+    BbOpenAction *open_action = batch->open_action;
     GError *local_error = NULL;
 
-    gboolean success = bb_general_opener_read_content_type_finish(opener, result, &local_error);
+    open_action->batches = g_slist_remove(open_action->batches, batch);
 
-    if (local_error != NULL)
-    {
-        gchar *basename = g_file_get_basename(task_data->file);
+    g_object_unref(batch->cancellable);
+    g_slice_free(BbOpenActionBatch, batch);
 
-        GtkWidget *dialog = gtk_message_dialog_new_with_markup(
-            GTK_WINDOW(task_data->window),
-            GTK_DIALOG_MODAL,
-            GTK_MESSAGE_ERROR,
-            GTK_BUTTONS_OK,
-            "<b>%s</b>\n\nCannot open file: \n\n    %s",
-            local_error->message,
-            basename
-            );
+    if (open_action->batches == NULL)
+    {
+        g_object_notify_by_pspec(G_OBJECT(open_action), properties[PROP_BUSY]);
+    }
 
-        g_free(basename);
+    g_object_notify_by_pspec(G_OBJECT(open_action), properties[PROP_FRACTION]);
 
-        gtk_dialog_run(GTK_DIALOG(dialog));
+    bb_general_opener_open_files_finish(opener, result, &local_error);
 
-        gtk_widget_destroy(dialog);
-        g_clear_error(&local_error);
-    }
-    else if (!success)
+    if (local_error != NULL && !g_error_matches(local_error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
     {
-        gchar *basename = g_file_get_basename(task_data->file);
-
         GtkWidget *dialog = gtk_message_dialog_new(
-            GTK_WINDOW(task_data->window),
+            GTK_WINDOW(open_action->window),
             GTK_DIALOG_MODAL,
             GTK_MESSAGE_ERROR,
             GTK_BUTTONS_OK,
-            "<b>%s</b>\n\nCannot open file: \n\n    %s",
-            "Internal Error",
-            basename
+            "%s",
+            local_error->message
             );
 
-        g_free(basename);
-
         gtk_dialog_run(GTK_DIALOG(dialog));
 
         gtk_widget_destroy(dialog);
     }
 
-    if (task_data != NULL)
-    {
-        g_clear_object(&task_data->file);
-        g_clear_object(&task_data->opener);
-        g_clear_object(&task_data->window);
-        g_free(task_data);
-    }
+    g_clear_error(&local_error);
+
+    g_object_unref(open_action);
 }
 
 
@@ -25,6 +25,35 @@
 #define BB_TYPE_OPEN_ACTION bb_open_action_get_type()
 G_DECLARE_FINAL_TYPE(BbOpenAction, bb_open_action, BB, OPEN_ACTION, GObject)
 
+/**
+ * Cancel opening the files not yet opened, in every batch in progress
+ *
+ * @param open_action A BbOpenAction
+ */
+void
+bb_open_action_cancel(BbOpenAction *open_action);
+
+
+/**
+ * Indicates batches of files are being opened
+ *
+ * @param open_action A BbOpenAction
+ * @return TRUE if any batch is in progress
+ */
+gboolean
+bb_open_action_get_busy(BbOpenAction *open_action);
+
+
+/**
+ * Get the fraction of the files opened, over every batch in progress
+ *
+ * @param open_action A BbOpenAction
+ * @return The fraction, from 0.0 to 1.0
+ */
+double
+bb_open_action_get_fraction(BbOpenAction *open_action);
+
+
 BbMainWindow*
 bb_open_action_get_window(BbOpenAction *open_action);
 
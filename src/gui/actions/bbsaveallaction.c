@@ -48,10 +48,68 @@ struct _BbSaveAllAction
 {
     GObject parent;
 
+    /**
+     * Indicates a "save all" is in progress
+     */
+    gboolean busy;
+
     BbSaveAllReceiver *receiver;
 };
 
 
+/**
+ * A document written to a temporary file, but not yet committed
+ */
+typedef struct _BbSaveAllWrite BbSaveAllWrite;
+
+struct _BbSaveAllWrite
+{
+    /**
+     * The document, with a reference held for the duration of the batch
+     */
+    BbSaveReceiver *receiver;
+
+    /**
+     * The temporary file containing the snapshot of the document
+     */
+    GFile *temporary;
+};
+
+
+/**
+ * The state of a "save all" while the documents are written
+ */
+typedef struct _BbSaveAllBatch BbSaveAllBatch;
+
+struct _BbSaveAllBatch
+{
+    /**
+     * The action, with a reference held for the duration of the batch
+     */
+    BbSaveAllAction *action;
+
+    /**
+     * A message for each document that could not be written or committed
+     */
+    GString *failures;
+
+    /**
+     * The number of writes in progress
+     */
+    guint pending;
+
+    /**
+     * The number of documents in the batch
+     */
+    guint total;
+
+    /**
+     * The successful writes, as BbSaveAllWrite
+     */
+    GSList *writes;
+};
+
+
 static void
 bb_save_all_action_action_init(GActionInterface *iface);
 
@@ -59,7 +117,10 @@ static void
 bb_save_all_action_activate(GAction *action, GVariant *parameter);
 
 static void
-bb_save_all_action_activate_lambda(gpointer data, gpointer unused);
+bb_save_all_action_batch_complete(BbSaveAllBatch *batch);
+
+static void
+bb_save_all_action_batch_free(BbSaveAllBatch *batch);
 
 static void
 bb_save_all_action_change_state(GAction *action, GVariant *value);
@@ -91,9 +152,18 @@ bb_save_all_action_get_state_hint(GAction *action);
 static const GVariantType *
 bb_save_all_action_get_state_type(GAction *action);
 
+static void
+bb_save_all_action_set_busy(BbSaveAllAction *action, gboolean busy);
+
 static void
 bb_save_all_action_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
 
+static void
+bb_save_all_action_write_free(BbSaveAllWrite *write);
+
+static void
+bb_save_all_action_write_ready(BbSaveReceiver *receiver, GAsyncResult *result, BbSaveAllBatch *batch);
+
 
 static GParamSpec *properties[N_PROPERTIES];
 
@@ -120,41 +190,149 @@ bb_save_all_action_action_init(GActionInterface *iface)
 }
 
 
+/**
+ * Write every savable document concurrently, then commit them together
+ *
+ * Each document writes a snapshot to a temporary file on a worker thread. Only when every write succeeds are the
+ * documents replaced with the temporary files. Otherwise, the temporary files are discarded and the documents
+ * remain unchanged.
+ *
+ * @param action A BbSaveAllAction
+ * @param parameter Unused
+ */
 static void
 bb_save_all_action_activate(GAction *action, GVariant *parameter)
 {
-    g_return_if_fail(BB_IS_SAVE_ALL_ACTION(action));
+    BbSaveAllAction *save_all_action = BB_SAVE_ALL_ACTION(action);
+    g_return_if_fail(save_all_action != NULL);
+    g_return_if_fail(save_all_action->receiver != NULL);
 
-    g_message("saveall activate");
+    if (save_all_action->busy)
+    {
+        return;
+    }
 
-    GSList *list = NULL;
+    GSList *receivers = bb_save_all_receiver_get_save_receivers(save_all_action->receiver);
 
-    g_slist_foreach(
-        list,
-        bb_save_all_action_activate_lambda,
-        NULL
-        );
+    BbSaveAllBatch *batch = g_slice_new(BbSaveAllBatch);
 
-    g_slist_free(list);
+    batch->action = g_object_ref(save_all_action);
+    batch->failures = g_string_new(NULL);
+    batch->pending = 0;
+    batch->total = 0;
+    batch->writes = NULL;
+
+    bb_save_all_action_set_busy(save_all_action, TRUE);
+
+    /* Count every write before starting any, in case one completes immediately */
+
+    for (GSList *iter = receivers; iter != NULL; iter = g_slist_next(iter))
+    {
+        if (bb_save_receiver_get_can_save(BB_SAVE_RECEIVER(iter->data)))
+        {
+            batch->pending++;
+        }
+    }
+
+    batch->total = batch->pending;
+
+    if (batch->pending == 0)
+    {
+        bb_save_all_action_batch_complete(batch);
+    }
+    else
+    {
+        for (GSList *iter = receivers; iter != NULL; iter = g_slist_next(iter))
+        {
+            BbSaveReceiver *receiver = BB_SAVE_RECEIVER(iter->data);
+
+            if (bb_save_receiver_get_can_save(receiver))
+            {
+                bb_save_receiver_write_async(
+                    receiver,
+                    NULL,
+                    (GAsyncReadyCallback) bb_save_all_action_write_ready,
+                    batch
+                    );
+            }
+        }
+    }
+
+    g_slist_free_full(receivers, g_object_unref);
 }
 
 
+/**
+ * Commit the documents once every write has completed, and report the failures
+ *
+ * @param batch The batch, which is freed
+ */
 static void
-bb_save_all_action_activate_lambda(gpointer data, gpointer unused)
+bb_save_all_action_batch_complete(BbSaveAllBatch *batch)
 {
-    if (BB_IS_SAVE_RECEIVER(data))
+    g_return_if_fail(batch != NULL);
+    g_return_if_fail(batch->pending == 0);
+
+    gboolean written = (batch->failures->len == 0);
+
+    batch->writes = g_slist_reverse(batch->writes);
+
+    for (GSList *iter = batch->writes; iter != NULL; iter = g_slist_next(iter))
     {
-        BbSaveReceiver *receiver = BB_SAVE_RECEIVER(data);
+        BbSaveAllWrite *write = iter->data;
 
-        if (receiver != NULL)
+        if (!written)
         {
-            GError *error = NULL;
+            /* A write failed, so leave every document unchanged */
 
-            bb_save_receiver_save(receiver, &error);
+            g_file_delete(write->temporary, NULL, NULL);
+        }
+        else
+        {
+            GError *local_error = NULL;
 
-            g_clear_error(&error);
+            if (!bb_save_receiver_commit(write->receiver, write->temporary, &local_error))
+            {
+                g_string_append_printf(batch->failures, "\n%s", local_error->message);
+                g_clear_error(&local_error);
+            }
         }
     }
+
+    if (batch->failures->len > 0)
+    {
+        BbSaveAllReceiver *receiver = batch->action->receiver;
+
+        GtkWidget *dialog = gtk_message_dialog_new(
+            GTK_IS_WINDOW(receiver) ? GTK_WINDOW(receiver) : NULL,
+            GTK_DIALOG_MODAL,
+            GTK_MESSAGE_ERROR,
+            GTK_BUTTONS_OK,
+            "Unable to save all %u documents:%s",
+            batch->total,
+            batch->failures->str
+            );
+
+        gtk_dialog_run(GTK_DIALOG(dialog));
+
+        gtk_widget_destroy(dialog);
+    }
+
+    bb_save_all_action_set_busy(batch->action, FALSE);
+    bb_save_all_action_batch_free(batch);
+}
+
+
+static void
+bb_save_all_action_batch_free(BbSaveAllBatch *batch)
+{
+    if (batch != NULL)
+    {
+        g_clear_object(&batch->action);
+        g_string_free(batch->failures, TRUE);
+        g_slist_free_full(batch->writes, (GDestroyNotify) bb_save_all_action_write_free);
+        g_slice_free(BbSaveAllBatch, batch);
+    }
 }
 
 
@@ -239,10 +417,16 @@ bb_save_all_action_finalize(GObject *object)
 static gboolean
 bb_save_all_action_get_enabled(GAction *action)
 {
-    g_return_val_if_fail(action != NULL, FALSE);
+    BbSaveAllAction *save_all_action = BB_SAVE_ALL_ACTION(action);
+    g_return_val_if_fail(save_all_action != NULL, FALSE);
+
+    if (save_all_action->busy || save_all_action->receiver == NULL)
+    {
+        return FALSE;
+    }
 
     gboolean enabled = FALSE;
-    GSList *list = NULL;
+    GSList *list = bb_save_all_receiver_get_save_receivers(save_all_action->receiver);
 
     for (GSList *iter = list; iter != NULL && !enabled; iter = iter->next)
     {
@@ -257,6 +441,8 @@ bb_save_all_action_get_enabled(GAction *action)
         }
     }
 
+    g_slist_free_full(list, g_object_unref);
+
     return enabled;
 }
 
@@ -357,6 +543,7 @@ bb_save_all_action_get_state_type(GAction *action)
 static void
 bb_save_all_action_init(BbSaveAllAction *action)
 {
+    action->busy = FALSE;
     action->receiver = NULL;
 }
 
@@ -372,6 +559,20 @@ bb_save_all_action_new(BbSaveAllReceiver *receiver)
 }
 
 
+static void
+bb_save_all_action_set_busy(BbSaveAllAction *action, gboolean busy)
+{
+    g_return_if_fail(action != NULL);
+
+    if (action->busy != busy)
+    {
+        action->busy = busy;
+
+        g_object_notify_by_pspec(G_OBJECT(action), properties[PROP_ENABLED]);
+    }
+}
+
+
 static void
 bb_save_all_action_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec)
 {
@@ -409,3 +610,55 @@ bb_save_all_action_set_receiver(BbSaveAllAction *action, BbSaveAllReceiver *rece
         g_object_notify_by_pspec(G_OBJECT(action), properties[PROP_RECEIVER]);
     }
 }
+
+
+static void
+bb_save_all_action_write_free(BbSaveAllWrite *write)
+{
+    if (write != NULL)
+    {
+        g_clear_object(&write->receiver);
+        g_clear_object(&write->temporary);
+        g_slice_free(BbSaveAllWrite, write);
+    }
+}
+
+
+/**
+ * Record the result of writing one document, and complete the batch after the last write
+ *
+ * @param receiver The document that was written
+ * @param result The result of the write
+ * @param batch The batch containing the write
+ */
+static void
+bb_save_all_action_write_ready(BbSaveReceiver *receiver, GAsyncResult *result, BbSaveAllBatch *batch)
+{
+    g_return_if_fail(BB_IS_SAVE_RECEIVER(receiver));
+    g_return_if_fail(batch != NULL);
+    g_return_if_fail(batch->pending > 0);
+
+    GError *local_error = NULL;
+
+    GFile *temporary = bb_save_receiver_write_finish(receiver, result, &local_error);
+
+    if (temporary != NULL)
+    {
+        BbSaveAllWrite *write = g_slice_new(BbSaveAllWrite);
+
+        write->receiver = g_object_ref(receiver);
+        write->temporary = temporary;
+
+        batch->writes = g_slist_prepend(batch->writes, write);
+    }
+    else
+    {
+        g_string_append_printf(batch->failures, "\n%s", local_error->message);
+        g_clear_error(&local_error);
+    }
+
+    if (--batch->pending == 0)
+    {
+        bb_save_all_action_batch_complete(batch);
+    }
+}
@@ -23,6 +23,9 @@
 static gboolean
 bb_save_all_receiver_get_save_all_missing(BbSaveAllReceiver *save_all_receiver);
 
+static GSList*
+bb_save_all_receiver_get_save_receivers_missing(BbSaveAllReceiver *save_all_receiver);
+
 void
 bb_save_all_receiver_set_save_all_missing(BbSaveAllReceiver *save_all_receiver, gboolean save_all);
 
@@ -39,6 +42,8 @@ bb_save_all_receiver_default_init(BbSaveAllReceiverInterface *iface)
 {
     g_return_if_fail(iface != NULL);
 
+    iface->get_save_receivers = bb_save_all_receiver_get_save_receivers_missing;
+
     g_object_interface_install_property(
         iface,
         g_param_spec_boolean(
@@ -50,3 +55,24 @@ bb_save_all_receiver_default_init(BbSaveAllReceiverInterface *iface)
             )
         );
 }
+
+
+GSList*
+bb_save_all_receiver_get_save_receivers(BbSaveAllReceiver *save_all_receiver)
+{
+    g_return_val_if_fail(BB_IS_SAVE_ALL_RECEIVER(save_all_receiver), NULL);
+
+    BbSaveAllReceiverInterface *iface = BB_SAVE_ALL_RECEIVER_GET_IFACE(save_all_receiver);
+
+    g_return_val_if_fail(iface != NULL, NULL);
+    g_return_val_if_fail(iface->get_save_receivers != NULL, NULL);
+
+    return iface->get_save_receivers(save_all_receiver);
+}
+
+
+static GSList*
+bb_save_all_receiver_get_save_receivers_missing(BbSaveAllReceiver *save_all_receiver)
+{
+    g_error("bb_save_all_receiver_get_save_receivers() not overridden");
+}
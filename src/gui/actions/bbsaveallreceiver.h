@@ -26,6 +26,20 @@ G_DECLARE_INTERFACE(BbSaveAllReceiver, bb_save_all_receiver, BB, SAVE_ALL_RECEIV
 struct _BbSaveAllReceiverInterface
 {
     GTypeInterface g_iface;
+
+    GSList* (*get_save_receivers)(BbSaveAllReceiver *save_all_receiver);
 };
 
+
+/**
+ * Get the documents saved by "save all"
+ *
+ * Free the list with g_slist_free_full() and g_object_unref().
+ *
+ * @param save_all_receiver A BbSaveAllReceiver
+ * @return A list of BbSaveReceiver, with a reference to each
+ */
+GSList*
+bb_save_all_receiver_get_save_receivers(BbSaveAllReceiver *save_all_receiver);
+
 #endif
@@ -20,6 +20,9 @@
 #include "bbsavereceiver.h"
 
 
+static gboolean
+bb_save_receiver_commit_missing(BbSaveReceiver *save_receiver, GFile *temporary, GError **error);
+
 static gboolean
 bb_save_receiver_get_can_save_missing(BbSaveReceiver *save_receiver);
 
@@ -32,6 +35,17 @@ bb_save_receiver_save_missing(BbSaveReceiver *save_receiver, GError **error);
 static void
 bb_save_receiver_save_as_missing(BbSaveReceiver *save_receiver, GError **error);
 
+static void
+bb_save_receiver_write_async_missing(
+    BbSaveReceiver *save_receiver,
+    GCancellable *cancellable,
+    GAsyncReadyCallback callback,
+    gpointer user_data
+    );
+
+static GFile*
+bb_save_receiver_write_finish_missing(BbSaveReceiver *save_receiver, GAsyncResult *result, GError **error);
+
 
 G_DEFINE_INTERFACE(
     BbSaveReceiver,
@@ -45,10 +59,13 @@ bb_save_receiver_default_init(BbSaveReceiverInterface *iface)
 {
     g_return_if_fail(iface != NULL);
 
+    iface->commit = bb_save_receiver_commit_missing;
     iface->get_can_save = bb_save_receiver_get_can_save_missing;
     iface->get_can_save_as = bb_save_receiver_get_can_save_as_missing;
     iface->save = bb_save_receiver_save_missing;
     iface->save_as = bb_save_receiver_save_as_missing;
+    iface->write_async = bb_save_receiver_write_async_missing;
+    iface->write_finish = bb_save_receiver_write_finish_missing;
 
     g_object_interface_install_property(
         iface,
@@ -74,6 +91,28 @@ bb_save_receiver_default_init(BbSaveReceiverInterface *iface)
 }
 
 
+gboolean
+bb_save_receiver_commit(BbSaveReceiver *save_receiver, GFile *temporary, GError **error)
+{
+    g_return_val_if_fail(BB_IS_SAVE_RECEIVER(save_receiver), FALSE);
+    g_return_val_if_fail(G_IS_FILE(temporary), FALSE);
+
+    BbSaveReceiverInterface *iface = BB_SAVE_RECEIVER_GET_IFACE(save_receiver);
+
+    g_return_val_if_fail(iface != NULL, FALSE);
+    g_return_val_if_fail(iface->commit != NULL, FALSE);
+
+    return iface->commit(save_receiver, temporary, error);
+}
+
+
+static gboolean
+bb_save_receiver_commit_missing(BbSaveReceiver *save_receiver, GFile *temporary, GError **error)
+{
+    g_error("bb_save_receiver_commit() not overridden");
+}
+
+
 gboolean
 bb_save_receiver_get_can_save(BbSaveReceiver *save_receiver)
 {
@@ -116,6 +155,71 @@ bb_save_receiver_get_can_save_as_missing(BbSaveReceiver *save_receiver)
 }
 
 
+GFile*
+bb_save_receiver_get_temporary_file(GFile *file)
+{
+    g_return_val_if_fail(G_IS_FILE(file), NULL);
+
+    GFile *parent = g_file_get_parent(file);
+    g_return_val_if_fail(parent != NULL, NULL);
+
+    gchar *basename = g_file_get_basename(file);
+    gchar *name = g_strdup_printf(".%s.bbsave", basename);
+
+    GFile *temporary = g_file_get_child(parent, name);
+
+    g_free(name);
+    g_free(basename);
+    g_object_unref(parent);
+
+    return temporary;
+}
+
+
+gboolean
+bb_save_receiver_replace_file(GFile *temporary, GFile *file, GError **error)
+{
+    g_return_val_if_fail(G_IS_FILE(temporary), FALSE);
+    g_return_val_if_fail(G_IS_FILE(file), FALSE);
+
+    GFile *parent = g_file_get_parent(file);
+    g_return_val_if_fail(parent != NULL, FALSE);
+
+    gchar *basename = g_file_get_basename(file);
+    gchar *name = g_strdup_printf("%s~", basename);
+
+    GFile *backup = g_file_get_child(parent, name);
+    GError *local_error = NULL;
+
+    /* Copy, rather than rename, so the document never goes missing. A new document has nothing to back up. */
+
+    g_file_copy(file, backup, G_FILE_COPY_OVERWRITE, NULL, NULL, NULL, &local_error);
+
+    if (g_error_matches(local_error, G_IO_ERROR, G_IO_ERROR_NOT_FOUND))
+    {
+        g_clear_error(&local_error);
+    }
+
+    if (local_error == NULL)
+    {
+        g_file_move(temporary, file, G_FILE_COPY_OVERWRITE, NULL, NULL, NULL, &local_error);
+    }
+
+    g_object_unref(backup);
+    g_free(name);
+    g_free(basename);
+    g_object_unref(parent);
+
+    if (local_error != NULL)
+    {
+        g_propagate_error(error, local_error);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+
 void
 bb_save_receiver_save(BbSaveReceiver *save_receiver, GError **error)
 {
@@ -156,3 +260,55 @@ bb_save_receiver_save_as_missing(BbSaveReceiver *save_receiver, GError **error)
 {
     g_error("bb_save_receiver_save_as() not overridden");
 }
+
+
+void
+bb_save_receiver_write_async(
+    BbSaveReceiver *save_receiver,
+    GCancellable *cancellable,
+    GAsyncReadyCallback callback,
+    gpointer user_data
+    )
+{
+    g_return_if_fail(BB_IS_SAVE_RECEIVER(save_receiver));
+
+    BbSaveReceiverInterface *iface = BB_SAVE_RECEIVER_GET_IFACE(save_receiver);
+
+    g_return_if_fail(iface != NULL);
+    g_return_if_fail(iface->write_async != NULL);
+
+    iface->write_async(save_receiver, cancellable, callback, user_data);
+}
+
+
+static void
+bb_save_receiver_write_async_missing(
+    BbSaveReceiver *save_receiver,
+    GCancellable *cancellable,
+    GAsyncReadyCallback callback,
+    gpointer user_data
+    )
+{
+    g_error("bb_save_receiver_write_async() not overridden");
+}
+
+
+GFile*
+bb_save_receiver_write_finish(BbSaveReceiver *save_receiver, GAsyncResult *result, GError **error)
+{
+    g_return_val_if_fail(BB_IS_SAVE_RECEIVER(save_receiver), NULL);
+
+    BbSaveReceiverInterface *iface = BB_SAVE_RECEIVER_GET_IFACE(save_receiver);
+
+    g_return_val_if_fail(iface != NULL, NULL);
+    g_return_val_if_fail(iface->write_finish != NULL, NULL);
+
+    return iface->write_finish(save_receiver, result, error);
+}
+
+
+static GFile*
+bb_save_receiver_write_finish_missing(BbSaveReceiver *save_receiver, GAsyncResult *result, GError **error)
+{
+    g_error("bb_save_receiver_write_finish() not overridden");
+}
@@ -18,7 +18,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <glib-object.h>
+#include <gio/gio.h>
 
 #define BB_TYPE_SAVE_RECEIVER bb_save_receiver_get_type()
 G_DECLARE_INTERFACE(BbSaveReceiver, bb_save_receiver, BB, SAVE_RECEIVER, GObject)
@@ -31,9 +31,32 @@ struct _BbSaveReceiverInterface
     gboolean (*get_can_save_as)(BbSaveReceiver *save_receiver);
     void (*save)(BbSaveReceiver *save_receiver, GError **error);
     void (*save_as)(BbSaveReceiver *save_receiver, GError **error);
+
+    void (*write_async)(
+        BbSaveReceiver *save_receiver,
+        GCancellable *cancellable,
+        GAsyncReadyCallback callback,
+        gpointer user_data
+        );
+
+    GFile* (*write_finish)(BbSaveReceiver *save_receiver, GAsyncResult *result, GError **error);
+
+    gboolean (*commit)(BbSaveReceiver *save_receiver, GFile *temporary, GError **error);
 };
 
 
+/**
+ * Replace the underlying document with the contents written by bb_save_receiver_write_async()
+ *
+ * @param save_receiver A BbSaveReceiver
+ * @param temporary The temporary file returned by bb_save_receiver_write_finish()
+ * @param error An optional location to store an error
+ * @return TRUE on success, FALSE on failure
+ */
+gboolean
+bb_save_receiver_commit(BbSaveReceiver *save_receiver, GFile *temporary, GError **error);
+
+
 /**
  * Indicates the underlying document can be saved
  *
@@ -54,10 +77,42 @@ gboolean
 bb_save_receiver_get_can_save_as(BbSaveReceiver *save_receiver);
 
 
+/**
+ * Get the temporary file used to write a document before replacing it
+ *
+ * The temporary file is a hidden sibling of the document, so replacing the document is a rename within the same
+ * directory.
+ *
+ * @param file The document
+ * @return The temporary file
+ */
+GFile*
+bb_save_receiver_get_temporary_file(GFile *file);
+
+
+/**
+ * Replace a document with a temporary file from bb_save_receiver_get_temporary_file()
+ *
+ * The existing document is first copied to a backup with a trailing tilde. The temporary file then moves over the
+ * document with a single rename, so readers see either the old or the new contents.
+ *
+ * @param temporary The temporary file containing the new contents
+ * @param file The document to replace
+ * @param error An optional location to store an error
+ * @return TRUE on success, FALSE on failure
+ */
+gboolean
+bb_save_receiver_replace_file(GFile *temporary, GFile *file, GError **error);
+
+
 /**
  * Save the underlying document
  *
+ * Implementations that save in the background report failures to the user when the save completes, and never set
+ * the error.
+ *
  * @param save_receiver A BbSaveReceiver
+ * @param error An optional location to store an error
  */
 void
 bb_save_receiver_save(BbSaveReceiver *save_receiver, GError **error);
@@ -72,4 +127,36 @@ void
 bb_save_receiver_save_as(BbSaveReceiver *save_receiver, GError **error);
 
 
+/**
+ * Begin writing a snapshot of the underlying document to a temporary file, on a worker thread
+ *
+ * The document itself is unchanged until bb_save_receiver_commit(). Together, these allow saving several
+ * documents concurrently, then replacing them only after every write succeeds.
+ *
+ * @param save_receiver A BbSaveReceiver
+ * @param cancellable An optional cancellable object
+ * @param callback A callback function when the write completes
+ * @param user_data User data to pass to the callback function
+ */
+void
+bb_save_receiver_write_async(
+    BbSaveReceiver *save_receiver,
+    GCancellable *cancellable,
+    GAsyncReadyCallback callback,
+    gpointer user_data
+    );
+
+
+/**
+ * Complete writing a snapshot of the underlying document
+ *
+ * @param save_receiver A BbSaveReceiver
+ * @param result The result passed to the callback
+ * @param error An optional location to store an error
+ * @return The temporary file containing the snapshot, or NULL on failure. Delete the file to discard it.
+ */
+GFile*
+bb_save_receiver_write_finish(BbSaveReceiver *save_receiver, GAsyncResult *result, GError **error);
+
+
 #endif
@@ -0,0 +1,377 @@
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtk/gtk.h>
+#include <bbextensions.h>
+#include "bbdetailpolicy.h"
+
+
+enum
+{
+    PROP_0,
+    PROP_COLLAPSED,
+    PROP_DETAIL_THRESHOLD,
+    PROP_GREEK_THRESHOLD,
+    PROP_GREEKED,
+    PROP_POINT_THRESHOLD,
+    PROP_SKIPPED,
+    N_PROPERTIES
+};
+
+
+struct _BbDetailPolicy
+{
+    GObject parent;
+
+    double detail_threshold;
+    double greek_threshold;
+    double point_threshold;
+
+    guint64 collapsed;
+    guint64 greeked;
+    guint64 skipped;
+};
+
+
+G_DEFINE_TYPE(BbDetailPolicy, bb_detail_policy, G_TYPE_OBJECT)
+
+
+static void
+bb_detail_policy_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
+
+static void
+bb_detail_policy_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
+
+
+static GParamSpec *properties[N_PROPERTIES];
+
+
+static void
+bb_detail_policy_class_init(BbDetailPolicyClass *klasse)
+{
+    GObjectClass *object_class = G_OBJECT_CLASS(klasse);
+    g_return_if_fail(object_class != NULL);
+
+    object_class->get_property = bb_detail_policy_get_property;
+    object_class->set_property = bb_detail_policy_set_property;
+
+    properties[PROP_COLLAPSED] = bb_object_class_install_property(
+        object_class,
+        PROP_COLLAPSED,
+        g_param_spec_uint64(
+            "collapsed",
+            "",
+            "",
+            0,
+            G_MAXUINT64,
+            0,
+            G_PARAM_READABLE
+            )
+        );
+
+    properties[PROP_DETAIL_THRESHOLD] = bb_object_class_install_property(
+        object_class,
+        PROP_DETAIL_THRESHOLD,
+        g_param_spec_double(
+            "detail-threshold",
+            "",
+            "",
+            0.0,
+            G_MAXDOUBLE,
+            BB_DETAIL_POLICY_DEFAULT_DETAIL_THRESHOLD,
+            G_PARAM_READWRITE
+            )
+        );
+
+    properties[PROP_GREEK_THRESHOLD] = bb_object_class_install_property(
+        object_class,
+        PROP_GREEK_THRESHOLD,
+        g_param_spec_double(
+            "greek-threshold",
+            "",
+            "",
+            0.0,
+            G_MAXDOUBLE,
+            BB_DETAIL_POLICY_DEFAULT_GREEK_THRESHOLD,
+            G_PARAM_READWRITE
+            )
+        );
+
+    properties[PROP_GREEKED] = bb_object_class_install_property(
+        object_class,
+        PROP_GREEKED,
+        g_param_spec_uint64(
+            "greeked",
+            "",
+            "",
+            0,
+            G_MAXUINT64,
+            0,
+            G_PARAM_READABLE
+            )
+        );
+
+    properties[PROP_POINT_THRESHOLD] = bb_object_class_install_property(
+        object_class,
+        PROP_POINT_THRESHOLD,
+        g_param_spec_double(
+            "point-threshold",
+            "",
+            "",
+            0.0,
+            G_MAXDOUBLE,
+            BB_DETAIL_POLICY_DEFAULT_POINT_THRESHOLD,
+            G_PARAM_READWRITE
+            )
+        );
+
+    properties[PROP_SKIPPED] = bb_object_class_install_property(
+        object_class,
+        PROP_SKIPPED,
+        g_param_spec_uint64(
+            "skipped",
+            "",
+            "",
+            0,
+            G_MAXUINT64,
+            0,
+            G_PARAM_READABLE
+            )
+        );
+}
+
+
+gboolean
+bb_detail_policy_collapse_item(BbDetailPolicy *policy, double size)
+{
+    g_return_val_if_fail(BB_IS_DETAIL_POLICY(policy), FALSE);
+
+    gboolean collapse = size < policy->point_threshold;
+
+    if (collapse)
+    {
+        policy->collapsed++;
+    }
+
+    return collapse;
+}
+
+
+guint64
+bb_detail_policy_get_collapsed(BbDetailPolicy *policy)
+{
+    g_return_val_if_fail(BB_IS_DETAIL_POLICY(policy), 0);
+
+    return policy->collapsed;
+}
+
+
+double
+bb_detail_policy_get_detail_threshold(BbDetailPolicy *policy)
+{
+    g_return_val_if_fail(BB_IS_DETAIL_POLICY(policy), 0.0);
+
+    return policy->detail_threshold;
+}
+
+
+double
+bb_detail_policy_get_greek_threshold(BbDetailPolicy *policy)
+{
+    g_return_val_if_fail(BB_IS_DETAIL_POLICY(policy), 0.0);
+
+    return policy->greek_threshold;
+}
+
+
+guint64
+bb_detail_policy_get_greeked(BbDetailPolicy *policy)
+{
+    g_return_val_if_fail(BB_IS_DETAIL_POLICY(policy), 0);
+
+    return policy->greeked;
+}
+
+
+double
+bb_detail_policy_get_point_threshold(BbDetailPolicy *policy)
+{
+    g_return_val_if_fail(BB_IS_DETAIL_POLICY(policy), 0.0);
+
+    return policy->point_threshold;
+}
+
+
+static void
+bb_detail_policy_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec)
+{
+    switch (property_id)
+    {
+        case PROP_COLLAPSED:
+            g_value_set_uint64(value, bb_detail_policy_get_collapsed(BB_DETAIL_POLICY(object)));
+            break;
+
+        case PROP_DETAIL_THRESHOLD:
+            g_value_set_double(value, bb_detail_policy_get_detail_threshold(BB_DETAIL_POLICY(object)));
+            break;
+
+        case PROP_GREEK_THRESHOLD:
+            g_value_set_double(value, bb_detail_policy_get_greek_threshold(BB_DETAIL_POLICY(object)));
+            break;
+
+        case PROP_GREEKED:
+            g_value_set_uint64(value, bb_detail_policy_get_greeked(BB_DETAIL_POLICY(object)));
+            break;
+
+        case PROP_POINT_THRESHOLD:
+            g_value_set_double(value, bb_detail_policy_get_point_threshold(BB_DETAIL_POLICY(object)));
+            break;
+
+        case PROP_SKIPPED:
+            g_value_set_uint64(value, bb_detail_policy_get_skipped(BB_DETAIL_POLICY(object)));
+            break;
+
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+    }
+}
+
+
+guint64
+bb_detail_policy_get_skipped(BbDetailPolicy *policy)
+{
+    g_return_val_if_fail(BB_IS_DETAIL_POLICY(policy), 0);
+
+    return policy->skipped;
+}
+
+
+gboolean
+bb_detail_policy_greek_text(BbDetailPolicy *policy, double em)
+{
+    g_return_val_if_fail(BB_IS_DETAIL_POLICY(policy), FALSE);
+
+    gboolean greek = em < policy->greek_threshold;
+
+    if (greek)
+    {
+        policy->greeked++;
+    }
+
+    return greek;
+}
+
+
+static void
+bb_detail_policy_init(BbDetailPolicy *policy)
+{
+    g_return_if_fail(BB_IS_DETAIL_POLICY(policy));
+
+    policy->detail_threshold = BB_DETAIL_POLICY_DEFAULT_DETAIL_THRESHOLD;
+    policy->greek_threshold = BB_DETAIL_POLICY_DEFAULT_GREEK_THRESHOLD;
+    policy->point_threshold = BB_DETAIL_POLICY_DEFAULT_POINT_THRESHOLD;
+}
+
+
+BbDetailPolicy*
+bb_detail_policy_new(void)
+{
+    return BB_DETAIL_POLICY(g_object_new(BB_TYPE_DETAIL_POLICY, NULL));
+}
+
+
+void
+bb_detail_policy_set_detail_threshold(BbDetailPolicy *policy, double threshold)
+{
+    g_return_if_fail(BB_IS_DETAIL_POLICY(policy));
+
+    if (policy->detail_threshold != threshold)
+    {
+        policy->detail_threshold = threshold;
+
+        g_object_notify_by_pspec(G_OBJECT(policy), properties[PROP_DETAIL_THRESHOLD]);
+    }
+}
+
+
+void
+bb_detail_policy_set_greek_threshold(BbDetailPolicy *policy, double threshold)
+{
+    g_return_if_fail(BB_IS_DETAIL_POLICY(policy));
+
+    if (policy->greek_threshold != threshold)
+    {
+        policy->greek_threshold = threshold;
+
+        g_object_notify_by_pspec(G_OBJECT(policy), properties[PROP_GREEK_THRESHOLD]);
+    }
+}
+
+
+void
+bb_detail_policy_set_point_threshold(BbDetailPolicy *policy, double threshold)
+{
+    g_return_if_fail(BB_IS_DETAIL_POLICY(policy));
+
+    if (policy->point_threshold != threshold)
+    {
+        policy->point_threshold = threshold;
+
+        g_object_notify_by_pspec(G_OBJECT(policy), properties[PROP_POINT_THRESHOLD]);
+    }
+}
+
+
+static void
+bb_detail_policy_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec)
+{
+    switch (property_id)
+    {
+        case PROP_DETAIL_THRESHOLD:
+            bb_detail_policy_set_detail_threshold(BB_DETAIL_POLICY(object), g_value_get_double(value));
+            break;
+
+        case PROP_GREEK_THRESHOLD:
+            bb_detail_policy_set_greek_threshold(BB_DETAIL_POLICY(object), g_value_get_double(value));
+            break;
+
+        case PROP_POINT_THRESHOLD:
+            bb_detail_policy_set_point_threshold(BB_DETAIL_POLICY(object), g_value_get_double(value));
+            break;
+
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+    }
+}
+
+
+gboolean
+bb_detail_policy_skip_detail(BbDetailPolicy *policy, double size)
+{
+    g_return_val_if_fail(BB_IS_DETAIL_POLICY(policy), FALSE);
+
+    gboolean skip = size < policy->detail_threshold;
+
+    if (skip)
+    {
+        policy->skipped++;
+    }
+
+    return skip;
+}
@@ -0,0 +1,189 @@
+#ifndef __BBDETAILPOLICY__
+#define __BBDETAILPOLICY__
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file bbdetailpolicy.h
+ *
+ * Thresholds for simplifying features too small to be legible at the current zoom
+ *
+ * Each feature is measured in device pixels, using the current transform. Text smaller than the greek threshold is
+ * drawn as boxes in place of the glyphs, which avoids shaping the text. Hatches and insertion points smaller than
+ * the detail threshold are skipped. Items smaller than the point threshold collapse to a single point.
+ *
+ * The policy also counts the simplified features, for debugging.
+ */
+
+#include <gtk/gtk.h>
+
+
+/**
+ * The default height of an em, in pixels, below which text is drawn as boxes
+ */
+#define BB_DETAIL_POLICY_DEFAULT_GREEK_THRESHOLD (5.0)
+
+
+/**
+ * The default size, in pixels, below which hatches and insertion points are skipped
+ */
+#define BB_DETAIL_POLICY_DEFAULT_DETAIL_THRESHOLD (3.0)
+
+
+/**
+ * The default size, in pixels, below which items collapse to a point
+ */
+#define BB_DETAIL_POLICY_DEFAULT_POINT_THRESHOLD (1.0)
+
+
+#define BB_TYPE_DETAIL_POLICY bb_detail_policy_get_type()
+G_DECLARE_FINAL_TYPE(BbDetailPolicy, bb_detail_policy, BB, DETAIL_POLICY, GObject)
+
+
+/**
+ * Check if an item collapses to a point
+ *
+ * @param policy A detail policy
+ * @param size The larger dimension of the item, in pixels
+ * @return TRUE if the item is drawn as a point
+ */
+gboolean
+bb_detail_policy_collapse_item(BbDetailPolicy *policy, double size);
+
+
+/**
+ * Get the number of items collapsed to a point
+ *
+ * @param policy A detail policy
+ * @return The number of items since creation
+ */
+guint64
+bb_detail_policy_get_collapsed(BbDetailPolicy *policy);
+
+
+/**
+ * Get the size below which hatches and insertion points are skipped
+ *
+ * @param policy A detail policy
+ * @return The threshold, in pixels
+ */
+double
+bb_detail_policy_get_detail_threshold(BbDetailPolicy *policy);
+
+
+/**
+ * Get the height of an em below which text is drawn as boxes
+ *
+ * @param policy A detail policy
+ * @return The threshold, in pixels
+ */
+double
+bb_detail_policy_get_greek_threshold(BbDetailPolicy *policy);
+
+
+/**
+ * Get the number of texts drawn as boxes
+ *
+ * @param policy A detail policy
+ * @return The number of texts since creation
+ */
+guint64
+bb_detail_policy_get_greeked(BbDetailPolicy *policy);
+
+
+/**
+ * Get the size below which items collapse to a point
+ *
+ * @param policy A detail policy
+ * @return The threshold, in pixels
+ */
+double
+bb_detail_policy_get_point_threshold(BbDetailPolicy *policy);
+
+
+/**
+ * Get the number of hatches and insertion points skipped
+ *
+ * @param policy A detail policy
+ * @return The number of details since creation
+ */
+guint64
+bb_detail_policy_get_skipped(BbDetailPolicy *policy);
+
+
+/**
+ * Check if text is drawn as boxes
+ *
+ * @param policy A detail policy
+ * @param em The height of an em, in pixels
+ * @return TRUE if the text is drawn as boxes
+ */
+gboolean
+bb_detail_policy_greek_text(BbDetailPolicy *policy, double em);
+
+
+/**
+ * Create a new detail policy with the default thresholds
+ *
+ * @return A new detail policy
+ */
+BbDetailPolicy*
+bb_detail_policy_new(void);
+
+
+/**
+ * Set the size below which hatches and insertion points are skipped
+ *
+ * @param policy A detail policy
+ * @param threshold The threshold, in pixels
+ */
+void
+bb_detail_policy_set_detail_threshold(BbDetailPolicy *policy, double threshold);
+
+
+/**
+ * Set the height of an em below which text is drawn as boxes
+ *
+ * @param policy A detail policy
+ * @param threshold The threshold, in pixels
+ */
+void
+bb_detail_policy_set_greek_threshold(BbDetailPolicy *policy, double threshold);
+
+
+/**
+ * Set the size below which items collapse to a point
+ *
+ * @param policy A detail policy
+ * @param threshold The threshold, in pixels
+ */
+void
+bb_detail_policy_set_point_threshold(BbDetailPolicy *policy, double threshold);
+
+
+/**
+ * Check if a hatch or insertion point is skipped
+ *
+ * @param policy A detail policy
+ * @param size The size of the detail, in pixels
+ * @return TRUE if the detail is skipped
+ */
+gboolean
+bb_detail_policy_skip_detail(BbDetailPolicy *policy, double size);
+
+#endif
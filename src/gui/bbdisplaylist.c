@@ -0,0 +1,767 @@
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtk/gtk.h>
+#include <bblibrary.h>
+#include <bbextensions.h>
+#include "bbdisplaylist.h"
+
+
+enum
+{
+    PROP_0,
+    PROP_REVEAL,
+    N_PROPERTIES
+};
+
+
+/**
+ * The operations in the display list
+ *
+ * The comment lists the operands of each operation, in order. Text also uses one double and one string.
+ */
+typedef enum _BbDisplayOp
+{
+    BB_DISPLAY_OP_ARC,              /* x, y, radius, start, sweep */
+    BB_DISPLAY_OP_CLOSE_PATH,
+    BB_DISPLAY_OP_CURVE_TO,         /* x1, y1, x2, y2, x3, y3 */
+    BB_DISPLAY_OP_FILL_PRESERVE,
+    BB_DISPLAY_OP_INSERTION_POINT,  /* x, y */
+    BB_DISPLAY_OP_LINE_TO,          /* x, y */
+    BB_DISPLAY_OP_MOVE_TO,          /* x, y */
+    BB_DISPLAY_OP_REL_LINE_TO,      /* dx, dy */
+    BB_DISPLAY_OP_REL_MOVE_TO,      /* dx, dy */
+    BB_DISPLAY_OP_SET_COLOR,        /* color */
+    BB_DISPLAY_OP_SET_LINE_WIDTH,   /* width */
+    BB_DISPLAY_OP_STROKE,
+    BB_DISPLAY_OP_TEXT              /* x, y, alignment, size */
+} BbDisplayOp;
+
+
+/**
+ * Indicates the state is unknown, so the next change must be recorded
+ */
+#define BB_DISPLAY_LIST_NO_STATE (-1)
+
+
+struct _BbDisplayList
+{
+    GObject parent;
+
+    /**
+     * The operations, as BbDisplayOp stored in single bytes
+     */
+    GByteArray *ops;
+
+    /**
+     * The integer operands of all operations, in order
+     */
+    GArray *operands;
+
+    /**
+     * The rotation of each text operation, in radians
+     */
+    GArray *angles;
+
+    /**
+     * The markup of each text operation, pointing into the chunk
+     */
+    GPtrArray *texts;
+
+    /**
+     * Storage for the markup, with each distinct string stored once
+     */
+    GStringChunk *chunk;
+
+    /**
+     * The color of the most recent color operation, for removing redundant changes
+     */
+    int color;
+
+    /**
+     * The width of the most recent line width operation, for removing redundant changes
+     */
+    int line_width;
+
+    gboolean reveal;
+
+    /**
+     * The schematic revision of the recording, valid only if current is TRUE
+     */
+    guint revision;
+
+    /**
+     * The schematic recorded, used only for comparison
+     */
+    gconstpointer schematic;
+
+    gboolean current;
+};
+
+
+static void
+bb_display_list_append(BbDisplayList *list, BbDisplayOp op, int count, ...);
+
+static void
+bb_display_list_clear(BbDisplayList *list);
+
+static void
+bb_display_list_close_path(BbItemRenderer *renderer);
+
+static void
+bb_display_list_draw_closed_shape(
+    BbItemRenderer *renderer,
+    int color,
+    BbFillStyle *fill_style,
+    BbLineStyle *line_style,
+    BbClosedShapeDrawer *drawer
+    );
+
+static void
+bb_display_list_draw_open_shape(
+    BbItemRenderer *renderer,
+    int color,
+    BbLineStyle *line_style,
+    BbOpenShapeDrawer *drawer
+    );
+
+static void
+bb_display_list_finalize(GObject *object);
+
+static void
+bb_display_list_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
+
+static gboolean
+bb_display_list_get_reveal(BbItemRenderer *renderer);
+
+static void
+bb_display_list_item_renderer_init(BbItemRendererInterface *iface);
+
+static void
+bb_display_list_render_absolute_curve_to(BbItemRenderer *renderer, int x1, int y1, int x2, int y2, int x3, int y3);
+
+static void
+bb_display_list_render_absolute_line_to(BbItemRenderer *renderer, int x, int y);
+
+static void
+bb_display_list_render_absolute_move_to(BbItemRenderer *renderer, int x, int y);
+
+static void
+bb_display_list_render_arc(BbItemRenderer *renderer, int x, int y, int radius, int start, int sweep);
+
+static void
+bb_display_list_render_insertion_point(BbItemRenderer *renderer, int x, int y);
+
+static void
+bb_display_list_render_relative_line_to(BbItemRenderer *renderer, int dx, int dy);
+
+static void
+bb_display_list_render_relative_move_to(BbItemRenderer *renderer, int dx, int dy);
+
+static void
+bb_display_list_render_text(
+    BbItemRenderer *renderer,
+    int insert_x,
+    int insert_y,
+    BbTextAlignment alignment,
+    double radians,
+    int size,
+    char *text
+    );
+
+static void
+bb_display_list_set_color(BbItemRenderer *renderer, int color);
+
+static void
+bb_display_list_set_fill_style(BbItemRenderer *renderer, BbFillStyle *style);
+
+static void
+bb_display_list_set_line_style(BbItemRenderer *renderer, BbLineStyle *style);
+
+static void
+bb_display_list_set_line_width(BbDisplayList *list, int width);
+
+static void
+bb_display_list_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
+
+static void
+bb_display_list_set_reveal(BbItemRenderer *renderer, gboolean reveal);
+
+
+static GParamSpec *properties[N_PROPERTIES];
+
+
+G_DEFINE_TYPE_WITH_CODE(
+    BbDisplayList,
+    bb_display_list,
+    G_TYPE_OBJECT,
+    G_IMPLEMENT_INTERFACE(BB_TYPE_ITEM_RENDERER, bb_display_list_item_renderer_init)
+    )
+
+
+/**
+ * Append an operation along with its integer operands
+ *
+ * @param list A display list
+ * @param op The operation
+ * @param count The number of integer operands that follow
+ */
+static void
+bb_display_list_append(BbDisplayList *list, BbDisplayOp op, int count, ...)
+{
+    guint8 byte = (guint8) op;
+    va_list args;
+
+    g_byte_array_append(list->ops, &byte, 1);
+
+    va_start(args, count);
+
+    for (int index = 0; index < count; index++)
+    {
+        int operand = va_arg(args, int);
+
+        g_array_append_val(list->operands, operand);
+    }
+
+    va_end(args);
+}
+
+
+static void
+bb_display_list_class_init(BbDisplayListClass *klasse)
+{
+    GObjectClass *object_class = G_OBJECT_CLASS(klasse);
+    g_return_if_fail(object_class != NULL);
+
+    object_class->finalize = bb_display_list_finalize;
+    object_class->get_property = bb_display_list_get_property;
+    object_class->set_property = bb_display_list_set_property;
+
+    /* From BbItemRenderer */
+    properties[PROP_REVEAL] = bb_object_class_override_property(
+        object_class,
+        PROP_REVEAL,
+        "reveal"
+        );
+}
+
+
+/**
+ * Remove all operations, keeping the allocated storage for the next recording
+ */
+static void
+bb_display_list_clear(BbDisplayList *list)
+{
+    g_byte_array_set_size(list->ops, 0);
+    g_array_set_size(list->operands, 0);
+    g_array_set_size(list->angles, 0);
+    g_ptr_array_set_size(list->texts, 0);
+    g_string_chunk_clear(list->chunk);
+
+    list->color = BB_DISPLAY_LIST_NO_STATE;
+    list->line_width = BB_DISPLAY_LIST_NO_STATE;
+}
+
+
+static void
+bb_display_list_close_path(BbItemRenderer *renderer)
+{
+    BbDisplayList *list = BB_DISPLAY_LIST(renderer);
+    g_return_if_fail(list != NULL);
+
+    bb_display_list_append(list, BB_DISPLAY_OP_CLOSE_PATH, 0);
+}
+
+
+static void
+bb_display_list_draw_closed_shape(
+    BbItemRenderer *renderer,
+    int color,
+    BbFillStyle *fill_style,
+    BbLineStyle *line_style,
+    BbClosedShapeDrawer *drawer
+    )
+{
+    BbDisplayList *list = BB_DISPLAY_LIST(renderer);
+    g_return_if_fail(list != NULL);
+
+    bb_display_list_set_color(renderer, color);
+
+    if (fill_style->type == BB_FILL_TYPE_HATCH || fill_style->type == BB_FILL_TYPE_MESH)
+    {
+        bb_display_list_set_line_width(list, fill_style->width);
+
+        bb_closed_shape_drawer_draw_hatch(drawer, renderer);
+
+        bb_display_list_append(list, BB_DISPLAY_OP_STROKE, 0);
+    }
+
+    bb_display_list_set_line_width(list, line_style->line_width);
+
+    bb_closed_shape_drawer_draw_outline(drawer, renderer);
+
+    if (fill_style->type == BB_FILL_TYPE_SOLID)
+    {
+        bb_display_list_append(list, BB_DISPLAY_OP_FILL_PRESERVE, 0);
+    }
+
+    bb_display_list_append(list, BB_DISPLAY_OP_STROKE, 0);
+}
+
+
+static void
+bb_display_list_draw_open_shape(
+    BbItemRenderer *renderer,
+    int color,
+    BbLineStyle *line_style,
+    BbOpenShapeDrawer *drawer
+    )
+{
+    BbDisplayList *list = BB_DISPLAY_LIST(renderer);
+    g_return_if_fail(list != NULL);
+
+    bb_display_list_set_line_width(list, line_style->line_width);
+    bb_display_list_set_color(renderer, color);
+
+    bb_open_shape_drawer_draw_shape(drawer, renderer);
+
+    bb_display_list_append(list, BB_DISPLAY_OP_STROKE, 0);
+}
+
+
+static void
+bb_display_list_finalize(GObject *object)
+{
+    BbDisplayList *list = BB_DISPLAY_LIST(object);
+    g_return_if_fail(list != NULL);
+
+    g_byte_array_unref(list->ops);
+    g_array_unref(list->operands);
+    g_array_unref(list->angles);
+    g_ptr_array_unref(list->texts);
+    g_string_chunk_free(list->chunk);
+
+    G_OBJECT_CLASS(bb_display_list_parent_class)->finalize(object);
+}
+
+
+guint
+bb_display_list_get_op_count(BbDisplayList *list)
+{
+    g_return_val_if_fail(BB_IS_DISPLAY_LIST(list), 0);
+
+    return list->ops->len;
+}
+
+
+static void
+bb_display_list_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec)
+{
+    switch (property_id)
+    {
+        case PROP_REVEAL:
+            g_value_set_boolean(value, bb_display_list_get_reveal(BB_ITEM_RENDERER(object)));
+            break;
+
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+    }
+}
+
+
+static gboolean
+bb_display_list_get_reveal(BbItemRenderer *renderer)
+{
+    BbDisplayList *list = BB_DISPLAY_LIST(renderer);
+    g_return_val_if_fail(list != NULL, FALSE);
+
+    return list->reveal;
+}
+
+
+static void
+bb_display_list_init(BbDisplayList *list)
+{
+    g_return_if_fail(BB_IS_DISPLAY_LIST(list));
+
+    list->ops = g_byte_array_new();
+    list->operands = g_array_new(FALSE, FALSE, sizeof(int));
+    list->angles = g_array_new(FALSE, FALSE, sizeof(double));
+    list->texts = g_ptr_array_new();
+    list->chunk = g_string_chunk_new(4096);
+
+    list->color = BB_DISPLAY_LIST_NO_STATE;
+    list->line_width = BB_DISPLAY_LIST_NO_STATE;
+}
+
+
+void
+bb_display_list_invalidate(BbDisplayList *list)
+{
+    g_return_if_fail(BB_IS_DISPLAY_LIST(list));
+
+    list->current = FALSE;
+}
+
+
+static void
+bb_display_list_item_renderer_init(BbItemRendererInterface *iface)
+{
+    g_return_if_fail(iface != NULL);
+
+    iface->close_path = bb_display_list_close_path;
+    iface->draw_closed_shape = bb_display_list_draw_closed_shape;
+    iface->draw_open_shape = bb_display_list_draw_open_shape;
+    iface->get_reveal = bb_display_list_get_reveal;
+    iface->render_absolute_curve_to = bb_display_list_render_absolute_curve_to;
+    iface->render_absolute_line_to = bb_display_list_render_absolute_line_to;
+    iface->render_absolute_move_to = bb_display_list_render_absolute_move_to;
+    iface->render_arc = bb_display_list_render_arc;
+    iface->render_insertion_point = bb_display_list_render_insertion_point;
+    iface->render_relative_line_to = bb_display_list_render_relative_line_to;
+    iface->render_relative_move_to = bb_display_list_render_relative_move_to;
+    iface->render_text = bb_display_list_render_text;
+    iface->set_color = bb_display_list_set_color;
+    iface->set_fill_style = bb_display_list_set_fill_style;
+    iface->set_line_style = bb_display_list_set_line_style;
+    iface->set_reveal = bb_display_list_set_reveal;
+}
+
+
+BbDisplayList*
+bb_display_list_new(void)
+{
+    return BB_DISPLAY_LIST(g_object_new(BB_TYPE_DISPLAY_LIST, NULL));
+}
+
+
+static void
+bb_display_list_render_absolute_curve_to(BbItemRenderer *renderer, int x1, int y1, int x2, int y2, int x3, int y3)
+{
+    BbDisplayList *list = BB_DISPLAY_LIST(renderer);
+    g_return_if_fail(list != NULL);
+
+    bb_display_list_append(list, BB_DISPLAY_OP_CURVE_TO, 6, x1, y1, x2, y2, x3, y3);
+}
+
+
+static void
+bb_display_list_render_absolute_line_to(BbItemRenderer *renderer, int x, int y)
+{
+    BbDisplayList *list = BB_DISPLAY_LIST(renderer);
+    g_return_if_fail(list != NULL);
+
+    bb_display_list_append(list, BB_DISPLAY_OP_LINE_TO, 2, x, y);
+}
+
+
+static void
+bb_display_list_render_absolute_move_to(BbItemRenderer *renderer, int x, int y)
+{
+    BbDisplayList *list = BB_DISPLAY_LIST(renderer);
+    g_return_if_fail(list != NULL);
+
+    bb_display_list_append(list, BB_DISPLAY_OP_MOVE_TO, 2, x, y);
+}
+
+
+static void
+bb_display_list_render_arc(BbItemRenderer *renderer, int x, int y, int radius, int start, int sweep)
+{
+    BbDisplayList *list = BB_DISPLAY_LIST(renderer);
+    g_return_if_fail(list != NULL);
+
+    if (sweep != 0)
+    {
+        bb_display_list_append(list, BB_DISPLAY_OP_ARC, 5, x, y, radius, start, sweep);
+    }
+}
+
+
+static void
+bb_display_list_render_insertion_point(BbItemRenderer *renderer, int x, int y)
+{
+    BbDisplayList *list = BB_DISPLAY_LIST(renderer);
+    g_return_if_fail(list != NULL);
+
+    bb_display_list_append(list, BB_DISPLAY_OP_INSERTION_POINT, 2, x, y);
+}
+
+
+static void
+bb_display_list_render_relative_line_to(BbItemRenderer *renderer, int dx, int dy)
+{
+    BbDisplayList *list = BB_DISPLAY_LIST(renderer);
+    g_return_if_fail(list != NULL);
+
+    bb_display_list_append(list, BB_DISPLAY_OP_REL_LINE_TO, 2, dx, dy);
+}
+
+
+static void
+bb_display_list_render_relative_move_to(BbItemRenderer *renderer, int dx, int dy)
+{
+    BbDisplayList *list = BB_DISPLAY_LIST(renderer);
+    g_return_if_fail(list != NULL);
+
+    bb_display_list_append(list, BB_DISPLAY_OP_REL_MOVE_TO, 2, dx, dy);
+}
+
+
+static void
+bb_display_list_render_text(
+    BbItemRenderer *renderer,
+    int insert_x,
+    int insert_y,
+    BbTextAlignment alignment,
+    double radians,
+    int size,
+    char *text
+    )
+{
+    BbDisplayList *list = BB_DISPLAY_LIST(renderer);
+    g_return_if_fail(list != NULL);
+    g_return_if_fail(text != NULL);
+
+    bb_display_list_append(list, BB_DISPLAY_OP_TEXT, 4, insert_x, insert_y, (int) alignment, size);
+
+    g_array_append_val(list->angles, radians);
+    g_ptr_array_add(list->texts, g_string_chunk_insert_const(list->chunk, text));
+}
+
+
+void
+bb_display_list_replay(BbDisplayList *list, BbGraphics *graphics)
+{
+    g_return_if_fail(BB_IS_DISPLAY_LIST(list));
+    g_return_if_fail(BB_IS_GRAPHICS(graphics));
+
+    cairo_t *cairo = bb_graphics_get_cairo(graphics);
+    g_return_if_fail(cairo != NULL);
+
+    const int *operand = (const int*) list->operands->data;
+    const double *angle = (const double*) list->angles->data;
+    const char **text = (const char**) list->texts->pdata;
+
+    for (guint index = 0; index < list->ops->len; index++)
+    {
+        switch (list->ops->data[index])
+        {
+            case BB_DISPLAY_OP_ARC:
+                cairo_new_sub_path(cairo);
+
+                if (operand[4] > 0)
+                {
+                    cairo_arc(
+                        cairo,
+                        operand[0],
+                        operand[1],
+                        operand[2],
+                        bb_angle_to_radians(operand[3]),
+                        bb_angle_to_radians(operand[3] + operand[4])
+                        );
+                }
+                else
+                {
+                    cairo_arc_negative(
+                        cairo,
+                        operand[0],
+                        operand[1],
+                        operand[2],
+                        bb_angle_to_radians(operand[3]),
+                        bb_angle_to_radians(operand[3] - operand[4])
+                        );
+                }
+
+                operand += 5;
+                break;
+
+            case BB_DISPLAY_OP_CLOSE_PATH:
+                cairo_close_path(cairo);
+                break;
+
+            case BB_DISPLAY_OP_CURVE_TO:
+                cairo_curve_to(cairo, operand[0], operand[1], operand[2], operand[3], operand[4], operand[5]);
+                operand += 6;
+                break;
+
+            case BB_DISPLAY_OP_FILL_PRESERVE:
+                cairo_fill_preserve(cairo);
+                break;
+
+            case BB_DISPLAY_OP_INSERTION_POINT:
+                /* Only present when revealing hidden items, so the dispatch is not worth avoiding */
+                bb_item_renderer_render_insertion_point(BB_ITEM_RENDERER(graphics), operand[0], operand[1]);
+                operand += 2;
+                break;
+
+            case BB_DISPLAY_OP_LINE_TO:
+                cairo_line_to(cairo, operand[0], operand[1]);
+                operand += 2;
+                break;
+
+            case BB_DISPLAY_OP_MOVE_TO:
+                cairo_move_to(cairo, operand[0], operand[1]);
+                operand += 2;
+                break;
+
+            case BB_DISPLAY_OP_REL_LINE_TO:
+                cairo_rel_line_to(cairo, operand[0], operand[1]);
+                operand += 2;
+                break;
+
+            case BB_DISPLAY_OP_REL_MOVE_TO:
+                cairo_rel_move_to(cairo, operand[0], operand[1]);
+                operand += 2;
+                break;
+
+            case BB_DISPLAY_OP_SET_COLOR:
+                bb_graphics_set_source_color(graphics, operand[0]);
+                operand += 1;
+                break;
+
+            case BB_DISPLAY_OP_SET_LINE_WIDTH:
+                cairo_set_line_width(cairo, operand[0]);
+                operand += 1;
+                break;
+
+            case BB_DISPLAY_OP_STROKE:
+                cairo_stroke(cairo);
+                break;
+
+            case BB_DISPLAY_OP_TEXT:
+                bb_graphics_draw_text(
+                    graphics,
+                    operand[0],
+                    operand[1],
+                    (BbTextAlignment) operand[2],
+                    *angle++,
+                    operand[3],
+                    *text++
+                    );
+
+                operand += 4;
+                break;
+
+            default:
+                g_return_if_reached();
+        }
+    }
+}
+
+
+static void
+bb_display_list_set_color(BbItemRenderer *renderer, int color)
+{
+    BbDisplayList *list = BB_DISPLAY_LIST(renderer);
+    g_return_if_fail(list != NULL);
+
+    if (list->color != color)
+    {
+        bb_display_list_append(list, BB_DISPLAY_OP_SET_COLOR, 1, color);
+
+        list->color = color;
+    }
+}
+
+
+static void
+bb_display_list_set_fill_style(BbItemRenderer *renderer, BbFillStyle *style)
+{
+}
+
+
+static void
+bb_display_list_set_line_style(BbItemRenderer *renderer, BbLineStyle *style)
+{
+    BbDisplayList *list = BB_DISPLAY_LIST(renderer);
+    g_return_if_fail(list != NULL);
+
+    /* Matches BbGraphics, which currently ignores the style */
+    bb_display_list_set_line_width(list, 10);
+}
+
+
+static void
+bb_display_list_set_line_width(BbDisplayList *list, int width)
+{
+    if (list->line_width != width)
+    {
+        bb_display_list_append(list, BB_DISPLAY_OP_SET_LINE_WIDTH, 1, width);
+
+        list->line_width = width;
+    }
+}
+
+
+static void
+bb_display_list_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec)
+{
+    switch (property_id)
+    {
+        case PROP_REVEAL:
+            bb_display_list_set_reveal(BB_ITEM_RENDERER(object), g_value_get_boolean(value));
+            break;
+
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+    }
+}
+
+
+static void
+bb_display_list_set_reveal(BbItemRenderer *renderer, gboolean reveal)
+{
+    BbDisplayList *list = BB_DISPLAY_LIST(renderer);
+    g_return_if_fail(list != NULL);
+
+    if (!bb_boolean_equals(list->reveal, reveal))
+    {
+        list->reveal = reveal;
+        list->current = FALSE;
+
+        g_object_notify_by_pspec(G_OBJECT(list), properties[PROP_REVEAL]);
+    }
+}
+
+
+gboolean
+bb_display_list_update(BbDisplayList *list, BbSchematic *schematic, gboolean reveal)
+{
+    g_return_val_if_fail(BB_IS_DISPLAY_LIST(list), FALSE);
+    g_return_val_if_fail(BB_IS_SCHEMATIC(schematic), FALSE);
+
+    bb_display_list_set_reveal(BB_ITEM_RENDERER(list), reveal);
+
+    guint revision = bb_schematic_get_revision(schematic);
+
+    if (list->current && list->schematic == schematic && list->revision == revision)
+    {
+        return FALSE;
+    }
+
+    bb_display_list_clear(list);
+    bb_schematic_render(schematic, BB_ITEM_RENDERER(list));
+
+    list->current = TRUE;
+    list->revision = revision;
+    list->schematic = schematic;
+
+    return TRUE;
+}
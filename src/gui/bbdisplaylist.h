@@ -0,0 +1,95 @@
+#ifndef __BBDISPLAYLIST__
+#define __BBDISPLAYLIST__
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file bbdisplaylist.h
+ *
+ * A recording of the draw calls made while rendering a schematic
+ *
+ * The display list implements BbItemRenderer, so bb_schematic_render() records into it like any other renderer.
+ * Each call becomes a single byte opcode with its operands in packed arrays. Changes to the color and line width
+ * are only recorded when the value differs from the previous one.
+ *
+ * Replaying the list draws straight into cairo, without walking the items or dispatching through the item
+ * renderer interface. The list is only rebuilt when the schematic revision or the reveal setting changes, so
+ * repaints for zooming and panning reuse the same list.
+ */
+
+#include <gtk/gtk.h>
+#include <bblibrary.h>
+#include "bbgraphics.h"
+
+
+#define BB_TYPE_DISPLAY_LIST bb_display_list_get_type()
+G_DECLARE_FINAL_TYPE(BbDisplayList, bb_display_list, BB, DISPLAY_LIST, GObject)
+
+
+/**
+ * Get the number of operations in the list
+ *
+ * @param list A display list
+ * @return The number of operations
+ */
+guint
+bb_display_list_get_op_count(BbDisplayList *list);
+
+
+/**
+ * Discard the recording, so the next update rebuilds the list
+ *
+ * Call when the schematic is replaced, since another schematic could have the same revision.
+ *
+ * @param list A display list
+ */
+void
+bb_display_list_invalidate(BbDisplayList *list);
+
+
+/**
+ * Create an empty display list
+ *
+ * @return A new display list
+ */
+BbDisplayList*
+bb_display_list_new(void);
+
+
+/**
+ * Draw the recorded operations
+ *
+ * @param list A display list
+ * @param graphics The graphics receiving the operations
+ */
+void
+bb_display_list_replay(BbDisplayList *list, BbGraphics *graphics);
+
+
+/**
+ * Record the schematic, if the list is stale
+ *
+ * @param list A display list
+ * @param schematic The schematic to record
+ * @param reveal Record hidden items
+ * @return TRUE if the list was rebuilt
+ */
+gboolean
+bb_display_list_update(BbDisplayList *list, BbSchematic *schematic, gboolean reveal);
+
+#endif
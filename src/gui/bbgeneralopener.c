@@ -30,6 +30,53 @@ enum
 };
 
 
+/**
+ * The state of opening a batch of files
+ */
+typedef struct _BbOpenBatch BbOpenBatch;
+
+struct _BbOpenBatch
+{
+    /**
+     * The files not yet started
+     */
+    GQueue *pending;
+
+    /**
+     * The maximum number of files opened at once
+     */
+    guint max_parallel;
+
+    /**
+     * The number of files in progress
+     */
+    guint active;
+
+    /**
+     * The number of files opened, or failed to open
+     */
+    guint completed;
+
+    /**
+     * The number of files in the batch
+     */
+    guint total;
+
+    /**
+     * A line for each file that failed to open
+     */
+    GString *failures;
+
+    /**
+     * The number of files that failed to open
+     */
+    guint failure_count;
+
+    BbOpenProgressFunc progress_func;
+    gpointer progress_data;
+};
+
+
 struct _BbGeneralOpener
 {
     GObject parent;
@@ -51,6 +98,15 @@ bb_general_opener_finalize(GObject *object);
 static void
 bb_general_opener_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
 
+static void
+bb_general_opener_open_batch_free(BbOpenBatch *batch);
+
+static void
+bb_general_opener_open_files_next(GTask *task);
+
+static void
+bb_general_opener_open_files_ready(BbGeneralOpener *opener, GAsyncResult *result, GTask *task);
+
 static void
 bb_general_opener_read_content_type_ready_1(GFile *file, GAsyncResult *result, GTask *task);
 
@@ -143,6 +199,167 @@ bb_general_opener_init(BbGeneralOpener *general_opener)
 }
 
 
+static void
+bb_general_opener_open_batch_free(BbOpenBatch *batch)
+{
+    g_queue_free_full(batch->pending, g_object_unref);
+    g_string_free(batch->failures, TRUE);
+    g_slice_free(BbOpenBatch, batch);
+}
+
+
+void
+bb_general_opener_open_files_async(
+    BbGeneralOpener *opener,
+    GSList *files,
+    guint max_parallel,
+    GCancellable *cancellable,
+    BbOpenProgressFunc progress_func,
+    gpointer progress_data,
+    GAsyncReadyCallback callback,
+    gpointer user_data
+    )
+{
+    g_return_if_fail(BB_IS_GENERAL_OPENER(opener));
+
+    BbOpenBatch *batch = g_slice_new0(BbOpenBatch);
+
+    batch->pending = g_queue_new();
+    batch->failures = g_string_new(NULL);
+    batch->max_parallel = (max_parallel > 0) ? max_parallel : g_get_num_processors();
+    batch->progress_func = progress_func;
+    batch->progress_data = progress_data;
+
+    for (GSList *iter = files; iter != NULL; iter = g_slist_next(iter))
+    {
+        g_queue_push_tail(batch->pending, g_object_ref(G_FILE(iter->data)));
+    }
+
+    batch->total = g_queue_get_length(batch->pending);
+
+    GTask *task = g_task_new(opener, cancellable, callback, user_data);
+
+    g_task_set_task_data(task, batch, (GDestroyNotify) bb_general_opener_open_batch_free);
+
+    bb_general_opener_open_files_next(task);
+}
+
+
+gboolean
+bb_general_opener_open_files_finish(
+    BbGeneralOpener *opener,
+    GAsyncResult *result,
+    GError **error
+    )
+{
+    g_return_val_if_fail(BB_IS_GENERAL_OPENER(opener), FALSE);
+    g_return_val_if_fail(g_task_is_valid(result, opener), FALSE);
+
+    return g_task_propagate_boolean(G_TASK(result), error);
+}
+
+
+/**
+ * Start opening pending files, up to the limit, or complete the batch when none remain
+ *
+ * @param task The task for the entire batch
+ */
+static void
+bb_general_opener_open_files_next(GTask *task)
+{
+    BbOpenBatch *batch = g_task_get_task_data(task);
+    GCancellable *cancellable = g_task_get_cancellable(task);
+
+    if (g_cancellable_is_cancelled(cancellable))
+    {
+        /* Files in progress still complete, but no more are started */
+
+        g_queue_free_full(batch->pending, g_object_unref);
+        batch->pending = g_queue_new();
+    }
+
+    while (batch->active < batch->max_parallel && !g_queue_is_empty(batch->pending))
+    {
+        GFile *file = g_queue_pop_head(batch->pending);
+
+        batch->active++;
+
+        bb_general_opener_read_content_type_async(
+            BB_GENERAL_OPENER(g_task_get_source_object(task)),
+            file,
+            cancellable,
+            (GAsyncReadyCallback) bb_general_opener_open_files_ready,
+            task
+            );
+
+        g_object_unref(file);
+    }
+
+    if (batch->active == 0)
+    {
+        if (g_task_return_error_if_cancelled(task))
+        {
+            /* The error is returned by the condition */
+        }
+        else if (batch->failure_count > 0)
+        {
+            g_task_return_new_error(
+                task,
+                BB_ERROR_DOMAIN,
+                0,
+                "Unable to open %u of %u files:%s",
+                batch->failure_count,
+                batch->total,
+                batch->failures->str
+                );
+        }
+        else
+        {
+            g_task_return_boolean(task, TRUE);
+        }
+
+        g_object_unref(task);
+    }
+}
+
+
+static void
+bb_general_opener_open_files_ready(BbGeneralOpener *opener, GAsyncResult *result, GTask *task)
+{
+    BbOpenBatch *batch = g_task_get_task_data(task);
+    GError *local_error = NULL;
+
+    gboolean success = bb_general_opener_read_content_type_finish(opener, result, &local_error);
+
+    if (!success && !g_error_matches(local_error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+    {
+        gchar *basename = g_file_get_basename(G_FILE(g_task_get_task_data(G_TASK(result))));
+
+        g_string_append_printf(
+            batch->failures,
+            "\n    %s: %s",
+            basename,
+            (local_error != NULL) ? local_error->message : "Internal error"
+            );
+
+        batch->failure_count++;
+        g_free(basename);
+    }
+
+    g_clear_error(&local_error);
+
+    batch->active--;
+    batch->completed++;
+
+    if (batch->progress_func != NULL)
+    {
+        batch->progress_func(batch->completed, batch->total, batch->progress_data);
+    }
+
+    bb_general_opener_open_files_next(task);
+}
+
+
 BbGeneralOpener*
 bb_general_opener_new()
 {
@@ -169,6 +386,10 @@ bb_general_opener_read_content_type_async(
         user_data
         );
 
+    /* Identifies the file when reporting errors for a batch */
+
+    g_task_set_task_data(task, g_object_ref(file), g_object_unref);
+
     g_file_query_info_async(
         file,
         G_FILE_ATTRIBUTE_STANDARD_CONTENT_TYPE,
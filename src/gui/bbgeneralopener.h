@@ -26,6 +26,16 @@
 G_DECLARE_FINAL_TYPE(BbGeneralOpener, bb_general_opener, BB, GENERAL_OPENER, GObject)
 
 
+/**
+ * Reports the progress of opening a batch of files
+ *
+ * @param completed The number of files opened, or failed to open
+ * @param total The number of files in the batch
+ * @param user_data The user data passed to bb_general_opener_open_files_async()
+ */
+typedef void (*BbOpenProgressFunc)(guint completed, guint total, gpointer user_data);
+
+
 /**
  * Add a handler for a specific file format
  *
@@ -50,6 +60,55 @@ BbGeneralOpener*
 bb_general_opener_new();
 
 
+/**
+ * Begin opening a document window for each file in a batch
+ *
+ * At most max_parallel files are opened at once, with each file read and parsed on a worker thread. Each
+ * document window is added to the main window as soon as its file is parsed. The batch completes after every
+ * file is opened or fails to open. A failure to open one file does not prevent opening the others.
+ *
+ * Cancelling the cancellable stops opening files not yet started, and cancels the files in progress.
+ *
+ * @param opener A BbGeneralOpener
+ * @param files A list of GFile to open. The opener does not take ownership of the list.
+ * @param max_parallel The maximum number of files to open at once, or 0 for the number of processors
+ * @param cancellable An optional cancellable object for the entire batch
+ * @param progress_func An optional function called after each file completes
+ * @param progress_data User data to pass to the progress function
+ * @param callback A callback function when the entire batch completes
+ * @param user_data User data to pass to the callback function
+ */
+void
+bb_general_opener_open_files_async(
+    BbGeneralOpener *opener,
+    GSList *files,
+    guint max_parallel,
+    GCancellable *cancellable,
+    BbOpenProgressFunc progress_func,
+    gpointer progress_data,
+    GAsyncReadyCallback callback,
+    gpointer user_data
+    );
+
+
+/**
+ * Complete opening a batch of files
+ *
+ * @param opener A BbGeneralOpener
+ * @param result The result passed to the callback
+ * @param error An error listing the files that could not be opened
+ * @return TRUE if every file was opened
+ *
+ * @see bb_general_opener_open_files_async()
+ */
+gboolean
+bb_general_opener_open_files_finish(
+    BbGeneralOpener *opener,
+    GAsyncResult *result,
+    GError **error
+    );
+
+
 /**
  * @brief Begin opening a document window
  *
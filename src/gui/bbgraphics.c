@@ -29,9 +29,12 @@ enum
 {
     PROP_0,
     PROP_CAIRO,
+    PROP_DETAIL_POLICY,
+    PROP_PATH_CACHE,
     PROP_WIDGET_MATRIX,
     PROP_REVEAL,
     PROP_STYLE,
+    PROP_TEXT_CACHE,
     N_PROPERTIES
 };
 
@@ -42,10 +45,25 @@ struct _BbGraphics
 
     cairo_t *cairo;
 
+    /**
+     * Thresholds for simplifying small features, or NULL to draw everything at full detail
+     */
+    BbDetailPolicy *detail_policy;
+
+    /**
+     * Paths of items, usually shared across frames, or NULL to build paths every frame
+     */
+    BbPathCache *path_cache;
+
     gboolean reveal;
     
     GtkStyleContext *style;
 
+    /**
+     * Shaped text layouts, usually shared across frames
+     */
+    BbTextCache *text_cache;
+
     /**
      * A matrix for converting widget coordinates to window coordinates
      */
@@ -53,7 +71,62 @@ struct _BbGraphics
 };
 
 
-typedef gboolean (*GridShowFunc)(int value);
+/**
+ * The number of grid lines in each major division
+ */
+#define BB_GRAPHICS_GRID_MAJOR (5)
+
+
+/**
+ * The largest major division, in widget units, drawn with a repeating tile
+ */
+#define BB_GRAPHICS_GRID_TILE_MAXIMUM (1024.0)
+
+
+/**
+ * The height of an em, in user units, per unit of text size
+ *
+ * Text sizes are in tens of points, shaped at the font map default resolution of 96 dpi.
+ */
+#define BB_GRAPHICS_EM_PER_SIZE (10.0 * 96.0 / 72.0)
+
+
+/**
+ * The size of the mark drawn at an insertion point, in user units
+ */
+#define BB_GRAPHICS_INSERTION_POINT_SIZE (2.0 * BB_ITEM_RENDERER_INSERTION_POINT_RADIUS)
+
+
+/*
+ * Approximate text metrics, in ems, for drawing text as boxes without shaping
+ */
+#define BB_GRAPHICS_GREEK_ADVANCE (0.55)
+#define BB_GRAPHICS_GREEK_ASCENT (0.9)
+#define BB_GRAPHICS_GREEK_LINE (1.2)
+#define BB_GRAPHICS_GREEK_X_HEIGHT (0.5)
+
+
+/**
+ * Selects a subset of the grid lines, for drawing each subset in a different color
+ */
+typedef enum _GridLines
+{
+    /**
+     * All lines not on a major division, and the origin
+     */
+    GRID_LINES_MINOR,
+
+    /**
+     * Lines on a major division, except the origin
+     */
+    GRID_LINES_MAJOR,
+
+    /**
+     * Lines through the origin
+     */
+    GRID_LINES_ORIGIN
+}
+GridLines;
 
 
 typedef struct _GridGeometry GridGeometry;
@@ -69,38 +142,87 @@ struct _GridGeometry
 };
 
 
+struct _BbGridTile
+{
+    /**
+     * A repeating pattern of one major division, or NULL if not created yet
+     */
+    cairo_pattern_t *pattern;
+
+    /*
+     * The parameters used to create the pattern
+     */
+    int grid_size;
+    double xx;
+    double yy;
+    double device_scale_x;
+    double device_scale_y;
+};
+
+
 static void
 calculate_text_adjustment(PangoLayout *layout, BbTextAlignment alignment, int *dx, int *dy);
 
+static gboolean
+bb_graphics_append_cached_path(BbGraphics *graphics, gpointer drawer);
+
+static void
+bb_graphics_cache_path(BbGraphics *graphics, gpointer drawer);
+
+static gboolean
+bb_graphics_collapse_path(BbGraphics *graphics);
+
 static void
 bb_graphics_dispose(GObject *object);
 
 static void
-bb_graphics_draw_grid_horizontal(BbGraphics *graphics, GridGeometry *geometry, GridShowFunc show);
+bb_graphics_calculate_grid_geometry(
+    BbGraphics *graphics,
+    int grid_size,
+    GridGeometry *horizontal,
+    GridGeometry *vertical
+    );
 
 static void
-bb_graphics_draw_grid_vertical(BbGraphics *graphics, GridGeometry *geometry, GridShowFunc show);
+bb_graphics_draw_grid_horizontal(BbGraphics *graphics, GridGeometry *geometry, GridLines lines);
+
+static void
+bb_graphics_draw_grid_vertical(BbGraphics *graphics, GridGeometry *geometry, GridLines lines);
+
+static void
+bb_graphics_draw_greeked_text(
+    BbGraphics *graphics,
+    int insert_x,
+    int insert_y,
+    BbTextAlignment alignment,
+    double radians,
+    double em,
+    const char *text
+    );
+
+static void
+bb_graphics_draw_grid_tile_lines(cairo_t *cairo, double pitch, double period, double length, gboolean major, gboolean vertical);
 
 static void
 bb_graphics_finalize(GObject *object);
 
+static double
+bb_graphics_get_pixels(BbGraphics *graphics, double distance);
+
 static void
 bb_graphics_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
 
 static gboolean 
 bb_graphics_get_reveal(BbItemRenderer *renderer);
 
-static gboolean
-bb_graphics_is_major(int value);
-
-static gboolean
-bb_graphics_is_minor(int value);
+static void
+bb_graphics_item_renderer_init(BbItemRendererInterface *iface);
 
-static gboolean
-bb_graphics_is_origin(int value);
+static int
+bb_graphics_next_grid_line(int value, GridLines lines);
 
 static void
-bb_graphics_item_renderer_init(BbItemRendererInterface *iface);
+bb_graphics_render_absolute_curve_to(BbItemRenderer *renderer, int x1, int y1, int x2, int y2, int x3, int y3);
 
 static void
 bb_graphics_render_absolute_line_to(BbItemRenderer *renderer, int x, int y);
@@ -137,24 +259,36 @@ bb_graphics_set_cairo(BbGraphics *graphics, cairo_t* cairo);
 static void
 bb_graphics_set_color(BbItemRenderer *renderer, int color);
 
+static void
+bb_graphics_set_detail_policy(BbGraphics *graphics, BbDetailPolicy *detail_policy);
+
 static void
 bb_graphics_set_fill_style(BbItemRenderer *renderer, BbFillStyle *style);
 
 static void
 bb_graphics_set_line_style(BbItemRenderer *renderer, BbLineStyle *style);
 
+static void
+bb_graphics_set_path_cache(BbGraphics *graphics, BbPathCache *path_cache);
+
 static void
 bb_graphics_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
 
 static void
 bb_graphics_set_style(BbGraphics *graphics, GtkStyleContext *style);
 
+static void
+bb_graphics_set_text_cache(BbGraphics *graphics, BbTextCache *text_cache);
+
 static void
 bb_graphics_set_widget_matrix(BbGraphics *graphics, cairo_matrix_t *widget_matrix);
 
 static void
 bb_graphics_set_reveal(BbItemRenderer *renderer, gboolean reveal);
 
+static gboolean
+bb_graphics_update_grid_tile(BbGraphics *graphics, int grid_size, BbGridTile *tile, double *phase_x, double *phase_y);
+
 
 GParamSpec *properties[N_PROPERTIES];
 
@@ -167,6 +301,40 @@ G_DEFINE_TYPE_WITH_CODE(
     )
 
 
+static void
+bb_graphics_calculate_grid_geometry(
+    BbGraphics *graphics,
+    int grid_size,
+    GridGeometry *horizontal,
+    GridGeometry *vertical
+    )
+{
+    cairo_get_matrix(graphics->cairo, &horizontal->matrix);
+    horizontal->matrix.xx *= grid_size;
+    horizontal->width = ABS(1.0 / horizontal->matrix.xx);
+
+    cairo_get_matrix(graphics->cairo, &vertical->matrix);
+    vertical->matrix.yy *= grid_size;
+    vertical->width = ABS(1.0 / vertical->matrix.yy);
+
+    cairo_save(graphics->cairo);
+
+    double x[2];
+    cairo_set_matrix(graphics->cairo, &horizontal->matrix);
+    cairo_clip_extents(graphics->cairo, &x[0], &horizontal->min_y, &x[1], &horizontal->max_y);
+    horizontal->min_x = ceil(MIN(x[0], x[1]));
+    horizontal->max_x = floor(MAX(x[0], x[1]));
+
+    double y[2];
+    cairo_set_matrix(graphics->cairo, &vertical->matrix);
+    cairo_clip_extents(graphics->cairo, &vertical->min_x, &y[0], &vertical->max_x, &y[1]);
+    vertical->min_y = ceil(MIN(y[0], y[1]));
+    vertical->max_y = floor(MAX(y[0], y[1]));
+
+    cairo_restore(graphics->cairo);
+}
+
+
 static void
 bb_graphics_class_init(BbGraphicsClass *klasse)
 {
@@ -215,6 +383,155 @@ bb_graphics_class_init(BbGraphicsClass *klasse)
             G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY
             )
         );
+
+    properties[PROP_DETAIL_POLICY] = bb_object_class_install_property(
+        G_OBJECT_CLASS(klasse),
+        PROP_DETAIL_POLICY,
+        g_param_spec_object(
+            "detail-policy",
+            "",
+            "",
+            BB_TYPE_DETAIL_POLICY,
+            G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY
+            )
+        );
+
+    properties[PROP_PATH_CACHE] = bb_object_class_install_property(
+        G_OBJECT_CLASS(klasse),
+        PROP_PATH_CACHE,
+        g_param_spec_object(
+            "path-cache",
+            "",
+            "",
+            BB_TYPE_PATH_CACHE,
+            G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY
+            )
+        );
+
+    properties[PROP_TEXT_CACHE] = bb_object_class_install_property(
+        G_OBJECT_CLASS(klasse),
+        PROP_TEXT_CACHE,
+        g_param_spec_object(
+            "text-cache",
+            "",
+            "",
+            BB_TYPE_TEXT_CACHE,
+            G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY
+            )
+        );
+}
+
+
+/**
+ * Append the cached path of an item to the current path
+ *
+ * @param graphics A graphics
+ * @param drawer The drawer of the shape, which is usually the item
+ * @return TRUE if the path came from the cache, FALSE if the caller must build the path
+ */
+static gboolean
+bb_graphics_append_cached_path(BbGraphics *graphics, gpointer drawer)
+{
+    if (graphics->path_cache == NULL || !BB_IS_GEDA_ITEM(drawer))
+    {
+        return FALSE;
+    }
+
+    const cairo_path_t *path = bb_path_cache_lookup(
+        graphics->path_cache,
+        drawer,
+        bb_geda_item_get_revision(BB_GEDA_ITEM(drawer))
+        );
+
+    if (path == NULL)
+    {
+        /* Any leftover path would otherwise be copied into the cache along with the shape */
+        cairo_new_path(graphics->cairo);
+
+        return FALSE;
+    }
+
+    cairo_append_path(graphics->cairo, path);
+
+    return TRUE;
+}
+
+
+/**
+ * Copy the path just built for an item into the cache
+ *
+ * @param graphics A graphics
+ * @param drawer The drawer of the shape, which is usually the item
+ */
+static void
+bb_graphics_cache_path(BbGraphics *graphics, gpointer drawer)
+{
+    if (graphics->path_cache == NULL || !BB_IS_GEDA_ITEM(drawer))
+    {
+        return;
+    }
+
+    cairo_path_t *path = cairo_copy_path(graphics->cairo);
+
+    if (path->status == CAIRO_STATUS_SUCCESS)
+    {
+        bb_path_cache_insert(
+            graphics->path_cache,
+            drawer,
+            bb_geda_item_get_revision(BB_GEDA_ITEM(drawer)),
+            path
+            );
+    }
+    else
+    {
+        cairo_path_destroy(path);
+    }
+}
+
+
+/**
+ * Replace the current path with a point, if the path is too small to be legible
+ *
+ * @param graphics A graphics
+ * @return TRUE if the point was drawn and the path consumed, FALSE if the caller must draw the path
+ */
+static gboolean
+bb_graphics_collapse_path(BbGraphics *graphics)
+{
+    if (graphics->detail_policy == NULL || !cairo_has_current_point(graphics->cairo))
+    {
+        return FALSE;
+    }
+
+    double x0;
+    double y0;
+    double x1;
+    double y1;
+
+    cairo_path_extents(graphics->cairo, &x0, &y0, &x1, &y1);
+
+    /* The line width extends the stroke beyond the path on both sides */
+
+    double size = bb_graphics_get_pixels(
+        graphics,
+        MAX(x1 - x0, y1 - y0) + cairo_get_line_width(graphics->cairo)
+        );
+
+    if (!bb_detail_policy_collapse_item(graphics->detail_policy, size))
+    {
+        return FALSE;
+    }
+
+    /* A point covers a single pixel */
+
+    double scale = bb_graphics_get_pixels(graphics, 1.0);
+    double half = (scale > 0.0) ? 0.5 / scale : 0.0;
+
+    cairo_new_path(graphics->cairo);
+    cairo_rectangle(graphics->cairo, 0.5 * (x0 + x1) - half, 0.5 * (y0 + y1) - half, 2.0 * half, 2.0 * half);
+    cairo_fill(graphics->cairo);
+
+    return TRUE;
 }
 
 
@@ -232,6 +549,12 @@ bb_graphics_close_path(BbItemRenderer *renderer)
 static void
 bb_graphics_dispose(GObject *object)
 {
+    BbGraphics *graphics = BB_GRAPHICS(object);
+    g_return_if_fail(graphics != NULL);
+
+    g_clear_object(&graphics->detail_policy);
+    g_clear_object(&graphics->path_cache);
+    g_clear_object(&graphics->text_cache);
 }
 
 
@@ -247,20 +570,42 @@ bb_graphics_draw_closed_shape(
     BbGraphics *graphics = BB_GRAPHICS(renderer);
     g_return_if_fail(BB_IS_GRAPHICS(graphics));
 
-    bb_graphics_set_color(graphics, color);
+    bb_graphics_set_source_color(graphics, color);
 
     if (fill_style->type == BB_FILL_TYPE_HATCH || fill_style->type == BB_FILL_TYPE_MESH)
     {
-        cairo_set_line_width(graphics->cairo, fill_style->width);
+        int pitch = fill_style->pitch[0];
 
-        bb_closed_shape_drawer_draw_hatch(drawer, renderer);
+        if (fill_style->type == BB_FILL_TYPE_MESH)
+        {
+            pitch = MIN(pitch, fill_style->pitch[1]);
+        }
 
-        cairo_stroke(graphics->cairo);
+        /* Hatch lines closer than the threshold would merge into a solid fill */
+
+        if (graphics->detail_policy == NULL ||
+            !bb_detail_policy_skip_detail(graphics->detail_policy, bb_graphics_get_pixels(graphics, pitch)))
+        {
+            cairo_set_line_width(graphics->cairo, fill_style->width);
+
+            bb_closed_shape_drawer_draw_hatch(drawer, renderer);
+
+            cairo_stroke(graphics->cairo);
+        }
     }
 
     cairo_set_line_width(graphics->cairo, line_style->line_width);
 
-    bb_closed_shape_drawer_draw_outline(drawer, renderer);
+    if (!bb_graphics_append_cached_path(graphics, drawer))
+    {
+        bb_closed_shape_drawer_draw_outline(drawer, renderer);
+        bb_graphics_cache_path(graphics, drawer);
+    }
+
+    if (bb_graphics_collapse_path(graphics))
+    {
+        return;
+    }
 
     if (fill_style->type == BB_FILL_TYPE_SOLID)
     {
@@ -283,90 +628,248 @@ bb_graphics_draw_open_shape(
     g_return_if_fail(BB_IS_GRAPHICS(graphics));
 
     cairo_set_line_width(graphics->cairo, line_style->line_width);
-    bb_graphics_set_color(graphics, color);
+    bb_graphics_set_source_color(graphics, color);
 
-    bb_open_shape_drawer_draw_shape(drawer, renderer);
+    if (!bb_graphics_append_cached_path(graphics, drawer))
+    {
+        bb_open_shape_drawer_draw_shape(drawer, renderer);
+        bb_graphics_cache_path(graphics, drawer);
+    }
 
-    cairo_stroke(graphics->cairo);
+    if (!bb_graphics_collapse_path(graphics))
+    {
+        cairo_stroke(graphics->cairo);
+    }
+}
+
+
+/**
+ * Draw text as a box for each line, in place of the glyphs
+ *
+ * The boxes use approximate metrics, so the text does not need to be shaped.
+ *
+ * @param graphics A graphics
+ * @param insert_x The x coordinate of the insertion point
+ * @param insert_y The y coordinate of the insertion point
+ * @param alignment The alignment of the text relative to the insertion point
+ * @param radians The rotation of the text
+ * @param em The height of an em, in user units
+ * @param text The text, in Pango markup
+ */
+static void
+bb_graphics_draw_greeked_text(
+    BbGraphics *graphics,
+    int insert_x,
+    int insert_y,
+    BbTextAlignment alignment,
+    double radians,
+    double em,
+    const char *text
+    )
+{
+    glong lines = 1;
+    glong widest = 0;
+    glong length = 0;
+
+    for (const char *iter = text; *iter != '\0'; iter = g_utf8_next_char(iter))
+    {
+        if (*iter == '\n')
+        {
+            lines++;
+            length = 0;
+        }
+        else
+        {
+            widest = MAX(widest, ++length);
+        }
+    }
+
+    double advance = BB_GRAPHICS_GREEK_ADVANCE * em;
+    double line = BB_GRAPHICS_GREEK_LINE * em;
+    double baseline = (lines - 1) * line + BB_GRAPHICS_GREEK_ASCENT * em;
+    double x = -bb_text_alignment_get_alignment_x(alignment) * widest * advance;
+    double y = -bb_text_alignment_get_alignment_y(alignment) * baseline;
+
+    cairo_save(graphics->cairo);
+
+    cairo_translate(graphics->cairo, insert_x, insert_y);
+    cairo_scale(graphics->cairo, 1.0, -1.0);
+    cairo_rotate(graphics->cairo, -radians);
+
+    /* Each box covers the lowercase letters of a line, from the x-height to the baseline */
+
+    y += (BB_GRAPHICS_GREEK_ASCENT - BB_GRAPHICS_GREEK_X_HEIGHT) * em;
+    length = 0;
+
+    for (const char *iter = text; ; iter = g_utf8_next_char(iter))
+    {
+        if (*iter == '\n' || *iter == '\0')
+        {
+            if (length > 0)
+            {
+                cairo_rectangle(graphics->cairo, x, y, length * advance, BB_GRAPHICS_GREEK_X_HEIGHT * em);
+            }
+
+            if (*iter == '\0')
+            {
+                break;
+            }
+
+            y += line;
+            length = 0;
+        }
+        else
+        {
+            length++;
+        }
+    }
+
+    cairo_fill(graphics->cairo);
+    cairo_restore(graphics->cairo);
 }
 
 
 void
 bb_graphics_draw_grid(BbGraphics *graphics, int grid_size)
 {
+    g_return_if_fail(BB_IS_GRAPHICS(graphics));
+
     cairo_save(graphics->cairo);
 
     GridGeometry horizontal;
     GridGeometry vertical;
 
-    cairo_get_matrix(graphics->cairo, &horizontal.matrix);
-    horizontal.matrix.xx *= grid_size;
-    horizontal.width = ABS(1.0 / horizontal.matrix.xx);
-
-    cairo_get_matrix(graphics->cairo, &vertical.matrix);
-    vertical.matrix.yy *= grid_size;
-    vertical.width = ABS(1.0 / vertical.matrix.yy);
-
-    double x[2];
-    cairo_set_matrix(graphics->cairo, &horizontal.matrix);
-    cairo_clip_extents(graphics->cairo, &x[0], &horizontal.min_y, &x[1], &horizontal.max_y);
-    horizontal.min_x = ceil(MIN(x[0], x[1]));
-    horizontal.max_x = floor(MAX(x[0], x[1]));
-
-    double y[2];
-    cairo_set_matrix(graphics->cairo, &vertical.matrix);
-    cairo_clip_extents(graphics->cairo, &vertical.min_x, &y[0], &vertical.max_x, &y[1]);
-    vertical.min_y = ceil(MIN(y[0], y[1]));
-    vertical.max_y = floor(MAX(y[0], y[1]));
+    bb_graphics_calculate_grid_geometry(graphics, grid_size, &horizontal, &vertical);
 
     cairo_set_source_rgb(graphics->cairo, 0.09, 0.09, 0.09);
-    bb_graphics_draw_grid_horizontal(graphics, &horizontal, bb_graphics_is_minor);
-    bb_graphics_draw_grid_vertical(graphics, &vertical, bb_graphics_is_minor);
+    bb_graphics_draw_grid_horizontal(graphics, &horizontal, GRID_LINES_MINOR);
+    bb_graphics_draw_grid_vertical(graphics, &vertical, GRID_LINES_MINOR);
 
     cairo_set_source_rgb(graphics->cairo, 0.125, 0.125, 0.125);
-    bb_graphics_draw_grid_horizontal(graphics, &horizontal, bb_graphics_is_major);
-    bb_graphics_draw_grid_vertical(graphics, &vertical, bb_graphics_is_major);
+    bb_graphics_draw_grid_horizontal(graphics, &horizontal, GRID_LINES_MAJOR);
+    bb_graphics_draw_grid_vertical(graphics, &vertical, GRID_LINES_MAJOR);
 
     cairo_set_source_rgb(graphics->cairo, 0.25, 0.25, 0.25);
-    bb_graphics_draw_grid_horizontal(graphics, &horizontal, bb_graphics_is_origin);
-    bb_graphics_draw_grid_vertical(graphics, &vertical, bb_graphics_is_origin);
+    bb_graphics_draw_grid_horizontal(graphics, &horizontal, GRID_LINES_ORIGIN);
+    bb_graphics_draw_grid_vertical(graphics, &vertical, GRID_LINES_ORIGIN);
 
     cairo_restore(graphics->cairo);
 }
 
 
 static void
-bb_graphics_draw_grid_horizontal(BbGraphics *graphics, GridGeometry *geometry, GridShowFunc show)
+bb_graphics_draw_grid_horizontal(BbGraphics *graphics, GridGeometry *geometry, GridLines lines)
 {
     cairo_set_matrix(graphics->cairo, &geometry->matrix);
     cairo_set_line_width(graphics->cairo, geometry->width);
 
-    for (int x = geometry->min_x; x <= geometry->max_x; x++)
-    {
-        if (show(x))
-        {
-            cairo_move_to(graphics->cairo, x, geometry->min_y);
-            cairo_line_to(graphics->cairo, x, geometry->max_y);
-        }
-    }
+    for (int x = bb_graphics_next_grid_line(geometry->min_x, lines); x <= geometry->max_x; x = bb_graphics_next_grid_line(x + 1, lines))
+    {
+        cairo_move_to(graphics->cairo, x, geometry->min_y);
+        cairo_line_to(graphics->cairo, x, geometry->max_y);
+    }
+
+    cairo_stroke(graphics->cairo);
+}
+
+
+/**
+ * Draw one subset of the lines in a grid tile
+ *
+ * The major line is at the origin of the tile. Lines are also drawn one period before and after, so antialiasing
+ * wraps across the edges of the tile.
+ *
+ * @param cairo The cairo context for the tile
+ * @param pitch The distance between lines
+ * @param period The size of the tile in the direction across the lines
+ * @param length The size of the tile in the direction along the lines
+ * @param major Draw the major line, otherwise draw the minor lines
+ * @param vertical Draw vertical lines, otherwise draw horizontal lines
+ */
+static void
+bb_graphics_draw_grid_tile_lines(cairo_t *cairo, double pitch, double period, double length, gboolean major, gboolean vertical)
+{
+    int first = major ? 0 : 1;
+    int last = major ? 0 : BB_GRAPHICS_GRID_MAJOR - 1;
+
+    for (int index = first; index <= last; index++)
+    {
+        double position = index * pitch;
+
+        for (int wrap = -1; wrap <= 1; wrap++)
+        {
+            double offset = position + wrap * period;
+
+            if (vertical)
+            {
+                cairo_move_to(cairo, offset, 0.0);
+                cairo_line_to(cairo, offset, length);
+            }
+            else
+            {
+                cairo_move_to(cairo, 0.0, offset);
+                cairo_line_to(cairo, length, offset);
+            }
+        }
+    }
+
+    cairo_stroke(cairo);
+}
+
+
+void
+bb_graphics_draw_grid_tiled(BbGraphics *graphics, int grid_size, BbGridTile *tile)
+{
+    g_return_if_fail(BB_IS_GRAPHICS(graphics));
+    g_return_if_fail(tile != NULL);
+
+    double phase_x;
+    double phase_y;
+
+    if (!bb_graphics_update_grid_tile(graphics, grid_size, tile, &phase_x, &phase_y))
+    {
+        bb_graphics_draw_grid(graphics, grid_size);
+        return;
+    }
+
+    /* The tile does not depend on panning, so the pattern carries the offset of the major lines */
+
+    cairo_matrix_t pattern_matrix;
+
+    cairo_matrix_init_translate(&pattern_matrix, -phase_x, -phase_y);
+    cairo_pattern_set_matrix(tile->pattern, &pattern_matrix);
+
+    cairo_save(graphics->cairo);
+
+    cairo_set_matrix(graphics->cairo, &graphics->widget_matrix);
+    cairo_set_source(graphics->cairo, tile->pattern);
+    cairo_paint(graphics->cairo);
+
+    /* The tile repeats, so the origin is the only part drawn line by line */
+
+    GridGeometry horizontal;
+    GridGeometry vertical;
+
+    bb_graphics_calculate_grid_geometry(graphics, grid_size, &horizontal, &vertical);
 
-    cairo_stroke(graphics->cairo);
+    cairo_set_source_rgb(graphics->cairo, 0.25, 0.25, 0.25);
+    bb_graphics_draw_grid_horizontal(graphics, &horizontal, GRID_LINES_ORIGIN);
+    bb_graphics_draw_grid_vertical(graphics, &vertical, GRID_LINES_ORIGIN);
+
+    cairo_restore(graphics->cairo);
 }
 
 
 static void
-bb_graphics_draw_grid_vertical(BbGraphics *graphics, GridGeometry *geometry, GridShowFunc show)
+bb_graphics_draw_grid_vertical(BbGraphics *graphics, GridGeometry *geometry, GridLines lines)
 {
     cairo_set_matrix(graphics->cairo, &geometry->matrix);
     cairo_set_line_width(graphics->cairo, geometry->width);
 
-    for (int y = geometry->min_y; y <= geometry->max_y; y++)
+    for (int y = bb_graphics_next_grid_line(geometry->min_y, lines); y <= geometry->max_y; y = bb_graphics_next_grid_line(y + 1, lines))
     {
-        if (show(y))
-        {
-            cairo_move_to(graphics->cairo, geometry->min_x, y);
-            cairo_line_to(graphics->cairo, geometry->max_x, y);
-        }
+        cairo_move_to(graphics->cairo, geometry->min_x, y);
+        cairo_line_to(graphics->cairo, geometry->max_x, y);
     }
 
     cairo_stroke(graphics->cairo);
@@ -436,6 +939,43 @@ bb_graphics_get_cairo(BbGraphics *graphics)
 }
 
 
+BbDetailPolicy*
+bb_graphics_get_detail_policy(BbGraphics *graphics)
+{
+    g_return_val_if_fail(BB_IS_GRAPHICS(graphics), NULL);
+
+    return graphics->detail_policy;
+}
+
+
+BbPathCache*
+bb_graphics_get_path_cache(BbGraphics *graphics)
+{
+    g_return_val_if_fail(BB_IS_GRAPHICS(graphics), NULL);
+
+    return graphics->path_cache;
+}
+
+
+/**
+ * Convert a distance in user units to device pixels, using the current transform
+ *
+ * @param graphics A graphics
+ * @param distance The distance in user units
+ * @return The distance in device pixels
+ */
+static double
+bb_graphics_get_pixels(BbGraphics *graphics, double distance)
+{
+    double dx = distance;
+    double dy = 0.0;
+
+    cairo_user_to_device_distance(graphics->cairo, &dx, &dy);
+
+    return hypot(dx, dy);
+}
+
+
 static void
 bb_graphics_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec)
 {
@@ -445,6 +985,14 @@ bb_graphics_get_property(GObject *object, guint property_id, GValue *value, GPar
             g_value_set_pointer(value, bb_graphics_get_cairo(BB_GRAPHICS(object)));
             break;
 
+        case PROP_DETAIL_POLICY:
+            g_value_set_object(value, bb_graphics_get_detail_policy(BB_GRAPHICS(object)));
+            break;
+
+        case PROP_PATH_CACHE:
+            g_value_set_object(value, bb_graphics_get_path_cache(BB_GRAPHICS(object)));
+            break;
+
         case PROP_REVEAL:
             g_value_set_boolean(value, bb_graphics_get_reveal(BB_ITEM_RENDERER(object)));
             break;
@@ -453,6 +1001,10 @@ bb_graphics_get_property(GObject *object, guint property_id, GValue *value, GPar
             g_value_set_object(value, bb_graphics_get_style(BB_GRAPHICS(object)));
             break;
 
+        case PROP_TEXT_CACHE:
+            g_value_set_object(value, bb_graphics_get_text_cache(BB_GRAPHICS(object)));
+            break;
+
         case PROP_WIDGET_MATRIX:
             g_value_set_pointer(value, bb_graphics_get_widget_matrix(BB_GRAPHICS(object)));
             break;
@@ -482,44 +1034,45 @@ bb_graphics_get_style(BbGraphics *graphics)
 }
 
 
-cairo_matrix_t*
-bb_graphics_get_widget_matrix(BbGraphics *graphics)
+BbTextCache*
+bb_graphics_get_text_cache(BbGraphics *graphics)
 {
     g_return_val_if_fail(BB_IS_GRAPHICS(graphics), NULL);
 
-    return &graphics->widget_matrix;
-}
-
+    if (graphics->text_cache == NULL)
+    {
+        graphics->text_cache = bb_text_cache_new(BB_TEXT_CACHE_DEFAULT_CAPACITY);
+    }
 
-static void
-bb_graphics_init(BbGraphics *graphics)
-{
+    return graphics->text_cache;
 }
 
 
-static gboolean
-bb_graphics_is_major(int value)
+cairo_matrix_t*
+bb_graphics_get_widget_matrix(BbGraphics *graphics)
 {
-    return !bb_graphics_is_origin(value) && ((ABS(value) % 5) == 0);
-}
-
+    g_return_val_if_fail(BB_IS_GRAPHICS(graphics), NULL);
 
-static gboolean
-bb_graphics_is_minor(int value)
-{
-    return !bb_graphics_is_major(value);
+    return &graphics->widget_matrix;
 }
 
 
-static gboolean
-bb_graphics_is_origin(int value)
+static void
+bb_graphics_init(BbGraphics *graphics)
 {
-    return (value == 0);
 }
 
 
 BbGraphics*
-bb_graphics_new(cairo_t *cairo, cairo_matrix_t *widget_matrix, gboolean reveal, GtkStyleContext *style)
+bb_graphics_new(
+    cairo_t *cairo,
+    cairo_matrix_t *widget_matrix,
+    gboolean reveal,
+    GtkStyleContext *style,
+    BbTextCache *text_cache,
+    BbPathCache *path_cache,
+    BbDetailPolicy *detail_policy
+    )
 {
     return BB_GRAPHICS(g_object_new(
         BB_TYPE_GRAPHICS,
@@ -527,6 +1080,9 @@ bb_graphics_new(cairo_t *cairo, cairo_matrix_t *widget_matrix, gboolean reveal,
         "widget-matrix", widget_matrix,
         "reveal", reveal,
         "style", style,
+        "text-cache", text_cache,
+        "path-cache", path_cache,
+        "detail-policy", detail_policy,
         NULL
         ));
 }
@@ -541,6 +1097,7 @@ bb_graphics_item_renderer_init(BbItemRendererInterface *iface)
     iface->draw_open_shape = bb_graphics_draw_open_shape;
     iface->close_path = bb_graphics_close_path;
     iface->get_reveal = bb_graphics_get_reveal;
+    iface->render_absolute_curve_to = bb_graphics_render_absolute_curve_to;
     iface->render_absolute_line_to = bb_graphics_render_absolute_line_to;
     iface->render_absolute_move_to = bb_graphics_render_absolute_move_to;
     iface->render_arc = bb_graphics_render_arc;
@@ -555,6 +1112,59 @@ bb_graphics_item_renderer_init(BbItemRendererInterface *iface)
 }
 
 
+/**
+ * Find the next line in a subset of grid lines
+ *
+ * Steps directly to the next line in the subset, so drawing does not test every line in the viewport.
+ *
+ * @param value The position, in grid units, to start searching from
+ * @param lines The subset of grid lines
+ * @return The position of the next line, in grid units, at or after value
+ */
+static int
+bb_graphics_next_grid_line(int value, GridLines lines)
+{
+    int remainder;
+
+    switch (lines)
+    {
+        case GRID_LINES_MAJOR:
+            remainder = value % BB_GRAPHICS_GRID_MAJOR;
+
+            if (remainder > 0)
+            {
+                value += BB_GRAPHICS_GRID_MAJOR - remainder;
+            }
+            else if (remainder < 0)
+            {
+                value -= remainder;
+            }
+
+            return (value == 0) ? BB_GRAPHICS_GRID_MAJOR : value;
+
+        case GRID_LINES_MINOR:
+            return ((value % BB_GRAPHICS_GRID_MAJOR) == 0 && value != 0) ? value + 1 : value;
+
+        case GRID_LINES_ORIGIN:
+            return (value <= 0) ? 0 : G_MAXINT;
+
+        default:
+            g_return_val_if_reached(G_MAXINT);
+    }
+}
+
+
+static void
+bb_graphics_render_absolute_curve_to(BbItemRenderer *renderer, int x1, int y1, int x2, int y2, int x3, int y3)
+{
+    BbGraphics *graphics = BB_GRAPHICS(renderer);
+    g_return_if_fail(graphics != NULL);
+    g_return_if_fail(graphics->cairo != NULL);
+
+    cairo_curve_to(graphics->cairo, x1, y1, x2, y2, x3, y3);
+}
+
+
 static void
 bb_graphics_render_absolute_line_to(BbItemRenderer *renderer, int x, int y)
 {
@@ -620,17 +1230,28 @@ bb_graphics_render_insertion_point(BbItemRenderer *renderer, int x, int y)
     g_return_if_fail(graphics != NULL);
     g_return_if_fail(graphics->cairo != NULL);
 
+    if (graphics->detail_policy != NULL &&
+        bb_detail_policy_skip_detail(
+            graphics->detail_policy,
+            bb_graphics_get_pixels(graphics, BB_GRAPHICS_INSERTION_POINT_SIZE)
+            ))
+    {
+        return;
+    }
+
     cairo_save(graphics->cairo);
 
     cairo_translate(graphics->cairo, x, y);
 
-    cairo_move_to(graphics->cairo, -20.0, -20.0);
-    cairo_line_to(graphics->cairo,  20.0,  20.0);
-    cairo_move_to(graphics->cairo, -20.0,  20.0);
-    cairo_line_to(graphics->cairo,  20.0, -20.0);
+    double radius = BB_ITEM_RENDERER_INSERTION_POINT_RADIUS;
+
+    cairo_move_to(graphics->cairo, -radius, -radius);
+    cairo_line_to(graphics->cairo,  radius,  radius);
+    cairo_move_to(graphics->cairo, -radius,  radius);
+    cairo_line_to(graphics->cairo,  radius, -radius);
 
     cairo_set_source_rgb(graphics->cairo, 0.5, 0.5, 0.5);
-    cairo_set_line_width(graphics->cairo, 10.0);
+    cairo_set_line_width(graphics->cairo, BB_ITEM_RENDERER_INSERTION_POINT_WIDTH);
 
     cairo_stroke(graphics->cairo);
     cairo_restore(graphics->cairo);
@@ -659,19 +1280,41 @@ bb_graphics_render_text(
     char *text
     )
 {
-    BbGraphics *graphics = BB_GRAPHICS(renderer);
-    g_return_if_fail(graphics != NULL);
+    bb_graphics_draw_text(BB_GRAPHICS(renderer), insert_x, insert_y, alignment, radians, size, text);
+}
 
-    cairo_save(graphics->cairo);
 
-    PangoFontDescription *font_description = pango_font_description_from_string("Sans");
+void
+bb_graphics_draw_text(
+    BbGraphics *graphics,
+    int insert_x,
+    int insert_y,
+    BbTextAlignment alignment,
+    double radians,
+    int size,
+    const char *text
+    )
+{
+    g_return_if_fail(BB_IS_GRAPHICS(graphics));
+    g_return_if_fail(text != NULL);
+
+    double em = size * BB_GRAPHICS_EM_PER_SIZE;
 
-    PangoLayout *layout = pango_cairo_create_layout(graphics->cairo);
+    if (graphics->detail_policy != NULL &&
+        bb_detail_policy_greek_text(graphics->detail_policy, bb_graphics_get_pixels(graphics, em)))
+    {
+        bb_graphics_draw_greeked_text(graphics, insert_x, insert_y, alignment, radians, em, text);
+        return;
+    }
+
+    cairo_save(graphics->cairo);
 
-    pango_font_description_set_size(font_description, 10 * size * PANGO_SCALE);
-    pango_layout_set_font_description(layout, font_description);
-    pango_layout_set_spacing(layout, 40000);
-    pango_layout_set_markup(layout, text, -1);
+    PangoLayout *layout = bb_text_cache_lookup(
+        bb_graphics_get_text_cache(graphics),
+        graphics->cairo,
+        size,
+        text
+        );
 
     cairo_move_to(graphics->cairo, insert_x, insert_y);
     cairo_scale(graphics->cairo, 1.0, -1.0);
@@ -691,13 +1334,72 @@ bb_graphics_render_text(
 
     pango_cairo_show_layout(graphics->cairo, layout);
 
-    pango_font_description_free(font_description);
-    g_clear_object(&layout);
-
     cairo_restore(graphics->cairo);
 }
 
 
+BbBounds*
+bb_graphics_measure_text(
+    BbTextCache *cache,
+    cairo_t *cairo,
+    int insert_x,
+    int insert_y,
+    BbTextAlignment alignment,
+    double radians,
+    int size,
+    const char *text
+    )
+{
+    g_return_val_if_fail(BB_IS_TEXT_CACHE(cache), NULL);
+    g_return_val_if_fail(cairo != NULL, NULL);
+    g_return_val_if_fail(text != NULL, NULL);
+
+    PangoLayout *layout = bb_text_cache_lookup(cache, cairo, size, text);
+
+    int dx = 0;
+    int dy = 0;
+
+    calculate_text_adjustment(layout, alignment, &dx, &dy);
+
+    PangoRectangle ink;
+    PangoRectangle logical;
+
+    pango_layout_get_extents(layout, &ink, &logical);
+
+    /* The ink covers overhanging glyphs, while the logical extents cover leading and trailing spaces */
+
+    double x0 = (double) (dx + MIN(ink.x, logical.x)) / (double) PANGO_SCALE;
+    double y0 = (double) (dy + MIN(ink.y, logical.y)) / (double) PANGO_SCALE;
+    double x1 = (double) (dx + MAX(ink.x + ink.width, logical.x + logical.width)) / (double) PANGO_SCALE;
+    double y1 = (double) (dy + MAX(ink.y + ink.height, logical.y + logical.height)) / (double) PANGO_SCALE;
+
+    /* Map the corners from the layout, with y down, as set up by bb_graphics_draw_text() */
+
+    double u[4] = { x0, x1, x0, x1 };
+    double v[4] = { y0, y0, y1, y1 };
+    double c = cos(radians);
+    double s = sin(radians);
+
+    double min_x = G_MAXDOUBLE;
+    double min_y = G_MAXDOUBLE;
+    double max_x = -G_MAXDOUBLE;
+    double max_y = -G_MAXDOUBLE;
+
+    for (int corner = 0; corner < 4; corner++)
+    {
+        double x = insert_x + u[corner] * c + v[corner] * s;
+        double y = insert_y + u[corner] * s - v[corner] * c;
+
+        min_x = MIN(min_x, x);
+        min_y = MIN(min_y, y);
+        max_x = MAX(max_x, x);
+        max_y = MAX(max_y, y);
+    }
+
+    return bb_bounds_new_with_points(floor(min_x), floor(min_y), ceil(max_x), ceil(max_y));
+}
+
+
 static void
 calculate_text_adjustment(PangoLayout *layout, BbTextAlignment alignment, int *dx, int *dy)
 {
@@ -750,8 +1452,14 @@ bb_graphics_render_relative_move_to(BbItemRenderer *renderer, int dx, int dy)
 static void
 bb_graphics_set_color(BbItemRenderer *renderer, int color)
 {
-    BbGraphics *graphics = BB_GRAPHICS(renderer);
-    g_return_if_fail(graphics != NULL);
+    bb_graphics_set_source_color(BB_GRAPHICS(renderer), color);
+}
+
+
+void
+bb_graphics_set_source_color(BbGraphics *graphics, int color)
+{
+    g_return_if_fail(BB_IS_GRAPHICS(graphics));
     g_return_if_fail(graphics->cairo != NULL);
 
     switch (color)
@@ -865,6 +1573,54 @@ bb_graphics_set_cairo(BbGraphics *graphics, cairo_t* cairo)
 }
 
 
+static void
+bb_graphics_set_detail_policy(BbGraphics *graphics, BbDetailPolicy *detail_policy)
+{
+    g_return_if_fail(BB_IS_GRAPHICS(graphics));
+
+    if (graphics->detail_policy != detail_policy)
+    {
+        if (graphics->detail_policy != NULL)
+        {
+            g_object_unref(graphics->detail_policy);
+        }
+
+        graphics->detail_policy = detail_policy;
+
+        if (graphics->detail_policy != NULL)
+        {
+            g_object_ref(graphics->detail_policy);
+        }
+
+        g_object_notify_by_pspec(G_OBJECT(graphics), properties[PROP_DETAIL_POLICY]);
+    }
+}
+
+
+static void
+bb_graphics_set_path_cache(BbGraphics *graphics, BbPathCache *path_cache)
+{
+    g_return_if_fail(BB_IS_GRAPHICS(graphics));
+
+    if (graphics->path_cache != path_cache)
+    {
+        if (graphics->path_cache != NULL)
+        {
+            g_object_unref(graphics->path_cache);
+        }
+
+        graphics->path_cache = path_cache;
+
+        if (graphics->path_cache != NULL)
+        {
+            g_object_ref(graphics->path_cache);
+        }
+
+        g_object_notify_by_pspec(G_OBJECT(graphics), properties[PROP_PATH_CACHE]);
+    }
+}
+
+
 static void
 bb_graphics_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec)
 {
@@ -874,6 +1630,14 @@ bb_graphics_set_property(GObject *object, guint property_id, const GValue *value
             bb_graphics_set_cairo(BB_GRAPHICS(object), g_value_get_pointer(value));
             break;
 
+        case PROP_DETAIL_POLICY:
+            bb_graphics_set_detail_policy(BB_GRAPHICS(object), g_value_get_object(value));
+            break;
+
+        case PROP_PATH_CACHE:
+            bb_graphics_set_path_cache(BB_GRAPHICS(object), g_value_get_object(value));
+            break;
+
         case PROP_REVEAL:
             bb_graphics_set_reveal(BB_ITEM_RENDERER(object), g_value_get_boolean(value));
             break;
@@ -882,6 +1646,10 @@ bb_graphics_set_property(GObject *object, guint property_id, const GValue *value
             bb_graphics_set_style(BB_GRAPHICS(object), g_value_get_object(value));
             break;
 
+        case PROP_TEXT_CACHE:
+            bb_graphics_set_text_cache(BB_GRAPHICS(object), g_value_get_object(value));
+            break;
+
         case PROP_WIDGET_MATRIX:
             bb_graphics_set_widget_matrix(BB_GRAPHICS(object), g_value_get_pointer(value));
             break;
@@ -931,6 +1699,30 @@ bb_graphics_set_style(BbGraphics *graphics, GtkStyleContext *style)
 }
 
 
+static void
+bb_graphics_set_text_cache(BbGraphics *graphics, BbTextCache *text_cache)
+{
+    g_return_if_fail(BB_IS_GRAPHICS(graphics));
+
+    if (graphics->text_cache != text_cache)
+    {
+        if (graphics->text_cache != NULL)
+        {
+            g_object_unref(graphics->text_cache);
+        }
+
+        graphics->text_cache = text_cache;
+
+        if (graphics->text_cache != NULL)
+        {
+            g_object_ref(graphics->text_cache);
+        }
+
+        g_object_notify_by_pspec(G_OBJECT(graphics), properties[PROP_TEXT_CACHE]);
+    }
+}
+
+
 static void
 bb_graphics_set_widget_matrix(BbGraphics *graphics, cairo_matrix_t *widget_matrix)
 {
@@ -941,3 +1733,133 @@ bb_graphics_set_widget_matrix(BbGraphics *graphics, cairo_matrix_t *widget_matri
 
     g_object_notify_by_pspec(G_OBJECT(graphics), properties[PROP_WIDGET_MATRIX]);
 }
+
+
+/**
+ * Create or reuse the pattern in a grid tile
+ *
+ * The tile must contain a whole number of device pixels, so lines land in the same place in every repetition.
+ * Otherwise, the grid must be drawn line by line.
+ *
+ * @param graphics The graphics used for drawing the grid
+ * @param grid_size The distance between grid lines, in user units
+ * @param tile The tile to update
+ * @param phase_x Receives the horizontal position of the major lines within the tile, in widget units
+ * @param phase_y Receives the vertical position of the major lines within the tile, in widget units
+ * @return TRUE if the tile can be used with the current transform
+ */
+static gboolean
+bb_graphics_update_grid_tile(BbGraphics *graphics, int grid_size, BbGridTile *tile, double *phase_x, double *phase_y)
+{
+    cairo_matrix_t inverse = graphics->widget_matrix;
+    cairo_matrix_t matrix;
+
+    if (cairo_matrix_invert(&inverse) != CAIRO_STATUS_SUCCESS)
+    {
+        return FALSE;
+    }
+
+    /* The transform from user coordinates to widget coordinates */
+    cairo_get_matrix(graphics->cairo, &matrix);
+    cairo_matrix_multiply(&matrix, &matrix, &inverse);
+
+    if (matrix.xy != 0.0 || matrix.yx != 0.0)
+    {
+        return FALSE;
+    }
+
+    double pitch_x = ABS(matrix.xx) * grid_size;
+    double pitch_y = ABS(matrix.yy) * grid_size;
+    double period_x = round(BB_GRAPHICS_GRID_MAJOR * pitch_x);
+    double period_y = round(BB_GRAPHICS_GRID_MAJOR * pitch_y);
+
+    if (ABS(BB_GRAPHICS_GRID_MAJOR * pitch_x - period_x) > 0.001 || ABS(BB_GRAPHICS_GRID_MAJOR * pitch_y - period_y) > 0.001)
+    {
+        return FALSE;
+    }
+
+    if (period_x < 1.0 || period_x > BB_GRAPHICS_GRID_TILE_MAXIMUM || period_y < 1.0 || period_y > BB_GRAPHICS_GRID_TILE_MAXIMUM)
+    {
+        return FALSE;
+    }
+
+    *phase_x = fmod(matrix.x0, period_x);
+    *phase_y = fmod(matrix.y0, period_y);
+
+    *phase_x = (*phase_x < 0.0) ? *phase_x + period_x : *phase_x;
+    *phase_y = (*phase_y < 0.0) ? *phase_y + period_y : *phase_y;
+
+    cairo_surface_t *target = cairo_get_target(graphics->cairo);
+    double device_scale_x;
+    double device_scale_y;
+
+    cairo_surface_get_device_scale(target, &device_scale_x, &device_scale_y);
+
+    gboolean valid = (tile->pattern != NULL) &&
+        (tile->grid_size == grid_size) &&
+        (tile->xx == matrix.xx) &&
+        (tile->yy == matrix.yy) &&
+        (tile->device_scale_x == device_scale_x) &&
+        (tile->device_scale_y == device_scale_y);
+
+    if (!valid)
+    {
+        g_clear_pointer(&tile->pattern, cairo_pattern_destroy);
+
+        cairo_surface_t *surface = cairo_surface_create_similar(
+            target,
+            CAIRO_CONTENT_COLOR_ALPHA,
+            (int) period_x,
+            (int) period_y
+            );
+
+        cairo_t *cairo = cairo_create(surface);
+
+        cairo_set_line_width(cairo, 1.0);
+
+        /* Same order as bb_graphics_draw_grid(), so overlapping lines composite identically */
+
+        cairo_set_source_rgb(cairo, 0.09, 0.09, 0.09);
+        bb_graphics_draw_grid_tile_lines(cairo, pitch_x, period_x, period_y, FALSE, TRUE);
+        bb_graphics_draw_grid_tile_lines(cairo, pitch_y, period_y, period_x, FALSE, FALSE);
+
+        cairo_set_source_rgb(cairo, 0.125, 0.125, 0.125);
+        bb_graphics_draw_grid_tile_lines(cairo, pitch_x, period_x, period_y, TRUE, TRUE);
+        bb_graphics_draw_grid_tile_lines(cairo, pitch_y, period_y, period_x, TRUE, FALSE);
+
+        cairo_destroy(cairo);
+
+        tile->pattern = cairo_pattern_create_for_surface(surface);
+        cairo_pattern_set_extend(tile->pattern, CAIRO_EXTEND_REPEAT);
+        cairo_pattern_set_filter(tile->pattern, CAIRO_FILTER_NEAREST);
+
+        cairo_surface_destroy(surface);
+
+        tile->grid_size = grid_size;
+        tile->xx = matrix.xx;
+        tile->yy = matrix.yy;
+        tile->device_scale_x = device_scale_x;
+        tile->device_scale_y = device_scale_y;
+    }
+
+    return TRUE;
+}
+
+
+void
+bb_grid_tile_free(BbGridTile *tile)
+{
+    if (tile != NULL)
+    {
+        g_clear_pointer(&tile->pattern, cairo_pattern_destroy);
+
+        g_free(tile);
+    }
+}
+
+
+BbGridTile*
+bb_grid_tile_new()
+{
+    return g_new0(BbGridTile, 1);
+}
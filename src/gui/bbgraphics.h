@@ -19,6 +19,19 @@
  */
 
 #include <gtk/gtk.h>
+#include <bbbounds.h>
+#include <bbtextalignment.h>
+#include "bbdetailpolicy.h"
+#include "bbpathcache.h"
+#include "bbtextcache.h"
+
+/**
+ * A cached rendering of one major division of the grid
+ *
+ * The tile must outlive a single frame, so it belongs to the caller (e.g. BbGrid).
+ */
+typedef struct _BbGridTile BbGridTile;
+
 
 #define BB_TYPE_GRAPHICS bb_graphics_get_type()
 G_DECLARE_FINAL_TYPE(BbGraphics, bb_graphics, BB, GRAPHICS, GObject)
@@ -30,6 +43,33 @@ bb_graphics_get_cairo(BbGraphics *graphics);
 GtkStyleContext*
 bb_graphics_get_style(BbGraphics *graphics);
 
+/**
+ * Get the policy for simplifying features too small to be legible
+ *
+ * @param graphics A graphics
+ * @return The detail policy, owned by the graphics, or NULL if everything is drawn at full detail
+ */
+BbDetailPolicy*
+bb_graphics_get_detail_policy(BbGraphics *graphics);
+
+/**
+ * Get the cache used for the paths of items
+ *
+ * @param graphics A graphics
+ * @return The path cache, owned by the graphics, or NULL if paths are not cached
+ */
+BbPathCache*
+bb_graphics_get_path_cache(BbGraphics *graphics);
+
+/**
+ * Get the cache used for text layouts
+ *
+ * @param graphics A graphics
+ * @return The text cache, owned by the graphics
+ */
+BbTextCache*
+bb_graphics_get_text_cache(BbGraphics *graphics);
+
 cairo_matrix_t*
 bb_graphics_get_widget_matrix(BbGraphics *graphics);
 
@@ -37,6 +77,19 @@ bb_graphics_get_widget_matrix(BbGraphics *graphics);
 void
 bb_graphics_draw_grid(BbGraphics *graphics, int grid_size);
 
+/**
+ * Draw the grid by filling the view with a repeating tile
+ *
+ * The tile is recreated only when the grid size or the zoom changes. Falls back to bb_graphics_draw_grid() when
+ * the transform does not allow a seamless tile.
+ *
+ * @param graphics
+ * @param grid_size The distance between grid lines, in user units
+ * @param tile The cache for the tile
+ */
+void
+bb_graphics_draw_grid_tiled(BbGraphics *graphics, int grid_size, BbGridTile *tile);
+
 /**
  * Draw a selection box
  *
@@ -50,6 +103,61 @@ void
 bb_graphics_draw_select_box(BbGraphics *graphics, int x0, int y0, int x1, int y1);
 
 
+/**
+ * Draw text
+ *
+ * Called directly when replaying a display list, and through the item renderer otherwise. Text too small to be
+ * legible, according to the detail policy, is drawn as boxes without shaping.
+ *
+ * @param graphics A graphics
+ * @param insert_x The x coordinate of the insertion point
+ * @param insert_y The y coordinate of the insertion point
+ * @param alignment The alignment of the text relative to the insertion point
+ * @param radians The rotation of the text
+ * @param size The text size, in points, as used in schematic files
+ * @param text The text, in Pango markup
+ */
+void
+bb_graphics_draw_text(
+    BbGraphics *graphics,
+    int insert_x,
+    int insert_y,
+    BbTextAlignment alignment,
+    double radians,
+    int size,
+    const char *text
+    );
+
+
+/**
+ * Measure text as drawn by bb_graphics_draw_text()
+ *
+ * The transform of the cairo context affects hinting, so measurements use a context and cache separate from
+ * rendering. With an identity transform and unhinted metrics, the result is independent of the zoom.
+ *
+ * @param cache The text cache providing the layout
+ * @param cairo A cairo context with the identity transform
+ * @param insert_x The x coordinate of the insertion point
+ * @param insert_y The y coordinate of the insertion point
+ * @param alignment The alignment of the text relative to the insertion point
+ * @param radians The rotation of the text
+ * @param size The text size, in points, as used in schematic files
+ * @param text The text, in Pango markup
+ * @return The bounds of the text, in schematic coordinates, free with bb_bounds_free()
+ */
+BbBounds*
+bb_graphics_measure_text(
+    BbTextCache *cache,
+    cairo_t *cairo,
+    int insert_x,
+    int insert_y,
+    BbTextAlignment alignment,
+    double radians,
+    int size,
+    const char *text
+    );
+
+
 /**
  * Draw a zoom box
  *
@@ -68,9 +176,45 @@ bb_graphics_draw_zoom_box(BbGraphics *graphics, int x0, int y0, int x1, int y1);
  * @param cairo
  * @param widget_matrix A matrix for converting widget coordinates to window coordinates
  * @param style
+ * @param text_cache A cache of text layouts, which should outlive a single frame, or NULL to use a private cache
+ * @param path_cache A cache of item paths, which should outlive a single frame, or NULL to build paths each frame
+ * @param detail_policy A policy for simplifying small features, or NULL to draw everything at full detail
  * @return
  */
 BbGraphics*
-bb_graphics_new(cairo_t *cairo, cairo_matrix_t *widget_matrix, gboolean reveal, GtkStyleContext *style);
+bb_graphics_new(
+    cairo_t *cairo,
+    cairo_matrix_t *widget_matrix,
+    gboolean reveal,
+    GtkStyleContext *style,
+    BbTextCache *text_cache,
+    BbPathCache *path_cache,
+    BbDetailPolicy *detail_policy
+    );
+
+/**
+ * Set the cairo source to a schematic color
+ *
+ * @param graphics A graphics
+ * @param color The color index, e.g. BB_COLOR_GRAPHIC
+ */
+void
+bb_graphics_set_source_color(BbGraphics *graphics, int color);
+
+/**
+ * Free a grid tile
+ *
+ * @param tile The grid tile to free
+ */
+void
+bb_grid_tile_free(BbGridTile *tile);
+
+/**
+ * Create an empty grid tile
+ *
+ * @return A grid tile, free with bb_grid_tile_free()
+ */
+BbGridTile*
+bb_grid_tile_new();
 
 #endif
@@ -31,6 +31,7 @@ enum
     PROP_DRAW_SIZE,
     PROP_SNAP_SIZE,
     PROP_RECEIVER,
+    PROP_TILED,
     N_PROPERTIES
 };
 
@@ -44,6 +45,16 @@ struct _BbGrid
     int draw_index;
 
     BbToolSubject *subject;
+
+    /**
+     * Draw the grid with a repeating tile, instead of line by line
+     */
+    gboolean tiled;
+
+    /**
+     * The cached tile, recreated when the grid size or zoom changes
+     */
+    BbGridTile *tile;
 };
 
 
@@ -68,6 +79,9 @@ bb_grid_set_property(GObject *object, guint property_id, const GValue *value, GP
 static void
 bb_grid_set_subject(BbGrid *grid, BbToolSubject *subject);
 
+static void
+bb_grid_set_tiled(BbGrid *grid, gboolean tiled);
+
 
 GParamSpec *properties[N_PROPERTIES];
 
@@ -196,6 +210,17 @@ bb_grid_class_init(BbGridClass *klasse)
             )
         );
 
+    properties[PROP_TILED] = bb_object_class_install_property(
+        object_class,
+        PROP_TILED,
+        g_param_spec_boolean(
+            "tiled",
+            "",
+            "",
+            TRUE,
+            G_PARAM_READWRITE
+            )
+        );
 }
 
 
@@ -212,6 +237,10 @@ bb_grid_dispose(GObject *object)
 static void
 bb_grid_finalize(GObject *object)
 {
+    BbGrid *grid = BB_GRID(object);
+    g_return_if_fail(grid != NULL);
+
+    g_clear_pointer(&grid->tile, bb_grid_tile_free);
 }
 
 
@@ -301,6 +330,10 @@ bb_grid_get_property(GObject *object, guint property_id, GValue *value, GParamSp
             g_value_set_object(value, bb_grid_get_subject(BB_GRID(object)));
             break;
 
+        case PROP_TILED:
+            g_value_set_boolean(value, bb_grid_get_tiled(BB_GRID(object)));
+            break;
+
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
     }
@@ -325,11 +358,22 @@ bb_grid_get_subject(BbGrid *grid)
 }
 
 
+gboolean
+bb_grid_get_tiled(BbGrid *grid)
+{
+    g_return_val_if_fail(BB_IS_GRID(grid), FALSE);
+
+    return grid->tiled;
+}
+
+
 static void
 bb_grid_init(BbGrid *grid)
 {
     grid->snap_index = 3;
     grid->draw_index = 3;
+    grid->tiled = TRUE;
+    grid->tile = bb_grid_tile_new();
 }
 
 void
@@ -379,7 +423,14 @@ bb_grid_draw(BbGrid *grid, BbGraphics *graphics)
 {
     g_return_if_fail(BB_IS_GRID(grid));
 
-    bb_graphics_draw_grid(graphics, bb_grid_get_draw_size(grid));
+    if (grid->tiled)
+    {
+        bb_graphics_draw_grid_tiled(graphics, bb_grid_get_draw_size(grid), grid->tile);
+    }
+    else
+    {
+        bb_graphics_draw_grid(graphics, bb_grid_get_draw_size(grid));
+    }
 }
 
 
@@ -430,6 +481,10 @@ bb_grid_set_property(GObject *object, guint property_id, const GValue *value, GP
             bb_grid_set_subject(BB_GRID(object), g_value_get_object(value));
             break;
 
+        case PROP_TILED:
+            bb_grid_set_tiled(BB_GRID(object), g_value_get_boolean(value));
+            break;
+
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
     }
@@ -460,3 +515,17 @@ bb_grid_set_subject(BbGrid *grid, BbToolSubject *subject)
 }
 
 
+static void
+bb_grid_set_tiled(BbGrid *grid, gboolean tiled)
+{
+    g_return_if_fail(BB_IS_GRID(grid));
+
+    if (grid->tiled != tiled)
+    {
+        grid->tiled = tiled;
+
+        bb_tool_subject_invalidate_all(grid->subject);
+
+        g_object_notify_by_pspec(G_OBJECT(grid), properties[PROP_TILED]);
+    }
+}
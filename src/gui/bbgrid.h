@@ -52,6 +52,15 @@ bb_grid_get_snap_size(BbGrid *grid);
 BbToolSubject*
 bb_grid_get_subject(BbGrid *grid);
 
+/**
+ * Indicates the grid is drawn with a repeating tile, instead of line by line
+ *
+ * @param grid A grid
+ * @return TRUE if the grid is drawn with a tile
+ */
+gboolean
+bb_grid_get_tiled(BbGrid *grid);
+
 BbGrid*
 bb_grid_new(BbToolSubject *tool_subject);
 
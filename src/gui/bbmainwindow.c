@@ -35,6 +35,7 @@
 #include "actions/bbredoaction.h"
 #include "actions/bbsaveaction.h"
 #include "actions/bbsaveallaction.h"
+#include "actions/bbsavereceiver.h"
 #include "actions/bbsaveasaction.h"
 #include "actions/bbreloadaction.h"
 #include "bbfillstyleeditor.h"
@@ -100,10 +101,20 @@ struct _BbMainWindow
     BbGeneralOpener *general_opener;
     BbToolStack *tool_stack;
 
+    /**
+     * Opens files, reporting progress in open_progress while batches are in progress
+     */
+    BbOpenAction *open_action;
+    GtkWidget *open_progress;
+    GtkWidget *open_progress_bar;
+
     GSList *document_actions;
 };
 
 
+static void
+bb_main_window_cancel_open(BbMainWindow *window, GtkButton *button);
+
 static gboolean
 bb_main_window_key_pressed_cb(GtkWidget *unused, GdkEvent *event, BbMainWindow *window);
 
@@ -199,10 +210,35 @@ bb_main_window_quit_receiver_init(BbQuitReceiverInterface *iface)
 
 // region From BbSaveAllReceiver interface
 
+static GSList*
+bb_main_window_get_save_receivers(BbSaveAllReceiver *receiver)
+{
+    BbMainWindow *window = BB_MAIN_WINDOW(receiver);
+    g_return_val_if_fail(window != NULL, NULL);
+    g_return_val_if_fail(window->document_notebook != NULL, NULL);
+
+    GSList *receivers = NULL;
+    gint count = gtk_notebook_get_n_pages(window->document_notebook);
+
+    for (gint page_num = count - 1; page_num >= 0; page_num--)
+    {
+        GtkWidget *page = gtk_notebook_get_nth_page(window->document_notebook, page_num);
+
+        if (BB_IS_SAVE_RECEIVER(page))
+        {
+            receivers = g_slist_prepend(receivers, g_object_ref(page));
+        }
+    }
+
+    return receivers;
+}
+
 static void
 bb_main_window_save_all_receiver_init(BbSaveAllReceiverInterface *iface)
 {
     g_return_if_fail(iface != NULL);
+
+    iface->get_save_receivers = bb_main_window_get_save_receivers;
 }
 
 // endregion
@@ -364,6 +400,21 @@ bb_main_window_add_page(BbMainWindow *window, BbDocumentWindow *page)
 }
 
 
+/**
+ * Cancel opening the files remaining in every batch
+ *
+ * @param window The main window
+ * @param button The cancel button next to the progress bar
+ */
+static void
+bb_main_window_cancel_open(BbMainWindow *window, GtkButton *button)
+{
+    g_return_if_fail(BB_IS_MAIN_WINDOW(window));
+
+    bb_open_action_cancel(window->open_action);
+}
+
+
 static void
 bb_main_window_class_init(BbMainWindowClass *class)
 {
@@ -430,6 +481,23 @@ bb_main_window_class_init(BbMainWindowClass *class)
         document_notebook
         );
 
+    gtk_widget_class_bind_template_child(
+        GTK_WIDGET_CLASS(class),
+        BbMainWindow,
+        open_progress
+        );
+
+    gtk_widget_class_bind_template_child(
+        GTK_WIDGET_CLASS(class),
+        BbMainWindow,
+        open_progress_bar
+        );
+
+    gtk_widget_class_bind_template_callback(
+        GTK_WIDGET_CLASS(class),
+        bb_main_window_cancel_open
+        );
+
     gtk_widget_class_bind_template_callback(
         GTK_WIDGET_CLASS(class),
         bb_main_window_notify_page_num
@@ -474,6 +542,7 @@ bb_main_window_dispose(GObject *object)
 
     g_set_object(&window->current_page, NULL);
     g_clear_object(&window->extensions);
+    g_clear_object(&window->open_action);
 
     G_OBJECT_CLASS(bb_main_window_parent_class)->dispose(object);
 }
@@ -537,11 +606,16 @@ bb_main_window_init(BbMainWindow *window)
 
     gtk_widget_init_template(GTK_WIDGET(window));
 
+    window->open_action = bb_open_action_new(BB_OPEN_RECEIVER(window));
+
     g_action_map_add_action(
         G_ACTION_MAP(window),
-        G_ACTION(bb_open_action_new(BB_OPEN_RECEIVER(window)))
+        G_ACTION(window->open_action)
         );
 
+    g_object_bind_property(window->open_action, "busy", window->open_progress, "visible", G_BINDING_SYNC_CREATE);
+    g_object_bind_property(window->open_action, "fraction", window->open_progress_bar, "fraction", G_BINDING_SYNC_CREATE);
+
     g_action_map_add_action(
         G_ACTION_MAP(window),
         G_ACTION(bb_quit_action_new(BB_QUIT_RECEIVER(window)))
@@ -0,0 +1,358 @@
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtk/gtk.h>
+#include <bbextensions.h>
+#include "bbpathcache.h"
+
+
+enum
+{
+    PROP_0,
+    PROP_CAPACITY,
+    PROP_HITS,
+    PROP_MISSES,
+    N_PROPERTIES
+};
+
+
+typedef struct _BbPathCacheEntry BbPathCacheEntry;
+
+struct _BbPathCacheEntry
+{
+    /**
+     * The position of this entry in the usage order, with the data pointing to this entry
+     */
+    GList link;
+
+    gconstpointer item;
+    guint revision;
+    cairo_path_t *path;
+};
+
+
+struct _BbPathCache
+{
+    GObject parent;
+
+    guint capacity;
+
+    /**
+     * The set of BbPathCacheEntry, hashed by item
+     */
+    GHashTable *entries;
+
+    /**
+     * The entries ordered from most recently used to least recently used
+     */
+    GQueue order;
+
+    guint64 hits;
+    guint64 misses;
+};
+
+
+G_DEFINE_TYPE(BbPathCache, bb_path_cache, G_TYPE_OBJECT)
+
+
+static void
+bb_path_cache_dispose(GObject *object);
+
+static void
+bb_path_cache_entry_free(gpointer data);
+
+static void
+bb_path_cache_finalize(GObject *object);
+
+static void
+bb_path_cache_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
+
+static void
+bb_path_cache_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
+
+
+static GParamSpec *properties[N_PROPERTIES];
+
+
+static void
+bb_path_cache_class_init(BbPathCacheClass *klasse)
+{
+    GObjectClass *object_class = G_OBJECT_CLASS(klasse);
+    g_return_if_fail(object_class != NULL);
+
+    object_class->dispose = bb_path_cache_dispose;
+    object_class->finalize = bb_path_cache_finalize;
+    object_class->get_property = bb_path_cache_get_property;
+    object_class->set_property = bb_path_cache_set_property;
+
+    properties[PROP_CAPACITY] = bb_object_class_install_property(
+        object_class,
+        PROP_CAPACITY,
+        g_param_spec_uint(
+            "capacity",
+            "",
+            "",
+            1,
+            G_MAXUINT,
+            BB_PATH_CACHE_DEFAULT_CAPACITY,
+            G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY
+            )
+        );
+
+    properties[PROP_HITS] = bb_object_class_install_property(
+        object_class,
+        PROP_HITS,
+        g_param_spec_uint64(
+            "hits",
+            "",
+            "",
+            0,
+            G_MAXUINT64,
+            0,
+            G_PARAM_READABLE
+            )
+        );
+
+    properties[PROP_MISSES] = bb_object_class_install_property(
+        object_class,
+        PROP_MISSES,
+        g_param_spec_uint64(
+            "misses",
+            "",
+            "",
+            0,
+            G_MAXUINT64,
+            0,
+            G_PARAM_READABLE
+            )
+        );
+}
+
+
+static void
+bb_path_cache_dispose(GObject *object)
+{
+    BbPathCache *cache = BB_PATH_CACHE(object);
+    g_return_if_fail(cache != NULL);
+
+    if (cache->entries != NULL)
+    {
+        bb_path_cache_invalidate(cache);
+    }
+
+    G_OBJECT_CLASS(bb_path_cache_parent_class)->dispose(object);
+}
+
+
+static void
+bb_path_cache_entry_free(gpointer data)
+{
+    BbPathCacheEntry *entry = data;
+
+    if (entry != NULL)
+    {
+        g_clear_pointer(&entry->path, cairo_path_destroy);
+
+        g_slice_free(BbPathCacheEntry, entry);
+    }
+}
+
+
+static void
+bb_path_cache_finalize(GObject *object)
+{
+    BbPathCache *cache = BB_PATH_CACHE(object);
+    g_return_if_fail(cache != NULL);
+
+    g_clear_pointer(&cache->entries, g_hash_table_destroy);
+
+    G_OBJECT_CLASS(bb_path_cache_parent_class)->finalize(object);
+}
+
+
+guint
+bb_path_cache_get_capacity(BbPathCache *cache)
+{
+    g_return_val_if_fail(BB_IS_PATH_CACHE(cache), 0);
+
+    return cache->capacity;
+}
+
+
+guint64
+bb_path_cache_get_hits(BbPathCache *cache)
+{
+    g_return_val_if_fail(BB_IS_PATH_CACHE(cache), 0);
+
+    return cache->hits;
+}
+
+
+guint64
+bb_path_cache_get_misses(BbPathCache *cache)
+{
+    g_return_val_if_fail(BB_IS_PATH_CACHE(cache), 0);
+
+    return cache->misses;
+}
+
+
+static void
+bb_path_cache_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec)
+{
+    switch (property_id)
+    {
+        case PROP_CAPACITY:
+            g_value_set_uint(value, bb_path_cache_get_capacity(BB_PATH_CACHE(object)));
+            break;
+
+        case PROP_HITS:
+            g_value_set_uint64(value, bb_path_cache_get_hits(BB_PATH_CACHE(object)));
+            break;
+
+        case PROP_MISSES:
+            g_value_set_uint64(value, bb_path_cache_get_misses(BB_PATH_CACHE(object)));
+            break;
+
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+    }
+}
+
+
+static void
+bb_path_cache_init(BbPathCache *cache)
+{
+    g_return_if_fail(BB_IS_PATH_CACHE(cache));
+
+    cache->capacity = BB_PATH_CACHE_DEFAULT_CAPACITY;
+
+    /* The entries are keyed by their item field, so the hash table owns only the values */
+
+    cache->entries = g_hash_table_new_full(
+        g_direct_hash,
+        g_direct_equal,
+        NULL,
+        bb_path_cache_entry_free
+        );
+
+    g_queue_init(&cache->order);
+}
+
+
+void
+bb_path_cache_insert(BbPathCache *cache, gconstpointer item, guint revision, cairo_path_t *path)
+{
+    g_return_if_fail(BB_IS_PATH_CACHE(cache));
+    g_return_if_fail(item != NULL);
+    g_return_if_fail(path != NULL);
+
+    BbPathCacheEntry *entry = g_hash_table_lookup(cache->entries, item);
+
+    if (entry != NULL)
+    {
+        g_queue_unlink(&cache->order, &entry->link);
+
+        cairo_path_destroy(entry->path);
+    }
+    else
+    {
+        while (cache->order.length >= cache->capacity)
+        {
+            GList *oldest = g_queue_peek_tail_link(&cache->order);
+            BbPathCacheEntry *evicted = oldest->data;
+
+            g_queue_unlink(&cache->order, oldest);
+            g_hash_table_remove(cache->entries, evicted->item);
+        }
+
+        entry = g_slice_new0(BbPathCacheEntry);
+
+        entry->link.data = entry;
+        entry->item = item;
+
+        g_hash_table_insert(cache->entries, (gpointer) item, entry);
+    }
+
+    entry->revision = revision;
+    entry->path = path;
+
+    g_queue_push_head_link(&cache->order, &entry->link);
+}
+
+
+void
+bb_path_cache_invalidate(BbPathCache *cache)
+{
+    g_return_if_fail(BB_IS_PATH_CACHE(cache));
+
+    /* The links are embedded in the entries, so the queue is emptied before the entries are freed */
+
+    g_queue_init(&cache->order);
+    g_hash_table_remove_all(cache->entries);
+}
+
+
+const cairo_path_t*
+bb_path_cache_lookup(BbPathCache *cache, gconstpointer item, guint revision)
+{
+    g_return_val_if_fail(BB_IS_PATH_CACHE(cache), NULL);
+
+    BbPathCacheEntry *entry = g_hash_table_lookup(cache->entries, item);
+
+    if (entry == NULL || entry->revision != revision)
+    {
+        cache->misses++;
+
+        return NULL;
+    }
+
+    cache->hits++;
+
+    g_queue_unlink(&cache->order, &entry->link);
+    g_queue_push_head_link(&cache->order, &entry->link);
+
+    return entry->path;
+}
+
+
+BbPathCache*
+bb_path_cache_new(guint capacity)
+{
+    return BB_PATH_CACHE(g_object_new(
+        BB_TYPE_PATH_CACHE,
+        "capacity", capacity,
+        NULL
+        ));
+}
+
+
+static void
+bb_path_cache_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec)
+{
+    switch (property_id)
+    {
+        case PROP_CAPACITY:
+            BB_PATH_CACHE(object)->capacity = g_value_get_uint(value);
+            break;
+
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+    }
+}
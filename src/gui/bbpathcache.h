@@ -0,0 +1,124 @@
+#ifndef __BBPATHCACHE__
+#define __BBPATHCACHE__
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file bbpathcache.h
+ *
+ * A least recently used cache of the paths of schematic items
+ *
+ * Building the path of an arc or a long path command by command, through the item renderer, is repeated for every
+ * repaint. The cache keeps a copy of each path, in user coordinates, so a repaint appends the whole path at once.
+ * Entries are keyed by the item and its geometry revision. Editing an item bumps the revision, so the stale entry
+ * misses and is replaced. Revisions are never reused, so an entry for a destroyed item cannot match another item
+ * allocated at the same address; it remains until evicted.
+ */
+
+#include <gtk/gtk.h>
+
+
+/**
+ * The default number of paths retained by the cache
+ */
+#define BB_PATH_CACHE_DEFAULT_CAPACITY (16384)
+
+
+#define BB_TYPE_PATH_CACHE bb_path_cache_get_type()
+G_DECLARE_FINAL_TYPE(BbPathCache, bb_path_cache, BB, PATH_CACHE, GObject)
+
+
+/**
+ * Get the maximum number of paths retained by the cache
+ *
+ * @param cache A path cache
+ * @return The maximum number of paths
+ */
+guint
+bb_path_cache_get_capacity(BbPathCache *cache);
+
+
+/**
+ * Get the number of lookups satisfied from the cache
+ *
+ * @param cache A path cache
+ * @return The number of hits since creation
+ */
+guint64
+bb_path_cache_get_hits(BbPathCache *cache);
+
+
+/**
+ * Get the number of lookups requiring the path to be built
+ *
+ * @param cache A path cache
+ * @return The number of misses since creation
+ */
+guint64
+bb_path_cache_get_misses(BbPathCache *cache);
+
+
+/**
+ * Add the path of an item to the cache
+ *
+ * Replaces any path cached for a previous revision of the item.
+ *
+ * @param cache A path cache
+ * @param item The item, used only as a key
+ * @param revision The geometry revision of the item
+ * @param path The path, in user coordinates, from cairo_copy_path(). The cache takes ownership.
+ */
+void
+bb_path_cache_insert(BbPathCache *cache, gconstpointer item, guint revision, cairo_path_t *path);
+
+
+/**
+ * Discard all paths in the cache
+ *
+ * The hit and miss counters are not reset.
+ *
+ * @param cache A path cache
+ */
+void
+bb_path_cache_invalidate(BbPathCache *cache);
+
+
+/**
+ * Get the path of an item
+ *
+ * The path belongs to the cache and remains valid until the next call to a function of the cache.
+ *
+ * @param cache A path cache
+ * @param item The item, used only as a key
+ * @param revision The current geometry revision of the item
+ * @return The path, or NULL if the cache does not contain the path for this revision
+ */
+const cairo_path_t*
+bb_path_cache_lookup(BbPathCache *cache, gconstpointer item, guint revision);
+
+
+/**
+ * Create a new path cache
+ *
+ * @param capacity The maximum number of paths to retain
+ * @return A new path cache
+ */
+BbPathCache*
+bb_path_cache_new(guint capacity);
+
+#endif
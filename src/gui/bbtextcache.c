@@ -0,0 +1,432 @@
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtk/gtk.h>
+#include <bbextensions.h>
+#include "bbtextcache.h"
+
+
+/**
+ * The font family for all schematic text
+ */
+#define BB_TEXT_CACHE_FONT_FAMILY "Sans"
+
+
+enum
+{
+    PROP_0,
+    PROP_CAPACITY,
+    PROP_HITS,
+    PROP_MISSES,
+    N_PROPERTIES
+};
+
+
+typedef struct _BbTextCacheEntry BbTextCacheEntry;
+
+struct _BbTextCacheEntry
+{
+    /**
+     * The position of this entry in the usage order, with the data pointing to this entry
+     */
+    GList link;
+
+    int size;
+    gchar *markup;
+    PangoLayout *layout;
+};
+
+
+struct _BbTextCache
+{
+    GObject parent;
+
+    guint capacity;
+
+    /**
+     * Shared by all layouts, so changes propagate to the layouts without recreating them
+     */
+    PangoContext *context;
+
+    /**
+     * The font for all text, with the size set before assigning to a layout
+     */
+    PangoFontDescription *font_description;
+
+    cairo_font_options_t *font_options;
+
+    /**
+     * The set of BbTextCacheEntry, hashed by size and markup
+     */
+    GHashTable *entries;
+
+    /**
+     * The entries ordered from most recently used to least recently used
+     */
+    GQueue order;
+
+    guint64 hits;
+    guint64 misses;
+};
+
+
+G_DEFINE_TYPE(BbTextCache, bb_text_cache, G_TYPE_OBJECT)
+
+
+static void
+bb_text_cache_dispose(GObject *object);
+
+static gboolean
+bb_text_cache_entry_equal(gconstpointer a, gconstpointer b);
+
+static void
+bb_text_cache_entry_free(gpointer data);
+
+static guint
+bb_text_cache_entry_hash(gconstpointer key);
+
+static void
+bb_text_cache_finalize(GObject *object);
+
+static void
+bb_text_cache_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
+
+static void
+bb_text_cache_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
+
+
+static GParamSpec *properties[N_PROPERTIES];
+
+
+static void
+bb_text_cache_class_init(BbTextCacheClass *klasse)
+{
+    GObjectClass *object_class = G_OBJECT_CLASS(klasse);
+    g_return_if_fail(object_class != NULL);
+
+    object_class->dispose = bb_text_cache_dispose;
+    object_class->finalize = bb_text_cache_finalize;
+    object_class->get_property = bb_text_cache_get_property;
+    object_class->set_property = bb_text_cache_set_property;
+
+    properties[PROP_CAPACITY] = bb_object_class_install_property(
+        object_class,
+        PROP_CAPACITY,
+        g_param_spec_uint(
+            "capacity",
+            "",
+            "",
+            1,
+            G_MAXUINT,
+            BB_TEXT_CACHE_DEFAULT_CAPACITY,
+            G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY
+            )
+        );
+
+    properties[PROP_HITS] = bb_object_class_install_property(
+        object_class,
+        PROP_HITS,
+        g_param_spec_uint64(
+            "hits",
+            "",
+            "",
+            0,
+            G_MAXUINT64,
+            0,
+            G_PARAM_READABLE
+            )
+        );
+
+    properties[PROP_MISSES] = bb_object_class_install_property(
+        object_class,
+        PROP_MISSES,
+        g_param_spec_uint64(
+            "misses",
+            "",
+            "",
+            0,
+            G_MAXUINT64,
+            0,
+            G_PARAM_READABLE
+            )
+        );
+}
+
+
+static void
+bb_text_cache_dispose(GObject *object)
+{
+    BbTextCache *cache = BB_TEXT_CACHE(object);
+    g_return_if_fail(cache != NULL);
+
+    if (cache->entries != NULL)
+    {
+        bb_text_cache_invalidate(cache);
+    }
+
+    g_clear_object(&cache->context);
+
+    G_OBJECT_CLASS(bb_text_cache_parent_class)->dispose(object);
+}
+
+
+static gboolean
+bb_text_cache_entry_equal(gconstpointer a, gconstpointer b)
+{
+    const BbTextCacheEntry *entry_a = a;
+    const BbTextCacheEntry *entry_b = b;
+
+    return (entry_a->size == entry_b->size) && (g_strcmp0(entry_a->markup, entry_b->markup) == 0);
+}
+
+
+static void
+bb_text_cache_entry_free(gpointer data)
+{
+    BbTextCacheEntry *entry = data;
+
+    if (entry != NULL)
+    {
+        g_clear_object(&entry->layout);
+        g_free(entry->markup);
+
+        g_slice_free(BbTextCacheEntry, entry);
+    }
+}
+
+
+static guint
+bb_text_cache_entry_hash(gconstpointer key)
+{
+    const BbTextCacheEntry *entry = key;
+
+    return g_str_hash(entry->markup) ^ (guint) entry->size;
+}
+
+
+static void
+bb_text_cache_finalize(GObject *object)
+{
+    BbTextCache *cache = BB_TEXT_CACHE(object);
+    g_return_if_fail(cache != NULL);
+
+    g_clear_pointer(&cache->entries, g_hash_table_destroy);
+    g_clear_pointer(&cache->font_description, pango_font_description_free);
+    g_clear_pointer(&cache->font_options, cairo_font_options_destroy);
+
+    G_OBJECT_CLASS(bb_text_cache_parent_class)->finalize(object);
+}
+
+
+guint
+bb_text_cache_get_capacity(BbTextCache *cache)
+{
+    g_return_val_if_fail(BB_IS_TEXT_CACHE(cache), 0);
+
+    return cache->capacity;
+}
+
+
+guint64
+bb_text_cache_get_hits(BbTextCache *cache)
+{
+    g_return_val_if_fail(BB_IS_TEXT_CACHE(cache), 0);
+
+    return cache->hits;
+}
+
+
+guint64
+bb_text_cache_get_misses(BbTextCache *cache)
+{
+    g_return_val_if_fail(BB_IS_TEXT_CACHE(cache), 0);
+
+    return cache->misses;
+}
+
+
+static void
+bb_text_cache_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec)
+{
+    switch (property_id)
+    {
+        case PROP_CAPACITY:
+            g_value_set_uint(value, bb_text_cache_get_capacity(BB_TEXT_CACHE(object)));
+            break;
+
+        case PROP_HITS:
+            g_value_set_uint64(value, bb_text_cache_get_hits(BB_TEXT_CACHE(object)));
+            break;
+
+        case PROP_MISSES:
+            g_value_set_uint64(value, bb_text_cache_get_misses(BB_TEXT_CACHE(object)));
+            break;
+
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+    }
+}
+
+
+static void
+bb_text_cache_init(BbTextCache *cache)
+{
+    g_return_if_fail(BB_IS_TEXT_CACHE(cache));
+
+    cache->capacity = BB_TEXT_CACHE_DEFAULT_CAPACITY;
+
+    /* The resolution stays at the font map default, so text has the same size in schematic units on all displays */
+    cache->context = pango_font_map_create_context(pango_cairo_font_map_get_default());
+
+    cache->font_description = pango_font_description_from_string(BB_TEXT_CACHE_FONT_FAMILY);
+
+    cache->entries = g_hash_table_new_full(
+        bb_text_cache_entry_hash,
+        bb_text_cache_entry_equal,
+        bb_text_cache_entry_free,
+        NULL
+        );
+
+    g_queue_init(&cache->order);
+}
+
+
+void
+bb_text_cache_invalidate(BbTextCache *cache)
+{
+    g_return_if_fail(BB_IS_TEXT_CACHE(cache));
+
+    /* The links are embedded in the entries, so the queue is emptied before the entries are freed */
+
+    g_queue_init(&cache->order);
+    g_hash_table_remove_all(cache->entries);
+}
+
+
+PangoLayout*
+bb_text_cache_lookup(BbTextCache *cache, cairo_t *cairo, int size, const char *markup)
+{
+    g_return_val_if_fail(BB_IS_TEXT_CACHE(cache), NULL);
+    g_return_val_if_fail(cairo != NULL, NULL);
+    g_return_val_if_fail(markup != NULL, NULL);
+
+    /* Only bumps the context serial if the transform or target changed since the previous lookup */
+    pango_cairo_update_context(cairo, cache->context);
+
+    BbTextCacheEntry key;
+
+    key.size = size;
+    key.markup = (gchar*) markup;
+
+    BbTextCacheEntry *entry = g_hash_table_lookup(cache->entries, &key);
+
+    if (entry != NULL)
+    {
+        cache->hits++;
+
+        g_queue_unlink(&cache->order, &entry->link);
+    }
+    else
+    {
+        cache->misses++;
+
+        entry = g_slice_new0(BbTextCacheEntry);
+
+        entry->link.data = entry;
+        entry->size = size;
+        entry->markup = g_strdup(markup);
+        entry->layout = pango_layout_new(cache->context);
+
+        pango_font_description_set_size(cache->font_description, 10 * size * PANGO_SCALE);
+        pango_layout_set_font_description(entry->layout, cache->font_description);
+        pango_layout_set_spacing(entry->layout, 40000);
+        pango_layout_set_markup(entry->layout, markup, -1);
+
+        g_hash_table_add(cache->entries, entry);
+
+        while (cache->order.length >= cache->capacity)
+        {
+            GList *oldest = g_queue_peek_tail_link(&cache->order);
+
+            g_queue_unlink(&cache->order, oldest);
+            g_hash_table_remove(cache->entries, oldest->data);
+        }
+    }
+
+    g_queue_push_head_link(&cache->order, &entry->link);
+
+    return entry->layout;
+}
+
+
+BbTextCache*
+bb_text_cache_new(guint capacity)
+{
+    return BB_TEXT_CACHE(g_object_new(
+        BB_TYPE_TEXT_CACHE,
+        "capacity", capacity,
+        NULL
+        ));
+}
+
+
+void
+bb_text_cache_set_font_options(BbTextCache *cache, const cairo_font_options_t *options)
+{
+    g_return_if_fail(BB_IS_TEXT_CACHE(cache));
+
+    gboolean changed;
+
+    if (options == NULL || cache->font_options == NULL)
+    {
+        changed = (options != cache->font_options);
+    }
+    else
+    {
+        changed = !cairo_font_options_equal(options, cache->font_options);
+    }
+
+    if (changed)
+    {
+        g_clear_pointer(&cache->font_options, cairo_font_options_destroy);
+
+        if (options != NULL)
+        {
+            cache->font_options = cairo_font_options_copy(options);
+        }
+
+        pango_cairo_context_set_font_options(cache->context, cache->font_options);
+
+        bb_text_cache_invalidate(cache);
+    }
+}
+
+
+static void
+bb_text_cache_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec)
+{
+    switch (property_id)
+    {
+        case PROP_CAPACITY:
+            BB_TEXT_CACHE(object)->capacity = g_value_get_uint(value);
+            break;
+
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+    }
+}
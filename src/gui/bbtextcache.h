@@ -0,0 +1,122 @@
+#ifndef __BBTEXTCACHE__
+#define __BBTEXTCACHE__
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file bbtextcache.h
+ *
+ * A least recently used cache of shaped text layouts
+ *
+ * Creating a layout, parsing its markup, and shaping its glyphs dominates rendering schematics with many
+ * attributes. The cache keeps layouts across frames, so it must outlive the BbGraphics used for a single frame.
+ * All layouts share one PangoContext, which is updated from the cairo context on each lookup. Pango reshapes
+ * layouts lazily when the context changes (e.g. zooming or a change in the device scale).
+ */
+
+#include <gtk/gtk.h>
+
+
+/**
+ * The default number of layouts retained by the cache
+ */
+#define BB_TEXT_CACHE_DEFAULT_CAPACITY (4096)
+
+
+#define BB_TYPE_TEXT_CACHE bb_text_cache_get_type()
+G_DECLARE_FINAL_TYPE(BbTextCache, bb_text_cache, BB, TEXT_CACHE, GObject)
+
+
+/**
+ * Get the maximum number of layouts retained by the cache
+ *
+ * @param cache A text cache
+ * @return The maximum number of layouts
+ */
+guint
+bb_text_cache_get_capacity(BbTextCache *cache);
+
+
+/**
+ * Get the number of lookups satisfied from the cache
+ *
+ * @param cache A text cache
+ * @return The number of hits since creation
+ */
+guint64
+bb_text_cache_get_hits(BbTextCache *cache);
+
+
+/**
+ * Get the number of lookups requiring a new layout
+ *
+ * @param cache A text cache
+ * @return The number of misses since creation
+ */
+guint64
+bb_text_cache_get_misses(BbTextCache *cache);
+
+
+/**
+ * Discard all layouts in the cache
+ *
+ * The hit and miss counters are not reset.
+ *
+ * @param cache A text cache
+ */
+void
+bb_text_cache_invalidate(BbTextCache *cache);
+
+
+/**
+ * Get a layout for the given text
+ *
+ * The layout belongs to the cache and remains valid until the next call to a function of the cache.
+ *
+ * @param cache A text cache
+ * @param cairo The cairo context, with the transform used for rendering the text
+ * @param size The text size, in points, as used in schematic files
+ * @param markup The text, in Pango markup
+ * @return The layout for the text
+ */
+PangoLayout*
+bb_text_cache_lookup(BbTextCache *cache, cairo_t *cairo, int size, const char *markup);
+
+
+/**
+ * Create a new text cache
+ *
+ * @param capacity The maximum number of layouts to retain
+ * @return A new text cache
+ */
+BbTextCache*
+bb_text_cache_new(guint capacity);
+
+
+/**
+ * Set the font options used for rendering text
+ *
+ * The cache is invalidated only when the options differ from the current ones. So, this function can be called
+ * for each frame with the options from the screen.
+ *
+ * @param cache A text cache
+ * @param options The font options, or NULL for the defaults
+ */
+void
+bb_text_cache_set_font_options(BbTextCache *cache, const cairo_font_options_t *options);
+
+#endif
@@ -0,0 +1,697 @@
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <math.h>
+#include <gtk/gtk.h>
+#include <bbextensions.h>
+#include "bbtilecache.h"
+
+
+/**
+ * The time, in microseconds, a frame may spend rendering tiles while stale tiles are available
+ *
+ * Without stale tiles to fill in, all missing tiles are rendered regardless of the time taken.
+ */
+#define BB_TILE_CACHE_BUDGET (8000)
+
+
+enum
+{
+    PROP_0,
+    PROP_CAPACITY,
+    N_PROPERTIES
+};
+
+
+typedef struct _BbTile BbTile;
+
+struct _BbTile
+{
+    /**
+     * The position of this tile in the usage order, with the data pointing to this tile
+     */
+    GList link;
+
+    /**
+     * The matrix converting schematic coordinates to the grid of tiles at this zoom level
+     *
+     * The translation of the editor matrix, less the whole pixels, so the matrix does not change when panning.
+     */
+    cairo_matrix_t level;
+
+    /**
+     * The column of the tile in the grid
+     */
+    int column;
+
+    /**
+     * The row of the tile in the grid
+     */
+    int row;
+
+    cairo_surface_t *surface;
+};
+
+
+struct _BbTileCache
+{
+    GObject parent;
+
+    guint capacity;
+
+    /**
+     * The set of BbTile, hashed by level, column, and row
+     */
+    GHashTable *tiles;
+
+    /**
+     * The tiles ordered from most recently used to least recently used
+     */
+    GQueue order;
+
+    /**
+     * The zoom level of the last frame drawn
+     */
+    cairo_matrix_t level;
+    gboolean has_level;
+
+    /**
+     * The zoom level before the last zoom, with tiles to fill in until the frame is complete
+     */
+    cairo_matrix_t stale;
+    gboolean has_stale;
+
+    /**
+     * The device scale of the surfaces used for tiles
+     */
+    double scale_x;
+    double scale_y;
+};
+
+
+G_DEFINE_TYPE(BbTileCache, bb_tile_cache, G_TYPE_OBJECT)
+
+
+static void
+bb_tile_cache_dispose(GObject *object);
+
+static void
+bb_tile_cache_draw_stale(BbTileCache *cache, cairo_t *cairo, const cairo_matrix_t *matrix, cairo_region_t *missing);
+
+static void
+bb_tile_cache_draw_tile(cairo_t *cairo, BbTile *tile, double x, double y);
+
+static void
+bb_tile_cache_finalize(GObject *object);
+
+static void
+bb_tile_cache_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
+
+static BbTile*
+bb_tile_cache_lookup(BbTileCache *cache, const cairo_matrix_t *level, int column, int row);
+
+static gboolean
+bb_tile_cache_matrix_equals(const cairo_matrix_t *a, const cairo_matrix_t *b);
+
+static void
+bb_tile_cache_remove(BbTileCache *cache, BbTile *tile);
+
+static BbTile*
+bb_tile_cache_render(
+    BbTileCache *cache,
+    cairo_surface_t *target,
+    int column,
+    int row,
+    BbTileRenderFunc render_func,
+    gpointer user_data
+    );
+
+static void
+bb_tile_cache_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
+
+static gboolean
+bb_tile_equal(gconstpointer a, gconstpointer b);
+
+static void
+bb_tile_free(gpointer data);
+
+static guint
+bb_tile_hash(gconstpointer key);
+
+
+static GParamSpec *properties[N_PROPERTIES];
+
+
+static void
+bb_tile_cache_class_init(BbTileCacheClass *klasse)
+{
+    GObjectClass *object_class = G_OBJECT_CLASS(klasse);
+    g_return_if_fail(object_class != NULL);
+
+    object_class->dispose = bb_tile_cache_dispose;
+    object_class->finalize = bb_tile_cache_finalize;
+    object_class->get_property = bb_tile_cache_get_property;
+    object_class->set_property = bb_tile_cache_set_property;
+
+    properties[PROP_CAPACITY] = bb_object_class_install_property(
+        object_class,
+        PROP_CAPACITY,
+        g_param_spec_uint(
+            "capacity",
+            "",
+            "",
+            1,
+            G_MAXUINT,
+            BB_TILE_CACHE_DEFAULT_CAPACITY,
+            G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY
+            )
+        );
+}
+
+
+static void
+bb_tile_cache_dispose(GObject *object)
+{
+    BbTileCache *cache = BB_TILE_CACHE(object);
+    g_return_if_fail(cache != NULL);
+
+    if (cache->tiles != NULL)
+    {
+        bb_tile_cache_invalidate(cache);
+    }
+
+    G_OBJECT_CLASS(bb_tile_cache_parent_class)->dispose(object);
+}
+
+
+gboolean
+bb_tile_cache_draw(
+    BbTileCache *cache,
+    cairo_t *cairo,
+    const cairo_matrix_t *matrix,
+    BbTileRenderFunc render_func,
+    gpointer user_data
+    )
+{
+    g_return_val_if_fail(BB_IS_TILE_CACHE(cache), TRUE);
+    g_return_val_if_fail(cairo != NULL, TRUE);
+    g_return_val_if_fail(matrix != NULL, TRUE);
+    g_return_val_if_fail(render_func != NULL, TRUE);
+
+    cairo_surface_t *target = cairo_get_target(cairo);
+    double scale_x;
+    double scale_y;
+
+    cairo_surface_get_device_scale(target, &scale_x, &scale_y);
+
+    if (scale_x != cache->scale_x || scale_y != cache->scale_y)
+    {
+        bb_tile_cache_invalidate(cache);
+
+        cache->scale_x = scale_x;
+        cache->scale_y = scale_y;
+    }
+
+    /* The editor snaps translations to whole pixels, so the whole pixels only shift the grid of tiles */
+
+    double origin_x = floor(matrix->x0);
+    double origin_y = floor(matrix->y0);
+    cairo_matrix_t level = *matrix;
+
+    level.x0 -= origin_x;
+    level.y0 -= origin_y;
+
+    if (!cache->has_level || !bb_tile_cache_matrix_equals(&level, &cache->level))
+    {
+        cache->has_stale = cache->has_level;
+        cache->stale = cache->level;
+
+        cache->has_level = TRUE;
+        cache->level = level;
+    }
+
+    double x0;
+    double y0;
+    double x1;
+    double y1;
+
+    cairo_clip_extents(cairo, &x0, &y0, &x1, &y1);
+
+    int min_column = (int) floor((x0 - origin_x) / BB_TILE_CACHE_TILE_SIZE);
+    int min_row = (int) floor((y0 - origin_y) / BB_TILE_CACHE_TILE_SIZE);
+    int max_column = (int) ceil((x1 - origin_x) / BB_TILE_CACHE_TILE_SIZE) - 1;
+    int max_row = (int) ceil((y1 - origin_y) / BB_TILE_CACHE_TILE_SIZE) - 1;
+
+    gint64 deadline = g_get_monotonic_time() + BB_TILE_CACHE_BUDGET;
+    cairo_region_t *missing = cairo_region_create();
+
+    for (int row = min_row; row <= max_row; row++)
+    {
+        for (int column = min_column; column <= max_column; column++)
+        {
+            double x = origin_x + column * BB_TILE_CACHE_TILE_SIZE;
+            double y = origin_y + row * BB_TILE_CACHE_TILE_SIZE;
+            BbTile *tile = bb_tile_cache_lookup(cache, &level, column, row);
+
+            if (tile == NULL && (!cache->has_stale || g_get_monotonic_time() < deadline))
+            {
+                tile = bb_tile_cache_render(cache, target, column, row, render_func, user_data);
+
+                if (tile == NULL)
+                {
+                    /* Without a surface for the tile, render the area directly */
+
+                    cairo_save(cairo);
+                    cairo_rectangle(cairo, x, y, BB_TILE_CACHE_TILE_SIZE, BB_TILE_CACHE_TILE_SIZE);
+                    cairo_clip(cairo);
+                    cairo_transform(cairo, matrix);
+                    render_func(cairo, user_data);
+                    cairo_restore(cairo);
+
+                    continue;
+                }
+            }
+
+            if (tile != NULL)
+            {
+                bb_tile_cache_draw_tile(cairo, tile, x, y);
+            }
+            else
+            {
+                cairo_rectangle_int_t rectangle = {
+                    .x = (int) x,
+                    .y = (int) y,
+                    .width = BB_TILE_CACHE_TILE_SIZE,
+                    .height = BB_TILE_CACHE_TILE_SIZE
+                };
+
+                cairo_region_union_rectangle(missing, &rectangle);
+            }
+        }
+    }
+
+    gboolean complete = cairo_region_is_empty(missing);
+
+    if (complete)
+    {
+        cache->has_stale = FALSE;
+    }
+    else
+    {
+        bb_tile_cache_draw_stale(cache, cairo, matrix, missing);
+    }
+
+    cairo_region_destroy(missing);
+
+    return complete;
+}
+
+
+/**
+ * Fill in missing tiles with the tiles from the previous zoom level
+ *
+ * @param cache A tile cache
+ * @param cairo The cairo context for the widget
+ * @param matrix The matrix converting schematic coordinates to widget coordinates
+ * @param missing The area of the missing tiles, in widget coordinates
+ */
+static void
+bb_tile_cache_draw_stale(BbTileCache *cache, cairo_t *cairo, const cairo_matrix_t *matrix, cairo_region_t *missing)
+{
+    cairo_matrix_t transform = cache->stale;
+
+    if (cairo_matrix_invert(&transform) != CAIRO_STATUS_SUCCESS)
+    {
+        return;
+    }
+
+    /* From the grid of stale tiles, to schematic coordinates, to widget coordinates */
+
+    cairo_matrix_multiply(&transform, &transform, matrix);
+
+    cairo_save(cairo);
+
+    for (int index = 0; index < cairo_region_num_rectangles(missing); index++)
+    {
+        cairo_rectangle_int_t rectangle;
+
+        cairo_region_get_rectangle(missing, index, &rectangle);
+        cairo_rectangle(cairo, rectangle.x, rectangle.y, rectangle.width, rectangle.height);
+    }
+
+    cairo_clip(cairo);
+    cairo_transform(cairo, &transform);
+
+    for (GList *link = cache->order.head; link != NULL; link = link->next)
+    {
+        BbTile *tile = link->data;
+
+        if (bb_tile_cache_matrix_equals(&tile->level, &cache->stale))
+        {
+            cairo_set_source_surface(
+                cairo,
+                tile->surface,
+                tile->column * BB_TILE_CACHE_TILE_SIZE,
+                tile->row * BB_TILE_CACHE_TILE_SIZE
+                );
+
+            cairo_rectangle(
+                cairo,
+                tile->column * BB_TILE_CACHE_TILE_SIZE,
+                tile->row * BB_TILE_CACHE_TILE_SIZE,
+                BB_TILE_CACHE_TILE_SIZE,
+                BB_TILE_CACHE_TILE_SIZE
+                );
+
+            cairo_fill(cairo);
+        }
+    }
+
+    cairo_restore(cairo);
+}
+
+
+static void
+bb_tile_cache_draw_tile(cairo_t *cairo, BbTile *tile, double x, double y)
+{
+    cairo_set_source_surface(cairo, tile->surface, x, y);
+    cairo_rectangle(cairo, x, y, BB_TILE_CACHE_TILE_SIZE, BB_TILE_CACHE_TILE_SIZE);
+    cairo_fill(cairo);
+}
+
+
+static void
+bb_tile_cache_finalize(GObject *object)
+{
+    BbTileCache *cache = BB_TILE_CACHE(object);
+    g_return_if_fail(cache != NULL);
+
+    g_clear_pointer(&cache->tiles, g_hash_table_destroy);
+
+    G_OBJECT_CLASS(bb_tile_cache_parent_class)->finalize(object);
+}
+
+
+guint
+bb_tile_cache_get_capacity(BbTileCache *cache)
+{
+    g_return_val_if_fail(BB_IS_TILE_CACHE(cache), 0);
+
+    return cache->capacity;
+}
+
+
+gboolean
+bb_tile_cache_get_fits(BbTileCache *cache, int width, int height)
+{
+    g_return_val_if_fail(BB_IS_TILE_CACHE(cache), FALSE);
+
+    /* Unaligned areas straddle an additional row and column of tiles */
+
+    guint64 columns = (guint64) MAX(width, 0) / BB_TILE_CACHE_TILE_SIZE + 2;
+    guint64 rows = (guint64) MAX(height, 0) / BB_TILE_CACHE_TILE_SIZE + 2;
+
+    /* Leave half the capacity for the tiles of the previous zoom level */
+
+    return 2 * columns * rows <= cache->capacity;
+}
+
+
+static void
+bb_tile_cache_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec)
+{
+    switch (property_id)
+    {
+        case PROP_CAPACITY:
+            g_value_set_uint(value, bb_tile_cache_get_capacity(BB_TILE_CACHE(object)));
+            break;
+
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+    }
+}
+
+
+static void
+bb_tile_cache_init(BbTileCache *cache)
+{
+    g_return_if_fail(BB_IS_TILE_CACHE(cache));
+
+    cache->capacity = BB_TILE_CACHE_DEFAULT_CAPACITY;
+
+    /* The tiles are their own keys, so the hash table owns only the values */
+
+    cache->tiles = g_hash_table_new_full(
+        bb_tile_hash,
+        bb_tile_equal,
+        NULL,
+        bb_tile_free
+        );
+
+    g_queue_init(&cache->order);
+
+    cache->scale_x = 1.0;
+    cache->scale_y = 1.0;
+}
+
+
+void
+bb_tile_cache_invalidate(BbTileCache *cache)
+{
+    g_return_if_fail(BB_IS_TILE_CACHE(cache));
+
+    /* The links are embedded in the tiles, so the queue is emptied before the tiles are freed */
+
+    g_queue_init(&cache->order);
+    g_hash_table_remove_all(cache->tiles);
+
+    cache->has_stale = FALSE;
+}
+
+
+void
+bb_tile_cache_invalidate_bounds(BbTileCache *cache, const BbBounds *bounds, double margin)
+{
+    g_return_if_fail(BB_IS_TILE_CACHE(cache));
+    g_return_if_fail(bounds != NULL);
+
+    GList *link = cache->order.head;
+
+    while (link != NULL)
+    {
+        BbTile *tile = link->data;
+        link = link->next;
+
+        double x[4] = { bounds->min_x, bounds->max_x, bounds->min_x, bounds->max_x };
+        double y[4] = { bounds->min_y, bounds->min_y, bounds->max_y, bounds->max_y };
+
+        for (int corner = 0; corner < 4; corner++)
+        {
+            cairo_matrix_transform_point(&tile->level, &x[corner], &y[corner]);
+        }
+
+        double min_x = MIN(MIN(x[0], x[1]), MIN(x[2], x[3])) - margin;
+        double min_y = MIN(MIN(y[0], y[1]), MIN(y[2], y[3])) - margin;
+        double max_x = MAX(MAX(x[0], x[1]), MAX(x[2], x[3])) + margin;
+        double max_y = MAX(MAX(y[0], y[1]), MAX(y[2], y[3])) + margin;
+
+        double tile_x = tile->column * BB_TILE_CACHE_TILE_SIZE;
+        double tile_y = tile->row * BB_TILE_CACHE_TILE_SIZE;
+
+        if (max_x >= tile_x && min_x <= tile_x + BB_TILE_CACHE_TILE_SIZE &&
+            max_y >= tile_y && min_y <= tile_y + BB_TILE_CACHE_TILE_SIZE)
+        {
+            bb_tile_cache_remove(cache, tile);
+        }
+    }
+}
+
+
+static BbTile*
+bb_tile_cache_lookup(BbTileCache *cache, const cairo_matrix_t *level, int column, int row)
+{
+    BbTile key;
+
+    key.level = *level;
+    key.column = column;
+    key.row = row;
+
+    BbTile *tile = g_hash_table_lookup(cache->tiles, &key);
+
+    if (tile != NULL)
+    {
+        g_queue_unlink(&cache->order, &tile->link);
+        g_queue_push_head_link(&cache->order, &tile->link);
+    }
+
+    return tile;
+}
+
+
+static gboolean
+bb_tile_cache_matrix_equals(const cairo_matrix_t *a, const cairo_matrix_t *b)
+{
+    return a->xx == b->xx && a->yx == b->yx && a->xy == b->xy && a->yy == b->yy && a->x0 == b->x0 && a->y0 == b->y0;
+}
+
+
+BbTileCache*
+bb_tile_cache_new(guint capacity)
+{
+    return BB_TILE_CACHE(g_object_new(
+        BB_TYPE_TILE_CACHE,
+        "capacity", capacity,
+        NULL
+        ));
+}
+
+
+static void
+bb_tile_cache_remove(BbTileCache *cache, BbTile *tile)
+{
+    g_queue_unlink(&cache->order, &tile->link);
+    g_hash_table_remove(cache->tiles, tile);
+}
+
+
+/**
+ * Render a tile at the current zoom level and add it to the cache
+ *
+ * @param cache A tile cache
+ * @param target The surface of the widget, used to create a compatible surface for the tile
+ * @param column The column of the tile in the grid
+ * @param row The row of the tile in the grid
+ * @param render_func Renders the schematic into the tile
+ * @param user_data Passed to the render function
+ * @return The new tile, or NULL if a surface could not be created
+ */
+static BbTile*
+bb_tile_cache_render(
+    BbTileCache *cache,
+    cairo_surface_t *target,
+    int column,
+    int row,
+    BbTileRenderFunc render_func,
+    gpointer user_data
+    )
+{
+    /* The similar surface inherits the device scale, so the size is in widget units */
+
+    cairo_surface_t *surface = cairo_surface_create_similar(
+        target,
+        CAIRO_CONTENT_COLOR_ALPHA,
+        BB_TILE_CACHE_TILE_SIZE,
+        BB_TILE_CACHE_TILE_SIZE
+        );
+
+    if (cairo_surface_status(surface) != CAIRO_STATUS_SUCCESS)
+    {
+        cairo_surface_destroy(surface);
+
+        return NULL;
+    }
+
+    cairo_t *cairo = cairo_create(surface);
+    cairo_matrix_t matrix = cache->level;
+
+    matrix.x0 -= column * BB_TILE_CACHE_TILE_SIZE;
+    matrix.y0 -= row * BB_TILE_CACHE_TILE_SIZE;
+
+    cairo_rectangle(cairo, 0.0, 0.0, BB_TILE_CACHE_TILE_SIZE, BB_TILE_CACHE_TILE_SIZE);
+    cairo_clip(cairo);
+    cairo_set_matrix(cairo, &matrix);
+
+    render_func(cairo, user_data);
+
+    cairo_destroy(cairo);
+
+    while (cache->order.length >= cache->capacity)
+    {
+        bb_tile_cache_remove(cache, g_queue_peek_tail(&cache->order));
+    }
+
+    BbTile *tile = g_slice_new0(BbTile);
+
+    tile->link.data = tile;
+    tile->level = cache->level;
+    tile->column = column;
+    tile->row = row;
+    tile->surface = surface;
+
+    g_hash_table_add(cache->tiles, tile);
+    g_queue_push_head_link(&cache->order, &tile->link);
+
+    return tile;
+}
+
+
+static void
+bb_tile_cache_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec)
+{
+    switch (property_id)
+    {
+        case PROP_CAPACITY:
+            BB_TILE_CACHE(object)->capacity = g_value_get_uint(value);
+            break;
+
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+    }
+}
+
+
+static gboolean
+bb_tile_equal(gconstpointer a, gconstpointer b)
+{
+    const BbTile *tile_a = a;
+    const BbTile *tile_b = b;
+
+    return tile_a->column == tile_b->column &&
+        tile_a->row == tile_b->row &&
+        bb_tile_cache_matrix_equals(&tile_a->level, &tile_b->level);
+}
+
+
+static void
+bb_tile_free(gpointer data)
+{
+    BbTile *tile = data;
+
+    if (tile != NULL)
+    {
+        g_clear_pointer(&tile->surface, cairo_surface_destroy);
+
+        g_slice_free(BbTile, tile);
+    }
+}
+
+
+static guint
+bb_tile_hash(gconstpointer key)
+{
+    const BbTile *tile = key;
+
+    guint hash = g_double_hash(&tile->level.xx);
+
+    hash = 31 * hash + g_double_hash(&tile->level.yy);
+    hash = 31 * hash + (guint) tile->column;
+    hash = 31 * hash + (guint) tile->row;
+
+    return hash;
+}
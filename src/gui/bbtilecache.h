@@ -0,0 +1,142 @@
+#ifndef __BBTILECACHE__
+#define __BBTILECACHE__
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file bbtilecache.h
+ *
+ * A least recently used cache of rendered tiles of the schematic
+ *
+ * Tiles are square image surfaces in a grid anchored to the schematic, not to the widget. The grid depends only on
+ * the zoom, since the editor snaps translations to whole pixels. So, panning reuses the tiles already rendered and
+ * only renders the newly exposed ones.
+ *
+ * After zooming, tiles from the previous zoom are scaled to fill in for tiles not rendered yet. Each frame renders
+ * missing tiles until its time budget runs out, and reports the frame as incomplete. The caller then schedules
+ * another frame, which continues with the remaining tiles.
+ *
+ * Tiles contain only the schematic items, over a transparent background. The grid and the drawing tools are drawn
+ * separately, below and above the tiles.
+ */
+
+#include <gtk/gtk.h>
+#include <bblibrary.h>
+
+
+/**
+ * The default number of tiles retained by the cache
+ */
+#define BB_TILE_CACHE_DEFAULT_CAPACITY (128)
+
+
+/**
+ * The width and height of a tile, in widget units
+ */
+#define BB_TILE_CACHE_TILE_SIZE (256)
+
+
+/**
+ * Render the schematic into a tile
+ *
+ * The cairo transform maps schematic coordinates to the tile, and the clip covers the tile.
+ *
+ * @param cairo The cairo context for the tile
+ * @param user_data The user data passed to bb_tile_cache_draw()
+ */
+typedef void (*BbTileRenderFunc)(cairo_t *cairo, gpointer user_data);
+
+
+#define BB_TYPE_TILE_CACHE bb_tile_cache_get_type()
+G_DECLARE_FINAL_TYPE(BbTileCache, bb_tile_cache, BB, TILE_CACHE, GObject)
+
+
+/**
+ * Draw the schematic using cached tiles
+ *
+ * Only the tiles intersecting the clip of the cairo context are drawn.
+ *
+ * @param cache A tile cache
+ * @param cairo The cairo context for the widget, with the transform in widget coordinates
+ * @param matrix The matrix converting schematic coordinates to widget coordinates
+ * @param render_func Renders tiles missing from the cache
+ * @param user_data Passed to the render function
+ * @return TRUE if the frame is complete, FALSE if stale tiles were drawn in place of some tiles
+ */
+gboolean
+bb_tile_cache_draw(
+    BbTileCache *cache,
+    cairo_t *cairo,
+    const cairo_matrix_t *matrix,
+    BbTileRenderFunc render_func,
+    gpointer user_data
+    );
+
+
+/**
+ * Get the maximum number of tiles retained by the cache
+ *
+ * @param cache A tile cache
+ * @return The maximum number of tiles
+ */
+guint
+bb_tile_cache_get_capacity(BbTileCache *cache);
+
+
+/**
+ * Check if the cache can hold all the tiles needed to fill an area of the widget
+ *
+ * @param cache A tile cache
+ * @param width The width of the area, in widget units
+ * @param height The height of the area, in widget units
+ * @return TRUE if the tiles fit in the cache
+ */
+gboolean
+bb_tile_cache_get_fits(BbTileCache *cache, int width, int height);
+
+
+/**
+ * Discard all tiles in the cache
+ *
+ * @param cache A tile cache
+ */
+void
+bb_tile_cache_invalidate(BbTileCache *cache);
+
+
+/**
+ * Discard the tiles, at all zoom levels, intersecting an area of the schematic
+ *
+ * @param cache A tile cache
+ * @param bounds The damaged area, in schematic coordinates
+ * @param margin Additional widget units around the area, covering antialiasing
+ */
+void
+bb_tile_cache_invalidate_bounds(BbTileCache *cache, const BbBounds *bounds, double margin);
+
+
+/**
+ * Create a new tile cache
+ *
+ * @param capacity The maximum number of tiles to retain
+ * @return A new tile cache
+ */
+BbTileCache*
+bb_tile_cache_new(guint capacity);
+
+#endif
@@ -132,6 +132,9 @@ bb_text_editor_source_mark_updated(GtkSourceBuffer *buffer, GtkTextMark *mark, G
 static void
 bb_text_editor_undo_receiver_init(BbUndoReceiverInterface *iface);
 
+static void
+bb_text_editor_write_ready_cb(GFile *temporary, GAsyncResult *result, GTask *task);
+
 // endregion
 
 static GParamSpec *properties[N_PROPERTIES];
@@ -370,6 +373,29 @@ bb_text_editor_redo_receiver_init(BbRedoReceiverInterface *iface)
 
 // region from BbSaveReceiver
 
+static gboolean
+bb_text_editor_save_receiver_commit(BbSaveReceiver *receiver, GFile *temporary, GError **error)
+{
+    BbTextEditor *editor = BB_TEXT_EDITOR(receiver);
+
+    g_return_val_if_fail(editor != NULL, FALSE);
+    g_return_val_if_fail(editor->file != NULL, FALSE);
+    g_return_val_if_fail(editor->view != NULL, FALSE);
+
+    gboolean success = bb_save_receiver_replace_file(temporary, editor->file, error);
+
+    if (success)
+    {
+        gtk_text_buffer_set_modified(gtk_text_view_get_buffer(GTK_TEXT_VIEW(editor->view)), FALSE);
+    }
+    else
+    {
+        g_file_delete(temporary, NULL, NULL);
+    }
+
+    return success;
+}
+
 static gboolean
 bb_text_editor_save_receiver_can_save(BbSaveReceiver *receiver)
 {
@@ -382,7 +408,7 @@ bb_text_editor_save_receiver_can_save(BbSaveReceiver *receiver)
 
     g_return_val_if_fail(buffer != NULL, FALSE);
 
-    return gtk_text_buffer_get_modified(buffer);
+    return editor->file != NULL && gtk_text_buffer_get_modified(buffer);
 }
 
 static void
@@ -393,13 +419,72 @@ bb_text_editor_save_receiver_save(BbSaveReceiver *receiver, GError **error)
     bb_text_editor_save(editor, error);
 }
 
+static void
+bb_text_editor_save_receiver_write_async(
+    BbSaveReceiver *receiver,
+    GCancellable *cancellable,
+    GAsyncReadyCallback callback,
+    gpointer user_data
+    )
+{
+    BbTextEditor *editor = BB_TEXT_EDITOR(receiver);
+
+    g_return_if_fail(editor != NULL);
+    g_return_if_fail(editor->view != NULL);
+
+    GTask *task = g_task_new(editor, cancellable, callback, user_data);
+
+    if (editor->file == NULL)
+    {
+        g_task_return_new_error(task, G_IO_ERROR, G_IO_ERROR_INVALID_FILENAME, "The document has not been saved");
+        g_object_unref(task);
+        return;
+    }
+
+    GtkTextBuffer *buffer = gtk_text_view_get_buffer(GTK_TEXT_VIEW(editor->view));
+
+    GtkTextIter iter0;
+    GtkTextIter iter1;
+
+    gtk_text_buffer_get_bounds(buffer, &iter0, &iter1);
+
+    gchar *text = gtk_text_buffer_get_text(buffer, &iter0, &iter1, FALSE);
+    GBytes *contents = g_bytes_new_take(text, strlen(text));
+    GFile *temporary = bb_save_receiver_get_temporary_file(editor->file);
+
+    g_file_replace_contents_bytes_async(
+        temporary,
+        contents,
+        NULL,
+        FALSE,
+        G_FILE_CREATE_NONE,
+        cancellable,
+        (GAsyncReadyCallback) bb_text_editor_write_ready_cb,
+        task
+        );
+
+    g_object_unref(temporary);
+    g_bytes_unref(contents);
+}
+
+static GFile*
+bb_text_editor_save_receiver_write_finish(BbSaveReceiver *receiver, GAsyncResult *result, GError **error)
+{
+    g_return_val_if_fail(g_task_is_valid(result, receiver), NULL);
+
+    return g_task_propagate_pointer(G_TASK(result), error);
+}
+
 static void
 bb_text_editor_save_receiver_init(BbSaveReceiverInterface *iface)
 {
     g_return_if_fail(iface != NULL);
 
+    iface->commit = bb_text_editor_save_receiver_commit;
     iface->get_can_save = bb_text_editor_save_receiver_can_save;
     iface->save = bb_text_editor_save_receiver_save;
+    iface->write_async = bb_text_editor_save_receiver_write_async;
+    iface->write_finish = bb_text_editor_save_receiver_write_finish;
 }
 
 // endregion
@@ -816,6 +901,25 @@ bb_text_editor_save(BbTextEditor *editor, GError **error)
 }
 
 
+static void
+bb_text_editor_write_ready_cb(GFile *temporary, GAsyncResult *result, GTask *task)
+{
+    GError *local_error = NULL;
+
+    if (g_file_replace_contents_finish(temporary, result, NULL, &local_error))
+    {
+        g_task_return_pointer(task, g_object_ref(temporary), g_object_unref);
+    }
+    else
+    {
+        g_file_delete(temporary, NULL, NULL);
+        g_task_return_error(task, local_error);
+    }
+
+    g_object_unref(task);
+}
+
+
 static void
 bb_text_editor_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec)
 {
@@ -37,6 +37,18 @@ bb_bounds_free(BbBounds *bounds)
 }
 
 
+gboolean
+bb_bounds_intersects(const BbBounds *a, const BbBounds *b)
+{
+    return !bb_bounds_is_empty(a) &&
+        !bb_bounds_is_empty(b) &&
+        (a->min_x <= b->max_x) &&
+        (a->max_x >= b->min_x) &&
+        (a->min_y <= b->max_y) &&
+        (a->max_y >= b->min_y);
+}
+
+
 gboolean
 bb_bounds_is_empty(const BbBounds *bounds)
 {
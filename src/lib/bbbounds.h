@@ -40,6 +40,16 @@ bb_bounds_copy(const BbBounds *bounds);
 void
 bb_bounds_free(BbBounds *bounds);
 
+/**
+ * Determine if two bounds overlap, including touching edges
+ *
+ * @param a The first bounds
+ * @param b The second bounds
+ * @return TRUE if neither bounds is empty and they overlap
+ */
+gboolean
+bb_bounds_intersects(const BbBounds *a, const BbBounds *b);
+
 gboolean
 bb_bounds_is_empty(const BbBounds *bounds);
 
@@ -48,10 +48,49 @@ bb_bounds_calculator_calculate_from_corners_missing(BbBoundsCalculator *calculat
 }
 
 
+BbBounds*
+bb_bounds_calculator_calculate_from_text(
+    BbBoundsCalculator *calculator,
+    int insert_x,
+    int insert_y,
+    BbTextAlignment alignment,
+    int angle,
+    int size,
+    const char *text
+    )
+{
+    g_return_val_if_fail(calculator != NULL, NULL);
+    g_return_val_if_fail(text != NULL, NULL);
+
+    BbBoundsCalculatorInterface *iface = BB_BOUNDS_CALCULATOR_GET_IFACE(calculator);
+
+    g_return_val_if_fail(iface != NULL, NULL);
+    g_return_val_if_fail(iface->calculate_from_text != NULL, NULL);
+
+    return iface->calculate_from_text(calculator, insert_x, insert_y, alignment, angle, size, text);
+}
+
+
+static BbBounds*
+bb_bounds_calculator_calculate_from_text_missing(
+    BbBoundsCalculator *calculator,
+    int insert_x,
+    int insert_y,
+    BbTextAlignment alignment,
+    int angle,
+    int size,
+    const char *text
+    )
+{
+    g_error("bb_bounds_calculator_calculate_from_text() not overridden");
+}
+
+
 static void
 bb_bounds_calculator_default_init(BbBoundsCalculatorInterface *class)
 {
     g_return_if_fail(class != NULL);
 
     class->calculate_from_corners = bb_bounds_calculator_calculate_from_corners_missing;
+    class->calculate_from_text = bb_bounds_calculator_calculate_from_text_missing;
 }
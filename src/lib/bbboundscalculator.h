@@ -20,6 +20,7 @@
 
 #include <gtk/gtk.h>
 #include "bbbounds.h"
+#include "bbtextalignment.h"
 
 #define BB_TYPE_BOUNDS_CALCULATOR bb_bounds_calculator_get_type()
 G_DECLARE_INTERFACE(BbBoundsCalculator, bb_bounds_calculator, BB, BOUNDS_CALCULATOR, GObject)
@@ -29,10 +30,44 @@ struct _BbBoundsCalculatorInterface
     GTypeInterface g_iface;
 
     BbBounds* (*calculate_from_corners)(BbBoundsCalculator *calculator, int x0, int y0, int x1, int y1, int width);
+
+    BbBounds* (*calculate_from_text)(
+        BbBoundsCalculator *calculator,
+        int insert_x,
+        int insert_y,
+        BbTextAlignment alignment,
+        int angle,
+        int size,
+        const char *text
+        );
 };
 
 
 BbBounds*
 bb_bounds_calculator_calculate_from_corners(BbBoundsCalculator *calculator, int x0, int y0, int x1, int y1, int width);
 
+
+/**
+ * Calculate the bounds of rendered text, from measured font metrics
+ *
+ * @param calculator A BbBoundsCalculator
+ * @param insert_x The x coordinate of the insertion point
+ * @param insert_y The y coordinate of the insertion point
+ * @param alignment The alignment of the text relative to the insertion point
+ * @param angle The rotation of the text, in degrees
+ * @param size The text size, in points, as used in schematic files
+ * @param text The text, in Pango markup
+ * @return The bounds of the text, free with bb_bounds_free()
+ */
+BbBounds*
+bb_bounds_calculator_calculate_from_text(
+    BbBoundsCalculator *calculator,
+    int insert_x,
+    int insert_y,
+    BbTextAlignment alignment,
+    int angle,
+    int size,
+    const char *text
+    );
+
 #endif
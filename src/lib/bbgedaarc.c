@@ -17,7 +17,9 @@
  */
 
 #include <gtk/gtk.h>
+#include <math.h>
 #include <bbextensions.h>
+#include "bbangle.h"
 #include "bbgedaarc.h"
 #include "bbcoord.h"
 #include "bbitemparams.h"
@@ -229,13 +231,8 @@ bb_geda_arc_translate(
     int dy
     );
 
-static gboolean
-bb_geda_arc_write(
-    BbGedaItem *item,
-    GOutputStream *stream,
-    GCancellable *cancellable,
-    GError **error
-    );
+static void
+bb_geda_arc_format(BbGedaItem *item, BbWriteBuffer *buffer);
 
 static void
 bb_geda_arc_write_async(
@@ -513,12 +510,67 @@ bb_geda_arc_calculate_bounds(BbGedaItem *item, BbBoundsCalculator *calculator)
     g_return_val_if_fail(arc != NULL, NULL);
     g_return_val_if_fail(arc->line_style != NULL, NULL);
 
+    int start = arc->start_angle;
+    int sweep = arc->sweep_angle;
+
+    if (sweep < 0)
+    {
+        start += sweep;
+        sweep = -sweep;
+    }
+
+    if (sweep >= 360)
+    {
+        return bb_bounds_calculator_calculate_from_corners(
+            calculator,
+            arc->center_x - arc->radius,
+            arc->center_y - arc->radius,
+            arc->center_x + arc->radius,
+            arc->center_y + arc->radius,
+            arc->line_style->line_width
+            );
+    }
+
+    /* Start with the endpoints, as unit vectors */
+
+    double x0 = cos(bb_angle_to_radians(start));
+    double y0 = sin(bb_angle_to_radians(start));
+    double x1 = cos(bb_angle_to_radians(start + sweep));
+    double y1 = sin(bb_angle_to_radians(start + sweep));
+
+    double min_x = MIN(x0, x1);
+    double min_y = MIN(y0, y1);
+    double max_x = MAX(x0, x1);
+    double max_y = MAX(y0, y1);
+
+    /* Then extend to each axis crossed by the sweep */
+
+    if (bb_angle_normalize(0 - start) <= sweep)
+    {
+        max_x = 1.0;
+    }
+
+    if (bb_angle_normalize(90 - start) <= sweep)
+    {
+        max_y = 1.0;
+    }
+
+    if (bb_angle_normalize(180 - start) <= sweep)
+    {
+        min_x = -1.0;
+    }
+
+    if (bb_angle_normalize(270 - start) <= sweep)
+    {
+        min_y = -1.0;
+    }
+
     return bb_bounds_calculator_calculate_from_corners(
         calculator,
-        arc->center_x - arc->radius,
-        arc->center_y - arc->radius,
-        arc->center_x + arc->radius,
-        arc->center_y + arc->radius,
+        arc->center_x + (int) floor(arc->radius * min_x),
+        arc->center_y + (int) floor(arc->radius * min_y),
+        arc->center_x + (int) ceil(arc->radius * max_x),
+        arc->center_y + (int) ceil(arc->radius * max_y),
         arc->line_style->line_width
         );
 }
@@ -564,18 +616,14 @@ bb_geda_arc_translate(BbGedaItem *item, int dx, int dy)
 }
 
 
-static gboolean
-bb_geda_arc_write(BbGedaItem *item, GOutputStream *stream, GCancellable *cancellable, GError **error)
+static void
+bb_geda_arc_format(BbGedaItem *item, BbWriteBuffer *buffer)
 {
     BbGedaArc *arc = BB_GEDA_ARC(item);
-    g_return_val_if_fail(arc != NULL, FALSE);
-
-    GString *params = g_string_new(NULL);
+    g_return_if_fail(arc != NULL);
 
-    g_string_printf(
-        params,
-        "%s %d %d %d %d %d %d %d %d %d %d %d\n",
-        BB_GEDA_ARC_TOKEN,
+    int params[] =
+    {
         arc->center_x,
         arc->center_y,
         arc->radius,
@@ -587,20 +635,9 @@ bb_geda_arc_write(BbGedaItem *item, GOutputStream *stream, GCancellable *cancell
         arc->line_style->dash_type,
         bb_line_style_get_dash_length_for_file(arc->line_style),
         bb_line_style_get_dash_space_for_file(arc->line_style)
-        );
-
-    gboolean result = g_output_stream_write_all(
-        stream,
-        params->str,
-        params->len,
-        NULL,
-        cancellable,
-        error
-        );
-
-    g_string_free(params, TRUE);
+    };
 
-    return result;
+    bb_write_buffer_append_params(buffer, BB_GEDA_ARC_TOKEN, G_N_ELEMENTS(params), params);
 }
 
 
@@ -660,7 +697,7 @@ bb_geda_arc_class_init(BbGedaArcClass *klasse)
     BB_GEDA_ITEM_CLASS(klasse)->clone = bb_geda_arc_clone;
     BB_GEDA_ITEM_CLASS(klasse)->render = bb_geda_arc_render;
     BB_GEDA_ITEM_CLASS(klasse)->translate = bb_geda_arc_translate;
-    BB_GEDA_ITEM_CLASS(klasse)->write = bb_geda_arc_write;
+    BB_GEDA_ITEM_CLASS(klasse)->format = bb_geda_arc_format;
     BB_GEDA_ITEM_CLASS(klasse)->write_async = bb_geda_arc_write_async;
     BB_GEDA_ITEM_CLASS(klasse)->write_finish = bb_geda_arc_write_finish;
 
@@ -20,6 +20,7 @@
 #include <bbextensions.h>
 #include "bbcoord.h"
 #include "bbitemparams.h"
+#include "bbitemrenderer.h"
 #include "bbgedablock.h"
 #include "bbadjustableitemcolor.h"
 #include "bbparams.h"
@@ -125,8 +126,8 @@ bb_geda_block_set_property(GObject *object, guint property_id, const GValue *val
 static void
 bb_geda_block_translate(BbGedaItem *item, int dx, int dy);
 
-static gboolean
-bb_geda_block_write(BbGedaItem *item, GOutputStream *stream, GCancellable *cancellable, GError **error);
+static void
+bb_geda_block_format(BbGedaItem *item, BbWriteBuffer *buffer);
 
 static void
 bb_geda_block_write_async(
@@ -165,13 +166,18 @@ bb_geda_block_calculate_bounds(BbGedaItem *item, BbBoundsCalculator *calculator)
 
     g_return_val_if_fail(block != NULL, NULL);
 
+    /*
+     * The symbol contents are not loaded yet. The bounds still need an area, since callers treat empty bounds as
+     * unknown and redraw everything. The area around the insertion point is the same as for text.
+     */
+
     return bb_bounds_calculator_calculate_from_corners(
         calculator,
-        block->insert_x,
-        block->insert_y,
-        block->insert_x,
-        block->insert_y,
-        0
+        block->insert_x - BB_ITEM_RENDERER_INSERTION_POINT_RADIUS,
+        block->insert_y - BB_ITEM_RENDERER_INSERTION_POINT_RADIUS,
+        block->insert_x + BB_ITEM_RENDERER_INSERTION_POINT_RADIUS,
+        block->insert_y + BB_ITEM_RENDERER_INSERTION_POINT_RADIUS,
+        BB_ITEM_RENDERER_INSERTION_POINT_WIDTH
         );
 }
 
@@ -191,7 +197,7 @@ bb_geda_block_class_init(BbGedaBlockClass *klasse)
     BB_GEDA_ITEM_CLASS(klasse)->clone = bb_geda_block_clone;
     BB_GEDA_ITEM_CLASS(klasse)->render = bb_geda_block_render;
     BB_GEDA_ITEM_CLASS(klasse)->translate = bb_geda_block_translate;
-    BB_GEDA_ITEM_CLASS(klasse)->write = bb_geda_block_write;
+    BB_GEDA_ITEM_CLASS(klasse)->format = bb_geda_block_format;
     BB_GEDA_ITEM_CLASS(klasse)->write_async = bb_geda_block_write_async;
     BB_GEDA_ITEM_CLASS(klasse)->write_finish = bb_geda_block_write_finish;
 
@@ -705,37 +711,31 @@ bb_geda_block_translate(BbGedaItem *item, int dx, int dy)
 }
 
 
-static gboolean
-bb_geda_block_write(BbGedaItem *item, GOutputStream *stream, GCancellable *cancellable, GError **error)
+static void
+bb_geda_block_format(BbGedaItem *item, BbWriteBuffer *buffer)
 {
-    g_return_val_if_fail(BB_IS_GEDA_BLOCK(item), FALSE);
-
-    GString *params = g_string_new(NULL);
+    g_return_if_fail(BB_IS_GEDA_BLOCK(item));
 
-    g_string_printf(
-        params,
-        "%s %d %d %d %d %d %s\n",
-        BB_GEDA_BLOCK_TOKEN,
+    int params[] =
+    {
         bb_geda_block_get_insert_x(BB_GEDA_BLOCK(item)),
         bb_geda_block_get_insert_y(BB_GEDA_BLOCK(item)),
         bb_geda_block_get_selectable(BB_GEDA_BLOCK(item)),
         bb_geda_block_get_rotation(BB_GEDA_BLOCK(item)),
-        bb_geda_block_get_mirror(BB_GEDA_BLOCK(item)),
-        bb_geda_block_get_name(BB_GEDA_BLOCK(item))
-        );
+        bb_geda_block_get_mirror(BB_GEDA_BLOCK(item))
+    };
 
-    gboolean result = g_output_stream_write_all(
-        stream,
-        params->str,
-        params->len,
-        NULL,
-        cancellable,
-        error
-        );
+    bb_write_buffer_append_string(buffer, BB_GEDA_BLOCK_TOKEN);
 
-    g_string_free(params, TRUE);
+    for (int index = 0; index < G_N_ELEMENTS(params); index++)
+    {
+        bb_write_buffer_append_char(buffer, ' ');
+        bb_write_buffer_append_int(buffer, params[index]);
+    }
 
-    return result;
+    bb_write_buffer_append_char(buffer, ' ');
+    bb_write_buffer_append_string(buffer, bb_geda_block_get_name(BB_GEDA_BLOCK(item)));
+    bb_write_buffer_append_char(buffer, '\n');
 }
 
 
@@ -109,6 +109,11 @@ struct _BbGedaBox
 
     int x[2];
     int y[2];
+
+    /**
+     * The hatch lines from the previous draw, or NULL if the geometry or fill style changed since
+     */
+    GArray *hatch;
 };
 
 static void
@@ -146,6 +151,11 @@ bb_geda_box_dispose(
     GObject *object
     );
 
+static void
+bb_geda_box_invalidate_hatch(
+    BbGedaBox *box
+    );
+
 static void
 bb_geda_box_finalize(
     GObject *object
@@ -240,13 +250,8 @@ bb_geda_box_translate(
     int dy
     );
 
-static gboolean
-bb_geda_box_write(
-    BbGedaItem *item,
-    GOutputStream *stream,
-    GCancellable *cancellable,
-    GError **error
-    );
+static void
+bb_geda_box_format(BbGedaItem *item, BbWriteBuffer *buffer);
 
 static void
 bb_geda_box_write_async(
@@ -291,21 +296,24 @@ bb_geda_box_draw_hatch(BbClosedShapeDrawer *drawer, BbItemRenderer *renderer)
     g_return_if_fail(BB_IS_GEDA_BOX(box));
     g_return_if_fail(BB_IS_ITEM_RENDERER(renderer));
 
-    GArray *lines = g_array_new(FALSE, FALSE, sizeof(BbLine));
-
-    if (bb_fill_type_uses_first_set(box->fill_style->type))
+    if (box->hatch == NULL)
     {
-        bb_hatch_box(box->x, box->y, box->fill_style->angle[0], box->fill_style->pitch[0], lines);
-    }
+        box->hatch = g_array_new(FALSE, FALSE, sizeof(BbLine));
 
-    if (bb_fill_type_uses_second_set(box->fill_style->type))
-    {
-        bb_hatch_box(box->x, box->y, box->fill_style->angle[1], box->fill_style->pitch[1], lines);
+        if (bb_fill_type_uses_first_set(box->fill_style->type))
+        {
+            bb_hatch_box(box->x, box->y, box->fill_style->angle[0], box->fill_style->pitch[0], box->hatch);
+        }
+
+        if (bb_fill_type_uses_second_set(box->fill_style->type))
+        {
+            bb_hatch_box(box->x, box->y, box->fill_style->angle[1], box->fill_style->pitch[1], box->hatch);
+        }
     }
 
-    for (int index = 0; index < lines->len; index++)
+    for (int index = 0; index < box->hatch->len; index++)
     {
-        BbLine *line = &g_array_index(lines, BbLine, index);
+        BbLine *line = &g_array_index(box->hatch, BbLine, index);
 
         bb_item_renderer_render_absolute_move_to(renderer, line->x[0], line->y[0]);
         bb_item_renderer_render_absolute_line_to(renderer, line->x[1], line->y[1]);
@@ -388,7 +396,7 @@ bb_geda_box_class_init(BbGedaBoxClass *klasse)
     BB_GEDA_ITEM_CLASS(klasse)->clone = bb_geda_box_clone;
     BB_GEDA_ITEM_CLASS(klasse)->render = bb_geda_box_render;
     BB_GEDA_ITEM_CLASS(klasse)->translate = bb_geda_box_translate;
-    BB_GEDA_ITEM_CLASS(klasse)->write = bb_geda_box_write;
+    BB_GEDA_ITEM_CLASS(klasse)->format = bb_geda_box_format;
     BB_GEDA_ITEM_CLASS(klasse)->write_async = bb_geda_box_write_async;
     BB_GEDA_ITEM_CLASS(klasse)->write_finish = bb_geda_box_write_finish;
 
@@ -578,6 +586,8 @@ bb_geda_box_finalize(GObject *object)
 
     bb_fill_style_free(box->fill_style);
     bb_line_style_free(box->line_style);
+
+    bb_geda_box_invalidate_hatch(box);
 }
 
 static int
@@ -820,6 +830,15 @@ bb_geda_box_init(BbGedaBox *box)
 }
 
 
+static void
+bb_geda_box_invalidate_hatch(BbGedaBox *box)
+{
+    g_return_if_fail(BB_IS_GEDA_BOX(box));
+
+    g_clear_pointer(&box->hatch, g_array_unref);
+}
+
+
 BbGedaBox*
 bb_geda_box_new()
 {
@@ -942,6 +961,7 @@ bb_geda_box_set_angle_1(BbGedaBox *box, int angle)
     if (box->fill_style->angle[0] != angle)
     {
         box->fill_style->angle[0] = angle;
+        bb_geda_box_invalidate_hatch(box);
 
         g_signal_emit(box, signals[SIG_INVALIDATE], 0);
 
@@ -959,6 +979,7 @@ bb_geda_box_set_angle_2(BbGedaBox *box, int angle)
     if (box->fill_style->angle[1] != angle)
     {
         box->fill_style->angle[1] = angle;
+        bb_geda_box_invalidate_hatch(box);
 
         g_signal_emit(box, signals[SIG_INVALIDATE], 0);
 
@@ -1066,6 +1087,7 @@ bb_geda_box_set_fill_type(BbGedaBox *box, int fill_type)
     if (box->fill_style->type != fill_type)
     {
         box->fill_style->type = fill_type;
+        bb_geda_box_invalidate_hatch(box);
 
         g_signal_emit(box, signals[SIG_INVALIDATE], 0);
 
@@ -1115,6 +1137,7 @@ bb_geda_box_set_pitch_1(BbGedaBox *box, int pitch)
     if (box->fill_style->pitch[0] != pitch)
     {
         box->fill_style->pitch[0] = pitch;
+        bb_geda_box_invalidate_hatch(box);
 
         g_signal_emit(box, signals[SIG_INVALIDATE], 0);
 
@@ -1132,6 +1155,7 @@ bb_geda_box_set_pitch_2(BbGedaBox *box, int pitch)
     if (box->fill_style->pitch[1] != pitch)
     {
         box->fill_style->pitch[1] = pitch;
+        bb_geda_box_invalidate_hatch(box);
 
         g_signal_emit(box, signals[SIG_INVALIDATE], 0);
 
@@ -1225,6 +1249,7 @@ bb_geda_box_set_x0(BbGedaBox *box, int x)
         g_signal_emit(box, signals[SIG_INVALIDATE], 0);
 
         box->x[0] = x;
+        bb_geda_box_invalidate_hatch(box);
 
         g_signal_emit(box, signals[SIG_INVALIDATE], 0);
 
@@ -1243,6 +1268,7 @@ bb_geda_box_set_x1(BbGedaBox *box, int x)
         g_signal_emit(box, signals[SIG_INVALIDATE], 0);
 
         box->x[1] = x;
+        bb_geda_box_invalidate_hatch(box);
 
         g_signal_emit(box, signals[SIG_INVALIDATE], 0);
 
@@ -1261,6 +1287,7 @@ bb_geda_box_set_y0(BbGedaBox *box, int y)
         g_signal_emit(box, signals[SIG_INVALIDATE], 0);
 
         box->y[0] = y;
+        bb_geda_box_invalidate_hatch(box);
 
         g_signal_emit(box, signals[SIG_INVALIDATE], 0);
 
@@ -1279,6 +1306,7 @@ bb_geda_box_set_y1(BbGedaBox *box, int y)
         g_signal_emit(box, signals[SIG_INVALIDATE], 0);
 
         box->y[1] = y;
+        bb_geda_box_invalidate_hatch(box);
 
         g_signal_emit(box, signals[SIG_INVALIDATE], 0);
 
@@ -1294,6 +1322,7 @@ bb_geda_box_translate(BbGedaItem *item, int dx, int dy)
     g_return_if_fail(box != NULL);
 
     bb_coord_translate(dx, dy, box->x, box->y, 2);
+    bb_geda_box_invalidate_hatch(box);
 
     g_object_notify_by_pspec(G_OBJECT(box), properties[PROP_X0]);
     g_object_notify_by_pspec(G_OBJECT(box), properties[PROP_Y0]);
@@ -1302,18 +1331,14 @@ bb_geda_box_translate(BbGedaItem *item, int dx, int dy)
 }
 
 
-static gboolean
-bb_geda_box_write(BbGedaItem *item, GOutputStream *stream, GCancellable *cancellable, GError **error)
+static void
+bb_geda_box_format(BbGedaItem *item, BbWriteBuffer *buffer)
 {
     BbGedaBox *box = BB_GEDA_BOX(item);
-    g_return_val_if_fail(box != NULL, FALSE);
-
-    GString *params = g_string_new(NULL);
+    g_return_if_fail(box != NULL);
 
-    g_string_printf(
-        params,
-        "%s %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n",
-        BB_GEDA_BOX_TOKEN,
+    int params[] =
+    {
         MIN(box->x[0], box->x[1]),
         MIN(box->y[0], box->y[1]),
         ABS(box->x[0] - box->x[1]),
@@ -1330,20 +1355,9 @@ bb_geda_box_write(BbGedaItem *item, GOutputStream *stream, GCancellable *cancell
         bb_fill_style_get_fill_pitch_1_for_file(box->fill_style),
         bb_fill_style_get_fill_angle_2_for_file(box->fill_style),
         bb_fill_style_get_fill_pitch_2_for_file(box->fill_style)
-        );
-
-    gboolean result = g_output_stream_write_all(
-        stream,
-        params->str,
-        params->len,
-        NULL,
-        cancellable,
-        error
-        );
-
-    g_string_free(params, TRUE);
+    };
 
-    return result;
+    bb_write_buffer_append_params(buffer, BB_GEDA_BOX_TOKEN, G_N_ELEMENTS(params), params);
 }
 
 
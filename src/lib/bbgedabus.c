@@ -232,13 +232,8 @@ bb_geda_bus_translate(
     int dy
     );
 
-static gboolean
-bb_geda_bus_write(
-    BbGedaItem *item,
-    GOutputStream *stream,
-    GCancellable *cancellable,
-    GError **error
-    );
+static void
+bb_geda_bus_format(BbGedaItem *item, BbWriteBuffer *buffer);
 
 static void
 bb_geda_bus_write_async(
@@ -347,7 +342,7 @@ bb_geda_bus_class_init(BbGedaBusClass *klasse)
     BB_GEDA_ITEM_CLASS(klasse)->clone = bb_geda_bus_clone;
     BB_GEDA_ITEM_CLASS(klasse)->render = bb_geda_bus_render;
     BB_GEDA_ITEM_CLASS(klasse)->translate = bb_geda_bus_translate;
-    BB_GEDA_ITEM_CLASS(klasse)->write = bb_geda_bus_write;
+    BB_GEDA_ITEM_CLASS(klasse)->format = bb_geda_bus_format;
     BB_GEDA_ITEM_CLASS(klasse)->write_async = bb_geda_bus_write_async;
     BB_GEDA_ITEM_CLASS(klasse)->write_finish = bb_geda_bus_write_finish;
 
@@ -765,38 +760,23 @@ bb_geda_bus_translate(BbGedaItem *item, int dx, int dy)
 }
 
 
-static gboolean
-bb_geda_bus_write(BbGedaItem *item, GOutputStream *stream, GCancellable *cancellable, GError **error)
+static void
+bb_geda_bus_format(BbGedaItem *item, BbWriteBuffer *buffer)
 {
     BbGedaBus *bus = BB_GEDA_BUS(item);
-    g_return_val_if_fail(bus != NULL, FALSE);
-
-    GString *params = g_string_new(NULL);
+    g_return_if_fail(bus != NULL);
 
-    g_string_printf(
-        params,
-        "%s %d %d %d %d %d %d\n",
-        BB_GEDA_BUS_TOKEN,
+    int params[] =
+    {
         bus->x[0],
         bus->y[0],
         bus->x[1],
         bus->y[1],
         bus->color,
         bus->direction
-        );
-
-    gboolean result = g_output_stream_write_all(
-        stream,
-        params->str,
-        params->len,
-        NULL,
-        cancellable,
-        error
-        );
-
-    g_string_free(params, TRUE);
+    };
 
-    return result;
+    bb_write_buffer_append_params(buffer, BB_GEDA_BUS_TOKEN, G_N_ELEMENTS(params), params);
 }
 
 
@@ -274,13 +274,8 @@ bb_geda_circle_translate(
     int dy
     );
 
-static gboolean
-bb_geda_circle_write(
-    BbGedaItem *item,
-    GOutputStream *stream,
-    GCancellable *cancellable,
-    GError **error
-    );
+static void
+bb_geda_circle_format(BbGedaItem *item, BbWriteBuffer *buffer);
 
 static void
 bb_geda_circle_write_async(
@@ -576,7 +571,7 @@ bb_geda_circle_class_init(BbGedaCircleClass *klasse)
     BB_GEDA_ITEM_CLASS(klasse)->clone = bb_geda_circle_clone;
     BB_GEDA_ITEM_CLASS(klasse)->render = bb_geda_circle_render;
     BB_GEDA_ITEM_CLASS(klasse)->translate = bb_geda_circle_translate;
-    BB_GEDA_ITEM_CLASS(klasse)->write = bb_geda_circle_write;
+    BB_GEDA_ITEM_CLASS(klasse)->format = bb_geda_circle_format;
     BB_GEDA_ITEM_CLASS(klasse)->write_async = bb_geda_circle_write_async;
     BB_GEDA_ITEM_CLASS(klasse)->write_finish = bb_geda_circle_write_finish;
 
@@ -1279,18 +1274,14 @@ bb_geda_circle_translate(BbGedaItem *item, int dx, int dy)
 }
 
 
-static gboolean
-bb_geda_circle_write(BbGedaItem *item, GOutputStream *stream, GCancellable *cancellable, GError **error)
+static void
+bb_geda_circle_format(BbGedaItem *item, BbWriteBuffer *buffer)
 {
     BbGedaCircle *circle = BB_GEDA_CIRCLE(item);
-    g_return_val_if_fail(circle != NULL, FALSE);
-
-    GString *params = g_string_new(NULL);
+    g_return_if_fail(circle != NULL);
 
-    g_string_printf(
-        params,
-        "%s %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n",
-        BB_GEDA_CIRCLE_TOKEN,
+    int params[] =
+    {
         bb_geda_circle_get_center_x(BB_GEDA_CIRCLE(item)),
         bb_geda_circle_get_center_y(BB_GEDA_CIRCLE(item)),
         bb_geda_circle_get_radius(BB_GEDA_CIRCLE(item)),
@@ -1306,20 +1297,9 @@ bb_geda_circle_write(BbGedaItem *item, GOutputStream *stream, GCancellable *canc
         bb_fill_style_get_fill_pitch_1_for_file(circle->fill_style),
         bb_fill_style_get_fill_angle_2_for_file(circle->fill_style),
         bb_fill_style_get_fill_pitch_2_for_file(circle->fill_style)
-        );
-
-    gboolean result = g_output_stream_write_all(
-        stream,
-        params->str,
-        params->len,
-        NULL,
-        cancellable,
-        error
-        );
-
-    g_string_free(params, TRUE);
+    };
 
-    return result;
+    bb_write_buffer_append_params(buffer, BB_GEDA_CIRCLE_TOKEN, G_N_ELEMENTS(params), params);
 }
 
 
@@ -33,7 +33,38 @@ enum
 //};
 
 
-G_DEFINE_TYPE(BbGedaItem, bb_geda_item, G_TYPE_OBJECT)
+typedef struct _BbGedaItemPrivate BbGedaItemPrivate;
+
+struct _BbGedaItemPrivate
+{
+    /**
+     * The bounds from the last calculation, valid only when bounds_dirty is FALSE
+     */
+    BbBounds bounds;
+
+    /**
+     * The calculator used for the cached bounds
+     *
+     * Only compared by identity and never dereferenced, so no reference is held.
+     */
+    gpointer bounds_calculator;
+
+    /**
+     * The cached bounds must be recalculated
+     *
+     * Set by each "invalidate-item" emission, since setters emit the signal after the change but before notifying
+     * the property change. Also set with each new revision.
+     */
+    gboolean bounds_dirty;
+
+    /**
+     * The revision of the geometry, unique across all items
+     */
+    guint revision;
+};
+
+
+G_DEFINE_TYPE_WITH_PRIVATE(BbGedaItem, bb_geda_item, G_TYPE_OBJECT)
 
 
 static BbBounds*
@@ -42,15 +73,24 @@ bb_geda_item_calculate_bounds_missing(BbGedaItem *item, BbBoundsCalculator *calc
 static BbGedaItem*
 bb_geda_item_clone_missing(BbGedaItem *item);
 
+static void
+bb_geda_item_dispatch_properties_changed(GObject *object, guint n_pspecs, GParamSpec **pspecs);
+
 static void
 bb_geda_item_dispose(GObject *object);
 
 static void
 bb_geda_item_finalize(GObject *object);
 
+static void
+bb_geda_item_format_missing(BbGedaItem *item, BbWriteBuffer *buffer);
+
 static void
 bb_geda_item_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
 
+static void
+bb_geda_item_invalidate_bounds(BbGedaItem *item);
+
 static gboolean
 bb_geda_item_is_significant_missing(BbGedaItem *item);
 
@@ -73,7 +113,7 @@ static void
 bb_geda_item_translate_missing(BbGedaItem *item, int dx, int dy);
 
 static gboolean
-bb_geda_item_write_missing(
+bb_geda_item_write_formatted(
     BbGedaItem *item,
     GOutputStream *stream,
     GCancellable *cancellable,
@@ -102,6 +142,25 @@ bb_geda_item_write_finish_missing(
 static GParamSpec *properties[N_PROPERTIES];
 
 
+/**
+ * The source of geometry revisions
+ *
+ * Items can be created on worker threads while loading, so revisions are taken atomically.
+ */
+static gint next_revision = 1;
+
+
+void
+bb_geda_item_bump_revision(BbGedaItem *item)
+{
+    BbGedaItemPrivate *privat = bb_geda_item_get_instance_private(item);
+    g_return_if_fail(privat != NULL);
+
+    privat->bounds_dirty = TRUE;
+    privat->revision = (guint) g_atomic_int_add(&next_revision, 1);
+}
+
+
 BbBounds*
 bb_geda_item_calculate_bounds(BbGedaItem *item, BbBoundsCalculator *calculator)
 {
@@ -110,7 +169,26 @@ bb_geda_item_calculate_bounds(BbGedaItem *item, BbBoundsCalculator *calculator)
     g_return_val_if_fail(class != NULL, NULL);
     g_return_val_if_fail(class->calculate_bounds != NULL, NULL);
 
-    return class->calculate_bounds(item, calculator);
+    BbGedaItemPrivate *privat = bb_geda_item_get_instance_private(item);
+    g_return_val_if_fail(privat != NULL, NULL);
+
+    if (privat->bounds_dirty || privat->bounds_calculator != calculator)
+    {
+        BbBounds *bounds = class->calculate_bounds(item, calculator);
+
+        if (bounds == NULL)
+        {
+            return NULL;
+        }
+
+        privat->bounds = *bounds;
+        privat->bounds_calculator = calculator;
+        privat->bounds_dirty = FALSE;
+
+        return bounds;
+    }
+
+    return bb_bounds_copy(&privat->bounds);
 }
 
 
@@ -124,6 +202,7 @@ bb_geda_item_calculate_bounds_missing(BbGedaItem *item, BbBoundsCalculator *calc
 static void
 bb_geda_item_class_init(BbGedaItemClass *class)
 {
+    G_OBJECT_CLASS(class)->dispatch_properties_changed = bb_geda_item_dispatch_properties_changed;
     G_OBJECT_CLASS(class)->dispose = bb_geda_item_dispose;
     G_OBJECT_CLASS(class)->finalize = bb_geda_item_finalize;
     G_OBJECT_CLASS(class)->get_property = bb_geda_item_get_property;
@@ -137,15 +216,16 @@ bb_geda_item_class_init(BbGedaItemClass *class)
     class->render = bb_geda_item_render_missing;
     class->rotate = bb_geda_item_rotate_missing;
     class->translate = bb_geda_item_translate_missing;
-    class->write = bb_geda_item_write_missing;
+    class->format = bb_geda_item_format_missing;
+    class->write = bb_geda_item_write_formatted;
     class->write_async = bb_geda_item_write_async_missing;
     class->write_finish = bb_geda_item_write_finish_missing;
 
-    g_signal_new(
+    g_signal_new_class_handler(
         "invalidate-item",
         BB_TYPE_GEDA_ITEM,
-        0,
-        0,
+        G_SIGNAL_RUN_FIRST,
+        G_CALLBACK(bb_geda_item_invalidate_bounds),
         NULL,
         NULL,
         g_cclosure_marshal_VOID__VOID,
@@ -175,6 +255,21 @@ bb_geda_item_clone_missing(BbGedaItem *item)
 }
 
 
+/**
+ * Every property change is treated as a change in geometry
+ *
+ * Some revisions are wasted on properties that do not affect the geometry, like the color. But, subclasses do not
+ * need to track which properties do.
+ */
+static void
+bb_geda_item_dispatch_properties_changed(GObject *object, guint n_pspecs, GParamSpec **pspecs)
+{
+    bb_geda_item_bump_revision(BB_GEDA_ITEM(object));
+
+    G_OBJECT_CLASS(bb_geda_item_parent_class)->dispatch_properties_changed(object, n_pspecs, pspecs);
+}
+
+
 static void
 bb_geda_item_dispose(GObject *object)
 {
@@ -187,6 +282,36 @@ bb_geda_item_finalize(GObject *object)
 }
 
 
+gboolean
+bb_geda_item_can_format(BbGedaItem *item)
+{
+    BbGedaItemClass *class = BB_GEDA_ITEM_GET_CLASS(item);
+
+    g_return_val_if_fail(class != NULL, FALSE);
+
+    return class->format != NULL && class->format != bb_geda_item_format_missing;
+}
+
+
+void
+bb_geda_item_format(BbGedaItem *item, BbWriteBuffer *buffer)
+{
+    BbGedaItemClass *class = BB_GEDA_ITEM_GET_CLASS(item);
+
+    g_return_if_fail(class != NULL);
+    g_return_if_fail(class->format != NULL);
+
+    class->format(item, buffer);
+}
+
+
+static void
+bb_geda_item_format_missing(BbGedaItem *item, BbWriteBuffer *buffer)
+{
+    g_error("bb_geda_item_format() not overridden");
+}
+
+
 static void
 bb_geda_item_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec)
 {
@@ -198,9 +323,37 @@ bb_geda_item_get_property(GObject *object, guint property_id, GValue *value, GPa
 }
 
 
+guint
+bb_geda_item_get_revision(BbGedaItem *item)
+{
+    BbGedaItemPrivate *privat = bb_geda_item_get_instance_private(item);
+    g_return_val_if_fail(privat != NULL, 0);
+
+    return privat->revision;
+}
+
+
+static void
+bb_geda_item_init(BbGedaItem *item)
+{
+    bb_geda_item_bump_revision(item);
+}
+
+
+/**
+ * Discard the cached bounds, as the class handler of "invalidate-item"
+ *
+ * Runs before the connected handlers, so the handlers of the emission following a change see the new bounds.
+ *
+ * @param item The item about to change, or that just changed
+ */
 static void
-bb_geda_item_init(BbGedaItem *window)
+bb_geda_item_invalidate_bounds(BbGedaItem *item)
 {
+    BbGedaItemPrivate *privat = bb_geda_item_get_instance_private(item);
+    g_return_if_fail(privat != NULL);
+
+    privat->bounds_dirty = TRUE;
 }
 
 
@@ -235,6 +388,21 @@ bb_geda_item_render(BbGedaItem *item, BbItemRenderer *renderer)
 }
 
 
+void
+bb_geda_item_mirror_x(BbGedaItem *item, int cx)
+{
+    BbGedaItemClass *class = BB_GEDA_ITEM_GET_CLASS(item);
+
+    g_return_if_fail(class != NULL);
+    g_return_if_fail(class->mirror_x != NULL);
+
+    g_signal_emit_by_name(item, "invalidate-item");
+    class->mirror_x(item, cx);
+    bb_geda_item_bump_revision(item);
+    g_signal_emit_by_name(item, "invalidate-item");
+}
+
+
 static void
 bb_geda_item_mirror_x_missing(BbGedaItem *item, int cx)
 {
@@ -242,6 +410,21 @@ bb_geda_item_mirror_x_missing(BbGedaItem *item, int cx)
 }
 
 
+void
+bb_geda_item_mirror_y(BbGedaItem *item, int cy)
+{
+    BbGedaItemClass *class = BB_GEDA_ITEM_GET_CLASS(item);
+
+    g_return_if_fail(class != NULL);
+    g_return_if_fail(class->mirror_y != NULL);
+
+    g_signal_emit_by_name(item, "invalidate-item");
+    class->mirror_y(item, cy);
+    bb_geda_item_bump_revision(item);
+    g_signal_emit_by_name(item, "invalidate-item");
+}
+
+
 static void
 bb_geda_item_mirror_y_missing(BbGedaItem *item, int cy)
 {
@@ -256,6 +439,21 @@ bb_geda_item_render_missing(BbGedaItem *item, BbItemRenderer *renderer)
 }
 
 
+void
+bb_geda_item_rotate(BbGedaItem *item, int cx, int cy, int angle)
+{
+    BbGedaItemClass *class = BB_GEDA_ITEM_GET_CLASS(item);
+
+    g_return_if_fail(class != NULL);
+    g_return_if_fail(class->rotate != NULL);
+
+    g_signal_emit_by_name(item, "invalidate-item");
+    class->rotate(item, cx, cy, angle);
+    bb_geda_item_bump_revision(item);
+    g_signal_emit_by_name(item, "invalidate-item");
+}
+
+
 static void
 bb_geda_item_rotate_missing(BbGedaItem *item, int cx, int cy, int angle)
 {
@@ -274,6 +472,21 @@ bb_geda_item_set_property(GObject *object, guint property_id, const GValue *valu
 }
 
 
+void
+bb_geda_item_translate(BbGedaItem *item, int dx, int dy)
+{
+    BbGedaItemClass *class = BB_GEDA_ITEM_GET_CLASS(item);
+
+    g_return_if_fail(class != NULL);
+    g_return_if_fail(class->translate != NULL);
+
+    g_signal_emit_by_name(item, "invalidate-item");
+    class->translate(item, dx, dy);
+    bb_geda_item_bump_revision(item);
+    g_signal_emit_by_name(item, "invalidate-item");
+}
+
+
 static void
 bb_geda_item_translate_missing(BbGedaItem *item, int dx, int dy)
 {
@@ -293,15 +506,26 @@ bb_geda_item_write(BbGedaItem *item, GOutputStream *stream, GCancellable *cancel
 }
 
 
-gboolean
-bb_geda_item_write_missing(
+/**
+ * Write a single item through a buffer sized for one record
+ */
+static gboolean
+bb_geda_item_write_formatted(
     BbGedaItem *item,
     GOutputStream *stream,
     GCancellable *cancellable,
     GError **error
     )
 {
-    g_error("bb_geda_item_write() not overridden");
+    BbWriteBuffer *buffer = bb_write_buffer_new(stream, 256);
+
+    bb_geda_item_format(item, buffer);
+
+    gboolean result = bb_write_buffer_flush(buffer, cancellable, error);
+
+    bb_write_buffer_free(buffer);
+
+    return result;
 }
 
 
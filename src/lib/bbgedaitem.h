@@ -22,6 +22,7 @@
 #include "bbbounds.h"
 #include "bbboundscalculator.h"
 #include "bbitemrenderer.h"
+#include "bbwritebuffer.h"
 
 #define BB_TYPE_GEDA_ITEM bb_geda_item_get_type()
 G_DECLARE_DERIVABLE_TYPE(BbGedaItem, bb_geda_item, BB, GEDA_ITEM, GObject)
@@ -38,6 +39,7 @@ struct _BbGedaItemClass
     void (*render)(BbGedaItem *item, BbItemRenderer *renderer);
     void (*rotate)(BbGedaItem *item, int cx, int cy, int angle);
     void (*translate)(BbGedaItem *item, int dx, int dy);
+    void (*format)(BbGedaItem *item, BbWriteBuffer *buffer);
     gboolean (*write)(BbGedaItem *item, GOutputStream *stream, GCancellable *cancellable, GError **error);
 
     void (*write_async)(
@@ -58,12 +60,63 @@ struct _BbGedaItemClass
 };
 
 
+/**
+ * Mark the geometry of the item as changed
+ *
+ * Property changes and transforms through this class bump the revision automatically. Subclasses only call this
+ * function when changing the geometry by other means.
+ *
+ * @param item The item with the changed geometry
+ */
+void
+bb_geda_item_bump_revision(BbGedaItem *item);
+
+/**
+ * Calculate the bounds of the rendered item, including line widths and text extents
+ *
+ * The result is cached on the item until its geometry, style, or text changes, or until a different calculator
+ * is used.
+ *
+ * @param item The item
+ * @param calculator Calculates the bounds of primitives
+ * @return The bounds of the item, free with bb_bounds_free()
+ */
 BbBounds*
 bb_geda_item_calculate_bounds(BbGedaItem *item, BbBoundsCalculator *calculator);
 
 BbGedaItem*
 bb_geda_item_clone(BbGedaItem *item);
 
+/**
+ * Check if the item type provides a file representation through bb_geda_item_format()
+ *
+ * @param item The item to check
+ * @return TRUE if the item can be formatted
+ */
+gboolean
+bb_geda_item_can_format(BbGedaItem *item);
+
+/**
+ * Append the file representation of the item to a buffer
+ *
+ * @param item The item to format
+ * @param buffer The buffer receiving the file representation
+ */
+void
+bb_geda_item_format(BbGedaItem *item, BbWriteBuffer *buffer);
+
+/**
+ * Get the revision of the item geometry
+ *
+ * The revision changes whenever the geometry may have changed. Revisions are unique across all items, so renderers
+ * can cache data derived from the geometry, keyed by the item and revision, without observing the item.
+ *
+ * @param item The item
+ * @return The revision of the item geometry
+ */
+guint
+bb_geda_item_get_revision(BbGedaItem *item);
+
 gboolean
 bb_geda_item_is_significant(BbGedaItem *item);
 
@@ -163,8 +163,8 @@ bb_geda_line_set_property(GObject *object, guint property_id, const GValue *valu
 static void
 bb_geda_line_translate(BbGedaItem *item, int dx, int dy);
 
-static gboolean
-bb_geda_line_write(BbGedaItem *item, GOutputStream *stream, GCancellable *cancellable, GError **error);
+static void
+bb_geda_line_format(BbGedaItem *item, BbWriteBuffer *buffer);
 
 static void
 bb_geda_line_write_async(
@@ -265,7 +265,7 @@ bb_geda_line_class_init(BbGedaLineClass *klasse)
     BB_GEDA_ITEM_CLASS(klasse)->clone = bb_geda_line_clone;
     BB_GEDA_ITEM_CLASS(klasse)->render = bb_geda_line_render;
     BB_GEDA_ITEM_CLASS(klasse)->translate = bb_geda_line_translate;
-    BB_GEDA_ITEM_CLASS(klasse)->write = bb_geda_line_write;
+    BB_GEDA_ITEM_CLASS(klasse)->format = bb_geda_line_format;
     BB_GEDA_ITEM_CLASS(klasse)->write_async = bb_geda_line_write_async;
     BB_GEDA_ITEM_CLASS(klasse)->write_finish = bb_geda_line_write_finish;
 
@@ -905,18 +905,14 @@ bb_geda_line_translate(BbGedaItem *item, int dx, int dy)
 }
 
 
-static gboolean
-bb_geda_line_write(BbGedaItem *item, GOutputStream *stream, GCancellable *cancellable, GError **error)
+static void
+bb_geda_line_format(BbGedaItem *item, BbWriteBuffer *buffer)
 {
     BbGedaLine *line = BB_GEDA_LINE(item);
-    g_return_val_if_fail(line != NULL, FALSE);
-
-    GString *params = g_string_new(NULL);
+    g_return_if_fail(line != NULL);
 
-    g_string_printf(
-        params,
-        "%s %d %d %d %d %d %d %d %d %d %d\n",
-        BB_GEDA_LINE_TOKEN,
+    int params[] =
+    {
         line->x[0],
         line->y[0],
         line->x[1],
@@ -927,20 +923,9 @@ bb_geda_line_write(BbGedaItem *item, GOutputStream *stream, GCancellable *cancel
         line->line_style->dash_type,
         bb_line_style_get_dash_length_for_file(line->line_style),
         bb_line_style_get_dash_space_for_file(line->line_style)
-        );
-
-    gboolean result = g_output_stream_write_all(
-        stream,
-        params->str,
-        params->len,
-        NULL,
-        cancellable,
-        error
-    );
-
-    g_string_free(params, TRUE);
+    };
 
-    return result;
+    bb_write_buffer_append_params(buffer, BB_GEDA_LINE_TOKEN, G_N_ELEMENTS(params), params);
 }
 
 
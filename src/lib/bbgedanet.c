@@ -170,13 +170,8 @@ bb_geda_net_translate(
     int dy
     );
 
-static gboolean
-bb_geda_net_write(
-    BbGedaItem *item,
-    GOutputStream *stream,
-    GCancellable *cancellable,
-    GError **error
-    );
+static void
+bb_geda_net_format(BbGedaItem *item, BbWriteBuffer *buffer);
 
 static void
 bb_geda_net_write_async(
@@ -286,7 +281,7 @@ bb_geda_net_class_init(BbGedaNetClass *klasse)
     BB_GEDA_ITEM_CLASS(klasse)->clone = bb_geda_net_clone;
     BB_GEDA_ITEM_CLASS(klasse)->render = bb_geda_net_render;
     BB_GEDA_ITEM_CLASS(klasse)->translate = bb_geda_net_translate;
-    BB_GEDA_ITEM_CLASS(klasse)->write = bb_geda_net_write;
+    BB_GEDA_ITEM_CLASS(klasse)->format = bb_geda_net_format;
     BB_GEDA_ITEM_CLASS(klasse)->write_async = bb_geda_net_write_async;
     BB_GEDA_ITEM_CLASS(klasse)->write_finish = bb_geda_net_write_finish;
 
@@ -702,37 +697,22 @@ bb_geda_net_translate(BbGedaItem *item, int dx, int dy)
 }
 
 
-static gboolean
-bb_geda_net_write(BbGedaItem *item, GOutputStream *stream, GCancellable *cancellable, GError **error)
+static void
+bb_geda_net_format(BbGedaItem *item, BbWriteBuffer *buffer)
 {
     BbGedaNet *net = BB_GEDA_NET(item);
-    g_return_val_if_fail(net != NULL, FALSE);
-
-    GString *params = g_string_new(NULL);
+    g_return_if_fail(net != NULL);
 
-    g_string_printf(
-        params,
-        "%s %d %d %d %d %d\n",
-        BB_GEDA_NET_TOKEN,
+    int params[] =
+    {
         net->x[0],
         net->y[0],
         net->x[1],
         net->y[1],
         net->color
-        );
-
-    gboolean result = g_output_stream_write_all(
-        stream,
-        params->str,
-        params->len,
-        NULL,
-        cancellable,
-        error
-    );
-
-    g_string_free(params, TRUE);
+    };
 
-    return result;
+    bb_write_buffer_append_params(buffer, BB_GEDA_NET_TOKEN, G_N_ELEMENTS(params), params);
 }
 
 
@@ -20,7 +20,7 @@
 #include <bbextensions.h>
 #include "bbgedapath.h"
 #include "bbitemparams.h"
-#include "bbpathcommand.h"
+#include "bbpathdata.h"
 #include "bbcolor.h"
 #include "bberror.h"
 #include "bbcolors.h"
@@ -90,7 +90,10 @@ struct _BbGedaPath
 
     BbItemParams *params;
 
-    GSList *commands;
+    /**
+     * The path commands, stored as packed arrays
+     */
+    BbPathData *data;
 
     int color;
 
@@ -99,47 +102,9 @@ struct _BbGedaPath
 };
 
 
-typedef struct _MirrorXCapture MirrorXCapture;
-
-struct _MirrorXCapture
-{
-    int cx;
-};
-
-
-typedef struct _MirrorYCapture MirrorYCapture;
-
-struct _MirrorYCapture
-{
-    int cy;
-};
-
-
-typedef struct _RotateCapture RotateCapture;
-
-struct _RotateCapture
-{
-    int cx;
-    int cy;
-    int angle;
-};
-
-
-typedef struct _TranslateCapture TranslateCapture;
-
-struct _TranslateCapture
-{
-    int dx;
-    int dy;
-};
-
-
 static void
 bb_geda_path_closed_shape_drawer_init(BbClosedShapeDrawerInterface *iface);
 
-static void
-bb_geda_path_draw_outline_lambda(gpointer command, gpointer renderer);
-
 static void
 bb_geda_path_adjustable_fill_style_init(BbAdjustableFillStyleInterface *iface);
 
@@ -154,12 +119,18 @@ bb_geda_path_adjustable_line_style_init(BbAdjustableLineStyleInterface *iface);
 static BbBounds*
 bb_geda_path_calculate_bounds(BbGedaItem *item, BbBoundsCalculator *calculator);
 
+static BbGedaItem*
+bb_geda_path_clone(BbGedaItem *item);
+
 static void
 bb_geda_path_dispose(GObject *object);
 
 static void
 bb_geda_path_finalize(GObject *object);
 
+static void
+bb_geda_path_format(BbGedaItem *item, BbWriteBuffer *buffer);
+
 static int
 bb_geda_path_get_cap_type(BbGedaPath *path);
 
@@ -184,24 +155,15 @@ bb_geda_path_get_property(GObject *object, guint property_id, GValue *value, GPa
 static void
 bb_geda_path_mirror_x(BbGedaItem *item, int cx);
 
-static void
-bb_geda_path_mirror_x_lambda(BbPathCommand *command, MirrorXCapture *capture);
-
 static void
 bb_geda_path_mirror_y(BbGedaItem *item, int cy);
 
-static void
-bb_geda_path_mirror_y_lambda(BbPathCommand *command, MirrorYCapture *capture);
-
 static void
 bb_geda_path_render(BbGedaItem *item, BbItemRenderer *renderer);
 
 static void
 bb_geda_path_rotate(BbGedaItem *item, int cx, int cy, int angle);
 
-static void
-bb_geda_path_rotate_lambda(BbPathCommand *command, RotateCapture *capture);
-
 static void
 bb_geda_path_set_cap_type(BbGedaPath *path, int type);
 
@@ -226,9 +188,6 @@ bb_geda_path_set_property(GObject *object, guint property_id, const GValue *valu
 static void
 bb_geda_path_translate(BbGedaItem *item, int dx, int dy);
 
-static void
-bb_geda_path_translate_lambda(BbPathCommand *command, TranslateCapture *capture);
-
 static void
 bb_geda_path_write_async(
     BbGedaItem *item,
@@ -453,21 +412,7 @@ bb_geda_path_draw_outline(BbClosedShapeDrawer *drawer, BbItemRenderer *renderer)
     g_return_if_fail(BB_IS_GEDA_PATH(path));
     g_return_if_fail(BB_IS_ITEM_RENDERER(renderer));
 
-    g_slist_foreach(
-        path->commands,
-        bb_geda_path_draw_outline_lambda,
-        renderer
-        );
-}
-
-
-static void
-bb_geda_path_draw_outline_lambda(gpointer command, gpointer renderer)
-{
-    bb_path_command_render(
-        BB_PATH_COMMAND(command),
-        BB_ITEM_RENDERER(renderer)
-        );
+    bb_path_data_render(path->data, renderer);
 }
 
 
@@ -498,8 +443,26 @@ bb_geda_path_calculate_bounds(BbGedaItem *item, BbBoundsCalculator *calculator)
     BbGedaPath *path = BB_GEDA_PATH(item);
 
     g_return_val_if_fail(path != NULL, NULL);
+    g_return_val_if_fail(path->data != NULL, NULL);
+    g_return_val_if_fail(path->line_style != NULL, NULL);
+
+    BbBounds bounds;
+
+    bb_path_data_calculate_bounds(path->data, &bounds);
 
-    return bb_bounds_new();
+    if (bb_bounds_is_empty(&bounds))
+    {
+        return bb_bounds_new();
+    }
+
+    return bb_bounds_calculator_calculate_from_corners(
+        calculator,
+        bounds.min_x,
+        bounds.min_y,
+        bounds.max_x,
+        bounds.max_y,
+        path->line_style->line_width
+        );
 }
 
 
@@ -515,6 +478,8 @@ bb_geda_path_class_init(BbGedaPathClass *klasse)
     G_OBJECT_CLASS(klasse)->set_property = bb_geda_path_set_property;
 
     BB_GEDA_ITEM_CLASS(klasse)->calculate_bounds = bb_geda_path_calculate_bounds;
+    BB_GEDA_ITEM_CLASS(klasse)->clone = bb_geda_path_clone;
+    BB_GEDA_ITEM_CLASS(klasse)->format = bb_geda_path_format;
     BB_GEDA_ITEM_CLASS(klasse)->mirror_x = bb_geda_path_mirror_x;
     BB_GEDA_ITEM_CLASS(klasse)->mirror_y = bb_geda_path_mirror_y;
     BB_GEDA_ITEM_CLASS(klasse)->render = bb_geda_path_render;
@@ -619,17 +584,44 @@ bb_geda_path_class_init(BbGedaPathClass *klasse)
 }
 
 
-static void
-bb_geda_path_dispose(GObject *object)
+static BbGedaItem*
+bb_geda_path_clone(BbGedaItem *item)
 {
-    BbGedaPath *path = BB_GEDA_PATH(object);
+    BbGedaPath *path = BB_GEDA_PATH(item);
+    g_return_val_if_fail(path != NULL, NULL);
 
-    g_return_if_fail(path != NULL);
+    return BB_GEDA_ITEM(g_object_new(
+        BB_TYPE_GEDA_PATH,
 
-    g_slist_free_full(
-        g_steal_pointer(&path->commands),
-        g_object_unref
-        );
+        /* From AdjustableFillStyle */
+        "angle-1", bb_geda_path_get_angle_1(path),
+        "angle-2", bb_geda_path_get_angle_2(path),
+        "fill-type", bb_geda_path_get_fill_type(path),
+        "fill-width", bb_geda_path_get_fill_width(path),
+        "pitch-1", bb_geda_path_get_pitch_1(path),
+        "pitch-2", bb_geda_path_get_pitch_2(path),
+
+        /* From AdjustableItemColor */
+        "item-color", bb_geda_path_get_item_color(path),
+
+        /* From AdjustableLineStyle */
+        "cap-type", bb_geda_path_get_cap_type(path),
+        "dash-length", bb_geda_path_get_dash_length(path),
+        "dash-space", bb_geda_path_get_dash_space(path),
+        "dash-type", bb_geda_path_get_dash_type(path),
+        "line-width", bb_geda_path_get_line_width(path),
+
+        /* From BbGedaPath */
+        "commands", path->data,
+
+        NULL
+        ));
+}
+
+
+static void
+bb_geda_path_dispose(GObject *object)
+{
 }
 
 
@@ -640,11 +632,40 @@ bb_geda_path_finalize(GObject *object)
 
     g_return_if_fail(path != NULL);
 
+    bb_path_data_free(path->data);
     bb_fill_style_free(path->fill_style);
     bb_line_style_free(path->line_style);
 }
 
 
+static void
+bb_geda_path_format(BbGedaItem *item, BbWriteBuffer *buffer)
+{
+    BbGedaPath *path = BB_GEDA_PATH(item);
+    g_return_if_fail(path != NULL);
+
+    int params[] =
+    {
+        path->color,
+        path->line_style->line_width,
+        path->line_style->cap_type,
+        path->line_style->dash_type,
+        bb_line_style_get_dash_length_for_file(path->line_style),
+        bb_line_style_get_dash_space_for_file(path->line_style),
+        path->fill_style->type,
+        bb_fill_style_get_fill_width_for_file(path->fill_style),
+        bb_fill_style_get_fill_angle_1_for_file(path->fill_style),
+        bb_fill_style_get_fill_pitch_1_for_file(path->fill_style),
+        bb_fill_style_get_fill_angle_2_for_file(path->fill_style),
+        bb_fill_style_get_fill_pitch_2_for_file(path->fill_style),
+        bb_path_data_get_command_count(path->data)
+    };
+
+    bb_write_buffer_append_params(buffer, BB_GEDA_PATH_TOKEN, G_N_ELEMENTS(params), params);
+    bb_path_data_format(path->data, buffer);
+}
+
+
 static int
 bb_geda_path_get_cap_type(BbGedaPath *path)
 {
@@ -776,6 +797,7 @@ bb_geda_path_init(BbGedaPath *path)
 {
     g_return_if_fail(path != NULL);
 
+    path->data = bb_path_data_new();
     path->fill_style = bb_fill_style_new();
     path->line_style = bb_line_style_new();
 }
@@ -787,24 +809,7 @@ bb_geda_path_mirror_x(BbGedaItem *item, int cx)
     BbGedaPath *path = BB_GEDA_PATH(item);
     g_return_if_fail(path != NULL);
 
-    MirrorXCapture capture;
-
-    capture.cx = cx;
-
-    g_slist_foreach(
-        path->commands,
-        (GFunc) bb_geda_path_mirror_x_lambda,
-        &capture
-        );
-}
-
-
-static void
-bb_geda_path_mirror_x_lambda(BbPathCommand *command, MirrorXCapture *capture)
-{
-    g_return_if_fail(capture != NULL);
-
-    bb_path_command_mirror_x(command, capture->cx);
+    bb_path_data_mirror_x(path->data, cx);
 }
 
 
@@ -814,29 +819,12 @@ bb_geda_path_mirror_y(BbGedaItem *item, int cy)
     BbGedaPath *path = BB_GEDA_PATH(item);
     g_return_if_fail(path != NULL);
 
-    MirrorYCapture capture;
-
-    capture.cy = cy;
-
-    g_slist_foreach(
-        path->commands,
-        (GFunc) bb_geda_path_mirror_y_lambda,
-        &capture
-        );
-}
-
-
-static void
-bb_geda_path_mirror_y_lambda(BbPathCommand *command, MirrorYCapture *capture)
-{
-    g_return_if_fail(capture != NULL);
-
-    bb_path_command_mirror_y(command, capture->cy);
+    bb_path_data_mirror_y(path->data, cy);
 }
 
 
 BbGedaPath*
-bb_geda_path_new_with_params(BbParams *params, GSList *commands, GError **error)
+bb_geda_path_new_with_params(BbParams *params, const BbPathData *data, GError **error)
 {
     GError *local_error = NULL;
 
@@ -882,7 +870,7 @@ bb_geda_path_new_with_params(BbParams *params, GSList *commands, GError **error)
             "dash-length", line_style.dash_length,
             "dash-space", line_style.dash_space,
 
-            "commands", commands,
+            "commands", data,
 
             NULL
         ));
@@ -904,26 +892,7 @@ bb_geda_path_rotate(BbGedaItem *item, int cx, int cy, int angle)
     BbGedaPath *path = BB_GEDA_PATH(item);
     g_return_if_fail(path != NULL);
 
-    RotateCapture capture;
-
-    capture.cx = cx;
-    capture.cy = cy;
-    capture.angle = angle;
-
-    g_slist_foreach(
-        path->commands,
-        (GFunc) bb_geda_path_rotate_lambda,
-        &capture
-        );
-}
-
-
-static void
-bb_geda_path_rotate_lambda(BbPathCommand *command, RotateCapture *capture)
-{
-    g_return_if_fail(capture != NULL);
-
-    bb_path_command_rotate(command, capture->cx, capture->cy, capture->angle);
+    bb_path_data_rotate(path->data, cx, cy, angle);
 }
 
 
@@ -963,15 +932,15 @@ bb_geda_path_set_cap_type(BbGedaPath *path, int type)
 
 
 static void
-bb_geda_path_set_commands(BbGedaPath *path, GSList *commands)
+bb_geda_path_set_commands(BbGedaPath *path, const BbPathData *data)
 {
     g_return_if_fail(BB_IS_GEDA_PATH(path));
+    g_return_if_fail(data != NULL);
 
     g_signal_emit(path, signals[SIG_INVALIDATE], 0);
 
-    g_clear_slist(&path->commands, g_object_unref);
-
-    path->commands = g_slist_copy_deep(commands, (GCopyFunc) g_object_ref, NULL);
+    bb_path_data_free(path->data);
+    path->data = bb_path_data_copy(data);
 
     g_signal_emit(path, signals[SIG_INVALIDATE], 0);
 
@@ -1136,32 +1105,14 @@ bb_geda_path_translate(BbGedaItem *item, int dx, int dy)
     BbGedaPath *path = BB_GEDA_PATH(item);
     g_return_if_fail(path != NULL);
 
-    TranslateCapture capture;
-
-    capture.dx = dx;
-    capture.dy = dy;
-
     g_signal_emit(path, signals[SIG_INVALIDATE], 0);
 
-    g_slist_foreach(
-        path->commands,
-        (GFunc) bb_geda_path_translate_lambda,
-        &capture
-        );
+    bb_path_data_translate(path->data, dx, dy);
 
     g_signal_emit(path, signals[SIG_INVALIDATE], 0);
 }
 
 
-static void
-bb_geda_path_translate_lambda(BbPathCommand *command, TranslateCapture *capture)
-{
-    g_return_if_fail(capture != NULL);
-
-    bb_path_command_translate(command, capture->dx, capture->dy);
-}
-
-
 static void
 bb_geda_path_write_async(
     BbGedaItem *item,
@@ -20,6 +20,7 @@
 
 #include <gtk/gtk.h>
 #include "bbgedaitem.h"
+#include "bbpathdata.h"
 
 
 #define BB_GEDA_PATH_TOKEN "H"
@@ -42,7 +43,15 @@ int
 bb_geda_path_get_line_count(BbParams *params, GError **error);
 
 
+/**
+ * Create a path from the parameters and commands read from a file
+ *
+ * @param params The parameters from the first line of the item
+ * @param data The path commands, which are copied
+ * @param error An optional location to store an error
+ * @return A new BbGedaPath, or NULL on failure
+ */
 BbGedaPath*
-bb_geda_path_new_with_params(BbParams *params, GSList *commands, GError **error);
+bb_geda_path_new_with_params(BbParams *params, const BbPathData *data, GError **error);
 
 #endif
@@ -184,13 +184,8 @@ bb_geda_pin_translate(
     int dy
     );
 
-static gboolean
-bb_geda_pin_write(
-    BbGedaItem *item,
-    GOutputStream *stream,
-    GCancellable *cancellable,
-    GError **error
-    );
+static void
+bb_geda_pin_format(BbGedaItem *item, BbWriteBuffer *buffer);
 
 static void
 bb_geda_pin_write_async(
@@ -304,7 +299,7 @@ bb_geda_pin_class_init(BbGedaPinClass *klasse)
     item_class->clone = bb_geda_pin_clone;
     item_class->render = bb_geda_pin_render;
     item_class->translate = bb_geda_pin_translate;
-    item_class->write = bb_geda_pin_write;
+    item_class->format = bb_geda_pin_format;
     item_class->write_async = bb_geda_pin_write_async;
     item_class->write_finish = bb_geda_pin_write_finish;
 
@@ -879,15 +874,11 @@ bb_geda_pin_translate(BbGedaItem *item, int dx, int dy)
 }
 
 
-static gboolean
-bb_geda_pin_write(BbGedaItem *item, GOutputStream *stream, GCancellable *cancellable, GError **error)
+static void
+bb_geda_pin_format(BbGedaItem *item, BbWriteBuffer *buffer)
 {
-    GString *params = g_string_new(NULL);
-
-    g_string_printf(
-        params,
-        "%s %d %d %d %d %d %d %d\n",
-        BB_GEDA_PIN_TOKEN,
+    int params[] =
+    {
         bb_geda_pin_get_x0(BB_GEDA_PIN(item)),
         bb_geda_pin_get_y0(BB_GEDA_PIN(item)),
         bb_geda_pin_get_x1(BB_GEDA_PIN(item)),
@@ -895,20 +886,9 @@ bb_geda_pin_write(BbGedaItem *item, GOutputStream *stream, GCancellable *cancell
         bb_geda_pin_get_item_color(BB_GEDA_PIN(item)),
         bb_geda_pin_get_pin_type(BB_GEDA_PIN(item)),
         bb_geda_pin_get_pin_end(BB_GEDA_PIN(item))
-        );
-
-    gboolean result = g_output_stream_write_all(
-        stream,
-        params->str,
-        params->len,
-        NULL,
-        cancellable,
-        error
-        );
-
-    g_string_free(params, TRUE);
+    };
 
-    return result;
+    bb_write_buffer_append_params(buffer, BB_GEDA_PIN_TOKEN, G_N_ELEMENTS(params), params);
 }
 
 
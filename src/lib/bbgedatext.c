@@ -203,6 +203,11 @@ bb_geda_text_get_property(
     GParamSpec *pspec
     );
 
+static const char*
+bb_geda_text_get_shown_text(
+    BbGedaText *text
+    );
+
 static gchar*
 bb_geda_text_get_value(
     BbAttribute *attribute
@@ -247,13 +252,8 @@ bb_geda_text_translate(
     int dy
     );
 
-static gboolean
-bb_geda_text_write(
-    BbGedaItem *item,
-    GOutputStream *stream,
-    GCancellable *cancellable,
-    GError **error
-    );
+static void
+bb_geda_text_format(BbGedaItem *item, BbWriteBuffer *buffer);
 
 static void
 bb_geda_text_write_async(
@@ -313,14 +313,35 @@ bb_geda_text_calculate_bounds(BbGedaItem *item, BbBoundsCalculator *calculator)
 
     g_return_val_if_fail(text != NULL, NULL);
 
-    return bb_bounds_calculator_calculate_from_corners(
+    BbBounds *bounds = bb_bounds_calculator_calculate_from_text(
         calculator,
         text->insert_x,
         text->insert_y,
-        text->insert_x,
-        text->insert_y,
-        0
+        text->alignment,
+        text->rotation,
+        text->size,
+        bb_geda_text_get_shown_text(text)
+        );
+
+    BbBounds *marker = bb_bounds_calculator_calculate_from_corners(
+        calculator,
+        text->insert_x - BB_ITEM_RENDERER_INSERTION_POINT_RADIUS,
+        text->insert_y - BB_ITEM_RENDERER_INSERTION_POINT_RADIUS,
+        text->insert_x + BB_ITEM_RENDERER_INSERTION_POINT_RADIUS,
+        text->insert_y + BB_ITEM_RENDERER_INSERTION_POINT_RADIUS,
+        BB_ITEM_RENDERER_INSERTION_POINT_WIDTH
         );
+
+    /* Hidden text is included, since revealing it must not require recalculating bounds */
+
+    if (bounds != NULL && marker != NULL)
+    {
+        bb_bounds_union(bounds, bounds, marker);
+    }
+
+    bb_bounds_free(marker);
+
+    return bounds;
 }
 
 
@@ -339,7 +360,7 @@ bb_geda_text_class_init(BbGedaTextClass *klasse)
     BB_GEDA_ITEM_CLASS(klasse)->clone = bb_geda_text_clone;
     BB_GEDA_ITEM_CLASS(klasse)->render = bb_geda_text_render;
     BB_GEDA_ITEM_CLASS(klasse)->translate = bb_geda_text_translate;
-    BB_GEDA_ITEM_CLASS(klasse)->write = bb_geda_text_write;
+    BB_GEDA_ITEM_CLASS(klasse)->format = bb_geda_text_format;
     BB_GEDA_ITEM_CLASS(klasse)->write_async = bb_geda_text_write_async;
     BB_GEDA_ITEM_CLASS(klasse)->write_finish = bb_geda_text_write_finish;
 
@@ -1237,15 +1258,11 @@ bb_geda_text_translate(BbGedaItem *item, int dx, int dy)
 }
 
 
-static gboolean
-bb_geda_text_write(BbGedaItem *item, GOutputStream *stream, GCancellable *cancellable, GError **error)
+static void
+bb_geda_text_format(BbGedaItem *item, BbWriteBuffer *buffer)
 {
-    GString *params = g_string_new(NULL);
-
-    g_string_printf(
-        params,
-        "%s %d %d %d %d %d %d %d %d %d\n%s\n",
-        BB_GEDA_TEXT_TOKEN,
+    int params[] =
+    {
         bb_geda_text_get_insert_x(BB_GEDA_TEXT(item)),
         bb_geda_text_get_insert_y(BB_GEDA_TEXT(item)),
         bb_adjustable_item_color_get_color(BB_ADJUSTABLE_ITEM_COLOR(item)),
@@ -1254,22 +1271,12 @@ bb_geda_text_write(BbGedaItem *item, GOutputStream *stream, GCancellable *cancel
         bb_geda_text_get_presentation(BB_GEDA_TEXT(item)),
         bb_geda_text_get_rotation(BB_GEDA_TEXT(item)),
         bb_geda_text_get_alignment(BB_GEDA_TEXT(item)),
-        bb_geda_text_count_lines(BB_GEDA_TEXT(item)),
-        bb_geda_text_get_text(BB_GEDA_TEXT(item))
-        );
-
-    gboolean result = g_output_stream_write_all(
-        stream,
-        params->str,
-        params->len,
-        NULL,
-        cancellable,
-        error
-        );
-
-    g_string_free(params, TRUE);
+        bb_geda_text_count_lines(BB_GEDA_TEXT(item))
+    };
 
-    return result;
+    bb_write_buffer_append_params(buffer, BB_GEDA_TEXT_TOKEN, G_N_ELEMENTS(params), params);
+    bb_write_buffer_append_string(buffer, bb_geda_text_get_text(BB_GEDA_TEXT(item)));
+    bb_write_buffer_append_char(buffer, '\n');
 }
 
 
@@ -44,34 +44,64 @@ struct _BbSweepEvent
 };
 
 
-void
-bb_hatch_box(int x[2], int y[2], gint angle, gint pitch, GArray *lines)
-{
-    g_return_if_fail(lines != NULL);
+static void
+bb_hatch_activate_events(GArray *events, guint *next_event, double sweep_y, GArray *status);
 
-    GArray *corners = g_array_sized_new(FALSE, FALSE, sizeof(BbPoint), 4);
+static double
+bb_hatch_calculate_initial_sweep(int pitch, double min_y, double max_y);
 
-    BbPoint point;
+static int
+bb_hatch_compare_sweep_events(BbSweepEvent *a, BbSweepEvent *b);
 
-    point.x = x[0];
-    point.y = y[0];
-    g_array_append_val(corners, point);
+static void
+bb_hatch_expire_statuses(GArray *status, double sweep_y);
 
-    point.x = x[1];
-    point.y = y[0];
-    g_array_append_val(corners, point);
+static void
+bb_hatch_update_statuses(GArray *status, double sweep_y);
 
-    point.x = x[1];
-    point.y = y[1];
-    g_array_append_val(corners, point);
 
-    point.x = x[0];
-    point.y = y[1];
-    g_array_append_val(corners, point);
+/**
+ * Move events reached by the sweep line into the status
+ *
+ * The events are sorted by their starting y, so the sweep only advances an index into the array.
+ *
+ * @param events The sorted events
+ * @param next_event The index of the first event not yet reached
+ * @param sweep_y The y coordinate of the sweep line
+ * @param status The edges crossing the sweep line
+ */
+static void
+bb_hatch_activate_events(GArray *events, guint *next_event, double sweep_y, GArray *status)
+{
+    while (*next_event < events->len)
+    {
+        BbSweepEvent *event = &g_array_index(events, BbSweepEvent, *next_event);
+
+        if (sweep_y < event->y0)
+        {
+            break;
+        }
+
+        g_array_append_val(status, event->status);
+        (*next_event)++;
+    }
+}
+
+
+void
+bb_hatch_box(int x[2], int y[2], gint angle, gint pitch, GArray *lines)
+{
+    g_return_if_fail(lines != NULL);
 
-    bb_hatch_polygon(corners, angle, pitch, lines);
+    BbPoint corners[4] =
+    {
+        { .x = x[0], .y = y[0] },
+        { .x = x[1], .y = y[0] },
+        { .x = x[1], .y = y[1] },
+        { .x = x[0], .y = y[1] }
+    };
 
-    g_array_free(corners, TRUE);
+    bb_hatch_points(G_N_ELEMENTS(corners), corners, angle, pitch, lines);
 }
 
 
@@ -91,22 +121,45 @@ bb_hatch_compare_sweep_events(BbSweepEvent *a, BbSweepEvent *b)
 }
 
 
-static int
-bb_hatch_compare_sweep_statuses(BbSweepStatus *a, BbSweepStatus *b)
+/**
+ * Remove edges ending at or before the sweep line, preserving the order of the remaining edges
+ *
+ * @param status The edges crossing the previous sweep line, ordered by x
+ * @param sweep_y The y coordinate of the sweep line
+ */
+static void
+bb_hatch_expire_statuses(GArray *status, double sweep_y)
 {
-    return a->x - b->x;
+    guint count = 0;
+
+    for (guint index = 0; index < status->len; index++)
+    {
+        BbSweepStatus *st = &g_array_index(status, BbSweepStatus, index);
+
+        if (sweep_y < st->y1)
+        {
+            g_array_index(status, BbSweepStatus, count++) = *st;
+        }
+    }
+
+    g_array_set_size(status, count);
 }
 
 
 void
-bb_hatch_polygon(GArray *points, gint angle, gint pitch, GArray *lines)
+bb_hatch_points(int count, const BbPoint points[count], gint angle, gint pitch, GArray *lines)
 {
-    g_return_if_fail(points != NULL);
+    g_return_if_fail(count == 0 || points != NULL);
     g_return_if_fail(pitch > 0);
     g_return_if_fail(lines != NULL);
 
-    GArray *events = g_array_new(FALSE, FALSE, sizeof(BbSweepEvent));
-    GArray *points2 = g_array_sized_new(FALSE, FALSE, sizeof(BbPoint), points->len);
+    if (count < 2)
+    {
+        return;
+    }
+
+    GArray *events = g_array_sized_new(FALSE, FALSE, sizeof(BbSweepEvent), count);
+    GArray *points2 = g_array_sized_new(FALSE, FALSE, sizeof(BbPoint), count);
     GArray *status = g_array_new(FALSE, FALSE, sizeof(BbSweepStatus));
 
     BbMatrix transform;
@@ -114,32 +167,29 @@ bb_hatch_polygon(GArray *points, gint angle, gint pitch, GArray *lines)
     bb_matrix_init(&transform);
     bb_matrix_rotate(&transform, bb_angle_to_radians(-angle));
 
-    g_array_append_vals(points2, points->data, points->len);
+    g_array_append_vals(points2, points, count);
     bb_point_transform_array(points2->len, &g_array_index(points2, BbPoint, 0), &transform);
 
-    if (points2->len > 1)
+    BbPoint *p0 = &g_array_index(points2, BbPoint, points2->len-1);
+
+    for (int index = 0; index < points2->len; index++)
     {
-        BbPoint *p0 = &g_array_index(points2, BbPoint, points2->len-1);
+        BbPoint *p1 = &g_array_index(points2, BbPoint, index);
 
-        for (int index = 0; index < points2->len; index++)
+        if ( p0->y != p1->y )
         {
-            BbPoint *p1 = &g_array_index(points2, BbPoint, index);
-
-            if ( p0->y != p1->y )
+            BbSweepEvent event =
             {
-                BbSweepEvent event =
-                {
-                    .y0 = MIN(p0->y, p1->y),
-                    .status.y1 = MAX(p0->y, p1->y),
-                    .status.m1 = (gdouble)( p1->x - p0->x ) / (gdouble)( p1->y - p0->y ),
-                    .status.b1 = p0->x - event.status.m1 * p0->y
-                };
-
-                g_array_append_val(events, event);
-            }
-
-            p0 = p1;
+                .y0 = MIN(p0->y, p1->y),
+                .status.y1 = MAX(p0->y, p1->y),
+                .status.m1 = (gdouble)( p1->x - p0->x ) / (gdouble)( p1->y - p0->y ),
+                .status.b1 = p0->x - event.status.m1 * p0->y
+            };
+
+            g_array_append_val(events, event);
         }
+
+        p0 = p1;
     }
 
     g_array_sort(events, (GCompareFunc) bb_hatch_compare_sweep_events);
@@ -159,59 +209,36 @@ bb_hatch_polygon(GArray *points, gint angle, gint pitch, GArray *lines)
     bb_points_calculate_bounds(points2->len, (BbPoint*) points2->data, &bounds);
     double sweep_y = bb_hatch_calculate_initial_sweep(pitch, bounds.min_y, bounds.max_y);
 
-    while (events->len > 0 || status->len > 0)
+    guint next_event = 0;
+
+    while (next_event < events->len || status->len > 0)
     {
-        int index = 0;
+        bb_hatch_activate_events(events, &next_event, sweep_y, status);
+        bb_hatch_expire_statuses(status, sweep_y);
+        bb_hatch_update_statuses(status, sweep_y);
 
-        while (index < events->len)
-        {
-            BbSweepEvent *event = &g_array_index(events, BbSweepEvent , index);
+        /* Reserve room for every segment on this scanline, then write them in place */
 
-            if (sweep_y >= event->y0)
-            {
-                BbSweepStatus st = event->status;
+        guint first = lines->len;
+        guint segments = status->len / 2;
 
-                g_array_append_val(status, st);
-                g_array_remove_index(events, index);
-            }
-            else
-            {
-                index++;
-            }
-        }
+        g_array_set_size(lines, first + segments);
 
-        for (index = status->len - 1; index >= 0; index--)
-        {
-            BbSweepStatus *st = &g_array_index(status, BbSweepStatus, index);
+        BbLine *line = &g_array_index(lines, BbLine, first);
 
-            if (sweep_y >= st->y1)
-            {
-                g_array_remove_index_fast(status, index);
-            }
-        }
-
-        for (index = 0; index < status->len; index++)
+        for (guint index = 0; index + 1 < status->len; index += 2)
         {
-            BbSweepStatus *st = &g_array_index(status, BbSweepStatus, index);
+            line->x[0] = g_array_index(status, BbSweepStatus, index).x;
+            line->y[0] = sweep_y;
+            line->x[1] = g_array_index(status, BbSweepStatus, index + 1).x;
+            line->y[1] = sweep_y;
 
-            st->x = st->m1 * sweep_y + st->b1;
+            line++;
         }
 
-        g_array_sort(status, (GCompareFunc) bb_hatch_compare_sweep_statuses);
-
-        for (index = 0; index+1 < status->len; index += 2)
+        if (segments > 0)
         {
-            BbLine line =
-            {
-                .x[0] = g_array_index(status, BbSweepStatus, index).x,
-                .y[0] = sweep_y,
-                .x[1] = g_array_index(status, BbSweepStatus, index+1).x,
-                .y[1] = sweep_y
-            };
-
-            bb_line_transform(&line, &inverse);
-
-            g_array_append_val(lines, line);
+            bb_line_transform_array(segments, &g_array_index(lines, BbLine, first), &inverse);
         }
 
         sweep_y += pitch;
@@ -221,3 +248,47 @@ bb_hatch_polygon(GArray *points, gint angle, gint pitch, GArray *lines)
     g_array_free(points2, TRUE);
     g_array_free(status, TRUE);
 }
+
+
+void
+bb_hatch_polygon(GArray *points, gint angle, gint pitch, GArray *lines)
+{
+    g_return_if_fail(points != NULL);
+
+    bb_hatch_points(points->len, (const BbPoint*) points->data, angle, pitch, lines);
+}
+
+
+/**
+ * Calculate where each edge crosses the sweep line and restore the order by x
+ *
+ * Edges of a simple polygon do not cross, so the previous order is nearly correct and an insertion sort only
+ * moves the newly activated edges into place.
+ *
+ * @param status The edges crossing the sweep line
+ * @param sweep_y The y coordinate of the sweep line
+ */
+static void
+bb_hatch_update_statuses(GArray *status, double sweep_y)
+{
+    BbSweepStatus *st = (BbSweepStatus*) status->data;
+
+    for (guint index = 0; index < status->len; index++)
+    {
+        st[index].x = st[index].m1 * sweep_y + st[index].b1;
+    }
+
+    for (guint index = 1; index < status->len; index++)
+    {
+        BbSweepStatus temp = st[index];
+        guint position = index;
+
+        while (position > 0 && st[position - 1].x > temp.x)
+        {
+            st[position] = st[position - 1];
+            position--;
+        }
+
+        st[position] = temp;
+    }
+}
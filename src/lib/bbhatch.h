@@ -19,12 +19,34 @@
  */
 
 #include <gtk/gtk.h>
+#include "bbpoint.h"
 
 
 void
 bb_hatch_box(int x[2], int y[2], gint angle, gint pitch, GArray *lines);
 
 
+/**
+ * Generate hatch lines for a polygon
+ *
+ * @param count The number of vertices
+ * @param points The vertices of the polygon, closed implicitly
+ * @param angle The angle of the hatch lines, in degrees
+ * @param pitch The distance between hatch lines
+ * @param lines An array of BbLine receiving the hatch lines, appended in batches of one scanline
+ */
+void
+bb_hatch_points(int count, const BbPoint points[count], gint angle, gint pitch, GArray *lines);
+
+
+/**
+ * Generate hatch lines for a polygon
+ *
+ * @param points An array of BbPoint containing the vertices of the polygon
+ * @param angle The angle of the hatch lines, in degrees
+ * @param pitch The distance between hatch lines
+ * @param lines An array of BbLine receiving the hatch lines
+ */
 void
 bb_hatch_polygon(GArray *points, gint angle, gint pitch, GArray *lines);
 
@@ -25,6 +25,9 @@
 static void
 bb_item_renderer_default_init(BbItemRendererInterface *class);
 
+static void
+bb_item_renderer_render_absolute_curve_to_missing(BbItemRenderer *renderer, int x1, int y1, int x2, int y2, int x3, int y3);
+
 static void
 bb_item_renderer_render_absolute_line_to_missing(BbItemRenderer *renderer, int x, int y);
 
@@ -179,6 +182,7 @@ bb_item_renderer_default_init(BbItemRendererInterface *iface)
     iface->draw_open_shape = bb_item_renderer_draw_open_shape_missing;
     iface->close_path = bb_item_renderer_close_path_missing;
     iface->get_reveal = bb_item_renderer_get_reveal_missing;
+    iface->render_absolute_curve_to = bb_item_renderer_render_absolute_curve_to_missing;
     iface->render_absolute_line_to = bb_item_renderer_render_absolute_line_to_missing;
     iface->render_absolute_move_to = bb_item_renderer_render_absolute_move_to_missing;
     iface->render_arc = bb_item_renderer_render_arc_missing;
@@ -203,6 +207,27 @@ bb_item_renderer_default_init(BbItemRendererInterface *iface)
 }
 
 
+void
+bb_item_renderer_render_absolute_curve_to(BbItemRenderer *renderer, int x1, int y1, int x2, int y2, int x3, int y3)
+{
+    g_return_if_fail(BB_IS_ITEM_RENDERER(renderer));
+
+    BbItemRendererInterface *iface = BB_ITEM_RENDERER_GET_IFACE(renderer);
+
+    g_return_if_fail(iface != NULL);
+    g_return_if_fail(iface->render_absolute_curve_to != NULL);
+
+    return iface->render_absolute_curve_to(renderer, x1, y1, x2, y2, x3, y3);
+}
+
+
+static void
+bb_item_renderer_render_absolute_curve_to_missing(BbItemRenderer *renderer, int x1, int y1, int x2, int y2, int x3, int y3)
+{
+    g_error("bb_item_renderer_render_absolute_curve_to() not overridden");
+}
+
+
 void
 bb_item_renderer_render_absolute_line_to(BbItemRenderer *renderer, int x, int y)
 {
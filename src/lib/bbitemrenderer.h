@@ -25,6 +25,19 @@
 #include "bbopenshapedrawer.h"
 #include "bbtextalignment.h"
 
+
+/**
+ * The distance from an insertion point to the ends of its marker, along each axis
+ */
+#define BB_ITEM_RENDERER_INSERTION_POINT_RADIUS (20)
+
+
+/**
+ * The line width of the insertion point marker
+ */
+#define BB_ITEM_RENDERER_INSERTION_POINT_WIDTH (10)
+
+
 #define BB_TYPE_ITEM_RENDERER bb_item_renderer_get_type()
 G_DECLARE_INTERFACE(BbItemRenderer, bb_item_renderer, BB, ITEM_RENDERER, GObject)
 
@@ -49,6 +62,7 @@ struct _BbItemRendererInterface
 
     void (*close_path)(BbItemRenderer *renderer);
     gboolean (*get_reveal)(BbItemRenderer *renderer);
+    void (*render_absolute_curve_to)(BbItemRenderer *renderer, int x1, int y1, int x2, int y2, int x3, int y3);
     void (*render_absolute_line_to)(BbItemRenderer *renderer, int x, int y);
     void (*render_absolute_move_to)(BbItemRenderer *renderer, int x, int y);
     void (*render_arc)(BbItemRenderer *renderer, int x, int y, int radius, int start, int sweep);
@@ -115,6 +129,10 @@ bb_item_renderer_close_path(BbItemRenderer *renderer);
 gboolean
 bb_item_renderer_get_reveal(BbItemRenderer *renderer);
 
+void
+bb_item_renderer_render_absolute_curve_to(BbItemRenderer *renderer, int x1, int y1, int x2, int y2, int x3, int y3);
+
+
 void
 bb_item_renderer_render_absolute_line_to(BbItemRenderer *renderer, int x, int y);
 
@@ -46,12 +46,7 @@
 #include "bbadjustableitemcolor.h"
 #include "bbadjustablelinestyle.h"
 
-#include "bbpathcommand.h"
-
-#include "bbabsolutelineto.h"
-#include "bbabsolutemoveto.h"
-#include "bbrelativelineto.h"
-#include "bbrelativemoveto.h"
+#include "bbpathdata.h"
 
 #include "bbgedaarc.h"
 #include "bbgedabox.h"
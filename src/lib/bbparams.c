@@ -16,37 +16,185 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
 #include <gtk/gtk.h>
 #include "bbparams.h"
 #include "bberror.h"
 
 
+/**
+ * The character separating parameters on a line
+ */
+#define SEPARATOR ' '
+
+
+/**
+ * The room needed to format a 32 bit integer, including the sign and the null terminator
+ */
+#define VALUE_TEXT_SIZE (12)
+
+
+/**
+ * A tokenized line
+ *
+ * The tokens point into the text of the line, with each separator replaced by a null terminator. When created
+ * from a line owned by someone else, the text is copied once into the same allocation as this structure. When
+ * tokenized in place, the tokens point directly into the caller's buffer.
+ *
+ * Params created from pre-parsed values also carry an array of integers, and a NULL token for each integer
+ * parameter. The text of an integer parameter is only formatted if requested as a string.
+ */
 struct _BbParams
 {
-    gchar **params;
+    /**
+     * The number of tokens on the line
+     */
+    int count;
+
+    /**
+     * The pre-parsed integer parameters, or NULL when all parameters are text
+     */
+    int *values;
+
+    /**
+     * Pointers to the beginning of each null terminated token
+     */
+    const gchar *tokens[];
 };
 
 
+static BbParams*
+bb_params_allocate(int count, gsize length, gchar **storage);
+
+static const gchar*
+bb_params_format_value(BbParams *params, int index);
+
+static int
+bb_params_count_tokens(const gchar *line, gsize length);
+
+static void
+bb_params_split(BbParams *params, gchar *text, gsize length);
+
+
+/**
+ * Allocate params with room for the tokens, and optionally the text, in a single block
+ *
+ * @param count The number of tokens
+ * @param length The length of the text to store with the params, or 0 when tokenizing in place
+ * @param storage Receives the location for the text within the block, may be NULL when length is 0
+ * @return The new params
+ */
+static BbParams*
+bb_params_allocate(int count, gsize length, gchar **storage)
+{
+    gsize header = sizeof(BbParams) + count * sizeof(const gchar*);
+
+    BbParams *params = g_malloc(header + length + (storage != NULL ? 1 : 0));
+
+    params->count = count;
+    params->values = NULL;
+
+    if (storage != NULL)
+    {
+        *storage = ((gchar*) params) + header;
+    }
+
+    return params;
+}
+
+
 BbParams*
 bb_params_copy(BbParams *params)
 {
-    BbParams *copy = g_new0(BbParams, 1);
+    g_return_val_if_fail(params != NULL, NULL);
+
+    gsize length = 0;
 
-    copy->params = g_strdupv(params->params);
+    /* The copy is always text, so format any pre-parsed values */
+
+    for (int index = 0; index < params->count; index++)
+    {
+        length += strlen(bb_params_get_string(params, index, NULL)) + 1;
+    }
+
+    gchar *storage;
+    BbParams *copy = bb_params_allocate(params->count, length, &storage);
+
+    for (int index = 0; index < params->count; index++)
+    {
+        gchar *end = g_stpcpy(storage, params->tokens[index]);
+
+        copy->tokens[index] = storage;
+        storage = end + 1;
+    }
 
     return copy;
 }
 
 
-void
-bb_params_free(BbParams *params)
+/**
+ * Count the tokens on a line, matching the behavior of g_strsplit()
+ *
+ * @param line The line to count
+ * @param length The length of the line in bytes
+ * @return The number of separators plus one, or zero for an empty line
+ */
+static int
+bb_params_count_tokens(const gchar *line, gsize length)
 {
-    if (params != NULL)
+    if (length == 0)
+    {
+        return 0;
+    }
+
+    int count = 1;
+    const gchar *end = line + length;
+    const gchar *current = memchr(line, SEPARATOR, length);
+
+    while (current != NULL)
     {
-        g_strfreev(params->params);
+        count++;
+        current++;
+        current = memchr(current, SEPARATOR, end - current);
     }
 
-    g_slice_free(BbParams, params);
+    return count;
+}
+
+
+/**
+ * Format a pre-parsed integer parameter as text, keeping the result for subsequent requests
+ *
+ * @param params Params created with bb_params_new_with_values()
+ * @param index The index of an integer parameter
+ * @return The text of the parameter, owned by the params
+ */
+static const gchar*
+bb_params_format_value(BbParams *params, int index)
+{
+    gchar *text = ((gchar*) (params->values + params->count)) + index * VALUE_TEXT_SIZE;
+
+    g_snprintf(text, VALUE_TEXT_SIZE, "%d", params->values[index]);
+
+    params->tokens[index] = text;
+
+    return text;
+}
+
+
+void
+bb_params_free(BbParams *params)
+{
+    g_free(params);
+}
+
+
+int
+bb_params_get_count(BbParams *params)
+{
+    g_return_val_if_fail(params != NULL, 0);
+
+    return params->count;
 }
 
 
@@ -54,13 +202,12 @@ int
 bb_params_get_int(BbParams *params, int index, GError **error)
 {
     g_return_val_if_fail(params != NULL, 0);
-    g_return_val_if_fail(params->params != NULL, 0);
     g_return_val_if_fail(index >= 0, 0);
 
     GError *local_error = NULL;
     gint64 value = 0;
 
-    if (index >= g_strv_length(params->params))
+    if (index >= params->count)
     {
         local_error = g_error_new(
             BB_ERROR_DOMAIN,
@@ -68,14 +215,40 @@ bb_params_get_int(BbParams *params, int index, GError **error)
             "Too few parameters"
             );
     }
+    else if (params->tokens[index] == NULL)
+    {
+        value = params->values[index];
+    }
     else
     {
-        const gchar *ptr0 = *(params->params + index);
-        gchar *ptr1;
+        const gchar *current = params->tokens[index];
+        gboolean negative = FALSE;
 
-        value = g_ascii_strtoll(ptr0, &ptr1, 10);
+        if (*current == '-' || *current == '+')
+        {
+            negative = (*current == '-');
+            current++;
+        }
 
-        if ((value == 0) && (ptr0 == ptr1))
+        const gchar *digits = current;
+
+        while (g_ascii_isdigit(*current))
+        {
+            /* Saturate, so values too large for 64 bits are still reported as out of range */
+            if (value <= (G_MAXINT64 - 9) / 10)
+            {
+                value = 10 * value + (*current - '0');
+            }
+
+            current++;
+        }
+
+        if (negative)
+        {
+            value = -value;
+        }
+
+        if (current == digits)
         {
             local_error = g_error_new(
                 BB_ERROR_DOMAIN,
@@ -109,13 +282,12 @@ const gchar*
 bb_params_get_string(BbParams *params, int index, GError **error)
 {
     g_return_val_if_fail(params != NULL, 0);
-    g_return_val_if_fail(params->params != NULL, 0);
     g_return_val_if_fail(index >= 0, 0);
 
     GError *local_error = NULL;
     const gchar *value = NULL;
 
-    if (index >= g_strv_length(params->params))
+    if (index >= params->count)
     {
         local_error = g_error_new(
             BB_ERROR_DOMAIN,
@@ -123,9 +295,13 @@ bb_params_get_string(BbParams *params, int index, GError **error)
             "Too few parameters"
             );
     }
+    else if (params->tokens[index] == NULL)
+    {
+        value = bb_params_format_value(params, index);
+    }
     else
     {
-        value = *(params->params + index);
+        value = params->tokens[index];
     }
 
     if (local_error != NULL)
@@ -143,10 +319,22 @@ const gchar*
 bb_params_get_token(BbParams *params)
 {
     g_return_val_if_fail(params != NULL, NULL);
-    g_return_val_if_fail(params->params != NULL, NULL);
-    g_return_val_if_fail(g_strv_length(params->params) > 0, NULL);
+    g_return_val_if_fail(params->count > 0, NULL);
+
+    return params->tokens[0];
+}
+
+
+BbParams*
+bb_params_new_in_place(gchar *line, gsize length, GError **error)
+{
+    g_return_val_if_fail(line != NULL, NULL);
 
-    return *params->params;
+    BbParams *params = bb_params_allocate(bb_params_count_tokens(line, length), 0, NULL);
+
+    bb_params_split(params, line, length);
+
+    return params;
 }
 
 
@@ -155,21 +343,75 @@ bb_params_new_with_line(const char *line, GError **error)
 {
     g_return_val_if_fail(line != NULL, NULL);
 
-    BbParams *params = g_slice_new(BbParams);
+    gsize length = strlen(line);
+    gchar *storage;
+
+    BbParams *params = bb_params_allocate(bb_params_count_tokens(line, length), length, &storage);
 
-    params->params = g_strsplit(line, " ", 0);
+    memcpy(storage, line, length + 1);
+
+    bb_params_split(params, storage, length);
 
     return params;
 }
 
 
+BbParams*
+bb_params_new_with_values(int count, const gchar *tokens[count], const int values[count])
+{
+    g_return_val_if_fail(count > 0, NULL);
+    g_return_val_if_fail(tokens != NULL, NULL);
+    g_return_val_if_fail(tokens[0] != NULL, NULL);
+    g_return_val_if_fail(values != NULL, NULL);
+
+    /* The values, followed by room to format each value as text, share the allocation */
+
+    gchar *storage;
+    BbParams *params = bb_params_allocate(count, count * (sizeof(int) + VALUE_TEXT_SIZE), &storage);
+
+    params->values = (int*) storage;
+
+    memcpy(params->tokens, tokens, count * sizeof(const gchar*));
+    memcpy(params->values, values, count * sizeof(int));
+
+    return params;
+}
+
+
+/**
+ * Record the location of each token, replacing separators with null terminators
+ *
+ * @param params Params allocated with room for all the tokens in the text
+ * @param text The text to tokenize, which must be null terminated at text + length
+ * @param length The length of the text in bytes
+ */
+static void
+bb_params_split(BbParams *params, gchar *text, gsize length)
+{
+    gchar *current = text;
+    gchar *end = text + length;
+
+    for (int index = 0; index < params->count; index++)
+    {
+        gchar *separator = memchr(current, SEPARATOR, end - current);
+
+        params->tokens[index] = current;
+
+        if (separator != NULL)
+        {
+            *separator = '\0';
+            current = separator + 1;
+        }
+    }
+}
+
+
 gboolean
 bb_params_token_matches(BbParams *params, const char *token)
 {
     g_return_val_if_fail(params != NULL, FALSE);
-    g_return_val_if_fail(params->params != NULL, FALSE);
-    g_return_val_if_fail(params->params[0] != NULL, FALSE);
+    g_return_val_if_fail(params->count > 0, FALSE);
     g_return_val_if_fail(token != NULL, FALSE);
 
-    return g_strcmp0(params->params[0], token) == 0;
+    return g_strcmp0(params->tokens[0], token) == 0;
 }
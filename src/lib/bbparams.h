@@ -36,6 +36,16 @@ void
 bb_params_free(BbParams *params);
 
 
+/**
+ * Get the number of parameters, including the token
+ *
+ * @param params A BbParams
+ * @return The number of parameters
+ */
+int
+bb_params_get_count(BbParams *params);
+
+
 /**
  * Parse a 32 bit integer parameter
  *
@@ -56,6 +66,23 @@ const gchar*
 bb_params_get_token(BbParams *params);
 
 
+/**
+ * Tokenize a line in place, without copying
+ *
+ * Separators within the buffer are overwritten with null terminators, and the resulting params point directly
+ * into the buffer. The buffer must remain valid, and unmodified, until the params are freed.
+ *
+ * Use bb_params_free() to free release all associated resources
+ *
+ * @param line A writable buffer containing the line, null terminated at line + length
+ * @param length The length of the line in bytes, excluding the null terminator
+ * @param error
+ * @return
+ */
+BbParams*
+bb_params_new_in_place(gchar *line, gsize length, GError **error);
+
+
 /**
  *
  * Returns FALSE and leaves error unset on programming errors
@@ -70,6 +97,24 @@ BbParams*
 bb_params_new_with_line(const char *line, GError **error);
 
 
+/**
+ * Create params from pre-parsed values, without parsing any text
+ *
+ * Each parameter is either text, when its token is not NULL, or the corresponding integer in values. Integer
+ * parameters are only formatted as text if retrieved with bb_params_get_string(). The token at index 0 must be
+ * text. The strings are not copied, so must remain valid until the params are freed.
+ *
+ * Use bb_params_free() to free release all associated resources
+ *
+ * @param count The number of parameters, including the token
+ * @param tokens The text parameters, or NULL for integer parameters
+ * @param values The integer parameters, ignored where the token is not NULL
+ * @return The new params
+ */
+BbParams*
+bb_params_new_with_values(int count, const gchar *tokens[count], const int values[count]);
+
+
 /**
  *
  * Returns FALSE on programming errors
@@ -0,0 +1,512 @@
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtk/gtk.h>
+#include <math.h>
+#include "bbcoord.h"
+#include "bbpathdata.h"
+
+
+struct _BbPathData
+{
+    /**
+     * The commands, as BbPathOp stored in single bytes
+     */
+    GByteArray *ops;
+
+    /**
+     * The x coordinates of the points used by the commands
+     */
+    GArray *x;
+
+    /**
+     * The y coordinates of the points used by the commands
+     */
+    GArray *y;
+
+    /**
+     * The index of the point starting the current subpath
+     */
+    guint subpath;
+};
+
+
+static void
+bb_path_data_append_op(BbPathData *data, BbPathOp op);
+
+static void
+bb_path_data_append_point(BbPathData *data, int x, int y);
+
+static void
+bb_path_data_extend_curve(double p0, double p1, double p2, double p3, double *min, double *max);
+
+static void
+bb_path_data_format_point(BbWriteBuffer *buffer, int x, int y);
+
+
+void
+bb_path_data_append_close_path(BbPathData *data)
+{
+    g_return_if_fail(data != NULL);
+
+    bb_path_data_append_op(data, BB_PATH_OP_CLOSE_PATH);
+}
+
+
+void
+bb_path_data_append_curve_to(BbPathData *data, int x1, int y1, int x2, int y2, int x3, int y3)
+{
+    g_return_if_fail(data != NULL);
+
+    bb_path_data_append_op(data, BB_PATH_OP_CURVE_TO);
+    bb_path_data_append_point(data, x1, y1);
+    bb_path_data_append_point(data, x2, y2);
+    bb_path_data_append_point(data, x3, y3);
+}
+
+
+void
+bb_path_data_append_line_to(BbPathData *data, int x, int y)
+{
+    g_return_if_fail(data != NULL);
+
+    bb_path_data_append_op(data, BB_PATH_OP_LINE_TO);
+    bb_path_data_append_point(data, x, y);
+}
+
+
+void
+bb_path_data_append_move_to(BbPathData *data, int x, int y)
+{
+    g_return_if_fail(data != NULL);
+
+    data->subpath = data->x->len;
+
+    bb_path_data_append_op(data, BB_PATH_OP_MOVE_TO);
+    bb_path_data_append_point(data, x, y);
+}
+
+
+static void
+bb_path_data_append_op(BbPathData *data, BbPathOp op)
+{
+    guint8 byte = (guint8) op;
+
+    g_byte_array_append(data->ops, &byte, 1);
+}
+
+
+static void
+bb_path_data_append_point(BbPathData *data, int x, int y)
+{
+    g_array_append_val(data->x, x);
+    g_array_append_val(data->y, y);
+}
+
+
+void
+bb_path_data_calculate_bounds(const BbPathData *data, BbBounds *bounds)
+{
+    g_return_if_fail(data != NULL);
+    g_return_if_fail(bounds != NULL);
+
+    const int *x = (const int*) data->x->data;
+    const int *y = (const int*) data->y->data;
+
+    double min_x = G_MAXDOUBLE;
+    double min_y = G_MAXDOUBLE;
+    double max_x = -G_MAXDOUBLE;
+    double max_y = -G_MAXDOUBLE;
+
+    /* The start and end points of each curve lie on the curve, so only the extrema need special handling */
+
+    double current_x = 0.0;
+    double current_y = 0.0;
+    double start_x = 0.0;
+    double start_y = 0.0;
+
+    for (guint index = 0; index < data->ops->len; index++)
+    {
+        switch (data->ops->data[index])
+        {
+            case BB_PATH_OP_CLOSE_PATH:
+                current_x = start_x;
+                current_y = start_y;
+                break;
+
+            case BB_PATH_OP_CURVE_TO:
+                bb_path_data_extend_curve(current_x, x[0], x[1], x[2], &min_x, &max_x);
+                bb_path_data_extend_curve(current_y, y[0], y[1], y[2], &min_y, &max_y);
+                current_x = x[2];
+                current_y = y[2];
+                x += 3;
+                y += 3;
+                break;
+
+            case BB_PATH_OP_LINE_TO:
+                current_x = *x++;
+                current_y = *y++;
+                break;
+
+            case BB_PATH_OP_MOVE_TO:
+                current_x = start_x = *x++;
+                current_y = start_y = *y++;
+                break;
+
+            default:
+                g_return_if_reached();
+        }
+
+        min_x = MIN(min_x, current_x);
+        min_y = MIN(min_y, current_y);
+        max_x = MAX(max_x, current_x);
+        max_y = MAX(max_y, current_y);
+    }
+
+    if (min_x > max_x || min_y > max_y)
+    {
+        bounds->min_x = G_MAXINT;
+        bounds->min_y = G_MAXINT;
+        bounds->max_x = G_MININT;
+        bounds->max_y = G_MININT;
+    }
+    else
+    {
+        bounds->min_x = (int) floor(min_x);
+        bounds->min_y = (int) floor(min_y);
+        bounds->max_x = (int) ceil(max_x);
+        bounds->max_y = (int) ceil(max_y);
+    }
+}
+
+
+BbPathData*
+bb_path_data_copy(const BbPathData *data)
+{
+    g_return_val_if_fail(data != NULL, NULL);
+
+    BbPathData *copy = bb_path_data_new();
+
+    g_byte_array_append(copy->ops, data->ops->data, data->ops->len);
+    g_array_append_vals(copy->x, data->x->data, data->x->len);
+    g_array_append_vals(copy->y, data->y->data, data->y->len);
+
+    copy->subpath = data->subpath;
+
+    return copy;
+}
+
+
+void
+bb_path_data_format(const BbPathData *data, BbWriteBuffer *buffer)
+{
+    g_return_if_fail(data != NULL);
+    g_return_if_fail(buffer != NULL);
+
+    const int *x = (const int*) data->x->data;
+    const int *y = (const int*) data->y->data;
+
+    for (guint index = 0; index < data->ops->len; index++)
+    {
+        switch (data->ops->data[index])
+        {
+            case BB_PATH_OP_CLOSE_PATH:
+                bb_write_buffer_append_char(buffer, 'z');
+                break;
+
+            case BB_PATH_OP_CURVE_TO:
+                bb_write_buffer_append_char(buffer, 'C');
+                bb_path_data_format_point(buffer, *x++, *y++);
+                bb_path_data_format_point(buffer, *x++, *y++);
+                bb_path_data_format_point(buffer, *x++, *y++);
+                break;
+
+            case BB_PATH_OP_LINE_TO:
+                bb_write_buffer_append_char(buffer, 'L');
+                bb_path_data_format_point(buffer, *x++, *y++);
+                break;
+
+            case BB_PATH_OP_MOVE_TO:
+                bb_write_buffer_append_char(buffer, 'M');
+                bb_path_data_format_point(buffer, *x++, *y++);
+                break;
+
+            default:
+                g_return_if_reached();
+        }
+
+        bb_write_buffer_append_char(buffer, '\n');
+    }
+}
+
+
+/**
+ * Extend a range by the extrema of a cubic Bézier curve, along one axis
+ *
+ * The extrema occur where the derivative, a quadratic, has roots inside (0,1). The end points are handled by the
+ * caller.
+ *
+ * @param p0 The coordinate of the start point
+ * @param p1 The coordinate of the first control point
+ * @param p2 The coordinate of the second control point
+ * @param p3 The coordinate of the end point
+ * @param min The minimum of the range
+ * @param max The maximum of the range
+ */
+static void
+bb_path_data_extend_curve(double p0, double p1, double p2, double p3, double *min, double *max)
+{
+    double a = -p0 + 3.0 * p1 - 3.0 * p2 + p3;
+    double b = 2.0 * (p0 - 2.0 * p1 + p2);
+    double c = p1 - p0;
+
+    double roots[2];
+    int count = 0;
+
+    if (fabs(a) < 1e-12)
+    {
+        if (fabs(b) > 1e-12)
+        {
+            roots[count++] = -c / b;
+        }
+    }
+    else
+    {
+        double discriminant = b * b - 4.0 * a * c;
+
+        if (discriminant >= 0.0)
+        {
+            double root = sqrt(discriminant);
+
+            roots[count++] = (-b + root) / (2.0 * a);
+            roots[count++] = (-b - root) / (2.0 * a);
+        }
+    }
+
+    for (int index = 0; index < count; index++)
+    {
+        double t = roots[index];
+
+        if (t > 0.0 && t < 1.0)
+        {
+            double u = 1.0 - t;
+            double p = u * u * u * p0 + 3.0 * u * u * t * p1 + 3.0 * u * t * t * p2 + t * t * t * p3;
+
+            *min = MIN(*min, p);
+            *max = MAX(*max, p);
+        }
+    }
+}
+
+
+static void
+bb_path_data_format_point(BbWriteBuffer *buffer, int x, int y)
+{
+    bb_write_buffer_append_char(buffer, ' ');
+    bb_write_buffer_append_int(buffer, x);
+    bb_write_buffer_append_char(buffer, ',');
+    bb_write_buffer_append_int(buffer, y);
+}
+
+
+void
+bb_path_data_free(BbPathData *data)
+{
+    if (data != NULL)
+    {
+        g_byte_array_unref(data->ops);
+        g_array_unref(data->x);
+        g_array_unref(data->y);
+        g_slice_free(BbPathData, data);
+    }
+}
+
+
+BbPathOp
+bb_path_data_get_command(const BbPathData *data, guint index)
+{
+    g_return_val_if_fail(data != NULL, BB_PATH_OP_CLOSE_PATH);
+    g_return_val_if_fail(index < data->ops->len, BB_PATH_OP_CLOSE_PATH);
+
+    return data->ops->data[index];
+}
+
+
+guint
+bb_path_data_get_command_count(const BbPathData *data)
+{
+    g_return_val_if_fail(data != NULL, 0);
+
+    return data->ops->len;
+}
+
+
+gboolean
+bb_path_data_get_current_point(const BbPathData *data, int *x, int *y)
+{
+    g_return_val_if_fail(data != NULL, FALSE);
+    g_return_val_if_fail(x != NULL, FALSE);
+    g_return_val_if_fail(y != NULL, FALSE);
+
+    if (data->x->len == 0)
+    {
+        return FALSE;
+    }
+
+    guint index = data->x->len - 1;
+
+    if (data->ops->data[data->ops->len - 1] == BB_PATH_OP_CLOSE_PATH)
+    {
+        index = data->subpath;
+    }
+
+    *x = g_array_index(data->x, int, index);
+    *y = g_array_index(data->y, int, index);
+
+    return TRUE;
+}
+
+
+void
+bb_path_data_get_point(const BbPathData *data, guint index, int *x, int *y)
+{
+    g_return_if_fail(data != NULL);
+    g_return_if_fail(index < data->x->len);
+    g_return_if_fail(x != NULL);
+    g_return_if_fail(y != NULL);
+
+    *x = g_array_index(data->x, int, index);
+    *y = g_array_index(data->y, int, index);
+}
+
+
+guint
+bb_path_data_get_point_count(const BbPathData *data)
+{
+    g_return_val_if_fail(data != NULL, 0);
+
+    return data->x->len;
+}
+
+
+void
+bb_path_data_mirror_x(BbPathData *data, int cx)
+{
+    g_return_if_fail(data != NULL);
+
+    int *x = (int*) data->x->data;
+    int *x1 = x + data->x->len;
+
+    while (x < x1)
+    {
+        *x = 2 * cx - *x;
+        x++;
+    }
+}
+
+
+void
+bb_path_data_mirror_y(BbPathData *data, int cy)
+{
+    g_return_if_fail(data != NULL);
+
+    int *y = (int*) data->y->data;
+    int *y1 = y + data->y->len;
+
+    while (y < y1)
+    {
+        *y = 2 * cy - *y;
+        y++;
+    }
+}
+
+
+BbPathData*
+bb_path_data_new(void)
+{
+    BbPathData *data = g_slice_new(BbPathData);
+
+    data->ops = g_byte_array_new();
+    data->x = g_array_new(FALSE, FALSE, sizeof(int));
+    data->y = g_array_new(FALSE, FALSE, sizeof(int));
+    data->subpath = 0;
+
+    return data;
+}
+
+
+void
+bb_path_data_render(const BbPathData *data, BbItemRenderer *renderer)
+{
+    g_return_if_fail(data != NULL);
+    g_return_if_fail(BB_IS_ITEM_RENDERER(renderer));
+
+    const int *x = (const int*) data->x->data;
+    const int *y = (const int*) data->y->data;
+
+    for (guint index = 0; index < data->ops->len; index++)
+    {
+        switch (data->ops->data[index])
+        {
+            case BB_PATH_OP_CLOSE_PATH:
+                bb_item_renderer_close_path(renderer);
+                break;
+
+            case BB_PATH_OP_CURVE_TO:
+                bb_item_renderer_render_absolute_curve_to(renderer, x[0], y[0], x[1], y[1], x[2], y[2]);
+                x += 3;
+                y += 3;
+                break;
+
+            case BB_PATH_OP_LINE_TO:
+                bb_item_renderer_render_absolute_line_to(renderer, *x++, *y++);
+                break;
+
+            case BB_PATH_OP_MOVE_TO:
+                bb_item_renderer_render_absolute_move_to(renderer, *x++, *y++);
+                break;
+
+            default:
+                g_return_if_reached();
+        }
+    }
+}
+
+
+void
+bb_path_data_rotate(BbPathData *data, int cx, int cy, int angle)
+{
+    g_return_if_fail(data != NULL);
+
+    int *x = (int*) data->x->data;
+    int *y = (int*) data->y->data;
+
+    for (guint index = 0; index < data->x->len; index++)
+    {
+        bb_coord_rotate(cx, cy, angle, x + index, y + index);
+    }
+}
+
+
+void
+bb_path_data_translate(BbPathData *data, int dx, int dy)
+{
+    g_return_if_fail(data != NULL);
+
+    bb_coord_translate(dx, dy, (int*) data->x->data, (int*) data->y->data, data->x->len);
+}
@@ -0,0 +1,262 @@
+#ifndef __BBPATHDATA__
+#define __BBPATHDATA__
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ *
+ * The commands of a path, stored as packed arrays
+ *
+ * Each command is a single byte opcode. The points used by the commands are stored, in order, as separate arrays
+ * of x and y coordinates. All coordinates are absolute, so transforming the path is a single loop over the points,
+ * independent of the commands.
+ */
+
+#include <gtk/gtk.h>
+#include "bbbounds.h"
+#include "bbitemrenderer.h"
+#include "bbwritebuffer.h"
+
+
+/**
+ * The path commands
+ */
+typedef enum _BbPathOp BbPathOp;
+
+enum _BbPathOp
+{
+    BB_PATH_OP_CLOSE_PATH,
+    BB_PATH_OP_CURVE_TO,
+    BB_PATH_OP_LINE_TO,
+    BB_PATH_OP_MOVE_TO
+};
+
+
+typedef struct _BbPathData BbPathData;
+
+
+/**
+ * Append a command to close the current subpath
+ *
+ * @param data A BbPathData
+ */
+void
+bb_path_data_append_close_path(BbPathData *data);
+
+
+/**
+ * Append a cubic Bézier curve from the current point
+ *
+ * @param data A BbPathData
+ * @param x1 The x coordinate of the first control point
+ * @param y1 The y coordinate of the first control point
+ * @param x2 The x coordinate of the second control point
+ * @param y2 The y coordinate of the second control point
+ * @param x3 The x coordinate of the end point
+ * @param y3 The y coordinate of the end point
+ */
+void
+bb_path_data_append_curve_to(BbPathData *data, int x1, int y1, int x2, int y2, int x3, int y3);
+
+
+/**
+ * Append a line from the current point
+ *
+ * @param data A BbPathData
+ * @param x The x coordinate of the end point
+ * @param y The y coordinate of the end point
+ */
+void
+bb_path_data_append_line_to(BbPathData *data, int x, int y);
+
+
+/**
+ * Append a command starting a new subpath
+ *
+ * @param data A BbPathData
+ * @param x The x coordinate of the new current point
+ * @param y The y coordinate of the new current point
+ */
+void
+bb_path_data_append_move_to(BbPathData *data, int x, int y);
+
+
+/**
+ * Calculate the bounds of the path, without the line width
+ *
+ * Curves contribute their extrema, instead of their control points, so the bounds are tight.
+ *
+ * @param data A BbPathData
+ * @param bounds Receives the bounds, or empty bounds if the path has no points
+ */
+void
+bb_path_data_calculate_bounds(const BbPathData *data, BbBounds *bounds);
+
+
+/**
+ * Create a copy of the path
+ *
+ * @param data A BbPathData
+ * @return A new BbPathData
+ */
+BbPathData*
+bb_path_data_copy(const BbPathData *data);
+
+
+/**
+ * Append the commands to a file, one command per line
+ *
+ * @param data A BbPathData
+ * @param buffer The buffer receiving the commands
+ */
+void
+bb_path_data_format(const BbPathData *data, BbWriteBuffer *buffer);
+
+
+/**
+ * Free resources associated with the path
+ *
+ * @param data A BbPathData, or NULL
+ */
+void
+bb_path_data_free(BbPathData *data);
+
+
+/**
+ * Get the number of commands in the path
+ *
+ * @param data A BbPathData
+ * @return The number of commands
+ */
+guint
+bb_path_data_get_command_count(const BbPathData *data);
+
+
+/**
+ * Get a command in the path
+ *
+ * @param data A BbPathData
+ * @param index The index of the command
+ * @return The command
+ */
+BbPathOp
+bb_path_data_get_command(const BbPathData *data, guint index);
+
+
+/**
+ * Get the current point, used as the origin of relative coordinates
+ *
+ * After closing a subpath, the current point is the start of the subpath.
+ *
+ * @param data A BbPathData
+ * @param x The x coordinate of the current point
+ * @param y The y coordinate of the current point
+ * @return TRUE if the path has a current point, FALSE if the path is empty
+ */
+gboolean
+bb_path_data_get_current_point(const BbPathData *data, int *x, int *y);
+
+
+/**
+ * Get the number of points used by the commands
+ *
+ * @param data A BbPathData
+ * @return The number of points
+ */
+guint
+bb_path_data_get_point_count(const BbPathData *data);
+
+
+/**
+ * Get a point in the path
+ *
+ * @param data A BbPathData
+ * @param index The index of the point
+ * @param x The x coordinate of the point
+ * @param y The y coordinate of the point
+ */
+void
+bb_path_data_get_point(const BbPathData *data, guint index, int *x, int *y);
+
+
+/**
+ * Mirror the path across a vertical line
+ *
+ * @param data A BbPathData
+ * @param cx The x coordinate of the vertical line
+ */
+void
+bb_path_data_mirror_x(BbPathData *data, int cx);
+
+
+/**
+ * Mirror the path across a horizontal line
+ *
+ * @param data A BbPathData
+ * @param cy The y coordinate of the horizontal line
+ */
+void
+bb_path_data_mirror_y(BbPathData *data, int cy);
+
+
+/**
+ * Create an empty path
+ *
+ * Use bb_path_data_free() to release all associated resources
+ *
+ * @return A new BbPathData
+ */
+BbPathData*
+bb_path_data_new(void);
+
+
+/**
+ * Render the commands of the path
+ *
+ * @param data A BbPathData
+ * @param renderer The renderer receiving the commands
+ */
+void
+bb_path_data_render(const BbPathData *data, BbItemRenderer *renderer);
+
+
+/**
+ * Rotate the path
+ *
+ * @param data A BbPathData
+ * @param cx The x coordinate of the center of rotation
+ * @param cy The y coordinate of the center of rotation
+ * @param angle The angle of rotation, in degrees
+ */
+void
+bb_path_data_rotate(BbPathData *data, int cx, int cy, int angle);
+
+
+/**
+ * Translate the path
+ *
+ * @param data A BbPathData
+ * @param dx The displacement along the x axis
+ * @param dy The displacement along the y axis
+ */
+void
+bb_path_data_translate(BbPathData *data, int dx, int dy);
+
+
+#endif
@@ -20,12 +20,6 @@
 #include "bbpathparser.h"
 #include "bbpathscanner.h"
 #include "bberror.h"
-#include "bbpathcommand.h"
-#include "bbabsolutemoveto.h"
-#include "bbrelativemoveto.h"
-#include "bbabsolutelineto.h"
-#include "bbrelativelineto.h"
-#include "bbclosepath.h"
 
 
 typedef struct _BbPathParser BbPathParser;
@@ -33,17 +27,17 @@ typedef struct _BbPathParser BbPathParser;
 struct _BbPathParser
 {
     /**
-     * @brief The path commands, accumulated by parsing, stored in reverse order
+     * @brief The path commands, accumulated by parsing, with relative coordinates converted to absolute
      */
-    GSList *commands;
+    BbPathData *data;
     BbPathScanner *scanner;
 };
 
 
 /**
- *
+ * Append a command, with parameters, to the path
  */
-typedef gboolean (*EmitFunc)(BbPathParser *parser, int count, int parameter[count], GError **error);
+typedef gboolean (*EmitFunc)(BbPathParser *parser, gboolean relative, int count, int parameter[count], GError **error);
 
 
 gboolean
@@ -75,13 +69,13 @@ static gboolean
 parse_subsequent_commands(BbPathParser *parser, BbPathScannerToken *token, GError **error);
 
 
-GSList*
+BbPathData*
 bb_path_parser_parse(const char *input, GError **error)
 {
     GError *local_error = NULL;
     BbPathParser parser =
     {
-        .commands = NULL,
+        .data = bb_path_data_new(),
         .scanner = bb_path_scanner_new(input)
     };
     BbPathScannerToken token = { .tag = BB_PATH_SCANNER_TOKEN_UNKNOWN };
@@ -101,49 +95,82 @@ bb_path_parser_parse(const char *input, GError **error)
     if (local_error != NULL)
     {
         g_propagate_error(error, local_error);
-        g_slist_free_full(g_steal_pointer(&parser.commands), g_object_unref);
+        g_clear_pointer(&parser.data, bb_path_data_free);
     }
 
     bb_path_scanner_free(g_steal_pointer(&parser.scanner));
 
-    return g_slist_reverse(parser.commands);
+    return parser.data;
+}
+
+
+/**
+ * Convert coordinate pairs from relative to absolute, using the current point as the origin
+ *
+ * @param parser The parser containing the path
+ * @param relative TRUE if the parameters contain relative coordinates
+ * @param count The number of parameters, in x, y pairs
+ * @param parameter The parameters to convert in place
+ */
+static void
+convert_to_absolute(BbPathParser *parser, gboolean relative, int count, int parameter[count])
+{
+    int x;
+    int y;
+
+    if (relative && bb_path_data_get_current_point(parser->data, &x, &y))
+    {
+        for (int index = 0; index < count; index += 2)
+        {
+            parameter[index] += x;
+            parameter[index + 1] += y;
+        }
+    }
 }
 
 
 static gboolean
-emit_close_path(BbPathParser *parser, int count, int *parameter, GError **error)
+emit_close_path(BbPathParser *parser, gboolean relative, int count, int *parameter, GError **error)
 {
     g_return_val_if_fail(count == 0, FALSE);
 
-    parser->commands = g_slist_prepend(
-        parser->commands,
-        BB_PATH_COMMAND(bb_close_path_new())
-        );
+    bb_path_data_append_close_path(parser->data);
 
     return TRUE;
 }
 
 
 static gboolean
-emit_curve_to(BbPathParser *parser, int count, int parameter[count], GError **error)
+emit_curve_to(BbPathParser *parser, gboolean relative, int count, int parameter[count], GError **error)
 {
+    g_return_val_if_fail(parser != NULL, FALSE);
     g_return_val_if_fail(count == 6, FALSE);
 
-    g_message("Curve to");
+    convert_to_absolute(parser, relative, count, parameter);
+
+    bb_path_data_append_curve_to(
+        parser->data,
+        parameter[0],
+        parameter[1],
+        parameter[2],
+        parameter[3],
+        parameter[4],
+        parameter[5]
+        );
 
     return TRUE;
 }
 
 
 static gboolean
-emit_line_to(BbPathParser *parser, int count, int parameter[count], GError **error)
+emit_line_to(BbPathParser *parser, gboolean relative, int count, int parameter[count], GError **error)
 {
     g_return_val_if_fail(parser != NULL, FALSE);
     g_return_val_if_fail(count == 2, FALSE);
 
     gboolean success = TRUE;
 
-    if (parser->commands == NULL)
+    if (bb_path_data_get_command_count(parser->data) == 0)
     {
         g_set_error(
             error,
@@ -154,19 +181,11 @@ emit_line_to(BbPathParser *parser, int count, int parameter[count], GError **err
 
         success = FALSE;
     }
-    else if (TRUE)
-    {
-        parser->commands = g_slist_prepend(
-            parser->commands,
-            BB_PATH_COMMAND(bb_absolute_line_to_new(parameter[0], parameter[1]))
-            );
-    }
     else
     {
-        parser->commands = g_slist_prepend(
-            parser->commands,
-            BB_PATH_COMMAND(bb_relative_line_to_new(parameter[0], parameter[1]))
-            );
+        convert_to_absolute(parser, relative, count, parameter);
+
+        bb_path_data_append_line_to(parser->data, parameter[0], parameter[1]);
     }
 
     return success;
@@ -174,26 +193,16 @@ emit_line_to(BbPathParser *parser, int count, int parameter[count], GError **err
 
 
 static gboolean
-emit_move_to(BbPathParser *parser, int count, int parameter[count], GError **error)
+emit_move_to(BbPathParser *parser, gboolean relative, int count, int parameter[count], GError **error)
 {
     g_return_val_if_fail(parser != NULL, FALSE);
     g_return_val_if_fail(count == 2, FALSE);
 
-    BbPathCommand *command = NULL;
+    /* An initial relative move to has no current point, so its coordinates are absolute */
 
-    if (parser->commands == NULL)
-    {
-        command = BB_PATH_COMMAND(bb_absolute_move_to_new(parameter[0], parameter[1]));
-    }
-    else
-    {
-        command = BB_PATH_COMMAND(bb_relative_move_to_new(parameter[0], parameter[1]));
-    }
+    convert_to_absolute(parser, relative, count, parameter);
 
-    parser->commands = g_slist_prepend(
-        parser->commands,
-        command
-        );
+    bb_path_data_append_move_to(parser->data, parameter[0], parameter[1]);
 
     return TRUE;
 }
@@ -438,7 +447,7 @@ parse_parse_and_emit(
 
     if (parameter_count == 0)
     {
-        success = emit(parser, parameter_count, parameter, &local_error);
+        success = emit(parser, relative, parameter_count, parameter, &local_error);
     }
     else
     {
@@ -446,7 +455,7 @@ parse_parse_and_emit(
 
         if (success && (local_error == NULL))
         {
-            emit(parser, parameter_count, parameter, &local_error);
+            emit(parser, relative, parameter_count, parameter, &local_error);
         }
     }
 
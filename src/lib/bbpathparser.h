@@ -19,16 +19,19 @@
  */
 
 #include <gtk/gtk.h>
+#include "bbpathdata.h"
 
 
 /**
- * @brief Parse the path string into a list of BbPathCommand items
+ * @brief Parse the path string directly into packed path commands
+ *
+ * Relative coordinates are converted to absolute while parsing.
  *
  * @param input The input path string
  * @param error An errors encountered
- * @return A list of path commands, or NULL on error.
+ * @return The path commands, or NULL on error. Free with bb_path_data_free().
  */
-GSList*
+BbPathData*
 bb_path_parser_parse(const char *input, GError **error);
 
 
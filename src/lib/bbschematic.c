@@ -27,6 +27,8 @@
 #include "bblibrary.h"
 #include "bbattribute.h"
 #include "bbelectrical.h"
+#include "bbspatialindex.h"
+#include "bbwritebuffer.h"
 
 
 enum
@@ -42,6 +44,9 @@ enum
 enum
 {
     SIG_INVALIDATE_ITEM,
+    SIG_ITEM_ADDED,
+    SIG_ITEM_REMOVED,
+    SIG_ITEMS_CHANGED,
     N_SIGNALS
 };
 
@@ -50,7 +55,60 @@ struct _BbSchematic
 {
     GObject parent;
 
-    GSList *items;
+    /**
+     * The union of the indexed bounds of the changed items, before the batch changed them
+     */
+    BbBounds *batch_damage;
+
+    /**
+     * The number of open batches, changes are coalesced while greater than zero
+     */
+    guint batch_depth;
+
+    /**
+     * The items changed during the batch, in the order of their first change
+     *
+     * Does not hold references, since removing an item also removes it from this array.
+     */
+    GPtrArray *batch_items;
+
+    /**
+     * The same items as batch_items, for constant time membership tests
+     */
+    GHashTable *batch_set;
+
+    /**
+     * The items in the schematic, in drawing and file order
+     *
+     * Stored contiguously, so appending is amortized constant time and iteration avoids chasing list nodes.
+     * Each element holds a reference to the BbGedaItem.
+     */
+    GPtrArray *items;
+
+    /**
+     * Locates items by their bounds, for rendering only the visible portion of the schematic
+     *
+     * Each entry covers an item and its attributes, ordered by the item position in the items array.
+     */
+    BbSpatialIndex *index;
+
+    /**
+     * Items that must be (re)inserted into the index before the next query
+     *
+     * Calculating bounds requires a BbBoundsCalculator, which is only available when rendering. So, new and
+     * changed items are placed here and the index gets updated lazily.
+     */
+    GHashTable *dirty;
+
+    /**
+     * Maps each item to one plus its position in the items array
+     */
+    GHashTable *positions;
+
+    /**
+     * Incremented when an item is added, removed, or changed
+     */
+    guint revision;
 };
 
 
@@ -66,11 +124,27 @@ struct _ApplyItemPropertyCapture
 
 typedef struct _AsyncWriteData AsyncWriteData;
 
+/**
+ * The state of a background write or save
+ *
+ * The items are clones, owned by this structure, so the worker thread never touches items the user is editing.
+ */
 struct _AsyncWriteData
 {
+    /**
+     * The file receiving the schematic, or NULL when writing to a stream
+     */
+    GFile *file;
+
+    /**
+     * A snapshot of the schematic items
+     */
+    GPtrArray *items;
+
+    /**
+     * The stream receiving the schematic, or NULL when saving to a file
+     */
     GOutputStream *stream;
-    int io_priority;
-    GSList *item;
 };
 
 
@@ -82,17 +156,17 @@ struct _RenderCapture
 };
 
 
-typedef struct _WriteCapture WriteCapture;
+typedef struct _UpdateIndexCapture UpdateIndexCapture;
 
-struct _WriteCapture
+struct _UpdateIndexCapture
 {
-    GOutputStream *stream;
-    GCancellable *cancellable;
-    GError **error;
+    BbBoundsCalculator *calculator;
+    BbBounds *bounds;
 };
 
+
 static void
-bb_schematic_add_items_lambda(BbGedaItem *item, BbSchematic *schematic);
+bb_schematic_add_item_lambda(BbGedaItem *item, BbSchematic *schematic);
 
 static void
 bb_schematic_apply_item_property_lambda(BbGedaItem *item, ApplyItemPropertyCapture *capture);
@@ -106,6 +180,9 @@ bb_schematic_finalize(GObject *object);
 static void
 bb_schematic_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
 
+static void
+bb_schematic_remove_item_cb(BbGedaItem *item, BbSchematic *schematic);
+
 static void
 bb_schematic_invalidate_item_cb(BbGedaItem *item, BbSchematic *schematic);
 
@@ -119,17 +196,26 @@ static void
 bb_schematic_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
 
 static void
-bb_schematic_write_callback(GObject *source, GAsyncResult *result, gpointer callback_data);
+bb_schematic_update_index(BbSchematic *schematic, BbBoundsCalculator *calculator);
 
 static void
-bb_schematic_write_lambda(BbGedaItem *item, WriteCapture *capture);
+bb_schematic_update_index_lambda(BbGedaItem *item, UpdateIndexCapture *capture);
 
 static AsyncWriteData*
-bb_schematic_async_write_data_new();
+bb_schematic_async_write_data_new(BbSchematic *schematic);
 
 static void
 bb_schematic_async_write_data_free(gpointer slice);
 
+static void
+bb_schematic_save_thread(GTask *task, gpointer source, gpointer task_data, GCancellable *cancellable);
+
+static gboolean
+bb_schematic_write_items(GPtrArray *items, GOutputStream *stream, GCancellable *cancellable, GError **error);
+
+static void
+bb_schematic_write_thread(GTask *task, gpointer source, gpointer task_data, GCancellable *cancellable);
+
 
 static void
 bb_schematic_modify_fill_angle_1_lambda(
@@ -190,9 +276,20 @@ bb_schematic_add_item(BbSchematic *schematic, BbGedaItem *item)
     g_return_if_fail(BB_IS_SCHEMATIC(schematic));
     g_return_if_fail(BB_IS_GEDA_ITEM(item));
 
-    GSList *items = g_slist_append(NULL, item);
+    g_signal_connect(
+        item,
+        "invalidate-item",
+        G_CALLBACK(bb_schematic_invalidate_item_cb),
+        schematic
+        );
+
+    g_ptr_array_add(schematic->items, g_object_ref(item));
+
+    g_hash_table_insert(schematic->positions, item, GUINT_TO_POINTER(schematic->items->len));
+    g_hash_table_add(schematic->dirty, item);
+    schematic->revision++;
 
-    bb_schematic_add_items(schematic, items);
+    g_signal_emit(schematic, signals[SIG_ITEM_ADDED], 0, item);
 }
 
 
@@ -201,26 +298,14 @@ bb_schematic_add_items(BbSchematic *schematic, GSList *items)
 {
     g_return_if_fail(BB_IS_SCHEMATIC(schematic));
 
-    g_slist_foreach(items, (GFunc) bb_schematic_add_items_lambda, schematic);
-
-    schematic->items = g_slist_concat(schematic->items, items);
+    g_slist_foreach(items, (GFunc) bb_schematic_add_item_lambda, schematic);
 }
 
 
 static void
-bb_schematic_add_items_lambda(BbGedaItem *item, BbSchematic *schematic)
+bb_schematic_add_item_lambda(BbGedaItem *item, BbSchematic *schematic)
 {
-    g_return_if_fail(BB_IS_SCHEMATIC(schematic));
-    g_return_if_fail(BB_IS_GEDA_ITEM(item));
-
-    g_object_ref(item);
-
-    g_signal_connect(
-        item,
-        "invalidate-item",
-        G_CALLBACK(bb_schematic_invalidate_item_cb),
-        schematic
-        );
+    bb_schematic_add_item(schematic, item);
 }
 
 
@@ -232,9 +317,9 @@ bb_schematic_apply_item_property(BbSchematic *schematic, const char *name, const
     capture.name = name;
     capture.value = value;
 
-    g_message("ApplyProperty = %s", capture.name);
-
+    bb_schematic_begin_batch(schematic);
     bb_schematic_foreach(schematic, (GFunc) bb_schematic_apply_item_property_lambda, &capture);
+    bb_schematic_end_batch(schematic);
 }
 
 
@@ -253,6 +338,15 @@ bb_schematic_apply_item_property_lambda(BbGedaItem *item, ApplyItemPropertyCaptu
 }
 
 
+void
+bb_schematic_begin_batch(BbSchematic *schematic)
+{
+    g_return_if_fail(BB_IS_SCHEMATIC(schematic));
+
+    schematic->batch_depth++;
+}
+
+
 void
 bb_schematic_calculate_bounds(
     BbSchematic *schematic,
@@ -262,20 +356,18 @@ bb_schematic_calculate_bounds(
     BbBounds *bounds
     )
 {
-    GSList *iter = schematic->items;
-
-    while (iter != NULL)
+    for (guint index = 0; index < schematic->items->len; index++)
     {
-        if (where_pred(iter->data , where_user_data))
+        BbGedaItem *item = g_ptr_array_index(schematic->items, index);
+
+        if (where_pred(item, where_user_data))
         {
-            BbBounds *temp = bb_geda_item_calculate_bounds(iter->data, calculator);
+            BbBounds *temp = bb_geda_item_calculate_bounds(item, calculator);
 
             bb_bounds_union(bounds, bounds, temp);
 
             bb_bounds_free(temp);
         }
-
-        iter = g_slist_next(iter);
     }
 }
 
@@ -302,12 +394,92 @@ bb_schematic_class_init(BbSchematicClass *klasse)
         1,
         BB_TYPE_GEDA_ITEM
         );
+
+    signals[SIG_ITEM_ADDED] = g_signal_new(
+        "item-added",
+        BB_TYPE_SCHEMATIC,
+        0,
+        0,
+        NULL,
+        NULL,
+        g_cclosure_marshal_VOID__OBJECT,
+        G_TYPE_NONE,
+        1,
+        BB_TYPE_GEDA_ITEM
+        );
+
+    signals[SIG_ITEM_REMOVED] = g_signal_new(
+        "item-removed",
+        BB_TYPE_SCHEMATIC,
+        0,
+        0,
+        NULL,
+        NULL,
+        g_cclosure_marshal_VOID__OBJECT,
+        G_TYPE_NONE,
+        1,
+        BB_TYPE_GEDA_ITEM
+        );
+
+    signals[SIG_ITEMS_CHANGED] = g_signal_new(
+        "items-changed",
+        BB_TYPE_SCHEMATIC,
+        0,
+        0,
+        NULL,
+        NULL,
+        NULL,
+        G_TYPE_NONE,
+        2,
+        G_TYPE_PTR_ARRAY | G_SIGNAL_TYPE_STATIC_SCOPE,
+        BB_TYPE_BOUNDS | G_SIGNAL_TYPE_STATIC_SCOPE
+        );
 }
 
 
 static void
 bb_schematic_dispose(GObject *object)
 {
+    BbSchematic *schematic = BB_SCHEMATIC(object);
+    g_return_if_fail(schematic != NULL);
+
+    if (schematic->items != NULL)
+    {
+        g_ptr_array_foreach(schematic->items, (GFunc) bb_schematic_remove_item_cb, schematic);
+        g_clear_pointer(&schematic->items, g_ptr_array_unref);
+    }
+
+    g_clear_pointer(&schematic->batch_damage, bb_bounds_free);
+    g_clear_pointer(&schematic->batch_items, g_ptr_array_unref);
+    g_clear_pointer(&schematic->batch_set, g_hash_table_destroy);
+    g_clear_pointer(&schematic->index, bb_spatial_index_free);
+    g_clear_pointer(&schematic->dirty, g_hash_table_destroy);
+    g_clear_pointer(&schematic->positions, g_hash_table_destroy);
+}
+
+
+void
+bb_schematic_end_batch(BbSchematic *schematic)
+{
+    g_return_if_fail(BB_IS_SCHEMATIC(schematic));
+    g_return_if_fail(schematic->batch_depth > 0);
+
+    if (--schematic->batch_depth == 0 && schematic->batch_items->len > 0)
+    {
+        /* Handlers may start another batch, so the state is reset before emitting */
+
+        BbBounds *damage = schematic->batch_damage;
+        GPtrArray *items = schematic->batch_items;
+
+        schematic->batch_damage = bb_bounds_new();
+        schematic->batch_items = g_ptr_array_new();
+        g_hash_table_remove_all(schematic->batch_set);
+
+        g_signal_emit(schematic, signals[SIG_ITEMS_CHANGED], 0, items, damage);
+
+        g_ptr_array_unref(items);
+        bb_bounds_free(damage);
+    }
 }
 
 
@@ -322,7 +494,7 @@ bb_schematic_foreach(BbSchematic *schematic, GFunc func, gpointer user_data)
 {
     g_return_if_fail(schematic != NULL);
 
-    g_slist_foreach(schematic->items, func, user_data);
+    g_ptr_array_foreach(schematic->items, func, user_data);
 }
 
 
@@ -335,25 +507,21 @@ bb_schematic_foreach_query(
     gpointer query_user_data
     )
 {
-    GSList *iter;
-
     g_return_if_fail(schematic != NULL);
     g_return_if_fail(where_pred != NULL);
     g_return_if_fail(query_func != NULL);
 
-    iter = schematic->items;
-
-    while (iter != NULL)
+    for (guint index = 0; index < schematic->items->len; index++)
     {
-        if (where_pred(iter->data , where_user_data))
+        BbGedaItem *item = g_ptr_array_index(schematic->items, index);
+
+        if (where_pred(item, where_user_data))
         {
-            if (!query_func(iter->data , query_user_data))
+            if (!query_func(item, query_user_data))
             {
                 break;
             }
         }
-
-        iter = g_slist_next(iter);
     }
 }
 
@@ -367,23 +535,23 @@ bb_schematic_foreach_modify(
     gpointer modify_user_data
     )
 {
-    GSList *iter;
-
     g_return_if_fail(schematic != NULL);
     g_return_if_fail(where_pred != NULL);
     g_return_if_fail(modify_func != NULL);
 
-    iter = schematic->items;
+    bb_schematic_begin_batch(schematic);
 
-    while (iter != NULL)
+    for (guint index = 0; index < schematic->items->len; index++)
     {
-        if (where_pred(iter->data , where_user_data))
+        BbGedaItem *item = g_ptr_array_index(schematic->items, index);
+
+        if (where_pred(item, where_user_data))
         {
-            modify_func(iter->data , modify_user_data);
+            modify_func(item, modify_user_data);
         }
-
-        iter = g_slist_next(iter);
     }
+
+    bb_schematic_end_batch(schematic);
 }
 
 
@@ -394,7 +562,62 @@ bb_schematic_foreach_remove(
     gpointer where_user_data
     )
 {
-    // TODO
+    g_return_if_fail(BB_IS_SCHEMATIC(schematic));
+    g_return_if_fail(where_pred != NULL);
+
+    guint kept = 0;
+    guint first_removed = schematic->items->len;
+
+    /* Compact in place, preserving the order of the remaining items */
+
+    for (guint index = 0; index < schematic->items->len; index++)
+    {
+        BbGedaItem *item = g_ptr_array_index(schematic->items, index);
+
+        if (where_pred(item, where_user_data))
+        {
+            first_removed = MIN(first_removed, index);
+
+            /* Allows views to repaint the area the item occupied */
+            g_signal_emit(schematic, signals[SIG_INVALIDATE_ITEM], 0, item);
+
+            bb_schematic_remove_item_cb(item, schematic);
+            bb_spatial_index_remove(schematic->index, item);
+            g_hash_table_remove(schematic->dirty, item);
+            g_hash_table_remove(schematic->positions, item);
+
+            if (g_hash_table_remove(schematic->batch_set, item))
+            {
+                g_ptr_array_remove(schematic->batch_items, item);
+            }
+            schematic->revision++;
+
+            g_signal_emit(schematic, signals[SIG_ITEM_REMOVED], 0, item);
+
+            g_object_unref(item);
+        }
+        else
+        {
+            g_ptr_array_index(schematic->items, kept++) = item;
+        }
+    }
+
+    for (guint index = first_removed; index < kept; index++)
+    {
+        gpointer item = g_ptr_array_index(schematic->items, index);
+
+        g_hash_table_insert(schematic->positions, item, GUINT_TO_POINTER(index + 1));
+
+        /* Items added later get larger orders, so the index must not keep the old order of a shifted item */
+
+        bb_spatial_index_set_order(schematic->index, item, index + 1);
+    }
+
+    /* The pointers were moved, not copied, so the array must not release them */
+
+    g_ptr_array_set_free_func(schematic->items, NULL);
+    g_ptr_array_set_size(schematic->items, kept);
+    g_ptr_array_set_free_func(schematic->items, g_object_unref);
 }
 
 
@@ -418,10 +641,29 @@ bb_schematic_get_property(GObject *object, guint property_id, GValue *value, GPa
 }
 
 
+guint
+bb_schematic_get_revision(BbSchematic *schematic)
+{
+    g_return_val_if_fail(BB_IS_SCHEMATIC(schematic), 0);
+
+    return schematic->revision;
+}
+
+
 static void
 bb_schematic_init(BbSchematic *schematic)
 {
     g_return_if_fail(BB_IS_SCHEMATIC(schematic));
+
+    schematic->items = g_ptr_array_new_with_free_func(g_object_unref);
+
+    schematic->batch_damage = bb_bounds_new();
+    schematic->batch_items = g_ptr_array_new();
+    schematic->batch_set = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+    schematic->index = bb_spatial_index_new();
+    schematic->dirty = g_hash_table_new(g_direct_hash, g_direct_equal);
+    schematic->positions = g_hash_table_new(g_direct_hash, g_direct_equal);
 }
 
 
@@ -430,9 +672,44 @@ bb_schematic_invalidate_item_cb(BbGedaItem *item, BbSchematic *schematic)
 {
     g_return_if_fail(BB_IS_SCHEMATIC(schematic));
 
-    g_message("invalidate-item");
+    if (schematic->batch_depth > 0 && g_hash_table_add(schematic->batch_set, item))
+    {
+        BbBounds bounds;
+
+        /* An item missing from the index has not been rendered since its area was last invalidated */
+
+        if (bb_spatial_index_lookup(schematic->index, item, &bounds))
+        {
+            bb_bounds_union(schematic->batch_damage, schematic->batch_damage, &bounds);
+        }
+
+        g_ptr_array_add(schematic->batch_items, item);
+    }
+
+    /* Emitted before and after each change, so the stale entry is gone before the item moves */
 
-    g_signal_emit(schematic, signals[SIG_INVALIDATE_ITEM], 0, item);
+    if (g_hash_table_add(schematic->dirty, item))
+    {
+        bb_spatial_index_remove(schematic->index, item);
+    }
+
+    schematic->revision++;
+
+    if (schematic->batch_depth == 0)
+    {
+        g_signal_emit(schematic, signals[SIG_INVALIDATE_ITEM], 0, item);
+    }
+}
+
+
+static void
+bb_schematic_remove_item_cb(BbGedaItem *item, BbSchematic *schematic)
+{
+    g_signal_handlers_disconnect_by_func(
+        item,
+        G_CALLBACK(bb_schematic_invalidate_item_cb),
+        schematic
+        );
 }
 
 
@@ -453,13 +730,13 @@ bb_schematic_render(
 
     capture.renderer = renderer;
 
-    g_slist_foreach(
+    g_ptr_array_foreach(
         schematic->items,
         (GFunc) bb_schematic_render_lambda_1,
         &capture
         );
 
-    g_slist_foreach(
+    g_ptr_array_foreach(
         schematic->items,
         (GFunc) bb_schematic_render_lambda_2,
         &capture
@@ -467,6 +744,41 @@ bb_schematic_render(
 }
 
 
+void
+bb_schematic_render_region(
+    BbSchematic *schematic,
+    BbItemRenderer *renderer,
+    BbBoundsCalculator *calculator,
+    const BbBounds *region
+    )
+{
+    g_return_if_fail(BB_IS_SCHEMATIC(schematic));
+    g_return_if_fail(region != NULL);
+
+    RenderCapture capture;
+    GPtrArray *visible = g_ptr_array_new();
+
+    capture.renderer = renderer;
+
+    bb_schematic_update_index(schematic, calculator);
+    bb_spatial_index_query(schematic->index, region, visible);
+
+    g_ptr_array_foreach(
+        visible,
+        (GFunc) bb_schematic_render_lambda_1,
+        &capture
+        );
+
+    g_ptr_array_foreach(
+        visible,
+        (GFunc) bb_schematic_render_lambda_2,
+        &capture
+        );
+
+    g_ptr_array_free(visible, TRUE);
+}
+
+
 static void
 bb_schematic_render_lambda_1(BbGedaItem *item, RenderCapture *capture)
 {
@@ -514,69 +826,163 @@ bb_schematic_set_property(GObject *object, guint property_id, const GValue *valu
 }
 
 
-gboolean
-bb_schematic_write(
-    BbSchematic *schematic,
-    GOutputStream *stream,
-    GCancellable *cancellable,
-    GError **error
-    )
+/**
+ * Insert the dirty items into the spatial index
+ *
+ * @param schematic The schematic containing the index
+ * @param calculator Calculates the bounds of items
+ */
+static void
+bb_schematic_update_index(BbSchematic *schematic, BbBoundsCalculator *calculator)
 {
-    WriteCapture capture;
+    GHashTableIter iter;
+    gpointer key;
 
-    capture.stream = stream;
-    capture.cancellable = cancellable;
-    capture.error = error;
+    g_hash_table_iter_init(&iter, schematic->dirty);
 
-    g_slist_foreach(
-        schematic->items,
-        (GFunc) bb_schematic_write_lambda,
-        &capture
-        );
+    while (g_hash_table_iter_next(&iter, &key, NULL))
+    {
+        BbGedaItem *item = BB_GEDA_ITEM(key);
+        UpdateIndexCapture capture;
+
+        capture.calculator = calculator;
+        capture.bounds = bb_bounds_new();
+
+        bb_schematic_update_index_lambda(item, &capture);
+
+        if (BB_IS_ELECTRICAL(item))
+        {
+            bb_electrical_foreach(
+                BB_ELECTRICAL(item),
+                (GFunc) bb_schematic_update_index_lambda,
+                &capture
+                );
+        }
+
+        /* Items without meaningful bounds always get rendered */
+
+        if (bb_bounds_is_empty(capture.bounds))
+        {
+            capture.bounds->min_x = G_MININT;
+            capture.bounds->min_y = G_MININT;
+            capture.bounds->max_x = G_MAXINT;
+            capture.bounds->max_y = G_MAXINT;
+        }
+
+        bb_spatial_index_insert(
+            schematic->index,
+            item,
+            GPOINTER_TO_UINT(g_hash_table_lookup(schematic->positions, item)),
+            capture.bounds
+            );
+
+        bb_bounds_free(capture.bounds);
+    }
+
+    g_hash_table_remove_all(schematic->dirty);
 }
 
 
 static void
-bb_schematic_write_lambda(BbGedaItem *item, WriteCapture *capture)
+bb_schematic_update_index_lambda(BbGedaItem *item, UpdateIndexCapture *capture)
 {
-    bb_geda_item_write(
-        item,
-        capture->stream,
-        capture->cancellable,
-        capture->error
-    );
+    g_return_if_fail(BB_IS_GEDA_ITEM(item));
+    g_return_if_fail(capture != NULL);
+
+    BbBounds *bounds = bb_geda_item_calculate_bounds(item, capture->calculator);
+
+    if (bounds != NULL)
+    {
+        bb_bounds_union(capture->bounds, capture->bounds, bounds);
+
+        bb_bounds_free(bounds);
+    }
 }
 
 
 void
-bb_schematic_write_async(
+bb_schematic_save_async(
     BbSchematic *schematic,
-    GOutputStream *stream,
+    GFile *file,
     int io_priority,
     GCancellable *cancellable,
     GAsyncReadyCallback callback,
     gpointer callback_data
     )
 {
+    g_return_if_fail(BB_IS_SCHEMATIC(schematic));
+    g_return_if_fail(G_IS_FILE(file));
+
     GTask *task = g_task_new(schematic, cancellable, callback, callback_data);
+    AsyncWriteData *data = bb_schematic_async_write_data_new(schematic);
 
-    if (schematic->items != NULL)
-    {
-        AsyncWriteData *data = bb_schematic_async_write_data_new();
-        g_task_set_task_data(task, data, bb_schematic_async_write_data_free);
-
-        data->stream = stream;
-        data->io_priority = io_priority;
-        data->item = schematic->items;
-
-        bb_geda_item_write_async(
-            BB_GEDA_ITEM(data->item->data),
-            stream,
-            io_priority,
-            g_task_get_cancellable(task),
-            bb_schematic_write_callback,
-            task
+    data->file = g_object_ref(file);
+
+    g_task_set_priority(task, io_priority);
+    g_task_set_task_data(task, data, bb_schematic_async_write_data_free);
+    g_task_run_in_thread(task, bb_schematic_save_thread);
+    g_object_unref(task);
+}
+
+
+gboolean
+bb_schematic_save_finish(
+    BbSchematic *schematic,
+    GAsyncResult *result,
+    GError **error
+    )
+{
+    g_return_val_if_fail(g_task_is_valid(result, schematic), FALSE);
+
+    return g_task_propagate_boolean(G_TASK(result), error);
+}
+
+
+static void
+bb_schematic_save_thread(GTask *task, gpointer source, gpointer task_data, GCancellable *cancellable)
+{
+    AsyncWriteData *data = task_data;
+    GError *local_error = NULL;
+
+    /*
+     * For local files, g_file_replace() writes into a temporary file and renames it over the original when the
+     * stream closes, so readers see either the old or the new contents.
+     */
+
+    GFileOutputStream *stream = g_file_replace(
+        data->file,
+        NULL,
+        TRUE,
+        G_FILE_CREATE_NONE,
+        cancellable,
+        &local_error
         );
+
+    if (local_error == NULL)
+    {
+        bb_schematic_write_items(data->items, G_OUTPUT_STREAM(stream), cancellable, &local_error);
+    }
+
+    if (local_error == NULL)
+    {
+        g_output_stream_close(G_OUTPUT_STREAM(stream), cancellable, &local_error);
+    }
+    else if (stream != NULL)
+    {
+        /* Closing with a cancelled cancellable discards the temporary file and leaves the original in place */
+
+        GCancellable *abort = g_cancellable_new();
+
+        g_cancellable_cancel(abort);
+        g_output_stream_close(G_OUTPUT_STREAM(stream), abort, NULL);
+        g_object_unref(abort);
+    }
+
+    g_clear_object(&stream);
+
+    if (local_error != NULL)
+    {
+        g_task_return_error(task, local_error);
     }
     else
     {
@@ -585,69 +991,155 @@ bb_schematic_write_async(
 }
 
 
+gboolean
+bb_schematic_write(
+    BbSchematic *schematic,
+    GOutputStream *stream,
+    GCancellable *cancellable,
+    GError **error
+    )
+{
+    g_return_val_if_fail(BB_IS_SCHEMATIC(schematic), FALSE);
+    g_return_val_if_fail(G_IS_OUTPUT_STREAM(stream), FALSE);
+
+    return bb_schematic_write_items(schematic->items, stream, cancellable, error);
+}
+
+
 void
+bb_schematic_write_async(
+    BbSchematic *schematic,
+    GOutputStream *stream,
+    int io_priority,
+    GCancellable *cancellable,
+    GAsyncReadyCallback callback,
+    gpointer callback_data
+    )
+{
+    g_return_if_fail(BB_IS_SCHEMATIC(schematic));
+    g_return_if_fail(G_IS_OUTPUT_STREAM(stream));
+
+    GTask *task = g_task_new(schematic, cancellable, callback, callback_data);
+    AsyncWriteData *data = bb_schematic_async_write_data_new(schematic);
+
+    data->stream = g_object_ref(stream);
+
+    g_task_set_priority(task, io_priority);
+    g_task_set_task_data(task, data, bb_schematic_async_write_data_free);
+    g_task_run_in_thread(task, bb_schematic_write_thread);
+    g_object_unref(task);
+}
+
+
+gboolean
 bb_schematic_write_finish(
     BbSchematic *schematic,
     GAsyncResult *result,
     GError **error
     )
 {
-    g_return_if_fail(g_task_is_valid(result, schematic));
+    g_return_val_if_fail(g_task_is_valid(result, schematic), FALSE);
 
-    g_task_propagate_pointer(G_TASK(result), error);
+    return g_task_propagate_boolean(G_TASK(result), error);
 }
 
 
-static void
-bb_schematic_write_callback(GObject *source, GAsyncResult *result, gpointer callback_data)
+/**
+ * Write items to a stream through a single buffer
+ *
+ * @param items The items to write
+ * @param stream The stream receiving the items
+ * @param cancellable An optional cancellable object
+ * @param error An optional location to store an error
+ * @return TRUE on success, FALSE on failure
+ */
+static gboolean
+bb_schematic_write_items(GPtrArray *items, GOutputStream *stream, GCancellable *cancellable, GError **error)
 {
-    GError *error = NULL;
-    GTask *task = G_TASK(callback_data);
-    AsyncWriteData *data = g_task_get_task_data(task);
+    GError *local_error = NULL;
+    BbWriteBuffer *buffer = bb_write_buffer_new(stream, BB_WRITE_BUFFER_DEFAULT_BLOCK_SIZE);
 
-    bb_geda_item_write_finish(
-        BB_GEDA_ITEM(data->item->data),
-        data->stream,
-        result,
-        &error
-    );
+    for (int index = 0; local_error == NULL && index < items->len; index++)
+    {
+        bb_geda_item_format(BB_GEDA_ITEM(g_ptr_array_index(items, index)), buffer);
+        bb_write_buffer_flush_if_full(buffer, cancellable, &local_error);
+    }
 
-    if (error != NULL)
+    if (local_error == NULL)
     {
-        data->item = data->item->next;
+        bb_write_buffer_flush(buffer, cancellable, &local_error);
+    }
 
-        if (data->item != NULL)
-        {
-            bb_geda_item_write_async(
-                BB_GEDA_ITEM(data->item->data),
-                data->stream,
-                data->io_priority,
-                g_task_get_cancellable(G_TASK(result)),
-                bb_schematic_write_callback,
-                task
-            );
-        }
-        else
-        {
-            g_task_return_boolean(task, TRUE);
-        }
+    bb_write_buffer_free(buffer);
+
+    if (local_error != NULL)
+    {
+        g_propagate_error(error, local_error);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+
+static void
+bb_schematic_write_thread(GTask *task, gpointer source, gpointer task_data, GCancellable *cancellable)
+{
+    AsyncWriteData *data = task_data;
+    GError *local_error = NULL;
+
+    bb_schematic_write_items(data->items, data->stream, cancellable, &local_error);
+
+    if (local_error != NULL)
+    {
+        g_task_return_error(task, local_error);
     }
     else
     {
-        g_task_return_error(G_TASK(result), error);
+        g_task_return_boolean(task, TRUE);
     }
 }
 
 
+/**
+ * Create the state for a background write, including a snapshot of the schematic
+ *
+ * Cloning only copies the values of each item, which is cheap compared to formatting and writing. The snapshot
+ * is taken on the calling thread, so it reflects the schematic at the moment the save was requested.
+ *
+ * @param schematic The schematic to snapshot
+ * @return The state for the background write
+ */
 static AsyncWriteData*
-bb_schematic_async_write_data_new()
+bb_schematic_async_write_data_new(BbSchematic *schematic)
 {
-    return g_slice_new(AsyncWriteData);
+    AsyncWriteData *data = g_slice_new0(AsyncWriteData);
+
+    data->items = g_ptr_array_new_full(schematic->items->len, g_object_unref);
+
+    for (int index = 0; index < schematic->items->len; index++)
+    {
+        g_ptr_array_add(
+            data->items,
+            bb_geda_item_clone(BB_GEDA_ITEM(g_ptr_array_index(schematic->items, index)))
+            );
+    }
+
+    return data;
 }
 
 
 static void
 bb_schematic_async_write_data_free(gpointer slice)
 {
-    g_slice_free(AsyncWriteData, slice);
-}
\ No newline at end of file
+    AsyncWriteData *data = slice;
+
+    if (data != NULL)
+    {
+        g_clear_object(&data->file);
+        g_clear_pointer(&data->items, g_ptr_array_unref);
+        g_clear_object(&data->stream);
+
+        g_slice_free(AsyncWriteData, data);
+    }
+}
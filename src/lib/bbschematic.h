@@ -27,18 +27,68 @@
 #define BB_TYPE_SCHEMATIC bb_schematic_get_type()
 G_DECLARE_FINAL_TYPE(BbSchematic, bb_schematic, BB, SCHEMATIC, GObject)
 
+/**
+ * Append an item to the schematic
+ *
+ * Amortized constant time. The schematic takes its own reference to the item, and emits "item-added".
+ *
+ * @param schematic A schematic
+ * @param item The item to append
+ */
 void
 bb_schematic_add_item(BbSchematic *schematic, BbGedaItem *item);
 
 
+/**
+ * Append items to the schematic, in list order
+ *
+ * The schematic takes its own reference to each item. The caller retains ownership of the list.
+ *
+ * @param schematic A schematic
+ * @param items A list of BbGedaItem to append
+ */
 void
 bb_schematic_add_items(BbSchematic *schematic, GSList *items);
 
 
+/**
+ * Set a property on every item in the schematic that has it
+ *
+ * The changes are coalesced into a single "items-changed" signal.
+ *
+ * @param schematic A schematic
+ * @param name The name of the property
+ * @param value The new value of the property
+ */
 void
 bb_schematic_apply_item_property(BbSchematic *schematic, const char *name, const GValue *value);
 
 
+/**
+ * Start coalescing changes to items
+ *
+ * Until the matching bb_schematic_end_batch(), changed items do not cause "invalidate-item". Batches nest, and
+ * only the outermost batch emits "items-changed". Adding and removing items still emit their own signals.
+ *
+ * @param schematic A schematic
+ */
+void
+bb_schematic_begin_batch(BbSchematic *schematic);
+
+
+/**
+ * Finish coalescing changes to items
+ *
+ * When the outermost batch ends with changed items, emits "items-changed" with an array of the changed items,
+ * in the order of their first change, and the union of the bounds the items occupied before the batch. The
+ * damage only covers items already rendered, so handlers add the current bounds of each item.
+ *
+ * @param schematic A schematic
+ */
+void
+bb_schematic_end_batch(BbSchematic *schematic);
+
+
 void
 bb_schematic_foreach(BbSchematic *schematic, GFunc func, gpointer user_data);
 
@@ -75,6 +125,8 @@ bb_schematic_foreach_query(
 /**
  * Modify items in the schematic
  *
+ * Runs as a batch, so the changes emit a single "items-changed" signal.
+ *
  * @param schematic A schematic with items to modify
  * @param where_pred A predicate to filter items passed to the modify function
  * @param where_user_data A user pointer to pass to the filter predicate
@@ -94,6 +146,8 @@ bb_schematic_foreach_modify(
 /**
  * Remove items from a schematic
  *
+ * The remaining items keep their order. The "item-removed" signal is emitted for each item removed.
+ *
  * @param schematic A schematic with items to modify
  * @param where_pred A predicate indicating which items to remove
  * @param where_user_data A user pointer to pass to the predicate
@@ -106,6 +160,19 @@ bb_schematic_foreach_remove(
     );
 
 
+/**
+ * Get the revision of the schematic contents
+ *
+ * The revision changes when an item is added, removed, or changed. Views can compare revisions to determine if
+ * data derived from the schematic, like a display list, is stale.
+ *
+ * @param schematic A schematic
+ * @return The revision of the schematic contents
+ */
+guint
+bb_schematic_get_revision(BbSchematic *schematic);
+
+
 BbSchematic*
 bb_schematic_new();
 
@@ -117,6 +184,78 @@ bb_schematic_render(
     );
 
 
+/**
+ * Render only the items intersecting a region
+ *
+ * Items, along with their attributes, are located using a spatial index. Items are rendered in the same order
+ * as bb_schematic_render().
+ *
+ * @param schematic A schematic
+ * @param renderer The renderer receiving the items
+ * @param calculator Calculates the bounds of new or changed items
+ * @param region The region to render, in schematic coordinates
+ */
+void
+bb_schematic_render_region(
+    BbSchematic *schematic,
+    BbItemRenderer *renderer,
+    BbBoundsCalculator *calculator,
+    const BbBounds *region
+    );
+
+
+/**
+ * Save the schematic to a file on a worker thread
+ *
+ * The items are cloned before returning, so edits made while the save is in progress are not captured. The
+ * contents are written to a temporary file, which replaces the original only after all contents are written
+ * successfully.
+ *
+ * @param schematic A schematic
+ * @param file The file receiving the schematic
+ * @param io_priority The priority of the request
+ * @param cancellable An optional cancellable object
+ * @param callback Called on the main context when the save completes
+ * @param callback_data Data passed to the callback
+ */
+void
+bb_schematic_save_async(
+    BbSchematic *schematic,
+    GFile *file,
+    int io_priority,
+    GCancellable *cancellable,
+    GAsyncReadyCallback callback,
+    gpointer callback_data
+    );
+
+
+/**
+ * Complete saving the schematic to a file
+ *
+ * @param schematic A schematic
+ * @param result The result passed to the callback
+ * @param error An optional location to store an error
+ * @return TRUE on success, FALSE on failure
+ */
+gboolean
+bb_schematic_save_finish(
+    BbSchematic *schematic,
+    GAsyncResult *result,
+    GError **error
+    );
+
+
+/**
+ * Write the schematic to an output stream
+ *
+ * All items are formatted into a single buffer, which is written to the stream in large blocks.
+ *
+ * @param schematic A schematic
+ * @param stream The output stream receiving the schematic
+ * @param cancellable An optional cancellable object
+ * @param error An optional location to store an error
+ * @return TRUE on success, FALSE on failure
+ */
 gboolean
 bb_schematic_write(
     BbSchematic *schematic,
@@ -126,6 +265,19 @@ bb_schematic_write(
     );
 
 
+/**
+ * Write the schematic to an output stream on a worker thread
+ *
+ * The items are cloned before returning, so edits made while the write is in progress are not captured. The
+ * stream must not be used by the caller until the write completes.
+ *
+ * @param schematic A schematic
+ * @param stream The output stream receiving the schematic
+ * @param io_priority The priority of the request
+ * @param cancellable An optional cancellable object
+ * @param callback Called on the main context when the write completes
+ * @param callback_data Data passed to the callback
+ */
 void
 bb_schematic_write_async(
     BbSchematic *schematic,
@@ -137,7 +289,15 @@ bb_schematic_write_async(
     );
 
 
-void
+/**
+ * Complete writing the schematic to an output stream
+ *
+ * @param schematic A schematic
+ * @param result The result passed to the callback
+ * @param error An optional location to store an error
+ * @return TRUE on success, FALSE on failure
+ */
+gboolean
 bb_schematic_write_finish(
     BbSchematic *schematic,
     GAsyncResult *result,
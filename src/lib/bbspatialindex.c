@@ -0,0 +1,711 @@
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtk/gtk.h>
+#include "bbspatialindex.h"
+
+
+/**
+ * The maximum number of entries in a node before it splits
+ */
+#define MAX_ENTRIES 16
+
+
+/**
+ * The minimum number of entries given to each node in a split
+ */
+#define MIN_ENTRIES 4
+
+
+typedef struct _BbSpatialNode BbSpatialNode;
+
+struct _BbSpatialNode
+{
+    /**
+     * The node containing this node, or NULL for the root
+     */
+    BbSpatialNode *parent;
+
+    /**
+     * The entries contain keys, instead of child nodes
+     */
+    gboolean leaf;
+
+    /**
+     * The number of entries in use
+     */
+    int count;
+
+    /**
+     * The bounds of each entry
+     */
+    BbBounds bounds[MAX_ENTRIES];
+
+    /**
+     * A child BbSpatialNode for branches, or a key for leaves
+     */
+    gpointer child[MAX_ENTRIES];
+
+    /**
+     * The sort order of each key, for leaves only
+     */
+    guint order[MAX_ENTRIES];
+};
+
+
+struct _BbSpatialIndex
+{
+    BbSpatialNode *root;
+
+    /**
+     * Locates the leaf containing each key, for removal
+     */
+    GHashTable *leaves;
+};
+
+
+typedef struct _BbSpatialResult BbSpatialResult;
+
+struct _BbSpatialResult
+{
+    gpointer key;
+    guint order;
+};
+
+
+static void
+bb_spatial_index_add_entry(
+    BbSpatialIndex *index,
+    BbSpatialNode *node,
+    const BbBounds *bounds,
+    gpointer child,
+    guint order
+    );
+
+static void
+bb_spatial_index_adjust(BbSpatialNode *node);
+
+static BbSpatialNode*
+bb_spatial_index_choose_leaf(BbSpatialIndex *index, const BbBounds *bounds);
+
+static void
+bb_spatial_index_query_node(BbSpatialNode *node, const BbBounds *region, GArray *results);
+
+static BbSpatialNode*
+bb_spatial_index_split(
+    BbSpatialIndex *index,
+    BbSpatialNode *node,
+    const BbBounds *bounds,
+    gpointer child,
+    guint order
+    );
+
+static void
+bb_spatial_node_append(
+    BbSpatialIndex *index,
+    BbSpatialNode *node,
+    const BbBounds *bounds,
+    gpointer child,
+    guint order
+    );
+
+static double
+bb_spatial_node_area(const BbBounds *bounds);
+
+static double
+bb_spatial_node_enlargement(const BbBounds *bounds, const BbBounds *addition);
+
+static void
+bb_spatial_node_extent(BbSpatialNode *node, BbBounds *extent);
+
+static void
+bb_spatial_node_free(BbSpatialNode *node);
+
+static BbSpatialNode*
+bb_spatial_node_new(gboolean leaf);
+
+static void
+bb_spatial_node_remove(BbSpatialNode *node, int slot);
+
+static int
+bb_spatial_node_slot(BbSpatialNode *node, gpointer child);
+
+static gint
+bb_spatial_result_compare(const BbSpatialResult *a, const BbSpatialResult *b);
+
+
+/**
+ * Add an entry to a node, splitting the node and its ancestors as needed
+ *
+ * @param index The index containing the node
+ * @param node The node receiving the entry
+ * @param bounds The bounds of the entry
+ * @param child A child node for branches, or a key for leaves
+ * @param order The sort order, for leaves only
+ */
+static void
+bb_spatial_index_add_entry(
+    BbSpatialIndex *index,
+    BbSpatialNode *node,
+    const BbBounds *bounds,
+    gpointer child,
+    guint order
+    )
+{
+    if (node->count < MAX_ENTRIES)
+    {
+        bb_spatial_node_append(index, node, bounds, child, order);
+        bb_spatial_index_adjust(node);
+    }
+    else
+    {
+        BbSpatialNode *sibling = bb_spatial_index_split(index, node, bounds, child, order);
+        BbSpatialNode *parent = node->parent;
+
+        BbBounds node_bounds;
+        BbBounds sibling_bounds;
+
+        bb_spatial_node_extent(node, &node_bounds);
+        bb_spatial_node_extent(sibling, &sibling_bounds);
+
+        if (parent == NULL)
+        {
+            BbSpatialNode *root = bb_spatial_node_new(FALSE);
+
+            bb_spatial_node_append(index, root, &node_bounds, node, 0);
+            bb_spatial_node_append(index, root, &sibling_bounds, sibling, 0);
+
+            index->root = root;
+        }
+        else
+        {
+            parent->bounds[bb_spatial_node_slot(parent, node)] = node_bounds;
+
+            bb_spatial_index_add_entry(index, parent, &sibling_bounds, sibling, 0);
+        }
+    }
+}
+
+
+/**
+ * Update the bounds of the ancestors of a node after its entries change
+ *
+ * @param node The node with changed entries
+ */
+static void
+bb_spatial_index_adjust(BbSpatialNode *node)
+{
+    while (node->parent != NULL)
+    {
+        BbSpatialNode *parent = node->parent;
+
+        bb_spatial_node_extent(node, &parent->bounds[bb_spatial_node_slot(parent, node)]);
+
+        node = parent;
+    }
+}
+
+
+/**
+ * Find the leaf requiring the least enlargement to contain the bounds
+ *
+ * @param index The index to search
+ * @param bounds The bounds of the new entry
+ * @return The leaf to receive the entry
+ */
+static BbSpatialNode*
+bb_spatial_index_choose_leaf(BbSpatialIndex *index, const BbBounds *bounds)
+{
+    BbSpatialNode *node = index->root;
+
+    while (!node->leaf)
+    {
+        int best = 0;
+        double best_area = G_MAXDOUBLE;
+        double best_enlargement = G_MAXDOUBLE;
+
+        for (int slot = 0; slot < node->count; slot++)
+        {
+            double area = bb_spatial_node_area(&node->bounds[slot]);
+            double enlargement = bb_spatial_node_enlargement(&node->bounds[slot], bounds);
+
+            if ((enlargement < best_enlargement) || (enlargement == best_enlargement && area < best_area))
+            {
+                best = slot;
+                best_area = area;
+                best_enlargement = enlargement;
+            }
+        }
+
+        node = node->child[best];
+    }
+
+    return node;
+}
+
+
+void
+bb_spatial_index_free(BbSpatialIndex *index)
+{
+    if (index != NULL)
+    {
+        bb_spatial_node_free(index->root);
+        g_hash_table_destroy(index->leaves);
+
+        g_free(index);
+    }
+}
+
+
+void
+bb_spatial_index_insert(BbSpatialIndex *index, gpointer key, guint order, const BbBounds *bounds)
+{
+    g_return_if_fail(index != NULL);
+    g_return_if_fail(bounds != NULL);
+    g_return_if_fail(!g_hash_table_contains(index->leaves, key));
+
+    if (!bb_bounds_is_empty(bounds))
+    {
+        BbSpatialNode *leaf = bb_spatial_index_choose_leaf(index, bounds);
+
+        bb_spatial_index_add_entry(index, leaf, bounds, key, order);
+    }
+}
+
+
+gboolean
+bb_spatial_index_lookup(BbSpatialIndex *index, gpointer key, BbBounds *bounds)
+{
+    g_return_val_if_fail(index != NULL, FALSE);
+    g_return_val_if_fail(bounds != NULL, FALSE);
+
+    BbSpatialNode *node = g_hash_table_lookup(index->leaves, key);
+
+    if (node == NULL)
+    {
+        return FALSE;
+    }
+
+    *bounds = node->bounds[bb_spatial_node_slot(node, key)];
+
+    return TRUE;
+}
+
+
+BbSpatialIndex*
+bb_spatial_index_new()
+{
+    BbSpatialIndex *index = g_new0(BbSpatialIndex, 1);
+
+    index->root = bb_spatial_node_new(TRUE);
+    index->leaves = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+    return index;
+}
+
+
+void
+bb_spatial_index_query(BbSpatialIndex *index, const BbBounds *region, GPtrArray *results)
+{
+    g_return_if_fail(index != NULL);
+    g_return_if_fail(region != NULL);
+    g_return_if_fail(results != NULL);
+
+    GArray *temp = g_array_new(FALSE, FALSE, sizeof(BbSpatialResult));
+
+    bb_spatial_index_query_node(index->root, region, temp);
+
+    g_array_sort(temp, (GCompareFunc) bb_spatial_result_compare);
+
+    for (guint result = 0; result < temp->len; result++)
+    {
+        g_ptr_array_add(results, g_array_index(temp, BbSpatialResult, result).key);
+    }
+
+    g_array_free(temp, TRUE);
+}
+
+
+static void
+bb_spatial_index_query_node(BbSpatialNode *node, const BbBounds *region, GArray *results)
+{
+    for (int slot = 0; slot < node->count; slot++)
+    {
+        if (bb_bounds_intersects(&node->bounds[slot], region))
+        {
+            if (node->leaf)
+            {
+                BbSpatialResult result;
+
+                result.key = node->child[slot];
+                result.order = node->order[slot];
+
+                g_array_append_val(results, result);
+            }
+            else
+            {
+                bb_spatial_index_query_node(node->child[slot], region, results);
+            }
+        }
+    }
+}
+
+
+gboolean
+bb_spatial_index_remove(BbSpatialIndex *index, gpointer key)
+{
+    g_return_val_if_fail(index != NULL, FALSE);
+
+    BbSpatialNode *node = g_hash_table_lookup(index->leaves, key);
+
+    if (node == NULL)
+    {
+        return FALSE;
+    }
+
+    g_hash_table_remove(index->leaves, key);
+    bb_spatial_node_remove(node, bb_spatial_node_slot(node, key));
+
+    /* Underfull nodes are kept, only empty nodes are removed from the tree */
+    while (node->parent != NULL && node->count == 0)
+    {
+        BbSpatialNode *parent = node->parent;
+
+        bb_spatial_node_remove(parent, bb_spatial_node_slot(parent, node));
+        bb_spatial_node_free(node);
+
+        node = parent;
+    }
+
+    bb_spatial_index_adjust(node);
+
+    while (!index->root->leaf && index->root->count <= 1)
+    {
+        BbSpatialNode *root = index->root;
+
+        if (root->count == 1)
+        {
+            index->root = root->child[0];
+            index->root->parent = NULL;
+            root->count = 0;
+        }
+        else
+        {
+            index->root = bb_spatial_node_new(TRUE);
+        }
+
+        bb_spatial_node_free(root);
+    }
+
+    return TRUE;
+}
+
+
+gboolean
+bb_spatial_index_set_order(BbSpatialIndex *index, gpointer key, guint order)
+{
+    g_return_val_if_fail(index != NULL, FALSE);
+
+    BbSpatialNode *node = g_hash_table_lookup(index->leaves, key);
+
+    if (node == NULL)
+    {
+        return FALSE;
+    }
+
+    node->order[bb_spatial_node_slot(node, key)] = order;
+
+    return TRUE;
+}
+
+
+/**
+ * Split a full node using the linear cost algorithm
+ *
+ * The entries of the node, along with the additional entry, are divided between the node and a new sibling.
+ *
+ * @param index The index containing the node
+ * @param node The full node
+ * @param bounds The bounds of the additional entry
+ * @param child The child or key of the additional entry
+ * @param order The order of the additional entry
+ * @return The new sibling, not yet added to a parent
+ */
+static BbSpatialNode*
+bb_spatial_index_split(
+    BbSpatialIndex *index,
+    BbSpatialNode *node,
+    const BbBounds *bounds,
+    gpointer child,
+    guint order
+    )
+{
+    const int total = MAX_ENTRIES + 1;
+
+    BbBounds entry_bounds[MAX_ENTRIES + 1];
+    gpointer entry_child[MAX_ENTRIES + 1];
+    guint entry_order[MAX_ENTRIES + 1];
+    gboolean assigned[MAX_ENTRIES + 1] = { FALSE };
+
+    for (int slot = 0; slot < MAX_ENTRIES; slot++)
+    {
+        entry_bounds[slot] = node->bounds[slot];
+        entry_child[slot] = node->child[slot];
+        entry_order[slot] = node->order[slot];
+    }
+
+    entry_bounds[MAX_ENTRIES] = *bounds;
+    entry_child[MAX_ENTRIES] = child;
+    entry_order[MAX_ENTRIES] = order;
+
+    /* Pick the two seeds with the greatest normalized separation along either axis */
+
+    int high_min_x = 0;
+    int high_min_y = 0;
+    int low_max_x = 0;
+    int low_max_y = 0;
+    BbBounds extent = entry_bounds[0];
+
+    for (int entry = 1; entry < total; entry++)
+    {
+        if (entry_bounds[entry].min_x > entry_bounds[high_min_x].min_x) high_min_x = entry;
+        if (entry_bounds[entry].min_y > entry_bounds[high_min_y].min_y) high_min_y = entry;
+        if (entry_bounds[entry].max_x < entry_bounds[low_max_x].max_x) low_max_x = entry;
+        if (entry_bounds[entry].max_y < entry_bounds[low_max_y].max_y) low_max_y = entry;
+
+        bb_bounds_union(&extent, &extent, &entry_bounds[entry]);
+    }
+
+    double separation_x = (double) entry_bounds[high_min_x].min_x - entry_bounds[low_max_x].max_x;
+    double separation_y = (double) entry_bounds[high_min_y].min_y - entry_bounds[low_max_y].max_y;
+
+    separation_x /= MAX(1.0, (double) extent.max_x - extent.min_x);
+    separation_y /= MAX(1.0, (double) extent.max_y - extent.min_y);
+
+    int seed[2];
+
+    if (separation_x >= separation_y)
+    {
+        seed[0] = low_max_x;
+        seed[1] = high_min_x;
+    }
+    else
+    {
+        seed[0] = low_max_y;
+        seed[1] = high_min_y;
+    }
+
+    if (seed[0] == seed[1])
+    {
+        seed[1] = (seed[0] == 0) ? 1 : 0;
+    }
+
+    /* Distribute the entries between the node and its new sibling */
+
+    BbSpatialNode *group[2];
+
+    group[0] = node;
+    group[1] = bb_spatial_node_new(node->leaf);
+    group[1]->parent = node->parent;
+
+    node->count = 0;
+
+    BbBounds group_bounds[2];
+    int remaining = total;
+
+    for (int which = 0; which < 2; which++)
+    {
+        bb_spatial_node_append(index, group[which], &entry_bounds[seed[which]], entry_child[seed[which]], entry_order[seed[which]]);
+        group_bounds[which] = entry_bounds[seed[which]];
+        assigned[seed[which]] = TRUE;
+        remaining--;
+    }
+
+    for (int entry = 0; entry < total; entry++)
+    {
+        if (assigned[entry])
+        {
+            continue;
+        }
+
+        int which;
+
+        if (group[0]->count + remaining <= MIN_ENTRIES)
+        {
+            which = 0;
+        }
+        else if (group[1]->count + remaining <= MIN_ENTRIES)
+        {
+            which = 1;
+        }
+        else
+        {
+            double enlargement0 = bb_spatial_node_enlargement(&group_bounds[0], &entry_bounds[entry]);
+            double enlargement1 = bb_spatial_node_enlargement(&group_bounds[1], &entry_bounds[entry]);
+
+            if (enlargement0 != enlargement1)
+            {
+                which = (enlargement0 < enlargement1) ? 0 : 1;
+            }
+            else
+            {
+                which = (group[0]->count <= group[1]->count) ? 0 : 1;
+            }
+        }
+
+        bb_spatial_node_append(index, group[which], &entry_bounds[entry], entry_child[entry], entry_order[entry]);
+        bb_bounds_union(&group_bounds[which], &group_bounds[which], &entry_bounds[entry]);
+        assigned[entry] = TRUE;
+        remaining--;
+    }
+
+    return group[1];
+}
+
+
+/**
+ * Append an entry to a node with room for it, updating back references
+ */
+static void
+bb_spatial_node_append(
+    BbSpatialIndex *index,
+    BbSpatialNode *node,
+    const BbBounds *bounds,
+    gpointer child,
+    guint order
+    )
+{
+    g_assert(node->count < MAX_ENTRIES);
+
+    node->bounds[node->count] = *bounds;
+    node->child[node->count] = child;
+    node->order[node->count] = order;
+    node->count++;
+
+    if (node->leaf)
+    {
+        g_hash_table_insert(index->leaves, child, node);
+    }
+    else
+    {
+        ((BbSpatialNode*) child)->parent = node;
+    }
+}
+
+
+static double
+bb_spatial_node_area(const BbBounds *bounds)
+{
+    return ((double) bounds->max_x - bounds->min_x) * ((double) bounds->max_y - bounds->min_y);
+}
+
+
+static double
+bb_spatial_node_enlargement(const BbBounds *bounds, const BbBounds *addition)
+{
+    BbBounds combined;
+
+    combined.min_x = MIN(bounds->min_x, addition->min_x);
+    combined.min_y = MIN(bounds->min_y, addition->min_y);
+    combined.max_x = MAX(bounds->max_x, addition->max_x);
+    combined.max_y = MAX(bounds->max_y, addition->max_y);
+
+    return bb_spatial_node_area(&combined) - bb_spatial_node_area(bounds);
+}
+
+
+static void
+bb_spatial_node_extent(BbSpatialNode *node, BbBounds *extent)
+{
+    extent->min_x = G_MAXINT;
+    extent->min_y = G_MAXINT;
+    extent->max_x = G_MININT;
+    extent->max_y = G_MININT;
+
+    for (int slot = 0; slot < node->count; slot++)
+    {
+        bb_bounds_union(extent, extent, &node->bounds[slot]);
+    }
+}
+
+
+static void
+bb_spatial_node_free(BbSpatialNode *node)
+{
+    if (node != NULL)
+    {
+        if (!node->leaf)
+        {
+            for (int slot = 0; slot < node->count; slot++)
+            {
+                bb_spatial_node_free(node->child[slot]);
+            }
+        }
+
+        g_slice_free(BbSpatialNode, node);
+    }
+}
+
+
+static BbSpatialNode*
+bb_spatial_node_new(gboolean leaf)
+{
+    BbSpatialNode *node = g_slice_new0(BbSpatialNode);
+
+    node->leaf = leaf;
+
+    return node;
+}
+
+
+/**
+ * Remove an entry from a node, without regard to order
+ */
+static void
+bb_spatial_node_remove(BbSpatialNode *node, int slot)
+{
+    g_assert(slot >= 0 && slot < node->count);
+
+    node->count--;
+
+    node->bounds[slot] = node->bounds[node->count];
+    node->child[slot] = node->child[node->count];
+    node->order[slot] = node->order[node->count];
+}
+
+
+static int
+bb_spatial_node_slot(BbSpatialNode *node, gpointer child)
+{
+    for (int slot = 0; slot < node->count; slot++)
+    {
+        if (node->child[slot] == child)
+        {
+            return slot;
+        }
+    }
+
+    g_assert_not_reached();
+}
+
+
+static gint
+bb_spatial_result_compare(const BbSpatialResult *a, const BbSpatialResult *b)
+{
+    return (a->order > b->order) - (a->order < b->order);
+}
@@ -0,0 +1,115 @@
+#ifndef __BBSPATIALINDEX__
+#define __BBSPATIALINDEX__
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file bbspatialindex.h
+ *
+ * An R-tree for locating items by their bounds
+ *
+ * Each entry associates a key (e.g. an item) with its bounds and an order. Query results are returned sorted by
+ * order, so callers can preserve drawing order. Keys must be unique within the index. Entries with empty bounds
+ * are not stored.
+ */
+
+#include <gtk/gtk.h>
+#include "bbbounds.h"
+
+
+typedef struct _BbSpatialIndex BbSpatialIndex;
+
+
+/**
+ * Free an index and all its nodes
+ *
+ * The keys are not owned by the index.
+ *
+ * @param index The index to free
+ */
+void
+bb_spatial_index_free(BbSpatialIndex *index);
+
+
+/**
+ * Add a key to the index
+ *
+ * @param index The index
+ * @param key The key, which must not already be in the index
+ * @param order The sort order for query results
+ * @param bounds The bounds of the key, nothing is stored if empty
+ */
+void
+bb_spatial_index_insert(BbSpatialIndex *index, gpointer key, guint order, const BbBounds *bounds);
+
+
+/**
+ * Get the bounds stored for a key
+ *
+ * @param index The index
+ * @param key The key to look up
+ * @param bounds Receives the bounds of the key
+ * @return TRUE if the key is in the index, FALSE if not and the bounds are unchanged
+ */
+gboolean
+bb_spatial_index_lookup(BbSpatialIndex *index, gpointer key, BbBounds *bounds);
+
+
+/**
+ * Create a new, empty index
+ *
+ * @return The new index, free with bb_spatial_index_free()
+ */
+BbSpatialIndex*
+bb_spatial_index_new();
+
+
+/**
+ * Find all keys with bounds intersecting a region
+ *
+ * @param index The index
+ * @param region The region to search
+ * @param results An array receiving the keys, sorted by order
+ */
+void
+bb_spatial_index_query(BbSpatialIndex *index, const BbBounds *region, GPtrArray *results);
+
+
+/**
+ * Remove a key from the index
+ *
+ * @param index The index
+ * @param key The key to remove
+ * @return TRUE if the key was in the index
+ */
+gboolean
+bb_spatial_index_remove(BbSpatialIndex *index, gpointer key);
+
+
+/**
+ * Change the sort order of a key, without moving it within the tree
+ *
+ * @param index The index
+ * @param key The key to reorder
+ * @param order The new sort order for query results
+ * @return TRUE if the key was in the index
+ */
+gboolean
+bb_spatial_index_set_order(BbSpatialIndex *index, gpointer key, guint order);
+
+
+#endif
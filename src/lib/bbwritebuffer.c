@@ -0,0 +1,229 @@
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtk/gtk.h>
+#include "bbwritebuffer.h"
+
+
+/**
+ * The character separating parameters on a line
+ */
+#define SEPARATOR ' '
+
+
+/**
+ * The maximum number of characters in a 32 bit integer, including the sign
+ */
+#define MAX_INT_LENGTH (11)
+
+
+struct _BbWriteBuffer
+{
+    /**
+     * The output stream receiving the contents
+     */
+    GOutputStream *stream;
+
+    /**
+     * The number of bytes to accumulate before writing to the stream
+     */
+    gsize block_size;
+
+    /**
+     * The formatted contents not yet written to the stream
+     */
+    GString *text;
+};
+
+
+/**
+ * Pairs of decimal digits for the values 00 through 99
+ *
+ * Converting two digits per division halves the number of divisions.
+ */
+static const gchar digit_pairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+
+void
+bb_write_buffer_append_char(BbWriteBuffer *buffer, gchar c)
+{
+    g_return_if_fail(buffer != NULL);
+
+    g_string_append_c(buffer->text, c);
+}
+
+
+void
+bb_write_buffer_append_int(BbWriteBuffer *buffer, int value)
+{
+    g_return_if_fail(buffer != NULL);
+
+    gchar digits[MAX_INT_LENGTH];
+    gchar *end = digits + MAX_INT_LENGTH;
+    gchar *begin = end;
+
+    /* Negate as unsigned, so G_MININT does not overflow */
+
+    guint magnitude = value < 0 ? 0u - (guint) value : (guint) value;
+
+    while (magnitude >= 100)
+    {
+        guint pair = 2 * (magnitude % 100);
+
+        magnitude /= 100;
+        *--begin = digit_pairs[pair + 1];
+        *--begin = digit_pairs[pair];
+    }
+
+    if (magnitude >= 10)
+    {
+        guint pair = 2 * magnitude;
+
+        *--begin = digit_pairs[pair + 1];
+        *--begin = digit_pairs[pair];
+    }
+    else
+    {
+        *--begin = (gchar) ('0' + magnitude);
+    }
+
+    if (value < 0)
+    {
+        *--begin = '-';
+    }
+
+    g_string_append_len(buffer->text, begin, end - begin);
+}
+
+
+void
+bb_write_buffer_append_params(BbWriteBuffer *buffer, const gchar *token, int count, const int values[count])
+{
+    g_return_if_fail(buffer != NULL);
+    g_return_if_fail(token != NULL);
+    g_return_if_fail(count == 0 || values != NULL);
+
+    g_string_append(buffer->text, token);
+
+    for (int index = 0; index < count; index++)
+    {
+        g_string_append_c(buffer->text, SEPARATOR);
+        bb_write_buffer_append_int(buffer, values[index]);
+    }
+
+    g_string_append_c(buffer->text, '\n');
+}
+
+
+void
+bb_write_buffer_append_string(BbWriteBuffer *buffer, const gchar *string)
+{
+    g_return_if_fail(buffer != NULL);
+    g_return_if_fail(string != NULL);
+
+    g_string_append(buffer->text, string);
+}
+
+
+gboolean
+bb_write_buffer_flush(BbWriteBuffer *buffer, GCancellable *cancellable, GError **error)
+{
+    g_return_val_if_fail(buffer != NULL, FALSE);
+
+    if (buffer->text->len == 0)
+    {
+        return TRUE;
+    }
+
+    gboolean result = g_output_stream_write_all(
+        buffer->stream,
+        buffer->text->str,
+        buffer->text->len,
+        NULL,
+        cancellable,
+        error
+        );
+
+    g_string_truncate(buffer->text, 0);
+
+    return result;
+}
+
+
+gboolean
+bb_write_buffer_flush_if_full(BbWriteBuffer *buffer, GCancellable *cancellable, GError **error)
+{
+    g_return_val_if_fail(buffer != NULL, FALSE);
+
+    if (buffer->text->len < buffer->block_size)
+    {
+        return TRUE;
+    }
+
+    return bb_write_buffer_flush(buffer, cancellable, error);
+}
+
+
+void
+bb_write_buffer_free(BbWriteBuffer *buffer)
+{
+    if (buffer != NULL)
+    {
+        g_clear_object(&buffer->stream);
+        g_string_free(buffer->text, TRUE);
+        g_slice_free(BbWriteBuffer, buffer);
+    }
+}
+
+
+gsize
+bb_write_buffer_get_length(BbWriteBuffer *buffer)
+{
+    g_return_val_if_fail(buffer != NULL, 0);
+
+    return buffer->text->len;
+}
+
+
+BbWriteBuffer*
+bb_write_buffer_new(GOutputStream *stream, gsize block_size)
+{
+    g_return_val_if_fail(G_IS_OUTPUT_STREAM(stream), NULL);
+    g_return_val_if_fail(block_size > 0, NULL);
+
+    BbWriteBuffer *buffer = g_slice_new(BbWriteBuffer);
+
+    buffer->stream = g_object_ref(stream);
+    buffer->block_size = block_size;
+
+    /* Leave room for the record that crosses the block size */
+
+    buffer->text = g_string_sized_new(block_size + 1024);
+
+    return buffer;
+}
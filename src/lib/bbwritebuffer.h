@@ -0,0 +1,144 @@
+#ifndef __BBWRITEBUFFER__
+#define __BBWRITEBUFFER__
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ *
+ * A growable buffer for formatting file records
+ *
+ * Items append their records to the buffer, which writes to the underlying output stream in large blocks. This
+ * avoids a separate write to the stream, and a separate allocation, for each item.
+ */
+
+#include <gtk/gtk.h>
+
+
+/**
+ * The default size of the blocks written to the output stream
+ */
+#define BB_WRITE_BUFFER_DEFAULT_BLOCK_SIZE (64 * 1024)
+
+
+typedef struct _BbWriteBuffer BbWriteBuffer;
+
+
+/**
+ * Append a single character
+ *
+ * @param buffer A BbWriteBuffer
+ * @param c The character to append
+ */
+void
+bb_write_buffer_append_char(BbWriteBuffer *buffer, gchar c);
+
+
+/**
+ * Append an integer in decimal, as with printf("%d")
+ *
+ * @param buffer A BbWriteBuffer
+ * @param value The integer to append
+ */
+void
+bb_write_buffer_append_int(BbWriteBuffer *buffer, int value);
+
+
+/**
+ * Append a record consisting of a token followed by integer parameters
+ *
+ * The token and parameters are separated by single spaces and the record is terminated with a newline.
+ *
+ * @param buffer A BbWriteBuffer
+ * @param token The token identifying the record type
+ * @param count The number of parameters
+ * @param values The parameters
+ */
+void
+bb_write_buffer_append_params(BbWriteBuffer *buffer, const gchar *token, int count, const int values[count]);
+
+
+/**
+ * Append a null terminated string
+ *
+ * @param buffer A BbWriteBuffer
+ * @param string The string to append
+ */
+void
+bb_write_buffer_append_string(BbWriteBuffer *buffer, const gchar *string);
+
+
+/**
+ * Write the entire contents of the buffer to the output stream
+ *
+ * @param buffer A BbWriteBuffer
+ * @param cancellable An optional cancellable object
+ * @param error An optional location to store an error
+ * @return TRUE on success, FALSE on failure
+ */
+gboolean
+bb_write_buffer_flush(BbWriteBuffer *buffer, GCancellable *cancellable, GError **error);
+
+
+/**
+ * Write the contents of the buffer to the output stream, if it has reached the block size
+ *
+ * @param buffer A BbWriteBuffer
+ * @param cancellable An optional cancellable object
+ * @param error An optional location to store an error
+ * @return TRUE on success, FALSE on failure
+ */
+gboolean
+bb_write_buffer_flush_if_full(BbWriteBuffer *buffer, GCancellable *cancellable, GError **error);
+
+
+/**
+ * Free resources associated with the buffer
+ *
+ * Unflushed contents are discarded.
+ *
+ * @param buffer A BbWriteBuffer
+ */
+void
+bb_write_buffer_free(BbWriteBuffer *buffer);
+
+
+/**
+ * Get the number of bytes formatted, but not yet written to the output stream
+ *
+ * @param buffer A BbWriteBuffer
+ * @return The number of bytes in the buffer
+ */
+gsize
+bb_write_buffer_get_length(BbWriteBuffer *buffer);
+
+
+/**
+ * Create a buffer writing to an output stream
+ *
+ * Use bb_write_buffer_free() to release all associated resources
+ *
+ * @param stream The output stream receiving the contents
+ * @param block_size The number of bytes to accumulate before writing
+ * @return A new BbWriteBuffer
+ */
+BbWriteBuffer*
+bb_write_buffer_new(GOutputStream *stream, gsize block_size);
+
+
+#endif
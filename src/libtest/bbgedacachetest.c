@@ -0,0 +1,447 @@
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtk/gtk.h>
+#include <string.h>
+#include <glib/gstdio.h>
+#include <bbschematic.h>
+#include <gedaplugin/bbgedacache.h>
+#include <gedaplugin/bbgedareader.h>
+
+
+/**
+ * A small schematic, including an attribute list and multiline text
+ */
+static const gchar *records =
+    "A 100 100 200 0 90 3 10 0 0 -1 -1\n"
+    "B 100 200 1000 500 3 10 0 0 -1 -1 2 10 45 100 135 100\n"
+    "C 1000 2000 1 0 0 resistor-1.sym\n"
+    "L -2147483648 2147483647 0 -1 3 0 0 0 -1 -1\n"
+    "N 0 0 1000 0 4\n"
+    "{\n"
+    "T 100 100 5 10 1 1 0 0 1\n"
+    "netname=GND\n"
+    "T 100 200 5 10 0 1 0 0 1\n"
+    "comment=001\n"
+    "}\n"
+    "P 0 0 300 0 1 0 1\n"
+    "T -100 -200 9 12 1 0 90 3 2\n"
+    "first line\n"
+    "second line\n"
+    "U 0 100 0 900 10 0\n"
+    "V 500 500 250 3 10 0 0 -1 -1 0 -1 -1 -1 -1 -1\n";
+
+
+/**
+ * A temporary source file and cache directory
+ */
+typedef struct
+{
+    gchar *folder;
+    gchar *directory;
+    GFile *file;
+    BbGedaReader *reader;
+}
+Fixture;
+
+
+static void
+fixture_set_up(Fixture *fixture, gconstpointer user_data)
+{
+    GError *error = NULL;
+
+    fixture->folder = g_dir_make_tmp("bbgedacachetest-XXXXXX", &error);
+    g_assert_no_error(error);
+
+    fixture->directory = g_build_filename(fixture->folder, "cache", NULL);
+
+    gchar *path = g_build_filename(fixture->folder, "test.sch", NULL);
+    fixture->file = g_file_new_for_path(path);
+    g_free(path);
+
+    BbGedaCache *cache = bb_geda_cache_new(fixture->directory);
+
+    fixture->reader = BB_GEDA_READER(g_object_new(BB_TYPE_GEDA_READER, "cache", cache, NULL));
+
+    g_object_unref(cache);
+}
+
+
+static void
+fixture_tear_down(Fixture *fixture, gconstpointer user_data)
+{
+    GDir *dir = g_dir_open(fixture->directory, 0, NULL);
+
+    if (dir != NULL)
+    {
+        const gchar *name;
+
+        while ((name = g_dir_read_name(dir)) != NULL)
+        {
+            gchar *path = g_build_filename(fixture->directory, name, NULL);
+
+            g_remove(path);
+            g_free(path);
+        }
+
+        g_dir_close(dir);
+        g_rmdir(fixture->directory);
+    }
+
+    g_file_delete(fixture->file, NULL, NULL);
+    g_rmdir(fixture->folder);
+
+    g_object_unref(fixture->reader);
+    g_object_unref(fixture->file);
+    g_free(fixture->directory);
+    g_free(fixture->folder);
+}
+
+
+/**
+ * Get the path of the only cache file, or NULL if there are none
+ */
+static gchar*
+get_cache_path(Fixture *fixture)
+{
+    GDir *dir = g_dir_open(fixture->directory, 0, NULL);
+    gchar *path = NULL;
+
+    if (dir != NULL)
+    {
+        const gchar *name = g_dir_read_name(dir);
+
+        if (name != NULL)
+        {
+            path = g_build_filename(fixture->directory, name, NULL);
+        }
+
+        g_assert_null(g_dir_read_name(dir));
+        g_dir_close(dir);
+    }
+
+    return path;
+}
+
+
+/**
+ * Read the schematic through the reader and return it written back as text
+ */
+static gchar*
+load(Fixture *fixture)
+{
+    GError *error = NULL;
+
+    BbSchematic *schematic = bb_geda_reader_read_file(fixture->reader, fixture->file, NULL, &error);
+
+    g_assert_no_error(error);
+    g_assert_nonnull(schematic);
+
+    GOutputStream *stream = g_memory_output_stream_new_resizable();
+
+    bb_schematic_write(schematic, stream, NULL, &error);
+    g_output_stream_write_all(stream, "", 1, NULL, NULL, &error);
+    g_output_stream_close(stream, NULL, &error);
+    g_assert_no_error(error);
+
+    gchar *contents = g_memory_output_stream_steal_data(G_MEMORY_OUTPUT_STREAM(stream));
+
+    g_object_unref(stream);
+    g_object_unref(schematic);
+
+    return contents;
+}
+
+
+static void
+save(Fixture *fixture, const gchar *contents)
+{
+    GError *error = NULL;
+    gchar *path = g_file_get_path(fixture->file);
+
+    g_file_set_contents(path, contents, -1, &error);
+    g_assert_no_error(error);
+
+    g_free(path);
+}
+
+
+/**
+ * Create the text of a large schematic
+ */
+static gchar*
+create_large(gsize length)
+{
+    GString *large = g_string_new("v 20191003 2\n");
+
+    while (large->len < length)
+    {
+        g_string_append(large, records);
+    }
+
+    return g_string_free(large, FALSE);
+}
+
+
+/**
+ * Look up the cache entry for the current contents of the source file
+ */
+static GArray*
+lookup(Fixture *fixture, GMappedFile **mapping, GError **error)
+{
+    gchar *contents = NULL;
+    gsize length = 0;
+    gchar *path = g_file_get_path(fixture->file);
+
+    g_file_get_contents(path, &contents, &length, NULL);
+
+    GFileInfo *info = g_file_query_info(
+        fixture->file,
+        G_FILE_ATTRIBUTE_STANDARD_SIZE "," G_FILE_ATTRIBUTE_TIME_MODIFIED "," G_FILE_ATTRIBUTE_TIME_MODIFIED_USEC,
+        G_FILE_QUERY_INFO_NONE,
+        NULL,
+        NULL
+        );
+
+    BbGedaCacheKey *key = bb_geda_cache_key_new(fixture->file, info, contents, length);
+
+    GArray *result = bb_geda_cache_load(bb_geda_reader_get_cache(fixture->reader), key, mapping, error);
+
+    bb_geda_cache_key_free(key);
+    g_object_unref(info);
+    g_free(contents);
+    g_free(path);
+
+    return result;
+}
+
+
+void
+check_corrupt(Fixture *fixture, gconstpointer user_data)
+{
+    save(fixture, "v 20191003 2\nN 0 0 1000 0 4\n");
+    gchar *expected = load(fixture);
+    gchar *path = get_cache_path(fixture);
+
+    g_assert_nonnull(path);
+
+    /* Truncate the entry within the records */
+
+    gchar *contents = NULL;
+    gsize length = 0;
+    GError *error = NULL;
+
+    g_file_get_contents(path, &contents, &length, &error);
+    g_assert_no_error(error);
+    g_file_set_contents(path, contents, length - 20, &error);
+    g_assert_no_error(error);
+
+    GMappedFile *mapping = NULL;
+    GArray *cached = lookup(fixture, &mapping, &error);
+
+    g_assert_null(cached);
+    g_assert_nonnull(error);
+    g_clear_error(&error);
+
+    /* The reader falls back to the text, and replaces the entry */
+
+    gchar *actual = load(fixture);
+
+    g_assert_cmpstr(expected, ==, actual);
+
+    cached = lookup(fixture, &mapping, &error);
+
+    g_assert_no_error(error);
+    g_assert_nonnull(cached);
+
+    g_array_unref(cached);
+    g_mapped_file_unref(mapping);
+    g_free(actual);
+    g_free(contents);
+    g_free(path);
+    g_free(expected);
+}
+
+
+void
+check_round_trip(Fixture *fixture, gconstpointer user_data)
+{
+    gchar *text = g_strconcat("v 20191003 2\n", records, NULL);
+
+    save(fixture, text);
+
+    g_assert_null(get_cache_path(fixture));
+
+    gchar *expected = load(fixture);
+    gchar *path = get_cache_path(fixture);
+
+    g_assert_nonnull(path);
+
+    GError *error = NULL;
+    GMappedFile *mapping = NULL;
+    GArray *cached = lookup(fixture, &mapping, &error);
+
+    g_assert_no_error(error);
+    g_assert_nonnull(cached);
+
+    /* Attributes are flattened into separate records, and the list delimiters dropped */
+    g_assert_cmpuint(cached->len, ==, 11);
+
+    g_array_unref(cached);
+    g_mapped_file_unref(mapping);
+
+    gchar *actual = load(fixture);
+
+    g_assert_cmpstr(expected, ==, actual);
+
+    g_free(actual);
+    g_free(path);
+    g_free(expected);
+    g_free(text);
+}
+
+
+void
+check_stale(Fixture *fixture, gconstpointer user_data)
+{
+    save(fixture, "v 20191003 2\nN 0 0 1000 0 4\n");
+    gchar *first = load(fixture);
+
+    /* Same size, so only the checksum, and possibly the time, differ */
+
+    save(fixture, "v 20191003 2\nN 0 0 2000 0 4\n");
+
+    GError *error = NULL;
+    GMappedFile *mapping = NULL;
+    GArray *cached = lookup(fixture, &mapping, &error);
+
+    g_assert_no_error(error);
+    g_assert_null(cached);
+
+    gchar *second = load(fixture);
+
+    g_assert_cmpstr(first, !=, second);
+    g_assert_nonnull(strstr(second, "N 0 0 2000 0 4"));
+
+    g_free(second);
+    g_free(first);
+}
+
+
+/**
+ * Compare the time taken to load a large file as text and from the cache
+ *
+ * Only runs in performance mode: gtester -m perf bbgedacachetest
+ */
+void
+check_performance(Fixture *fixture, gconstpointer user_data)
+{
+    if (!g_test_perf())
+    {
+        g_test_skip("Performance tests only run with -m perf");
+        return;
+    }
+
+    GError *error = NULL;
+    gchar *text = create_large(32 * 1024 * 1024);
+
+    save(fixture, text);
+
+    BbGedaReader *uncached = BB_GEDA_READER(g_object_new(BB_TYPE_GEDA_READER, NULL));
+
+    g_test_timer_start();
+    BbSchematic *schematic = bb_geda_reader_read_file(uncached, fixture->file, NULL, &error);
+    double cold = g_test_timer_elapsed();
+
+    g_assert_no_error(error);
+    g_clear_object(&schematic);
+
+    /* Populates the cache */
+
+    g_test_timer_start();
+    schematic = bb_geda_reader_read_file(fixture->reader, fixture->file, NULL, &error);
+    double storing = g_test_timer_elapsed();
+
+    g_assert_no_error(error);
+    g_clear_object(&schematic);
+
+    g_test_timer_start();
+    schematic = bb_geda_reader_read_file(fixture->reader, fixture->file, NULL, &error);
+    double cached = g_test_timer_elapsed();
+
+    g_assert_no_error(error);
+    g_clear_object(&schematic);
+
+    g_test_message(
+        "%zu bytes: text %.1f ms, text and store %.1f ms, cached %.1f ms",
+        strlen(text),
+        1000.0 * cold,
+        1000.0 * storing,
+        1000.0 * cached
+        );
+
+    g_test_minimized_result(cached, "cached load %.6f seconds", cached);
+
+    g_object_unref(uncached);
+    g_free(text);
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add(
+        "/bbgedacachetest/checkcorrupt",
+        Fixture,
+        NULL,
+        fixture_set_up,
+        check_corrupt,
+        fixture_tear_down
+        );
+
+    g_test_add(
+        "/bbgedacachetest/checkroundtrip",
+        Fixture,
+        NULL,
+        fixture_set_up,
+        check_round_trip,
+        fixture_tear_down
+        );
+
+    g_test_add(
+        "/bbgedacachetest/checkstale",
+        Fixture,
+        NULL,
+        fixture_set_up,
+        check_stale,
+        fixture_tear_down
+        );
+
+    g_test_add(
+        "/bbgedacachetest/checkperformance",
+        Fixture,
+        NULL,
+        fixture_set_up,
+        check_performance,
+        fixture_tear_down
+        );
+
+    return g_test_run();
+}
@@ -0,0 +1,563 @@
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtk/gtk.h>
+#include <string.h>
+#include <glib/gstdio.h>
+#include <bbschematic.h>
+#include <bbelectrical.h>
+#include <gedaplugin/bbgedajournal.h>
+#include <gedaplugin/bbgedareader.h>
+
+
+static const gchar *records =
+    "v 20191003 2\n"
+    "A 100 100 200 0 90 3 10 0 0 -1 -1\n"
+    "B 100 200 1000 500 3 10 0 0 -1 -1 2 10 45 100 135 100\n"
+    "L 100 200 300 400 3 10 0 0 -1 -1\n"
+    "N 0 0 1000 0 4\n"
+    "P 0 0 300 0 1 0 1\n"
+    "T -100 -200 9 12 1 0 90 3 2\n"
+    "first line\n"
+    "second line\n"
+    "V 500 500 250 3 10 0 0 -1 -1 0 -1 -1 -1 -1 -1\n";
+
+
+static const gchar *attributed_records =
+    "v 20191003 2\n"
+    "N 0 0 1000 0 4\n"
+    "{\n"
+    "T 100 100 5 10 1 1 0 0 1\n"
+    "netname=one\n"
+    "}\n";
+
+
+/**
+ * A temporary document
+ */
+typedef struct
+{
+    gchar *folder;
+    GFile *file;
+    GFile *journal_file;
+    BbGedaReader *reader;
+}
+Fixture;
+
+
+static void
+fixture_set_up(Fixture *fixture, gconstpointer user_data)
+{
+    GError *error = NULL;
+
+    fixture->folder = g_dir_make_tmp("bbgedajournaltest-XXXXXX", &error);
+    g_assert_no_error(error);
+
+    gchar *path = g_build_filename(fixture->folder, "test.sch", NULL);
+    fixture->file = g_file_new_for_path(path);
+    g_free(path);
+
+    path = g_build_filename(fixture->folder, ".test.sch.bbjournal", NULL);
+    fixture->journal_file = g_file_new_for_path(path);
+    g_free(path);
+
+    fixture->reader = BB_GEDA_READER(g_object_new(BB_TYPE_GEDA_READER, NULL));
+
+    g_file_replace_contents(fixture->file, records, strlen(records), NULL, FALSE, 0, NULL, NULL, &error);
+    g_assert_no_error(error);
+}
+
+
+static void
+fixture_tear_down(Fixture *fixture, gconstpointer user_data)
+{
+    g_file_delete(fixture->journal_file, NULL, NULL);
+    g_file_delete(fixture->file, NULL, NULL);
+    g_rmdir(fixture->folder);
+
+    g_object_unref(fixture->reader);
+    g_object_unref(fixture->journal_file);
+    g_object_unref(fixture->file);
+    g_free(fixture->folder);
+}
+
+
+static BbSchematic*
+load(Fixture *fixture)
+{
+    GError *error = NULL;
+
+    BbSchematic *schematic = bb_geda_reader_read_file(fixture->reader, fixture->file, NULL, &error);
+
+    g_assert_no_error(error);
+    g_assert_nonnull(schematic);
+
+    return schematic;
+}
+
+
+/**
+ * Replay the journal onto the saved document
+ */
+static BbSchematic*
+recover(Fixture *fixture)
+{
+    GError *error = NULL;
+    BbSchematic *saved = load(fixture);
+
+    BbSchematic *recovered = bb_geda_journal_recover(fixture->file, saved, &error);
+
+    g_assert_no_error(error);
+    g_object_unref(saved);
+
+    return recovered;
+}
+
+
+static gchar*
+write_schematic(BbSchematic *schematic)
+{
+    GError *error = NULL;
+    GOutputStream *stream = g_memory_output_stream_new_resizable();
+
+    bb_schematic_write(schematic, stream, NULL, &error);
+    g_output_stream_write_all(stream, "", 1, NULL, NULL, &error);
+    g_output_stream_close(stream, NULL, &error);
+    g_assert_no_error(error);
+
+    gchar *contents = g_memory_output_stream_steal_data(G_MEMORY_OUTPUT_STREAM(stream));
+
+    g_object_unref(stream);
+
+    return contents;
+}
+
+
+static void
+assert_schematics_equal(BbSchematic *expected, BbSchematic *actual)
+{
+    gchar *expected_text = write_schematic(expected);
+    gchar *actual_text = write_schematic(actual);
+
+    g_assert_cmpstr(expected_text, ==, actual_text);
+
+    g_free(actual_text);
+    g_free(expected_text);
+}
+
+
+static gboolean
+is_item(gpointer item, gpointer target)
+{
+    return item == target;
+}
+
+
+static gboolean
+is_nth_item(gpointer item, int *countdown)
+{
+    return (*countdown)-- == 0;
+}
+
+
+static gboolean
+get_item_lambda(BbGedaItem *item, BbGedaItem **result)
+{
+    *result = g_object_ref(item);
+
+    return FALSE;
+}
+
+
+static void
+add_attribute_lambda(BbAttribute *attribute, GPtrArray *attributes)
+{
+    g_ptr_array_add(attributes, g_object_ref(attribute));
+}
+
+
+/**
+ * Check the only item of a schematic is a net with the attribute from attributed_records
+ */
+static void
+assert_attributed(BbSchematic *schematic)
+{
+    BbGedaItem *net = NULL;
+    int countdown = 0;
+
+    bb_schematic_foreach_query(schematic, (BbPred) is_nth_item, &countdown, (BbQueryFunc) get_item_lambda, &net);
+    g_assert_true(BB_IS_ELECTRICAL(net));
+
+    GPtrArray *attributes = g_ptr_array_new_with_free_func((GDestroyNotify) g_object_unref);
+
+    bb_electrical_foreach(BB_ELECTRICAL(net), (GFunc) add_attribute_lambda, attributes);
+    g_assert_cmpuint(attributes->len, ==, 1);
+
+    gchar *name = bb_attribute_get_name(g_ptr_array_index(attributes, 0));
+    gchar *value = bb_attribute_get_value(g_ptr_array_index(attributes, 0));
+
+    g_assert_cmpstr(name, ==, "netname");
+    g_assert_cmpstr(value, ==, "one");
+
+    g_free(value);
+    g_free(name);
+    g_ptr_array_unref(attributes);
+    g_object_unref(net);
+}
+
+
+static void
+translate_lambda(BbGedaItem *item, gpointer user_data)
+{
+    bb_geda_item_translate(item, 100, -100);
+}
+
+
+/**
+ * Add, remove and change items, as the editor would
+ */
+static void
+edit(BbSchematic *schematic)
+{
+    BbGedaItem *net = NULL;
+    int countdown = 3;
+
+    bb_schematic_foreach_query(schematic, (BbPred) is_nth_item, &countdown, (BbQueryFunc) get_item_lambda, &net);
+    g_assert_nonnull(net);
+
+    BbGedaItem *copy = bb_geda_item_clone(net);
+
+    bb_geda_item_translate(copy, 500, 500);
+    bb_schematic_add_item(schematic, copy);
+    bb_geda_item_translate(copy, 10, 10);
+
+    bb_schematic_foreach(schematic, (GFunc) translate_lambda, NULL);
+
+    countdown = 1;
+    bb_schematic_foreach_remove(schematic, (BbPred) is_nth_item, &countdown);
+
+    /* Added and removed before the flush */
+
+    BbGedaItem *transient = bb_geda_item_clone(net);
+
+    bb_schematic_add_item(schematic, transient);
+    bb_schematic_foreach_remove(schematic, is_item, transient);
+
+    g_object_unref(transient);
+    g_object_unref(copy);
+    g_object_unref(net);
+}
+
+
+void
+check_attributes(Fixture *fixture, gconstpointer user_data)
+{
+    GError *error = NULL;
+
+    g_file_replace_contents(
+        fixture->file,
+        attributed_records,
+        strlen(attributed_records),
+        NULL,
+        FALSE,
+        0,
+        NULL,
+        NULL,
+        &error
+        );
+    g_assert_no_error(error);
+
+    BbSchematic *schematic = load(fixture);
+    assert_attributed(schematic);
+
+    /* Snapshot entries */
+
+    BbGedaJournal *journal = bb_geda_journal_new(schematic, fixture->file, TRUE, &error);
+    g_assert_no_error(error);
+
+    BbSchematic *recovered = recover(fixture);
+
+    g_assert_nonnull(recovered);
+    assert_attributed(recovered);
+    g_clear_object(&recovered);
+
+    /* Change entries */
+
+    bb_schematic_foreach(schematic, (GFunc) translate_lambda, NULL);
+    bb_geda_journal_flush(journal, &error);
+    g_assert_no_error(error);
+
+    recovered = recover(fixture);
+
+    g_assert_nonnull(recovered);
+    assert_schematics_equal(schematic, recovered);
+    assert_attributed(recovered);
+
+    bb_geda_journal_free(journal);
+    g_object_unref(recovered);
+    g_object_unref(schematic);
+}
+
+
+void
+check_compact(Fixture *fixture, gconstpointer user_data)
+{
+    GError *error = NULL;
+    BbSchematic *schematic = load(fixture);
+    BbGedaJournal *journal = bb_geda_journal_new(schematic, fixture->file, FALSE, &error);
+
+    g_assert_no_error(error);
+
+    /* Enough entries to exceed the minimum compaction length many times over */
+
+    for (int count = 0; count < 10000; count++)
+    {
+        bb_schematic_foreach(schematic, (GFunc) translate_lambda, NULL);
+        bb_geda_journal_flush(journal, &error);
+        g_assert_no_error(error);
+    }
+
+    GFileInfo *info = g_file_query_info(fixture->journal_file, G_FILE_ATTRIBUTE_STANDARD_SIZE, 0, NULL, &error);
+
+    g_assert_no_error(error);
+    g_assert_cmpuint(g_file_info_get_size(info), <, 2 * 256 * 1024);
+
+    BbSchematic *recovered = recover(fixture);
+
+    g_assert_nonnull(recovered);
+    assert_schematics_equal(schematic, recovered);
+
+    bb_geda_journal_free(journal);
+    g_object_unref(info);
+    g_object_unref(recovered);
+    g_object_unref(schematic);
+}
+
+
+void
+check_recover(Fixture *fixture, gconstpointer user_data)
+{
+    GError *error = NULL;
+    BbSchematic *schematic = load(fixture);
+    BbGedaJournal *journal = bb_geda_journal_new(schematic, fixture->file, FALSE, &error);
+
+    g_assert_no_error(error);
+
+    /* An empty journal has nothing to recover */
+
+    BbSchematic *recovered = recover(fixture);
+
+    g_assert_null(recovered);
+
+    edit(schematic);
+    bb_geda_journal_flush(journal, &error);
+    g_assert_no_error(error);
+
+    recovered = recover(fixture);
+
+    g_assert_nonnull(recovered);
+    assert_schematics_equal(schematic, recovered);
+    g_clear_object(&recovered);
+
+    /* Edits to the recovered schematic continue the journal */
+
+    BbSchematic *saved = load(fixture);
+
+    recovered = bb_geda_journal_recover(fixture->file, saved, &error);
+    g_assert_no_error(error);
+
+    bb_geda_journal_free(journal);
+    g_assert_false(g_file_query_exists(fixture->journal_file, NULL));
+
+    journal = bb_geda_journal_new(recovered, fixture->file, TRUE, &error);
+    g_assert_no_error(error);
+
+    edit(recovered);
+    edit(schematic);
+    bb_geda_journal_flush(journal, &error);
+    g_assert_no_error(error);
+
+    BbSchematic *second = recover(fixture);
+
+    g_assert_nonnull(second);
+    assert_schematics_equal(schematic, second);
+
+    bb_geda_journal_free(journal);
+    g_object_unref(second);
+    g_object_unref(recovered);
+    g_object_unref(saved);
+    g_object_unref(schematic);
+}
+
+
+void
+check_saved(Fixture *fixture, gconstpointer user_data)
+{
+    GError *error = NULL;
+    BbSchematic *schematic = load(fixture);
+    BbGedaJournal *journal = bb_geda_journal_new(schematic, fixture->file, FALSE, &error);
+
+    g_assert_no_error(error);
+
+    edit(schematic);
+    bb_geda_journal_flush(journal, &error);
+    g_assert_no_error(error);
+
+    gulong edit_count = bb_geda_journal_get_edit_count(journal);
+    gchar *items = write_schematic(schematic);
+    gchar *contents = g_strconcat("v 20191003 2\n", items, NULL);
+
+    g_file_replace_contents(fixture->file, contents, strlen(contents), NULL, FALSE, 0, NULL, NULL, &error);
+    g_assert_no_error(error);
+
+    /* An edit while saving remains in the journal */
+
+    edit(schematic);
+
+    bb_geda_journal_saved(journal, fixture->file, edit_count, &error);
+    g_assert_no_error(error);
+
+    BbSchematic *recovered = recover(fixture);
+
+    g_assert_nonnull(recovered);
+    assert_schematics_equal(schematic, recovered);
+
+    /* A stale journal is ignored */
+
+    g_file_replace_contents(fixture->file, records, strlen(records), NULL, FALSE, 0, NULL, NULL, &error);
+    g_assert_no_error(error);
+
+    g_clear_object(&recovered);
+    recovered = recover(fixture);
+
+    g_assert_null(recovered);
+
+    bb_geda_journal_free(journal);
+    g_free(contents);
+    g_free(items);
+    g_object_unref(schematic);
+}
+
+
+void
+check_truncated(Fixture *fixture, gconstpointer user_data)
+{
+    GError *error = NULL;
+    BbSchematic *schematic = load(fixture);
+    BbGedaJournal *journal = bb_geda_journal_new(schematic, fixture->file, FALSE, &error);
+
+    g_assert_no_error(error);
+
+    edit(schematic);
+    bb_geda_journal_flush(journal, &error);
+    g_assert_no_error(error);
+
+    gchar *expected = write_schematic(schematic);
+    int countdown = 2;
+
+    bb_schematic_foreach_modify(schematic, (BbPred) is_nth_item, &countdown, (BbApplyFunc) translate_lambda, NULL);
+    bb_geda_journal_flush(journal, &error);
+    g_assert_no_error(error);
+
+    /* A crash during the last append leaves an incomplete entry */
+
+    gchar *path = g_file_get_path(fixture->journal_file);
+    gchar *contents = NULL;
+    gsize length = 0;
+
+    g_file_get_contents(path, &contents, &length, &error);
+    g_assert_no_error(error);
+
+    gchar *last = g_strrstr(contents, "\n=");
+    g_assert_nonnull(last);
+
+    g_file_set_contents(path, contents, last - contents + 4, &error);
+    g_assert_no_error(error);
+
+    BbSchematic *recovered = recover(fixture);
+
+    g_assert_nonnull(recovered);
+
+    /* Every entry before the incomplete entry is replayed */
+
+    gchar *actual = write_schematic(recovered);
+
+    g_assert_cmpstr(expected, ==, actual);
+
+    bb_geda_journal_free(journal);
+    g_free(actual);
+    g_free(contents);
+    g_free(path);
+    g_free(expected);
+    g_object_unref(recovered);
+    g_object_unref(schematic);
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add(
+        "/bbgedajournaltest/checkattributes",
+        Fixture,
+        NULL,
+        fixture_set_up,
+        check_attributes,
+        fixture_tear_down
+        );
+
+    g_test_add(
+        "/bbgedajournaltest/checkcompact",
+        Fixture,
+        NULL,
+        fixture_set_up,
+        check_compact,
+        fixture_tear_down
+        );
+
+    g_test_add(
+        "/bbgedajournaltest/checkrecover",
+        Fixture,
+        NULL,
+        fixture_set_up,
+        check_recover,
+        fixture_tear_down
+        );
+
+    g_test_add(
+        "/bbgedajournaltest/checksaved",
+        Fixture,
+        NULL,
+        fixture_set_up,
+        check_saved,
+        fixture_tear_down
+        );
+
+    g_test_add(
+        "/bbgedajournaltest/checktruncated",
+        Fixture,
+        NULL,
+        fixture_set_up,
+        check_truncated,
+        fixture_tear_down
+        );
+
+    return g_test_run();
+}
@@ -0,0 +1,458 @@
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtk/gtk.h>
+#include <math.h>
+#include "bbangle.h"
+#include "bbhatch.h"
+#include "bbline.h"
+#include "bbpoint.h"
+
+
+#define TOLERANCE (1e-6)
+
+
+/*
+ * The previous implementation of bb_hatch_polygon(), kept as a reference for the results and as the baseline for the
+ * benchmark. The status comparison uses doubles, since the original truncated the difference to an int.
+ */
+
+typedef struct
+{
+    double x;
+    double y1;
+    double m1;
+    double b1;
+} ReferenceStatus;
+
+
+typedef struct
+{
+    ReferenceStatus status;
+    int y0;
+} ReferenceEvent;
+
+
+static int
+reference_compare_events(ReferenceEvent *a, ReferenceEvent *b)
+{
+    return a->y0 - b->y0;
+}
+
+
+static int
+reference_compare_statuses(ReferenceStatus *a, ReferenceStatus *b)
+{
+    return (a->x > b->x) - (a->x < b->x);
+}
+
+
+static void
+reference_hatch_polygon(GArray *points, gint angle, gint pitch, GArray *lines)
+{
+    GArray *events = g_array_new(FALSE, FALSE, sizeof(ReferenceEvent));
+    GArray *points2 = g_array_sized_new(FALSE, FALSE, sizeof(BbPoint), points->len);
+    GArray *status = g_array_new(FALSE, FALSE, sizeof(ReferenceStatus));
+
+    BbMatrix transform;
+
+    bb_matrix_init(&transform);
+    bb_matrix_rotate(&transform, bb_angle_to_radians(-angle));
+
+    g_array_append_vals(points2, points->data, points->len);
+    bb_point_transform_array(points2->len, &g_array_index(points2, BbPoint, 0), &transform);
+
+    if (points2->len > 1)
+    {
+        BbPoint *p0 = &g_array_index(points2, BbPoint, points2->len-1);
+
+        for (int index = 0; index < points2->len; index++)
+        {
+            BbPoint *p1 = &g_array_index(points2, BbPoint, index);
+
+            if ( p0->y != p1->y )
+            {
+                ReferenceEvent event =
+                {
+                    .y0 = MIN(p0->y, p1->y),
+                    .status.y1 = MAX(p0->y, p1->y),
+                    .status.m1 = (gdouble)( p1->x - p0->x ) / (gdouble)( p1->y - p0->y ),
+                    .status.b1 = p0->x - event.status.m1 * p0->y
+                };
+
+                g_array_append_val(events, event);
+            }
+
+            p0 = p1;
+        }
+    }
+
+    g_array_sort(events, (GCompareFunc) reference_compare_events);
+
+    BbBounds bounds =
+    {
+        .min_x = G_MAXINT,
+        .min_y = G_MAXINT,
+        .max_x = G_MININT,
+        .max_y = G_MININT
+    };
+
+    BbMatrix inverse;
+    bb_matrix_init(&inverse);
+    bb_matrix_rotate(&inverse, bb_angle_to_radians(angle));
+
+    bb_points_calculate_bounds(points2->len, (BbPoint*) points2->data, &bounds);
+
+    double delta = bounds.max_y - bounds.min_y;
+    double sweep_y = bounds.min_y + ((delta - (floor((delta - pitch) / pitch) * pitch)) / 2.0);
+
+    while (events->len > 0 || status->len > 0)
+    {
+        int index = 0;
+
+        while (index < events->len)
+        {
+            ReferenceEvent *event = &g_array_index(events, ReferenceEvent, index);
+
+            if (sweep_y >= event->y0)
+            {
+                ReferenceStatus st = event->status;
+
+                g_array_append_val(status, st);
+                g_array_remove_index(events, index);
+            }
+            else
+            {
+                index++;
+            }
+        }
+
+        for (index = status->len - 1; index >= 0; index--)
+        {
+            ReferenceStatus *st = &g_array_index(status, ReferenceStatus, index);
+
+            if (sweep_y >= st->y1)
+            {
+                g_array_remove_index_fast(status, index);
+            }
+        }
+
+        for (index = 0; index < status->len; index++)
+        {
+            ReferenceStatus *st = &g_array_index(status, ReferenceStatus, index);
+
+            st->x = st->m1 * sweep_y + st->b1;
+        }
+
+        g_array_sort(status, (GCompareFunc) reference_compare_statuses);
+
+        for (index = 0; index+1 < status->len; index += 2)
+        {
+            BbLine line =
+            {
+                .x[0] = g_array_index(status, ReferenceStatus, index).x,
+                .y[0] = sweep_y,
+                .x[1] = g_array_index(status, ReferenceStatus, index+1).x,
+                .y[1] = sweep_y
+            };
+
+            bb_line_transform(&line, &inverse);
+
+            g_array_append_val(lines, line);
+        }
+
+        sweep_y += pitch;
+    }
+
+    g_array_free(events, TRUE);
+    g_array_free(points2, TRUE);
+    g_array_free(status, TRUE);
+}
+
+
+static void
+append_point(GArray *points, double x, double y)
+{
+    BbPoint point = { .x = x, .y = y };
+
+    g_array_append_val(points, point);
+}
+
+
+static void
+assert_lines_equal(GArray *expected, GArray *actual)
+{
+    g_assert_cmpuint(expected->len, ==, actual->len);
+
+    for (int index = 0; index < expected->len; index++)
+    {
+        BbLine *e = &g_array_index(expected, BbLine, index);
+        BbLine *a = &g_array_index(actual, BbLine, index);
+
+        g_assert_cmpfloat_with_epsilon(e->x[0], a->x[0], TOLERANCE);
+        g_assert_cmpfloat_with_epsilon(e->y[0], a->y[0], TOLERANCE);
+        g_assert_cmpfloat_with_epsilon(e->x[1], a->x[1], TOLERANCE);
+        g_assert_cmpfloat_with_epsilon(e->y[1], a->y[1], TOLERANCE);
+    }
+}
+
+
+static void
+check_against_reference(GArray *points, gint angle, gint pitch)
+{
+    GArray *expected = g_array_new(FALSE, FALSE, sizeof(BbLine));
+    GArray *actual = g_array_new(FALSE, FALSE, sizeof(BbLine));
+
+    reference_hatch_polygon(points, angle, pitch, expected);
+    bb_hatch_polygon(points, angle, pitch, actual);
+
+    assert_lines_equal(expected, actual);
+
+    g_array_free(expected, TRUE);
+    g_array_free(actual, TRUE);
+}
+
+
+/**
+ * Create a polygon with V-shaped notches along the top, exercising concave shapes with many active edges
+ */
+static GArray*
+create_comb(int notches, int width, int height)
+{
+    GArray *points = g_array_new(FALSE, FALSE, sizeof(BbPoint));
+
+    append_point(points, 0, 0);
+    append_point(points, 2 * notches * width, 0);
+
+    for (int notch = notches - 1; notch >= 0; notch--)
+    {
+        int x = 2 * notch * width;
+
+        append_point(points, x + width, height);
+        append_point(points, x + width / 2, height / 4);
+        append_point(points, x, height);
+    }
+
+    return points;
+}
+
+
+/**
+ * Create a convex polygon with vertices on a circle
+ */
+static GArray*
+create_convex(int count, double radius)
+{
+    GArray *points = g_array_new(FALSE, FALSE, sizeof(BbPoint));
+
+    for (int index = 0; index < count; index++)
+    {
+        double angle = 2.0 * M_PI * index / count;
+
+        append_point(points, round(radius * cos(angle)), round(radius * sin(angle)));
+    }
+
+    return points;
+}
+
+
+void
+check_box()
+{
+    for (int count = 0; count < 1000; count++)
+    {
+        int x[2] = { g_test_rand_int_range(-10000, 10000), g_test_rand_int_range(-10000, 10000) };
+        int y[2] = { g_test_rand_int_range(-10000, 10000), g_test_rand_int_range(-10000, 10000) };
+        int angle = g_test_rand_int_range(0, 360);
+        int pitch = g_test_rand_int_range(10, 1000);
+
+        GArray *points = g_array_new(FALSE, FALSE, sizeof(BbPoint));
+
+        append_point(points, x[0], y[0]);
+        append_point(points, x[1], y[0]);
+        append_point(points, x[1], y[1]);
+        append_point(points, x[0], y[1]);
+
+        GArray *expected = g_array_new(FALSE, FALSE, sizeof(BbLine));
+        GArray *actual = g_array_new(FALSE, FALSE, sizeof(BbLine));
+
+        reference_hatch_polygon(points, angle, pitch, expected);
+        bb_hatch_box(x, y, angle, pitch, actual);
+
+        assert_lines_equal(expected, actual);
+
+        g_array_free(actual, TRUE);
+        g_array_free(expected, TRUE);
+        g_array_free(points, TRUE);
+    }
+}
+
+
+void
+check_comb()
+{
+    for (int count = 0; count < 100; count++)
+    {
+        GArray *points = create_comb(
+            g_test_rand_int_range(1, 50),
+            g_test_rand_int_range(2, 200),
+            g_test_rand_int_range(4, 2000)
+            );
+
+        check_against_reference(
+            points,
+            g_test_rand_int_range(0, 360),
+            g_test_rand_int_range(1, 100)
+            );
+
+        g_array_free(points, TRUE);
+    }
+}
+
+
+void
+check_convex()
+{
+    for (int count = 0; count < 100; count++)
+    {
+        GArray *points = create_convex(
+            g_test_rand_int_range(3, 100),
+            g_test_rand_int_range(10, 10000)
+            );
+
+        check_against_reference(
+            points,
+            g_test_rand_int_range(0, 360),
+            g_test_rand_int_range(1, 100)
+            );
+
+        g_array_free(points, TRUE);
+    }
+}
+
+
+void
+check_degenerate()
+{
+    GArray *lines = g_array_new(FALSE, FALSE, sizeof(BbLine));
+    GArray *points = g_array_new(FALSE, FALSE, sizeof(BbPoint));
+
+    bb_hatch_polygon(points, 0, 10, lines);
+    g_assert_cmpuint(0, ==, lines->len);
+
+    append_point(points, 100, 100);
+    bb_hatch_polygon(points, 45, 10, lines);
+    g_assert_cmpuint(0, ==, lines->len);
+
+    append_point(points, 200, 100);
+    bb_hatch_polygon(points, 0, 10, lines);
+    g_assert_cmpuint(0, ==, lines->len);
+
+    g_array_free(points, TRUE);
+    g_array_free(lines, TRUE);
+}
+
+
+/**
+ * Compare the time taken by the reference and the current implementation
+ *
+ * Only runs in performance mode: gtester -m perf bbhatchtest
+ */
+void
+check_performance()
+{
+    if (!g_test_perf())
+    {
+        g_test_skip("Performance tests only run with -m perf");
+        return;
+    }
+
+    struct
+    {
+        const char *name;
+        GArray *points;
+    }
+    shapes[] =
+    {
+        { "comb", create_comb(200, 50, 100000) },
+        { "convex", create_convex(1000, 100000.0) }
+    };
+
+    GArray *lines = g_array_new(FALSE, FALSE, sizeof(BbLine));
+
+    for (int index = 0; index < G_N_ELEMENTS(shapes); index++)
+    {
+        g_array_set_size(lines, 0);
+        g_test_timer_start();
+        reference_hatch_polygon(shapes[index].points, 45, 10, lines);
+        double reference = g_test_timer_elapsed();
+
+        g_array_set_size(lines, 0);
+        g_test_timer_start();
+        bb_hatch_polygon(shapes[index].points, 45, 10, lines);
+        double current = g_test_timer_elapsed();
+
+        g_test_message(
+            "%s: %u lines, reference %.3f ms, current %.3f ms",
+            shapes[index].name,
+            lines->len,
+            1000.0 * reference,
+            1000.0 * current
+            );
+
+        g_test_minimized_result(current, "%s %.6f seconds", shapes[index].name, current);
+
+        g_array_free(shapes[index].points, TRUE);
+    }
+
+    g_array_free(lines, TRUE);
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func(
+        "/bbhatchtest/checkbox",
+        check_box
+        );
+
+    g_test_add_func(
+        "/bbhatchtest/checkcomb",
+        check_comb
+        );
+
+    g_test_add_func(
+        "/bbhatchtest/checkconvex",
+        check_convex
+        );
+
+    g_test_add_func(
+        "/bbhatchtest/checkdegenerate",
+        check_degenerate
+        );
+
+    g_test_add_func(
+        "/bbhatchtest/checkperformance",
+        check_performance
+        );
+
+    return g_test_run();
+}
@@ -0,0 +1,182 @@
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtk/gtk.h>
+#include <bberror.h>
+#include <bbparams.h>
+
+
+void
+check_copy(void)
+{
+    BbParams *params = bb_params_new_with_line("L 100 200 -300 400", NULL);
+    BbParams *copy = bb_params_copy(params);
+
+    bb_params_free(params);
+
+    g_assert_cmpstr(bb_params_get_token(copy), ==, "L");
+    g_assert_cmpint(bb_params_get_int(copy, 3, NULL), ==, -300);
+    g_assert_cmpint(bb_params_get_int(copy, 4, NULL), ==, 400);
+
+    bb_params_free(copy);
+}
+
+
+void
+check_errors(void)
+{
+    GError *error = NULL;
+    BbParams *params = bb_params_new_with_line("T 1 abc 99999999999", NULL);
+
+    bb_params_get_int(params, 2, &error);
+    g_assert_error(error, BB_ERROR_DOMAIN, ERROR_INTEGER_EXPECTED);
+    g_clear_error(&error);
+
+    bb_params_get_int(params, 3, &error);
+    g_assert_error(error, BB_ERROR_DOMAIN, ERROR_VALUE_OUT_OF_RANGE);
+    g_clear_error(&error);
+
+    bb_params_get_int(params, 4, &error);
+    g_assert_error(error, BB_ERROR_DOMAIN, ERROR_TOO_FEW_PARAMETERS);
+    g_clear_error(&error);
+
+    bb_params_get_string(params, 4, &error);
+    g_assert_error(error, BB_ERROR_DOMAIN, ERROR_TOO_FEW_PARAMETERS);
+    g_clear_error(&error);
+
+    bb_params_free(params);
+}
+
+
+void
+check_in_place(void)
+{
+    gchar line[] = "B 0 1 2 3";
+    BbParams *params = bb_params_new_in_place(line, sizeof(line) - 1, NULL);
+
+    g_assert_true(bb_params_token_matches(params, "B"));
+
+    for (int index = 1; index <= 4; index++)
+    {
+        g_assert_cmpint(bb_params_get_int(params, index, NULL), ==, index - 1);
+        g_assert_true(bb_params_get_string(params, index, NULL) > line);
+        g_assert_true(bb_params_get_string(params, index, NULL) < line + sizeof(line));
+    }
+
+    bb_params_free(params);
+}
+
+
+void
+check_split(void)
+{
+    gchar *lines[] =
+    {
+        "v 20191003 2",
+        "T 100 200 5 10 1 1 0 0 1",
+        "a  b ",
+        " c",
+        "{",
+        NULL
+    };
+
+    for (gchar **line = lines; *line != NULL; line++)
+    {
+        gchar **expected = g_strsplit(*line, " ", 0);
+        BbParams *params = bb_params_new_with_line(*line, NULL);
+        int count = g_strv_length(expected);
+
+        g_assert_cmpstr(bb_params_get_token(params), ==, expected[0]);
+
+        for (int index = 0; index < count; index++)
+        {
+            g_assert_cmpstr(bb_params_get_string(params, index, NULL), ==, expected[index]);
+        }
+
+        g_assert_null(bb_params_get_string(params, count, NULL));
+
+        bb_params_free(params);
+        g_strfreev(expected);
+    }
+}
+
+
+void
+check_values(void)
+{
+    const gchar *tokens[] = { "C", NULL, NULL, NULL, "resistor-1.sym" };
+    int values[] = { 0, 1000, -2000, G_MININT, 0 };
+
+    BbParams *params = bb_params_new_with_values(G_N_ELEMENTS(tokens), tokens, values);
+
+    g_assert_true(bb_params_token_matches(params, "C"));
+    g_assert_cmpint(bb_params_get_int(params, 1, NULL), ==, 1000);
+    g_assert_cmpint(bb_params_get_int(params, 2, NULL), ==, -2000);
+    g_assert_cmpint(bb_params_get_int(params, 3, NULL), ==, G_MININT);
+    g_assert_cmpstr(bb_params_get_string(params, 4, NULL), ==, "resistor-1.sym");
+
+    /* Integer parameters are formatted on request, and remain integers */
+
+    g_assert_cmpstr(bb_params_get_string(params, 2, NULL), ==, "-2000");
+    g_assert_cmpint(bb_params_get_int(params, 2, NULL), ==, -2000);
+
+    BbParams *copy = bb_params_copy(params);
+
+    bb_params_free(params);
+
+    g_assert_cmpstr(bb_params_get_string(copy, 1, NULL), ==, "1000");
+    g_assert_cmpint(bb_params_get_int(copy, 3, NULL), ==, G_MININT);
+    g_assert_cmpstr(bb_params_get_string(copy, 4, NULL), ==, "resistor-1.sym");
+    g_assert_null(bb_params_get_string(copy, 5, NULL));
+
+    bb_params_free(copy);
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func(
+        "/bbparamstest/checkcopy",
+        check_copy
+        );
+
+    g_test_add_func(
+        "/bbparamstest/checkerrors",
+        check_errors
+        );
+
+    g_test_add_func(
+        "/bbparamstest/checkinplace",
+        check_in_place
+        );
+
+    g_test_add_func(
+        "/bbparamstest/checksplit",
+        check_split
+        );
+
+    g_test_add_func(
+        "/bbparamstest/checkvalues",
+        check_values
+        );
+
+    return g_test_run();
+}
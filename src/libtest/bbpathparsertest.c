@@ -0,0 +1,232 @@
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtk/gtk.h>
+#include <bbpathparser.h>
+
+
+/**
+ * Check the points of a path against the expected absolute coordinates
+ */
+static void
+assert_points(BbPathData *data, int count, const int expected[count][2])
+{
+    g_assert_cmpuint(bb_path_data_get_point_count(data), ==, count);
+
+    for (int index = 0; index < count; index++)
+    {
+        int x;
+        int y;
+
+        bb_path_data_get_point(data, index, &x, &y);
+
+        g_assert_cmpint(x, ==, expected[index][0]);
+        g_assert_cmpint(y, ==, expected[index][1]);
+    }
+}
+
+
+void
+check_absolute()
+{
+    GError *error = NULL;
+    BbPathData *data = bb_path_parser_parse("M 100,200 L 300,400 500,600 C 1,2 3,4 5,6 Z", &error);
+
+    g_assert_no_error(error);
+    g_assert_nonnull(data);
+
+    BbPathOp ops[] =
+    {
+        BB_PATH_OP_MOVE_TO,
+        BB_PATH_OP_LINE_TO,
+        BB_PATH_OP_LINE_TO,
+        BB_PATH_OP_CURVE_TO,
+        BB_PATH_OP_CLOSE_PATH
+    };
+
+    g_assert_cmpuint(bb_path_data_get_command_count(data), ==, G_N_ELEMENTS(ops));
+
+    for (int index = 0; index < G_N_ELEMENTS(ops); index++)
+    {
+        g_assert_cmpint(bb_path_data_get_command(data, index), ==, ops[index]);
+    }
+
+    const int points[][2] = { { 100, 200 }, { 300, 400 }, { 500, 600 }, { 1, 2 }, { 3, 4 }, { 5, 6 } };
+
+    assert_points(data, G_N_ELEMENTS(points), points);
+
+    bb_path_data_free(data);
+}
+
+
+void
+check_bounds()
+{
+    struct
+    {
+        const char *path;
+        int min_x;
+        int min_y;
+        int max_x;
+        int max_y;
+    }
+    tests[] =
+    {
+        { "M 10,20 L 30,-5 Z",                 10,  -5,  30,  20 },
+        { "M 0,0 C 0,100 100,100 100,0",         0,   0, 100,  75 },
+        { "M 0,0 C 100,0 100,100 0,100",         0,   0,  75, 100 },
+        { "M 0,0 L 50,50 Z C 0,-40 0,-40 0,0",   0, -30,  50,  50 }
+    };
+
+    for (int index = 0; index < G_N_ELEMENTS(tests); index++)
+    {
+        GError *error = NULL;
+        BbPathData *data = bb_path_parser_parse(tests[index].path, &error);
+
+        g_assert_no_error(error);
+        g_assert_nonnull(data);
+
+        BbBounds bounds;
+
+        bb_path_data_calculate_bounds(data, &bounds);
+
+        g_assert_cmpint(bounds.min_x, ==, tests[index].min_x);
+        g_assert_cmpint(bounds.min_y, ==, tests[index].min_y);
+        g_assert_cmpint(bounds.max_x, ==, tests[index].max_x);
+        g_assert_cmpint(bounds.max_y, ==, tests[index].max_y);
+
+        bb_path_data_free(data);
+    }
+
+    BbPathData *empty = bb_path_data_new();
+    BbBounds bounds;
+
+    bb_path_data_calculate_bounds(empty, &bounds);
+
+    g_assert_true(bb_bounds_is_empty(&bounds));
+
+    bb_path_data_free(empty);
+}
+
+
+void
+check_error()
+{
+    GError *error = NULL;
+    BbPathData *data = bb_path_parser_parse("L 100,200", &error);
+
+    g_assert_nonnull(error);
+    g_assert_null(data);
+
+    g_clear_error(&error);
+}
+
+
+void
+check_relative()
+{
+    GError *error = NULL;
+    BbPathData *data = bb_path_parser_parse("m 100,200 l 10,0 0,10 c 1,1 2,2 3,3 z m 5,5 l -5,0", &error);
+
+    g_assert_no_error(error);
+    g_assert_nonnull(data);
+
+    /* After closing the subpath, the current point returns to the start of the subpath */
+
+    const int points[][2] =
+    {
+        { 100, 200 },
+        { 110, 200 },
+        { 110, 210 },
+        { 111, 211 },
+        { 112, 212 },
+        { 113, 213 },
+        { 105, 205 },
+        { 100, 205 }
+    };
+
+    assert_points(data, G_N_ELEMENTS(points), points);
+
+    bb_path_data_free(data);
+}
+
+
+void
+check_transform()
+{
+    GError *error = NULL;
+    BbPathData *data = bb_path_parser_parse("M 100,200 L 300,200 L 300,400 z", &error);
+
+    g_assert_no_error(error);
+    g_assert_nonnull(data);
+
+    BbPathData *copy = bb_path_data_copy(data);
+
+    bb_path_data_translate(data, 10, -10);
+
+    const int translated[][2] = { { 110, 190 }, { 310, 190 }, { 310, 390 } };
+    assert_points(data, G_N_ELEMENTS(translated), translated);
+
+    bb_path_data_mirror_x(data, 0);
+    bb_path_data_mirror_y(data, 100);
+
+    const int mirrored[][2] = { { -110, 10 }, { -310, 10 }, { -310, -190 } };
+    assert_points(data, G_N_ELEMENTS(mirrored), mirrored);
+
+    bb_path_data_rotate(copy, 100, 200, 90);
+
+    const int rotated[][2] = { { 100, 200 }, { 100, 400 }, { -100, 400 } };
+    assert_points(copy, G_N_ELEMENTS(rotated), rotated);
+
+    bb_path_data_free(copy);
+    bb_path_data_free(data);
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func(
+        "/bbpathparsertest/checkabsolute",
+        check_absolute
+        );
+
+    g_test_add_func(
+        "/bbpathparsertest/checkbounds",
+        check_bounds
+        );
+
+    g_test_add_func(
+        "/bbpathparsertest/checkerror",
+        check_error
+        );
+
+    g_test_add_func(
+        "/bbpathparsertest/checkrelative",
+        check_relative
+        );
+
+    g_test_add_func(
+        "/bbpathparsertest/checktransform",
+        check_transform
+        );
+
+    return g_test_run();
+}
@@ -0,0 +1,396 @@
+/*
+ * bbschem
+ * Copyright (C) 2020 Edward C. Hennessy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtk/gtk.h>
+#include <string.h>
+#include <bbgedaarc.h>
+#include <bbgedablock.h>
+#include <bbgedabox.h>
+#include <bbgedabus.h>
+#include <bbgedacircle.h>
+#include <bbgedaline.h>
+#include <bbgedanet.h>
+#include <bbgedapath.h>
+#include <bbgedapin.h>
+#include <bbgedatext.h>
+#include <bbparams.h>
+#include <bbpathparser.h>
+#include <bbschematic.h>
+#include <bbwritebuffer.h>
+
+
+/**
+ * Records in the form written by the previous, printf based, writer
+ */
+static const gchar *records =
+    "A 100 100 200 0 90 3 10 0 0 -1 -1\n"
+    "B 100 200 1000 500 3 10 0 0 -1 -1 2 10 45 100 135 100\n"
+    "B -500 -600 100 100 3 15 1 0 -1 -1 0 -1 -1 -1 -1 -1\n"
+    "C 1000 2000 1 0 0 resistor-1.sym\n"
+    "H 3 10 0 0 -1 -1 0 -1 -1 -1 -1 -1 5\n"
+    "M 100,200\n"
+    "L 300,-400\n"
+    "C 400,500 600,500 700,400\n"
+    "z\n"
+    "M -100,-200\n"
+    "L 100 200 300 400 3 10 0 0 -1 -1\n"
+    "L -2147483648 2147483647 0 -1 3 0 0 0 -1 -1\n"
+    "N 0 0 1000 0 4\n"
+    "P 0 0 300 0 1 0 1\n"
+    "T 100 200 5 10 1 1 0 0 1\n"
+    "refdes=R1\n"
+    "T -100 -200 9 12 1 0 90 3 2\n"
+    "first line\n"
+    "second line\n"
+    "U 0 100 0 900 10 0\n"
+    "V 500 500 250 3 10 0 0 -1 -1 0 -1 -1 -1 -1 -1\n";
+
+
+static BbGedaItem*
+create_item(gchar **lines, int *index)
+{
+    GError *error = NULL;
+    BbParams *params = bb_params_new_with_line(lines[(*index)++], &error);
+    BbGedaItem *item = NULL;
+
+    g_assert_no_error(error);
+    g_assert_nonnull(params);
+
+    if (bb_params_token_matches(params, BB_GEDA_TEXT_TOKEN))
+    {
+        int count = bb_params_get_int(params, 9, &error);
+        g_assert_no_error(error);
+
+        gchar **text = g_new0(gchar*, count + 1);
+
+        for (int line = 0; line < count; line++)
+        {
+            text[line] = g_strdup(lines[(*index)++]);
+        }
+
+        item = BB_GEDA_ITEM(bb_geda_text_new_with_params(params, text, &error));
+
+        g_strfreev(text);
+    }
+    else if (bb_params_token_matches(params, BB_GEDA_PATH_TOKEN))
+    {
+        int count = bb_geda_path_get_line_count(params, &error);
+        g_assert_no_error(error);
+
+        gchar **text = g_new0(gchar*, count + 1);
+
+        for (int line = 0; line < count; line++)
+        {
+            text[line] = g_strdup(lines[(*index)++]);
+        }
+
+        gchar *merged = g_strjoinv(" ", text);
+        BbPathData *data = bb_path_parser_parse(merged, &error);
+        g_assert_no_error(error);
+
+        item = BB_GEDA_ITEM(bb_geda_path_new_with_params(params, data, &error));
+
+        bb_path_data_free(data);
+        g_free(merged);
+        g_strfreev(text);
+    }
+    else if (bb_params_token_matches(params, BB_GEDA_ARC_TOKEN))
+    {
+        item = BB_GEDA_ITEM(bb_geda_arc_new_with_params(params, &error));
+    }
+    else if (bb_params_token_matches(params, BB_GEDA_BLOCK_TOKEN))
+    {
+        item = BB_GEDA_ITEM(bb_geda_block_new_with_params(params, &error));
+    }
+    else if (bb_params_token_matches(params, BB_GEDA_BOX_TOKEN))
+    {
+        item = BB_GEDA_ITEM(bb_geda_box_new_with_params(params, &error));
+    }
+    else if (bb_params_token_matches(params, BB_GEDA_BUS_TOKEN))
+    {
+        item = BB_GEDA_ITEM(bb_geda_bus_new_with_params(params, &error));
+    }
+    else if (bb_params_token_matches(params, BB_GEDA_CIRCLE_TOKEN))
+    {
+        item = BB_GEDA_ITEM(bb_geda_circle_new_with_params(params, &error));
+    }
+    else if (bb_params_token_matches(params, BB_GEDA_LINE_TOKEN))
+    {
+        item = BB_GEDA_ITEM(bb_geda_line_new_with_params(params, &error));
+    }
+    else if (bb_params_token_matches(params, BB_GEDA_NET_TOKEN))
+    {
+        item = BB_GEDA_ITEM(bb_geda_net_new_with_params(params, &error));
+    }
+    else if (bb_params_token_matches(params, BB_GEDA_PIN_TOKEN))
+    {
+        item = BB_GEDA_ITEM(bb_geda_pin_new_with_params(params, &error));
+    }
+
+    bb_params_free(params);
+
+    g_assert_no_error(error);
+    g_assert_nonnull(item);
+
+    return item;
+}
+
+
+static BbSchematic*
+create_schematic(const gchar *contents)
+{
+    BbSchematic *schematic = bb_schematic_new();
+    gchar **lines = g_strsplit(contents, "\n", -1);
+    int index = 0;
+
+    while (lines[index] != NULL && *lines[index] != '\0')
+    {
+        BbGedaItem *item = create_item(lines, &index);
+
+        bb_schematic_add_item(schematic, item);
+
+        g_object_unref(item);
+    }
+
+    g_strfreev(lines);
+
+    return schematic;
+}
+
+
+/**
+ * Write the schematic into memory and return the contents as a null terminated string
+ */
+static gchar*
+write_schematic(BbSchematic *schematic)
+{
+    GError *error = NULL;
+    GOutputStream *stream = g_memory_output_stream_new_resizable();
+
+    gboolean result = bb_schematic_write(schematic, stream, NULL, &error);
+
+    g_assert_no_error(error);
+    g_assert_true(result);
+
+    g_output_stream_write_all(stream, "", 1, NULL, NULL, &error);
+    g_output_stream_close(stream, NULL, &error);
+    g_assert_no_error(error);
+
+    gchar *contents = g_memory_output_stream_steal_data(G_MEMORY_OUTPUT_STREAM(stream));
+
+    g_object_unref(stream);
+
+    return contents;
+}
+
+
+void
+check_append_int()
+{
+    GError *error = NULL;
+    GOutputStream *stream = g_memory_output_stream_new_resizable();
+    BbWriteBuffer *buffer = bb_write_buffer_new(stream, 16);
+    GString *expected = g_string_new(NULL);
+
+    int values[] = { 0, 1, -1, 9, 10, 99, 100, -100, 12345, G_MAXINT, G_MININT, G_MININT + 1 };
+
+    for (int index = 0; index < G_N_ELEMENTS(values); index++)
+    {
+        bb_write_buffer_append_int(buffer, values[index]);
+        bb_write_buffer_append_char(buffer, ' ');
+        g_string_append_printf(expected, "%d ", values[index]);
+    }
+
+    for (int count = 0; count < 100000; count++)
+    {
+        int value = g_test_rand_int();
+
+        bb_write_buffer_append_int(buffer, value);
+        bb_write_buffer_append_char(buffer, ' ');
+        g_string_append_printf(expected, "%d ", value);
+
+        bb_write_buffer_flush_if_full(buffer, NULL, &error);
+        g_assert_no_error(error);
+    }
+
+    bb_write_buffer_append_char(buffer, '\0');
+    bb_write_buffer_flush(buffer, NULL, &error);
+    g_assert_no_error(error);
+
+    g_output_stream_close(stream, NULL, &error);
+    g_assert_no_error(error);
+
+    g_assert_cmpstr(expected->str, ==, g_memory_output_stream_get_data(G_MEMORY_OUTPUT_STREAM(stream)));
+
+    g_string_free(expected, TRUE);
+    bb_write_buffer_free(buffer);
+    g_object_unref(stream);
+}
+
+
+void
+check_append_params()
+{
+    GError *error = NULL;
+    GOutputStream *stream = g_memory_output_stream_new_resizable();
+    BbWriteBuffer *buffer = bb_write_buffer_new(stream, BB_WRITE_BUFFER_DEFAULT_BLOCK_SIZE);
+
+    int params[] = { 1, -2, 3 };
+
+    bb_write_buffer_append_params(buffer, "X", G_N_ELEMENTS(params), params);
+    bb_write_buffer_append_params(buffer, "Y", 0, NULL);
+    bb_write_buffer_append_char(buffer, '\0');
+    bb_write_buffer_flush(buffer, NULL, &error);
+    g_assert_no_error(error);
+
+    g_assert_cmpstr("X 1 -2 3\nY\n", ==, g_memory_output_stream_get_data(G_MEMORY_OUTPUT_STREAM(stream)));
+
+    bb_write_buffer_free(buffer);
+    g_object_unref(stream);
+}
+
+
+void
+check_round_trip()
+{
+    BbSchematic *schematic = create_schematic(records);
+    gchar *contents = write_schematic(schematic);
+
+    g_assert_cmpstr(records, ==, contents);
+
+    g_free(contents);
+    g_object_unref(schematic);
+}
+
+
+void
+check_round_trip_large()
+{
+    GString *large = g_string_new(NULL);
+
+    while (large->len < 4 * BB_WRITE_BUFFER_DEFAULT_BLOCK_SIZE)
+    {
+        g_string_append(large, records);
+    }
+
+    BbSchematic *schematic = create_schematic(large->str);
+    gchar *contents = write_schematic(schematic);
+
+    g_assert_cmpstr(large->str, ==, contents);
+
+    g_free(contents);
+    g_object_unref(schematic);
+    g_string_free(large, TRUE);
+}
+
+
+static void
+save_ready(BbSchematic *schematic, GAsyncResult *result, GMainLoop *loop)
+{
+    GError *error = NULL;
+
+    gboolean success = bb_schematic_save_finish(schematic, result, &error);
+
+    g_assert_no_error(error);
+    g_assert_true(success);
+
+    g_main_loop_quit(loop);
+}
+
+
+void
+check_save_async()
+{
+    GError *error = NULL;
+    gchar *folder = g_dir_make_tmp("bbwritebuffertest-XXXXXX", &error);
+    g_assert_no_error(error);
+
+    gchar *path = g_build_filename(folder, "test.sch", NULL);
+    GFile *file = g_file_new_for_path(path);
+    GMainLoop *loop = g_main_loop_new(NULL, FALSE);
+    BbSchematic *schematic = create_schematic(records);
+
+    bb_schematic_save_async(
+        schematic,
+        file,
+        G_PRIORITY_DEFAULT,
+        NULL,
+        (GAsyncReadyCallback) save_ready,
+        loop
+        );
+
+    /* Edits after the save begins must not appear in the file */
+
+    gchar *lines[] = { "N 0 0 1000 0 4", NULL };
+    int index = 0;
+    BbGedaItem *net = create_item(lines, &index);
+
+    bb_schematic_add_item(schematic, net);
+
+    g_main_loop_run(loop);
+
+    gchar *contents = NULL;
+    g_file_get_contents(path, &contents, NULL, &error);
+    g_assert_no_error(error);
+
+    g_assert_cmpstr(records, ==, contents);
+
+    g_free(contents);
+    g_object_unref(net);
+    g_object_unref(schematic);
+    g_main_loop_unref(loop);
+    g_file_delete(file, NULL, NULL);
+    g_object_unref(file);
+    g_rmdir(folder);
+    g_free(path);
+    g_free(folder);
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func(
+        "/bbwritebuffertest/checkappendint",
+        check_append_int
+        );
+
+    g_test_add_func(
+        "/bbwritebuffertest/checkappendparams",
+        check_append_params
+        );
+
+    g_test_add_func(
+        "/bbwritebuffertest/checkroundtrip",
+        check_round_trip
+        );
+
+    g_test_add_func(
+        "/bbwritebuffertest/checkroundtriplarge",
+        check_round_trip_large
+        );
+
+    g_test_add_func(
+        "/bbwritebuffertest/checksaveasync",
+        check_save_async
+        );
+
+    return g_test_run();
+}